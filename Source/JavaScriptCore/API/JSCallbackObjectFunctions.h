@@ -134,7 +134,7 @@ bool JSCallbackObject<Parent>::getOwnPropertySlot(JSCell* cell, ExecState* exec,
             // optional optimization to bypass getProperty in cases when we only need to know if the property exists
             if (JSObjectHasPropertyCallback hasProperty = jsClass->hasProperty) {
                 if (!propertyNameRef)
-                    propertyNameRef = OpaqueJSString::create(name);
+                    propertyNameRef = OpaqueJSString::create(&exec->vm(), name);
                 APICallbackShim callbackShim(exec);
                 if (hasProperty(ctx, thisRef, propertyNameRef.get())) {
                     slot.setCustom(thisObject, callbackGetter);
@@ -142,7 +142,7 @@ bool JSCallbackObject<Parent>::getOwnPropertySlot(JSCell* cell, ExecState* exec,
                 }
             } else if (JSObjectGetPropertyCallback getProperty = jsClass->getProperty) {
                 if (!propertyNameRef)
-                    propertyNameRef = OpaqueJSString::create(name);
+                    propertyNameRef = OpaqueJSString::create(&exec->vm(), name);
                 JSValueRef exception = 0;
                 JSValueRef value;
                 {
@@ -245,7 +245,7 @@ void JSCallbackObject<Parent>::put(JSCell* cell, ExecState* exec, PropertyName p
         for (JSClassRef jsClass = thisObject->classRef(); jsClass; jsClass = jsClass->parentClass) {
             if (JSObjectSetPropertyCallback setProperty = jsClass->setProperty) {
                 if (!propertyNameRef)
-                    propertyNameRef = OpaqueJSString::create(name);
+                    propertyNameRef = OpaqueJSString::create(&exec->vm(), name);
                 JSValueRef exception = 0;
                 bool result;
                 {
@@ -264,7 +264,7 @@ void JSCallbackObject<Parent>::put(JSCell* cell, ExecState* exec, PropertyName p
                         return;
                     if (JSObjectSetPropertyCallback setProperty = entry->setProperty) {
                         if (!propertyNameRef)
-                            propertyNameRef = OpaqueJSString::create(name);
+                            propertyNameRef = OpaqueJSString::create(&exec->vm(), name);
                         JSValueRef exception = 0;
                         bool result;
                         {
@@ -306,7 +306,7 @@ void JSCallbackObject<Parent>::putByIndex(JSCell* cell, ExecState* exec, unsigne
     for (JSClassRef jsClass = thisObject->classRef(); jsClass; jsClass = jsClass->parentClass) {
         if (JSObjectSetPropertyCallback setProperty = jsClass->setProperty) {
             if (!propertyNameRef)
-                propertyNameRef = OpaqueJSString::create(propertyName.impl());
+                propertyNameRef = OpaqueJSString::create(&exec->vm(), propertyName.impl());
             JSValueRef exception = 0;
             bool result;
             {
@@ -325,7 +325,7 @@ void JSCallbackObject<Parent>::putByIndex(JSCell* cell, ExecState* exec, unsigne
                     return;
                 if (JSObjectSetPropertyCallback setProperty = entry->setProperty) {
                     if (!propertyNameRef)
-                        propertyNameRef = OpaqueJSString::create(propertyName.impl());
+                        propertyNameRef = OpaqueJSString::create(&exec->vm(), propertyName.impl());
                     JSValueRef exception = 0;
                     bool result;
                     {
@@ -364,7 +364,7 @@ bool JSCallbackObject<Parent>::deleteProperty(JSCell* cell, ExecState* exec, Pro
         for (JSClassRef jsClass = thisObject->classRef(); jsClass; jsClass = jsClass->parentClass) {
             if (JSObjectDeletePropertyCallback deleteProperty = jsClass->deleteProperty) {
                 if (!propertyNameRef)
-                    propertyNameRef = OpaqueJSString::create(name);
+                    propertyNameRef = OpaqueJSString::create(&exec->vm(), name);
                 JSValueRef exception = 0;
                 bool result;
                 {
@@ -588,7 +588,7 @@ JSValue JSCallbackObject<Parent>::getStaticValue(ExecState* exec, PropertyName p
                 if (StaticValueEntry* entry = staticValues->get(name)) {
                     if (JSObjectGetPropertyCallback getProperty = entry->getProperty) {
                         if (!propertyNameRef)
-                            propertyNameRef = OpaqueJSString::create(name);
+                            propertyNameRef = OpaqueJSString::create(&exec->vm(), name);
                         JSValueRef exception = 0;
                         JSValueRef value;
                         {
@@ -650,7 +650,7 @@ JSValue JSCallbackObject<Parent>::callbackGetter(ExecState* exec, JSValue slotPa
         for (JSClassRef jsClass = thisObj->classRef(); jsClass; jsClass = jsClass->parentClass) {
             if (JSObjectGetPropertyCallback getProperty = jsClass->getProperty) {
                 if (!propertyNameRef)
-                    propertyNameRef = OpaqueJSString::create(name);
+                    propertyNameRef = OpaqueJSString::create(&exec->vm(), name);
                 JSValueRef exception = 0;
                 JSValueRef value;
                 {
@@ -107,6 +107,54 @@ void JSContextGroupClearExecutionTimeLimit(JSContextGroupRef group)
     watchdog.setTimeLimit(vm, std::numeric_limits<double>::infinity());
 }
 
+static void internalTimeSliceCallback(ExecState* exec, void* callbackPtr, void* callbackData)
+{
+    JSTimeSliceCallback callback = reinterpret_cast<JSTimeSliceCallback>(callbackPtr);
+    JSContextRef contextRef = toRef(exec);
+    ASSERT(callback);
+    callback(contextRef, callbackData);
+}
+
+void JSContextGroupSetTimeSlice(JSContextGroupRef group, double slice, JSTimeSliceCallback callback, void* callbackData)
+{
+    ASSERT(callback);
+    VM& vm = *toJS(group);
+    APIEntryShim entryShim(&vm);
+    void* callbackPtr = reinterpret_cast<void*>(callback);
+    vm.watchdog.setTimeSlice(vm, slice, internalTimeSliceCallback, callbackPtr, callbackData);
+}
+
+void JSContextGroupClearTimeSlice(JSContextGroupRef group)
+{
+    VM& vm = *toJS(group);
+    APIEntryShim entryShim(&vm);
+    vm.watchdog.setTimeSlice(vm, std::numeric_limits<double>::infinity());
+}
+
+void JSContextGroupSetRecyclingLimit(unsigned limit)
+{
+    initializeThreading();
+    VM::setMaximumRecycledContextGroups(limit);
+}
+
+void JSContextGroupSetTierUpTelemetryEnabled(JSContextGroupRef group, bool enabled)
+{
+    VM& vm = *toJS(group);
+    APIEntryShim entryShim(&vm);
+    vm.m_tierUpTelemetry->setEnabled(enabled);
+}
+
+JSValueRef JSContextCreateTierUpTelemetry(JSContextRef ctx, bool clearEvents)
+{
+    if (!ctx) {
+        ASSERT_NOT_REACHED();
+        return 0;
+    }
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+    return toRef(exec, exec->vm().m_tierUpTelemetry->toJS(exec, clearEvents));
+}
+
 // From the API's perspective, a global context remains alive iff it has been JSGlobalContextRetained.
 
 JSGlobalContextRef JSGlobalContextCreate(JSClassRef globalObjectClass)
@@ -103,6 +103,82 @@ JS_EXPORT void JSContextGroupSetExecutionTimeLimit(JSContextGroupRef, double lim
 */
 JS_EXPORT void JSContextGroupClearExecutionTimeLimit(JSContextGroupRef) AVAILABLE_IN_WEBKIT_VERSION_4_0;
 
+/*! 
+@typedef JSTimeSliceCallback
+@abstract The callback invoked each time script execution has used up the time
+ slice previously specified via JSContextGroupSetTimeSlice.
+@param ctx The execution context to use.
+@param context User specified context data previously passed to
+ JSContextGroupSetTimeSlice.
+@discussion If you named your function Callback, you would declare it like this:
+
+ void Callback(JSContextRef ctx, void* context);
+
+ The script is paused while the callback runs, and resumes where it left off
+ when the callback returns. This lets you handle pending input, or other work of
+ your event loop, while a long computation is in progress.
+
+ Neither the time slice nor the execution time limit applies to scripts that you
+ evaluate from within this callback, and the CPU time that the callback uses is
+ not charged to the paused script. Within this callback function, you may call
+ JSContextGroupSetTimeSlice to change the time slice, or
+ JSContextGroupClearTimeSlice to stop slicing.
+*/
+typedef void
+(*JSTimeSliceCallback) (JSContextRef ctx, void* context);
+
+/*!
+@function
+@abstract Sets the time slice of script execution.
+@param group The JavaScript context group that this time slice applies to.
+@param slice The CPU time, in seconds, that script may run before it is paused
+ and the callback is invoked.
+@param callback The callback function that will be invoked every time a script
+ has run for the time slice.
+@param context User data that you can provide to be passed back to you
+ in your callback.
+@discussion Script is paused at the same points at which the execution time limit
+ is checked, which include every loop iteration, so the callback can be invoked
+ somewhat after the time slice has ended. The time slice is independent of the
+ execution time limit, and both may be set at once. Like the time limit, the
+ time slice only takes full effect if it is set before you start executing any
+ scripts.
+*/
+JS_EXPORT void JSContextGroupSetTimeSlice(JSContextGroupRef group, double slice, JSTimeSliceCallback callback, void* context);
+
+/*!
+@function
+@abstract Clears the time slice of script execution.
+@param group The JavaScript context group that the time slice is cleared on.
+*/
+JS_EXPORT void JSContextGroupClearTimeSlice(JSContextGroupRef group);
+
+/*!
+@function
+@abstract Sets how many released context groups are kept for reuse.
+@param limit The largest number of released context groups to keep. The default, 0, destroys a context group as soon as it is released.
+@discussion Creating a context group, or a global context without one, normally builds a new virtual machine, with its own heap, identifiers and compiled code. A released context group that is kept is instead handed to the next one created, which then starts out with all of these. None of the values that the released group's contexts created are reachable from the new group, but they are finalized during a later garbage collection rather than when the group is released. A group that still has protected values is not kept. A context group can be used from any thread, one at a time, so kept groups can serve a pool of worker threads.
+*/
+JS_EXPORT void JSContextGroupSetRecyclingLimit(unsigned limit);
+
+/*!
+@function
+@abstract Turns recording of tier-up telemetry on or off.
+@param group The JavaScript context group whose telemetry you want to record.
+@param enabled Whether compilations, OSR exits, jettisons and reoptimizations should be recorded.
+@discussion Turning telemetry off keeps what has been recorded so far.
+*/
+JS_EXPORT void JSContextGroupSetTierUpTelemetryEnabled(JSContextGroupRef group, bool enabled);
+
+/*!
+@function
+@abstract Gets the tier-up telemetry recorded for a context's group.
+@param ctx The execution context to use.
+@param clearEvents Whether to remove the returned events from the event log, so that the next call only returns newer events.
+@result An object whose "functions" property holds an array of per-function counters, whose "events" property holds an array of the most recent events, oldest first, and whose "droppedEvents" property counts the events that did not fit in the log.
+*/
+JS_EXPORT JSValueRef JSContextCreateTierUpTelemetry(JSContextRef ctx, bool clearEvents);
+
 #ifdef __cplusplus
 }
 #endif
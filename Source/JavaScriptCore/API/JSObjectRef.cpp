@@ -314,16 +314,8 @@ JSValueRef JSObjectGetProperty(JSContextRef ctx, JSObjectRef object, JSStringRef
     return toRef(exec, jsValue);
 }
 
-void JSObjectSetProperty(JSContextRef ctx, JSObjectRef object, JSStringRef propertyName, JSValueRef value, JSPropertyAttributes attributes, JSValueRef* exception)
+static void setProperty(ExecState* exec, JSObject* jsObject, JSStringRef propertyName, JSValueRef value, JSPropertyAttributes attributes)
 {
-    if (!ctx) {
-        ASSERT_NOT_REACHED();
-        return;
-    }
-    ExecState* exec = toJS(ctx);
-    APIEntryShim entryShim(exec);
-
-    JSObject* jsObject = toJS(object);
     Identifier name(propertyName->identifier(&exec->vm()));
     JSValue jsValue = toJS(exec, value);
 
@@ -333,6 +325,18 @@ void JSObjectSetProperty(JSContextRef ctx, JSObjectRef object, JSStringRef prope
         PutPropertySlot slot;
         jsObject->methodTable()->put(jsObject, exec, name, jsValue, slot);
     }
+}
+
+void JSObjectSetProperty(JSContextRef ctx, JSObjectRef object, JSStringRef propertyName, JSValueRef value, JSPropertyAttributes attributes, JSValueRef* exception)
+{
+    if (!ctx) {
+        ASSERT_NOT_REACHED();
+        return;
+    }
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    setProperty(exec, toJS(object), propertyName, value, attributes);
 
     if (exec->hadException()) {
         if (exception)
@@ -341,6 +345,27 @@ void JSObjectSetProperty(JSContextRef ctx, JSObjectRef object, JSStringRef prope
     }
 }
 
+void JSObjectSetProperties(JSContextRef ctx, JSObjectRef object, size_t propertyCount, const JSStringRef propertyNames[], const JSValueRef values[], JSPropertyAttributes attributes, JSValueRef* exception)
+{
+    if (!ctx) {
+        ASSERT_NOT_REACHED();
+        return;
+    }
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    JSObject* jsObject = toJS(object);
+    for (size_t i = 0; i < propertyCount; ++i) {
+        setProperty(exec, jsObject, propertyNames[i], values[i], attributes);
+        if (exec->hadException()) {
+            if (exception)
+                *exception = toRef(exec, exec->exception());
+            exec->clearException();
+            return;
+        }
+    }
+}
+
 JSValueRef JSObjectGetPropertyAtIndex(JSContextRef ctx, JSObjectRef object, unsigned propertyIndex, JSValueRef* exception)
 {
     if (!ctx) {
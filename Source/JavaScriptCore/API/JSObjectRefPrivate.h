@@ -67,6 +67,20 @@ JS_EXPORT JSValueRef JSObjectGetPrivateProperty(JSContextRef ctx, JSObjectRef ob
  */
 JS_EXPORT bool JSObjectDeletePrivateProperty(JSContextRef ctx, JSObjectRef object, JSStringRef propertyName);
 
+/*!
+ @function
+ @abstract Sets several properties on an object in one call.
+ @param ctx The execution context to use.
+ @param object The JSObject whose properties you want to set.
+ @param propertyCount An integer count of the number of properties in propertyNames and values.
+ @param propertyNames A C array of JSStrings containing the properties' names.
+ @param values A C array of JSValues to use as the properties' values.
+ @param attributes A logically ORed set of JSPropertyAttributes to give to every property.
+ @param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+ @discussion Behaves like calling JSObjectSetProperty for each name and value in order, but enters the VM only once. Stops at the first property that throws.
+ */
+JS_EXPORT void JSObjectSetProperties(JSContextRef ctx, JSObjectRef object, size_t propertyCount, const JSStringRef propertyNames[], const JSValueRef values[], JSPropertyAttributes attributes, JSValueRef* exception);
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,14 +45,20 @@ JSStringRef JSStringCreateWithUTF8CString(const char* string)
     initializeThreading();
     if (string) {
         size_t length = strlen(string);
-        Vector<UChar, 1024> buffer(length);
-        UChar* p = buffer.data();
-        bool sourceIsAllASCII;
-        const LChar* stringStart = reinterpret_cast<const LChar*>(string);
-        if (conversionOK == convertUTF8ToUTF16(&string, string + length, &p, p + length, &sourceIsAllASCII)) {
-            if (sourceIsAllASCII)
-                return OpaqueJSString::create(stringStart, length).leakRef();
-            return OpaqueJSString::create(buffer.data(), p - buffer.data()).leakRef();
+        const char* end = string + length;
+        Vector<LChar, 1024> latin1Buffer(length);
+        LChar* q = latin1Buffer.data();
+        ConversionResult result = convertUTF8ToLatin1(&string, end, &q, q + length);
+        if (result == conversionOK)
+            return OpaqueJSString::create(latin1Buffer.data(), q - latin1Buffer.data()).leakRef();
+        if (result == sourceNotLatin1) {
+            // Widen what was decoded so far, and decode the rest as UTF-16.
+            Vector<UChar, 1024> buffer(length);
+            unsigned latin1Length = q - latin1Buffer.data();
+            StringImpl::copyChars(buffer.data(), latin1Buffer.data(), latin1Length);
+            UChar* p = buffer.data() + latin1Length;
+            if (conversionOK == convertUTF8ToUTF16(&string, end, &p, buffer.data() + length))
+                return OpaqueJSString::create(buffer.data(), p - buffer.data()).leakRef();
         }
     }
 
@@ -29,6 +29,7 @@
 #include <interpreter/CallFrame.h>
 #include <runtime/JSGlobalObject.h>
 #include <runtime/Identifier.h>
+#include <runtime/VM.h>
 
 using namespace JSC;
 
@@ -39,6 +40,18 @@ PassRefPtr<OpaqueJSString> OpaqueJSString::create(const String& string)
     return 0;
 }
 
+PassRefPtr<OpaqueJSString> OpaqueJSString::create(VM* vm, StringImpl* identifier)
+{
+    ASSERT(identifier->isIdentifier());
+    OpaqueJSStringIdentifierCache& cache = vm->opaqueJSStringIdentifierCache();
+    if (OpaqueJSString* string = cache.stringFor(identifier))
+        return string;
+
+    RefPtr<OpaqueJSString> string = create(String(identifier));
+    cache.add(string.get(), identifier);
+    return string.release();
+}
+
 String OpaqueJSString::string() const
 {
     if (!this)
@@ -56,8 +69,36 @@ Identifier OpaqueJSString::identifier(VM* vm) const
     if (m_string.isEmpty())
         return Identifier(Identifier::EmptyIdentifier);
 
-    if (m_string.is8Bit())
-        return Identifier(vm, m_string.characters8(), m_string.length());
+    OpaqueJSStringIdentifierCache& cache = vm->opaqueJSStringIdentifierCache();
+    if (StringImpl* identifier = cache.identifierFor(this))
+        return Identifier(vm, identifier);
+
+    Identifier result = m_string.is8Bit()
+        ? Identifier(vm, m_string.characters8(), m_string.length())
+        : Identifier(vm, m_string.characters16(), m_string.length());
+    cache.add(const_cast<OpaqueJSString*>(this), result.impl());
+    return result;
+}
+
+StringImpl* OpaqueJSStringIdentifierCache::identifierFor(const OpaqueJSString* string) const
+{
+    const Entry& entry = m_byString[indexFor(string)];
+    return entry.string == string ? entry.identifier.get() : 0;
+}
+
+OpaqueJSString* OpaqueJSStringIdentifierCache::stringFor(StringImpl* identifier) const
+{
+    const Entry& entry = m_byIdentifier[indexFor(identifier)];
+    return entry.identifier == identifier ? entry.string.get() : 0;
+}
+
+void OpaqueJSStringIdentifierCache::add(OpaqueJSString* string, StringImpl* identifier)
+{
+    Entry& byString = m_byString[indexFor(string)];
+    byString.string = string;
+    byString.identifier = identifier;
 
-    return Identifier(vm, m_string.characters16(), m_string.length());
+    Entry& byIdentifier = m_byIdentifier[indexFor(identifier)];
+    byIdentifier.string = string;
+    byIdentifier.identifier = identifier;
 }
@@ -53,6 +53,10 @@ struct OpaqueJSString : public ThreadSafeRefCounted<OpaqueJSString> {
 
     JS_EXPORT_PRIVATE static PassRefPtr<OpaqueJSString> create(const String&);
 
+    // Returns the string handed out for this identifier by a recent call, if the VM still has it cached.
+    // Must be called with the VM's API lock held.
+    static PassRefPtr<OpaqueJSString> create(JSC::VM*, StringImpl* identifier);
+
     const UChar* characters() { return !!this ? m_string.characters() : 0; }
     unsigned length() { return !!this ? m_string.length() : 0; }
 
@@ -87,4 +91,29 @@ private:
     String m_string;
 };
 
+// Direct-mapped caches between API strings and the identifiers made from them, owned by a VM
+// and only used with its API lock held. Each entry keeps both its string and its identifier
+// alive, so a pointer match means the characters are unchanged.
+class OpaqueJSStringIdentifierCache {
+    WTF_MAKE_NONCOPYABLE(OpaqueJSStringIdentifierCache); WTF_MAKE_FAST_ALLOCATED;
+public:
+    OpaqueJSStringIdentifierCache() { }
+
+    StringImpl* identifierFor(const OpaqueJSString*) const;
+    OpaqueJSString* stringFor(StringImpl* identifier) const;
+    void add(OpaqueJSString*, StringImpl* identifier);
+
+private:
+    struct Entry {
+        RefPtr<OpaqueJSString> string;
+        RefPtr<StringImpl> identifier;
+    };
+
+    static const unsigned cacheSize = 64;
+    static unsigned indexFor(const void* pointer) { return (reinterpret_cast<uintptr_t>(pointer) >> 4) & (cacheSize - 1); }
+
+    Entry m_byString[cacheSize];
+    Entry m_byIdentifier[cacheSize];
+};
+
 #endif
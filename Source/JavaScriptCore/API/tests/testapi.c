@@ -1043,6 +1043,29 @@ static bool checkForCycleInPrototypeChain()
     return result;
 }
 
+static bool checkContextGroupRecycling()
+{
+    bool result = true;
+    JSContextGroupSetRecyclingLimit(1);
+
+    JSGlobalContextRef context = JSGlobalContextCreate(0);
+    JSContextGroupRef group = JSContextGetGroup(context);
+    JSStringRef code = JSStringCreateWithUTF8CString("var fromReleasedContext = 42;");
+    JSEvaluateScript(context, code, 0, 0, 1, 0);
+    JSStringRelease(code);
+    JSGlobalContextRelease(context);
+
+    context = JSGlobalContextCreate(0);
+    result &= assertTrue(JSContextGetGroup(context) == group, "A released context group is reused");
+    code = JSStringCreateWithUTF8CString("typeof fromReleasedContext == 'undefined' && [1, 2, 3].join() == '1,2,3'");
+    result &= assertTrue(JSValueToBoolean(context, JSEvaluateScript(context, code, 0, 0, 1, 0)), "A reused context group starts out with a fresh global object");
+    JSStringRelease(code);
+    JSGlobalContextRelease(context);
+
+    JSContextGroupSetRecyclingLimit(0);
+    return result;
+}
+
 static void checkConstnessInJSObjectNames()
 {
     JSStaticFunction fun;
@@ -1110,6 +1133,14 @@ static bool extendTerminateCallback(JSContextRef ctx, void* context)
     }
     return true;
 }
+
+int timeSliceCallbackCalled = 0;
+static void timeSliceCallback(JSContextRef ctx, void* context)
+{
+    UNUSED_PARAM(ctx);
+    UNUSED_PARAM(context);
+    timeSliceCallbackCalled++;
+}
 #endif /* PLATFORM(MAC) || PLATFORM(IOS) */
 
 
@@ -1346,6 +1377,48 @@ int main(int argc, char* argv[])
     } else
         printf("PASS: Retrieved private property.\n");
 
+    {
+        JSObjectRef batchObject = JSObjectMake(context, 0, 0);
+        JSStringRef batchNames[2] = { JSStringCreateWithUTF8CString("first"), JSStringCreateWithUTF8CString("second") };
+        JSValueRef batchValues[2] = { JSValueMakeNumber(context, 1), JSValueMakeNumber(context, 2) };
+        JSValueRef batchException = 0;
+        JSObjectSetProperties(context, batchObject, 2, batchNames, batchValues, kJSPropertyAttributeReadOnly, &batchException);
+        JSObjectSetProperty(context, batchObject, batchNames[1], JSValueMakeNumber(context, 3), kJSPropertyAttributeNone, 0);
+        if (batchException
+            || JSValueToNumber(context, JSObjectGetProperty(context, batchObject, batchNames[0], 0), 0) != 1
+            || JSValueToNumber(context, JSObjectGetProperty(context, batchObject, batchNames[1], 0), 0) != 2) {
+            printf("FAIL: JSObjectSetProperties did not set read-only properties.\n");
+            failed = 1;
+        } else
+            printf("PASS: JSObjectSetProperties set read-only properties.\n");
+        JSStringRelease(batchNames[0]);
+        JSStringRelease(batchNames[1]);
+    }
+
+    {
+        JSContextGroupSetTierUpTelemetryEnabled(JSContextGetGroup(context), true);
+        JSStringRef hotScript = JSStringCreateWithUTF8CString("function hot(x) { return x + 1; } for (var i = 0; i < 100000; ++i) hot(i);");
+        JSEvaluateScript(context, hotScript, 0, 0, 1, 0);
+        JSStringRelease(hotScript);
+        JSContextGroupSetTierUpTelemetryEnabled(JSContextGetGroup(context), false);
+
+        JSStringRef functionsName = JSStringCreateWithUTF8CString("functions");
+        JSStringRef eventsName = JSStringCreateWithUTF8CString("events");
+        JSStringRef lengthName = JSStringCreateWithUTF8CString("length");
+        JSValueRef telemetry = JSContextCreateTierUpTelemetry(context, true);
+        JSValueRef telemetryAfterClear = JSContextCreateTierUpTelemetry(context, false);
+        if (!JSValueIsObject(context, telemetry)
+            || !JSValueIsObject(context, JSObjectGetProperty(context, JSValueToObject(context, telemetry, 0), functionsName, 0))
+            || JSValueToNumber(context, JSObjectGetProperty(context, JSValueToObject(context, JSObjectGetProperty(context, JSValueToObject(context, telemetryAfterClear, 0), eventsName, 0), 0), lengthName, 0), 0)) {
+            printf("FAIL: JSContextCreateTierUpTelemetry did not return counters and clear events.\n");
+            failed = 1;
+        } else
+            printf("PASS: JSContextCreateTierUpTelemetry returned counters and cleared events.\n");
+        JSStringRelease(functionsName);
+        JSStringRelease(eventsName);
+        JSStringRelease(lengthName);
+    }
+
     JSStringRef nullJSON = JSStringCreateWithUTF8CString(0);
     JSValueRef nullJSONObject = JSValueMakeFromJSONString(context, nullJSON);
     if (nullJSONObject) {
@@ -1932,6 +2005,28 @@ int main(int argc, char* argv[])
             failed = true;
         }
     }
+
+    /* Test script time slicing: */
+    JSContextGroupClearExecutionTimeLimit(contextGroup);
+    JSContextGroupSetTimeSlice(contextGroup, .050f, timeSliceCallback, 0);
+    {
+        const char* longRunningScript = "var startTime = currentCPUTime(); var iterations = 0; while (currentCPUTime() - startTime < .300) iterations++; iterations > 0";
+        JSStringRef script = JSStringCreateWithUTF8CString(longRunningScript);
+        exception = NULL;
+        v = JSEvaluateScript(context, script, NULL, NULL, 1, &exception);
+        JSStringRelease(script);
+
+        if (!exception && JSValueToBoolean(context, v) && timeSliceCallbackCalled >= 3)
+            printf("PASS: script was paused every time slice and then resumed.\n");
+        else {
+            if (timeSliceCallbackCalled < 3)
+                printf("FAIL: time slice callback was called %d times.\n", timeSliceCallbackCalled);
+            if (exception)
+                printf("FAIL: script was terminated during time slicing test.\n");
+            failed = true;
+        }
+    }
+    JSContextGroupClearTimeSlice(contextGroup);
 #endif /* PLATFORM(MAC) || PLATFORM(IOS) */
 
     // Clear out local variables pointing at JSObjectRefs to allow their values to be collected
@@ -1976,6 +2071,13 @@ int main(int argc, char* argv[])
         failed = true;
     }
 
+    if (checkContextGroupRecycling())
+        printf("PASS: Released context groups are recycled.\n");
+    else {
+        printf("FAIL: Released context groups are not recycled.\n");
+        failed = true;
+    }
+
     if (failed) {
         printf("FAIL: Some tests failed.\n");
         return 1;
@@ -133,6 +133,7 @@ SOURCES += \
     dfg/DFGMinifiedNode.cpp \
     dfg/DFGNode.cpp \
     dfg/DFGNodeFlags.cpp \
+    dfg/DFGObjectAllocationSinkingPhase.cpp \
     dfg/DFGOperations.cpp \
     dfg/DFGOSREntry.cpp \
     dfg/DFGOSRExit.cpp \
@@ -218,10 +219,12 @@ SOURCES += \
     profiler/ProfilerOSRExit.cpp \
     profiler/ProfilerOSRExitSite.cpp \
     profiler/ProfilerProfiledBytecodes.cpp \
+    profiler/ProfilerTierUpTelemetry.cpp \
     profiler/Profile.cpp \
     profiler/ProfileGenerator.cpp \
     profiler/ProfileNode.cpp \
     profiler/LegacyProfiler.cpp \
+    profiler/SamplingProfiler.cpp \
     runtime/ArgList.cpp \
     runtime/Arguments.cpp \
     runtime/ArrayConstructor.cpp \
@@ -293,6 +296,7 @@ SOURCES += \
     runtime/NumberConstructor.cpp \
     runtime/NumberObject.cpp \
     runtime/NumberPrototype.cpp \
+    runtime/NumericStrings.cpp \
     runtime/ObjectConstructor.cpp \
     runtime/ObjectPrototype.cpp \
     runtime/Operations.cpp \
@@ -321,7 +325,7 @@ SOURCES += \
     runtime/StructureRareData.cpp \
     runtime/SymbolTable.cpp \
     runtime/Watchdog.cpp \
-    runtime/WatchdogNone.cpp \
+    runtime/WatchdogGeneric.cpp \
     tools/CodeProfile.cpp \
     tools/CodeProfiling.cpp \
     yarr/YarrJIT.cpp \
@@ -1149,6 +1149,7 @@ void CodeBlock::dumpBytecode(PrintStream& out, ExecState* exec, const Instructio
             int r4 = (++it)->u.operand;
             int r5 = (++it)->u.operand;
             out.printf("[%4d] get_by_pname\t %s, %s, %s, %s, %s, %s", location, registerName(exec, r0).data(), registerName(exec, r1).data(), registerName(exec, r2).data(), registerName(exec, r3).data(), registerName(exec, r4).data(), registerName(exec, r5).data());
+            dumpValueProfiling(out, it, hasPrintedProfiling);
             break;
         }
         case op_put_by_val: {
@@ -1614,6 +1615,7 @@ CodeBlock::CodeBlock(CopyParsedBlockTag, CodeBlock& other)
     , m_osrExitCounter(0)
     , m_optimizationDelayCounter(0)
     , m_reoptimizationRetryCounter(0)
+    , m_wasEnteredRecently(true)
     , m_resolveOperations(other.m_resolveOperations)
     , m_putToBaseOperations(other.m_putToBaseOperations)
 #if ENABLE(JIT)
@@ -1633,6 +1635,11 @@ CodeBlock::CodeBlock(CopyParsedBlockTag, CodeBlock& other)
         m_rareData->m_characterSwitchJumpTables = other.m_rareData->m_characterSwitchJumpTables;
         m_rareData->m_stringSwitchJumpTables = other.m_rareData->m_stringSwitchJumpTables;
     }
+
+#if ENABLE(SAMPLING_PROFILER)
+    if (m_vm->m_samplingProfiler)
+        m_vm->m_samplingProfiler->noticeCodeBlockCreation(this);
+#endif
 }
 
 CodeBlock::CodeBlock(ScriptExecutable* ownerExecutable, UnlinkedCodeBlock* unlinkedCodeBlock, JSGlobalObject* globalObject, unsigned baseScopeDepth, PassRefPtr<SourceProvider> sourceProvider, unsigned sourceOffset, unsigned firstLineColumnOffset, PassOwnPtr<CodeBlock> alternative)
@@ -1657,6 +1664,7 @@ CodeBlock::CodeBlock(ScriptExecutable* ownerExecutable, UnlinkedCodeBlock* unlin
     , m_osrExitCounter(0)
     , m_optimizationDelayCounter(0)
     , m_reoptimizationRetryCounter(0)
+    , m_wasEnteredRecently(true)
 {
     m_vm->startedCompiling(this);
 
@@ -1802,6 +1810,7 @@ CodeBlock::CodeBlock(ScriptExecutable* ownerExecutable, UnlinkedCodeBlock* unlin
         }
         case op_convert_this:
         case op_get_by_id:
+        case op_get_by_pname:
         case op_call_put_result:
         case op_get_callee: {
             ValueProfile* profile = &m_valueProfiles[pc[i + opLength - 1].u.operand];
@@ -1971,12 +1980,23 @@ CodeBlock::CodeBlock(ScriptExecutable* ownerExecutable, UnlinkedCodeBlock* unlin
     if (Options::dumpGeneratedBytecodes())
         dumpBytecode();
     m_vm->finishedCompiling(this);
+
+#if ENABLE(SAMPLING_PROFILER)
+    if (m_vm->m_samplingProfiler)
+        m_vm->m_samplingProfiler->noticeCodeBlockCreation(this);
+#endif
 }
 
 CodeBlock::~CodeBlock()
 {
     if (m_vm->m_perBytecodeProfiler)
         m_vm->m_perBytecodeProfiler->notifyDestruction(this);
+    if (Profiler::TierUpTelemetry* telemetry = m_vm->enabledTierUpTelemetry())
+        telemetry->notifyDestruction(this);
+#if ENABLE(SAMPLING_PROFILER)
+    if (m_vm->m_samplingProfiler)
+        m_vm->m_samplingProfiler->noticeCodeBlockDestruction(this);
+#endif
     
 #if ENABLE(DFG_JIT)
     // Remove myself from the set of DFG code blocks. Note that I may not be in this set
@@ -2819,6 +2839,8 @@ void CodeBlock::reoptimize()
         dataLog(*replacement(), " will be jettisoned due to reoptimization of ", *this, ".\n");
     replacement()->jettison();
     countReoptimization();
+    if (Profiler::TierUpTelemetry* telemetry = m_vm->enabledTierUpTelemetry())
+        telemetry->notifyReoptimization(this);
 }
 
 CodeBlock* ProgramCodeBlock::replacement()
@@ -2885,6 +2907,8 @@ void CodeBlock::jettison()
     tallyFrequentExitSites();
     if (DFG::shouldShowDisassembly())
         dataLog("Jettisoning ", *this, ".\n");
+    if (Profiler::TierUpTelemetry* telemetry = m_vm->enabledTierUpTelemetry())
+        telemetry->notifyJettison(this);
     jettisonImpl();
 }
 
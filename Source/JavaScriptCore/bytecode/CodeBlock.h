@@ -412,6 +412,7 @@ public:
     }
 
     bool isNumericCompareFunction() { return m_unlinkedCode->isNumericCompareFunction(); }
+    bool isReverseNumericCompareFunction() { return m_unlinkedCode->isReverseNumericCompareFunction(); }
 
     unsigned numberOfInstructions() const { return m_instructions.size(); }
     RefCountedArray<Instruction>& instructions() { return m_instructions; }
@@ -969,6 +970,13 @@ public:
     static ptrdiff_t offsetOfJITExecutionTotalCount() { return OBJECT_OFFSETOF(CodeBlock, m_jitExecuteCounter) + OBJECT_OFFSETOF(ExecutionCounter, m_totalCount); }
 
     const ExecutionCounter& jitExecuteCounter() const { return m_jitExecuteCounter; }
+
+    // JIT code for functions sets this flag on every entry, and the heap clears it each time
+    // it looks for cold code to evict (see Heap::deleteColdCompiledCode()). A CodeBlock starts
+    // out marked as entered so that freshly compiled code survives at least one check.
+    bool wasEnteredRecently() const { return m_wasEnteredRecently; }
+    void clearWasEnteredRecently() { m_wasEnteredRecently = false; }
+    bool* addressOfWasEnteredRecently() { return &m_wasEnteredRecently; }
         
     unsigned optimizationDelayCounter() const { return m_optimizationDelayCounter; }
         
@@ -1272,6 +1280,7 @@ private:
     uint32_t m_osrExitCounter;
     uint16_t m_optimizationDelayCounter;
     uint16_t m_reoptimizationRetryCounter;
+    bool m_wasEnteredRecently;
 
     Vector<ResolveOperations> m_resolveOperations;
     Vector<PutToBaseOperation, 1> m_putToBaseOperations;
@@ -70,6 +70,8 @@ const char* exitKindToString(ExitKind kind)
         return "Uncountable";
     case UncountableWatchpoint:
         return "UncountableWatchpoint";
+    case WatchdogTimerFired:
+        return "WatchdogTimerFired";
     default:
         RELEASE_ASSERT_NOT_REACHED();
         return "Unknown";
@@ -84,6 +86,7 @@ bool exitKindIsCountable(ExitKind kind)
     case BadType:
     case Uncountable:
     case UncountableWatchpoint:
+    case WatchdogTimerFired: // Not a speculation failure.
     case LoadFromHole: // Already counted directly by the baseline JIT.
     case StoreToHole: // Already counted directly by the baseline JIT.
     case OutOfBounds: // Already counted directly by the baseline JIT.
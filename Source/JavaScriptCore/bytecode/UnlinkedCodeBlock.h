@@ -314,6 +314,8 @@ public:
 
     void setIsNumericCompareFunction(bool isNumericCompareFunction) { m_isNumericCompareFunction = isNumericCompareFunction; }
     bool isNumericCompareFunction() const { return m_isNumericCompareFunction; }
+    void setIsReverseNumericCompareFunction(bool isReverseNumericCompareFunction) { m_isReverseNumericCompareFunction = isReverseNumericCompareFunction; }
+    bool isReverseNumericCompareFunction() const { return m_isReverseNumericCompareFunction; }
 
     void shrinkToFit()
     {
@@ -506,6 +508,7 @@ private:
     bool m_needsFullScopeChain : 1;
     bool m_usesEval : 1;
     bool m_isNumericCompareFunction : 1;
+    bool m_isReverseNumericCompareFunction : 1;
     bool m_isStrictMode : 1;
     bool m_isConstructor : 1;
     bool m_hasCapturedVariables : 1;
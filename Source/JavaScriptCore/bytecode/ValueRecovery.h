@@ -63,6 +63,8 @@ enum ValueRecoveryTechnique {
     BooleanDisplacedInJSStack,
     // It's an Arguments object.
     ArgumentsThatWereNotCreated,
+    // It's an object whose allocation was sunk; OSR exit has to materialize it.
+    ObjectThatWasNotCreated,
     // It's a constant.
     Constant,
     // Don't know how to recover it.
@@ -202,6 +204,14 @@ public:
         return result;
     }
     
+    static ValueRecovery objectThatWasNotCreated(unsigned materializationIndex)
+    {
+        ValueRecovery result;
+        result.m_technique = ObjectThatWasNotCreated;
+        result.m_source.materializationIndex = materializationIndex;
+        return result;
+    }
+    
     ValueRecoveryTechnique technique() const { return m_technique; }
     
     bool isConstant() const { return m_technique == Constant; }
@@ -274,6 +284,12 @@ public:
         return JSValue::decode(m_source.constant);
     }
     
+    unsigned materializationIndex() const
+    {
+        ASSERT(m_technique == ObjectThatWasNotCreated);
+        return m_source.materializationIndex;
+    }
+    
     void dump(PrintStream& out) const
     {
         switch (technique()) {
@@ -330,6 +346,9 @@ public:
         case ArgumentsThatWereNotCreated:
             out.printf("arguments");
             break;
+        case ObjectThatWasNotCreated:
+            out.printf("object#%u", materializationIndex());
+            break;
         case Constant:
             out.print("[", constant(), "]");
             break;
@@ -355,6 +374,7 @@ private:
 #endif
         VirtualRegister virtualReg;
         EncodedJSValue constant;
+        unsigned materializationIndex;
     } m_source;
 };
 
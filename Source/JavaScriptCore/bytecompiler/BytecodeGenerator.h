@@ -261,6 +261,7 @@ namespace JSC {
         bool isArgumentNumber(const Identifier&, int);
 
         void setIsNumericCompareFunction(bool isNumericCompareFunction);
+        void setIsReverseNumericCompareFunction(bool isReverseNumericCompareFunction);
 
         bool willResolveToArguments(const Identifier&);
         RegisterID* uncheckedRegisterForArguments();
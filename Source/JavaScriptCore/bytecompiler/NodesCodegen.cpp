@@ -2204,12 +2204,13 @@ void FunctionBodyNode::emitBytecode(BytecodeGenerator& generator, RegisterID*)
         if (returnValueExpression && returnValueExpression->isSubtract()) {
             ExpressionNode* lhsExpression = static_cast<SubNode*>(returnValueExpression)->lhs();
             ExpressionNode* rhsExpression = static_cast<SubNode*>(returnValueExpression)->rhs();
-            if (lhsExpression->isResolveNode()
-                && rhsExpression->isResolveNode()
-                && generator.isArgumentNumber(static_cast<ResolveNode*>(lhsExpression)->identifier(), 0)
-                && generator.isArgumentNumber(static_cast<ResolveNode*>(rhsExpression)->identifier(), 1)) {
-                
-                generator.setIsNumericCompareFunction(true);
+            if (lhsExpression->isResolveNode() && rhsExpression->isResolveNode()) {
+                const Identifier& lhs = static_cast<ResolveNode*>(lhsExpression)->identifier();
+                const Identifier& rhs = static_cast<ResolveNode*>(rhsExpression)->identifier();
+                if (generator.isArgumentNumber(lhs, 0) && generator.isArgumentNumber(rhs, 1))
+                    generator.setIsNumericCompareFunction(true);
+                else if (generator.isArgumentNumber(lhs, 1) && generator.isArgumentNumber(rhs, 0))
+                    generator.setIsReverseNumericCompareFunction(true);
             }
         }
     }
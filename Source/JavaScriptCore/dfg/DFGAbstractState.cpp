@@ -276,7 +276,8 @@ bool AbstractState::executeEffects(unsigned indexInBlock, Node* node)
     switch (node->op()) {
     case JSConstant:
     case WeakJSConstant:
-    case PhantomArguments: {
+    case PhantomArguments:
+    case PhantomNewObject: {
         forNode(node).set(m_graph.valueOfJSConstant(node));
         break;
     }
@@ -1043,6 +1044,36 @@ bool AbstractState::executeEffects(unsigned indexInBlock, Node* node)
         node->setCanExit(true);
         break;
             
+    case ToObjectForIn:
+        forNode(node).set(SpecObject | SpecOther);
+        break;
+            
+    case GetPropertyNameIterator:
+        clobberWorld(node->codeOrigin, indexInBlock);
+        forNode(node).set(SpecCellOther | SpecOther);
+        break;
+            
+    case GetPropertyNameIteratorSize:
+        forNode(node).set(SpecInt32);
+        break;
+            
+    case NextPropertyNameIndex:
+        clobberWorld(node->codeOrigin, indexInBlock);
+        forNode(node).set(SpecInt32);
+        break;
+            
+    case GetPropertyNameAtIndex: {
+        AbstractValue& destination = forNode(node);
+        destination = forNode(node->child3());
+        destination.merge(SpecString);
+        break;
+    }
+            
+    case GetByValForIn:
+        clobberWorld(node->codeOrigin, indexInBlock);
+        forNode(node).makeTop();
+        break;
+            
     case ToPrimitive: {
         JSValue childConst = forNode(node->child1()).value();
         if (childConst && childConst.isNumber() && trySetConstant(node, childConst)) {
@@ -1178,7 +1209,7 @@ bool AbstractState::executeEffects(unsigned indexInBlock, Node* node)
     case CheckArgumentsNotCreated:
         if (isEmptySpeculation(
                 m_variables.operand(
-                    m_graph.argumentsRegisterFor(node->codeOrigin)).m_type))
+                    m_graph.argumentsRegisterFor(node->argumentsCallFrame())).m_type))
             m_foundConstants = true;
         else
             node->setCanExit(true);
@@ -1189,14 +1220,14 @@ bool AbstractState::executeEffects(unsigned indexInBlock, Node* node)
         // the arguments a bit. Note that this is not sufficient to force constant folding
         // of GetMyArgumentsLength, because GetMyArgumentsLength is a clobbering operation.
         // We perform further optimizations on this later on.
-        if (node->codeOrigin.inlineCallFrame)
-            forNode(node).set(jsNumber(node->codeOrigin.inlineCallFrame->arguments.size() - 1));
+        if (node->argumentsCallFrame())
+            forNode(node).set(jsNumber(node->argumentsCallFrame()->arguments.size() - 1));
         else
             forNode(node).set(SpecInt32);
         node->setCanExit(
             !isEmptySpeculation(
                 m_variables.operand(
-                    m_graph.argumentsRegisterFor(node->codeOrigin)).m_type));
+                    m_graph.argumentsRegisterFor(node->argumentsCallFrame())).m_type));
         break;
         
     case GetMyArgumentsLengthSafe:
@@ -1565,6 +1596,8 @@ bool AbstractState::executeEffects(unsigned indexInBlock, Node* node)
     case InlineStart:
     case Nop:
     case CountExecution:
+    case PutStructureHint:
+    case PutByOffsetHint:
         break;
 
     case Unreachable:
@@ -232,7 +232,7 @@ public:
                         ArgumentsAliasingData& data =
                             m_argumentsAliasing.find(variableAccessData)->value;
                         data.mergeNonArgumentsAssignment();
-                        data.mergeCallContext(node->codeOrigin.inlineCallFrame);
+                        data.mergeCallContext(callContextFor(variableAccessData, node));
                         break;
                     }
                     if (argumentsRegister != InvalidVirtualRegister
@@ -251,8 +251,9 @@ public:
                         m_argumentsAliasing.find(variableAccessData)->value;
                     data.mergeArgumentsAssignment();
                     // This ensures that the variable's uses are in the same context as
-                    // the arguments it is aliasing.
-                    data.mergeCallContext(node->codeOrigin.inlineCallFrame);
+                    // the arguments it is aliasing, or in callees inlined into that
+                    // context that received the arguments as a parameter.
+                    data.mergeCallContext(callContextFor(variableAccessData, node));
                     data.mergeCallContext(source->codeOrigin.inlineCallFrame);
                     break;
                 }
@@ -264,7 +265,7 @@ public:
                         break;
                     ArgumentsAliasingData& data =
                         m_argumentsAliasing.find(variableAccessData)->value;
-                    data.mergeCallContext(node->codeOrigin.inlineCallFrame);
+                    data.mergeCallContext(callContextFor(variableAccessData, node));
                     break;
                 }
                     
@@ -274,10 +275,14 @@ public:
                         break;
                     ArgumentsAliasingData& data =
                         m_argumentsAliasing.find(variableAccessData)->value;
-                    data.mergeCallContext(node->codeOrigin.inlineCallFrame);
-                    
-                    // If a variable is used in a flush then by definition it escapes.
-                    data.escapes = true;
+                    data.mergeCallContext(callContextFor(variableAccessData, node));
+                    
+                    // Uncaptured variables only get flushed because they are parameters,
+                    // which must stay in the stack so that the frame's arguments can be
+                    // reified from there. An inlined callee's parameter that aliases its
+                    // caller's arguments holds the empty value instead, which Arguments
+                    // knows to replace with the caller's arguments. So this is not an
+                    // escape.
                     break;
                 }
                     
@@ -288,7 +293,7 @@ public:
                     ArgumentsAliasingData& data =
                         m_argumentsAliasing.find(variableAccessData)->value;
                     data.mergeNonArgumentsAssignment();
-                    data.mergeCallContext(node->codeOrigin.inlineCallFrame);
+                    data.mergeCallContext(callContextFor(variableAccessData, node));
                     break;
                 }
                     
@@ -473,9 +478,12 @@ public:
                 case PhantomLocal: {
                     VariableAccessData* variableAccessData = node->variableAccessData();
                     
-                    if (variableAccessData->isCaptured()
-                        || !m_argumentsAliasing.find(variableAccessData)->value.isValid()
-                        || m_createsArguments.contains(node->codeOrigin.inlineCallFrame))
+                    if (variableAccessData->isCaptured())
+                        break;
+                    
+                    ArgumentsAliasingData& data =
+                        m_argumentsAliasing.find(variableAccessData)->value;
+                    if (!data.isValid() || m_createsArguments.contains(data.callContext))
                         break;
                     
                     // Turn PhantomLocals into just GetLocals. This will preserve the threading
@@ -486,18 +494,6 @@ public:
                     break;
                 }
 
-                case Flush: {
-                    VariableAccessData* variableAccessData = node->variableAccessData();
-                    
-                    if (variableAccessData->isCaptured()
-                        || !m_argumentsAliasing.find(variableAccessData)->value.isValid()
-                        || m_createsArguments.contains(node->codeOrigin.inlineCallFrame))
-                        break;
-                    
-                    RELEASE_ASSERT_NOT_REACHED();
-                    break;
-                }
-                    
                 case Phantom: {
                     // It's highly likely that we will have a Phantom referencing either
                     // CreateArguments, or a local op for the arguments register, or a
@@ -540,9 +536,11 @@ public:
                     if (!isOKToOptimize(node->child1().node()))
                         break;
                     
+                    InlineCallFrame* inlineCallFrame = argumentsCallFrameFor(node->child1().node());
                     node->children.child1() = node->children.child2();
                     node->children.child2() = Edge();
                     node->setOpAndDefaultFlags(GetMyArgumentByVal);
+                    node->setArgumentsCallFrame(inlineCallFrame);
                     changed = true;
                     --indexInBlock; // Force reconsideration of this op now that it's a GetMyArgumentByVal.
                     break;
@@ -555,8 +553,10 @@ public:
                     if (!isOKToOptimize(node->child1().node()))
                         break;
                     
+                    InlineCallFrame* inlineCallFrame = argumentsCallFrameFor(node->child1().node());
                     node->children.child1() = Edge();
                     node->setOpAndDefaultFlags(GetMyArgumentsLength);
+                    node->setArgumentsCallFrame(inlineCallFrame);
                     changed = true;
                     --indexInBlock; // Force reconsideration of this op noew that it's a GetMyArgumentsLength.
                     break;
@@ -564,7 +564,8 @@ public:
                     
                 case GetMyArgumentsLength:
                 case GetMyArgumentsLengthSafe: {
-                    if (m_createsArguments.contains(node->codeOrigin.inlineCallFrame)) {
+                    InlineCallFrame* inlineCallFrame = node->argumentsCallFrame();
+                    if (m_createsArguments.contains(inlineCallFrame)) {
                         ASSERT(node->op() == GetMyArgumentsLengthSafe);
                         break;
                     }
@@ -573,24 +574,25 @@ public:
                         changed = true;
                     }
                     
-                    CodeOrigin codeOrigin = node->codeOrigin;
-                    if (!codeOrigin.inlineCallFrame)
+                    if (!inlineCallFrame)
                         break;
                     
                     // We know exactly what this will return. But only after we have checked
                     // that nobody has escaped our arguments.
                     insertionSet.insertNode(
-                        indexInBlock, SpecNone, CheckArgumentsNotCreated, codeOrigin);
+                        indexInBlock, SpecNone, CheckArgumentsNotCreated, node->codeOrigin,
+                        OpInfo(inlineCallFrame));
                     
                     m_graph.convertToConstant(
-                        node, jsNumber(codeOrigin.inlineCallFrame->arguments.size() - 1));
+                        node, jsNumber(inlineCallFrame->arguments.size() - 1));
                     changed = true;
                     break;
                 }
                     
                 case GetMyArgumentByVal:
                 case GetMyArgumentByValSafe: {
-                    if (m_createsArguments.contains(node->codeOrigin.inlineCallFrame)) {
+                    InlineCallFrame* inlineCallFrame = node->argumentsCallFrame();
+                    if (m_createsArguments.contains(inlineCallFrame)) {
                         ASSERT(node->op() == GetMyArgumentByValSafe);
                         break;
                     }
@@ -598,7 +600,7 @@ public:
                         node->setOp(GetMyArgumentByVal);
                         changed = true;
                     }
-                    if (!node->codeOrigin.inlineCallFrame)
+                    if (!inlineCallFrame)
                         break;
                     if (!node->child1()->hasConstant())
                         break;
@@ -607,8 +609,7 @@ public:
                         break;
                     int32_t index = value.asInt32();
                     if (index < 0
-                        || static_cast<size_t>(index + 1) >=
-                            node->codeOrigin.inlineCallFrame->arguments.size())
+                        || static_cast<size_t>(index + 1) >= inlineCallFrame->arguments.size())
                         break;
                     
                     // We know which argument this is accessing. But only after we have checked
@@ -625,12 +626,12 @@ public:
                     
                     node->convertToGetLocalUnlinked(
                         static_cast<VirtualRegister>(
-                            node->codeOrigin.inlineCallFrame->stackOffset +
-                            m_graph.baselineCodeBlockFor(node->codeOrigin)->argumentIndexAfterCapture(index)));
+                            inlineCallFrame->stackOffset +
+                            baselineCodeBlockForInlineCallFrame(inlineCallFrame)->argumentIndexAfterCapture(index)));
 
                     insertionSet.insertNode(
                         indexInBlock, SpecNone, CheckArgumentsNotCreated,
-                        codeOrigin);
+                        codeOrigin, OpInfo(inlineCallFrame));
                     insertionSet.insertNode(
                         indexInBlock, SpecNone, Phantom, codeOrigin,
                         children);
@@ -759,9 +760,14 @@ private:
             //
             // 2) If we're accessing arguments we got from the heap!
                             
+            //
+            // The first case may also cross into a callee that was inlined into the
+            // frame that owns the arguments, and that received them as a parameter.
+            // That's fine, since the owning frame is live for as long as its callee is.
+                            
             if (edge->op() == CreateArguments
-                && node->codeOrigin.inlineCallFrame
-                    != edge->codeOrigin.inlineCallFrame)
+                && !isInlinedInto(
+                    node->codeOrigin.inlineCallFrame, edge->codeOrigin.inlineCallFrame))
                 m_createsArguments.add(edge->codeOrigin.inlineCallFrame);
             
             return;
@@ -778,43 +784,83 @@ private:
             return;
         
         ArgumentsAliasingData& data = m_argumentsAliasing.find(variableAccessData)->value;
-        data.mergeCallContext(node->codeOrigin.inlineCallFrame);
+        data.mergeCallContext(callContextFor(variableAccessData, node));
     }
     
-    bool isOKToOptimize(Node* source)
+    // Returns the call frame whose arguments the given node refers to. This is only
+    // meaningful for nodes that isOKToOptimize() accepts.
+    InlineCallFrame* argumentsCallFrameFor(Node* source)
     {
-        if (m_createsArguments.contains(source->codeOrigin.inlineCallFrame))
-            return false;
+        if (source->op() != GetLocal)
+            return source->codeOrigin.inlineCallFrame;
+        
+        VariableAccessData* variableAccessData = source->variableAccessData();
+        int argumentsRegister = m_graph.uncheckedArgumentsRegisterFor(source->codeOrigin);
+        if (argumentsRegister != InvalidVirtualRegister
+            && (argumentsRegister == variableAccessData->local()
+                || unmodifiedArgumentsRegister(argumentsRegister) == variableAccessData->local()))
+            return source->codeOrigin.inlineCallFrame;
         
+        return m_argumentsAliasing.find(variableAccessData)->value.callContext;
+    }
+    
+    bool isOKToOptimize(Node* source)
+    {
         switch (source->op()) {
         case GetLocal: {
             VariableAccessData* variableAccessData = source->variableAccessData();
             int argumentsRegister = m_graph.uncheckedArgumentsRegisterFor(source->codeOrigin);
-            if (argumentsRegister == InvalidVirtualRegister)
+            if (argumentsRegister != InvalidVirtualRegister
+                && (argumentsRegister == variableAccessData->local()
+                    || unmodifiedArgumentsRegister(argumentsRegister) == variableAccessData->local()))
                 break;
-            if (argumentsRegister == variableAccessData->local())
-                return true;
-            if (unmodifiedArgumentsRegister(argumentsRegister) == variableAccessData->local())
-                return true;
             if (variableAccessData->isCaptured())
-                break;
+                return false;
             ArgumentsAliasingData& data =
                 m_argumentsAliasing.find(variableAccessData)->value;
             if (!data.isValid())
-                break;
-                            
-            return true;
+                return false;
+            break;
         }
                             
-        case CreateArguments: {
-            return true;
-        }
+        case CreateArguments:
+            break;
                             
         default:
-            break;
+            return false;
         }
         
-        return false;
+        return !m_createsArguments.contains(argumentsCallFrameFor(source));
+    }
+    
+    // The call context of a variable access is the frame whose arguments OSR exit would
+    // reify into the variable if it turned out to be an arguments alias. OSR exit picks
+    // the innermost frame on the inline stack whose locals start at or below the variable.
+    // For a variable in the frame's own locals that is the accessing frame, but for the
+    // parameter of an inlined callee it is the caller, since the caller's outgoing
+    // argument registers double as the callee's parameters. Using this as the context
+    // lets a caller pass its arguments into an inlined callee without creating them.
+    InlineCallFrame* callContextFor(VariableAccessData* variableAccessData, Node* node)
+    {
+        int operand = variableAccessData->local();
+        for (InlineCallFrame* inlineCallFrame = node->codeOrigin.inlineCallFrame;
+             inlineCallFrame;
+             inlineCallFrame = inlineCallFrame->caller.inlineCallFrame) {
+            if (inlineCallFrame->stackOffset <= operand)
+                return inlineCallFrame;
+        }
+        return 0;
+    }
+    
+    static bool isInlinedInto(InlineCallFrame* inlineCallFrame, InlineCallFrame* callerCallFrame)
+    {
+        for (;;) {
+            if (inlineCallFrame == callerCallFrame)
+                return true;
+            if (!inlineCallFrame)
+                return false;
+            inlineCallFrame = inlineCallFrame->caller.inlineCallFrame;
+        }
     }
     
     void removeArgumentsReferencingPhantomChild(Node* node, unsigned edgeIndex)
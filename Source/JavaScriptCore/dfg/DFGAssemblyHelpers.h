@@ -376,23 +376,38 @@ public:
         return argumentsRegisterFor(codeOrigin.inlineCallFrame);
     }
     
+    SharedSymbolTable* symbolTableFor(InlineCallFrame* inlineCallFrame)
+    {
+        return baselineCodeBlockFor(inlineCallFrame)->symbolTable();
+    }
+
     SharedSymbolTable* symbolTableFor(const CodeOrigin& codeOrigin)
     {
         return baselineCodeBlockFor(codeOrigin)->symbolTable();
     }
 
-    int offsetOfLocals(const CodeOrigin& codeOrigin)
+    int offsetOfLocals(InlineCallFrame* inlineCallFrame)
     {
-        if (!codeOrigin.inlineCallFrame)
+        if (!inlineCallFrame)
             return 0;
-        return codeOrigin.inlineCallFrame->stackOffset * sizeof(Register);
+        return inlineCallFrame->stackOffset * sizeof(Register);
     }
 
-    int offsetOfArgumentsIncludingThis(const CodeOrigin& codeOrigin)
+    int offsetOfLocals(const CodeOrigin& codeOrigin)
     {
-        if (!codeOrigin.inlineCallFrame)
+        return offsetOfLocals(codeOrigin.inlineCallFrame);
+    }
+
+    int offsetOfArgumentsIncludingThis(InlineCallFrame* inlineCallFrame)
+    {
+        if (!inlineCallFrame)
             return CallFrame::argumentOffsetIncludingThis(0) * sizeof(Register);
-        return (codeOrigin.inlineCallFrame->stackOffset + CallFrame::argumentOffsetIncludingThis(0)) * sizeof(Register);
+        return (inlineCallFrame->stackOffset + CallFrame::argumentOffsetIncludingThis(0)) * sizeof(Register);
+    }
+
+    int offsetOfArgumentsIncludingThis(const CodeOrigin& codeOrigin)
+    {
+        return offsetOfArgumentsIncludingThis(codeOrigin.inlineCallFrame);
     }
 
     Vector<BytecodeAndMachineOffset>& decodedCodeMapFor(CodeBlock*);
@@ -2336,6 +2336,47 @@ bool ByteCodeParser::parseBlock(unsigned limit)
             NEXT_OPCODE(op_not);
         }
             
+        case op_get_pnames: {
+            int breakTarget = currentInstruction[5].u.operand;
+            Node* base = addToGraph(ToObjectForIn, get(currentInstruction[2].u.operand));
+            Node* iterator = addToGraph(GetPropertyNameIterator, base);
+            set(currentInstruction[1].u.operand, iterator);
+            set(currentInstruction[2].u.operand, base);
+            set(currentInstruction[3].u.operand, getJSConstantForValue(jsNumber(0)));
+            set(currentInstruction[4].u.operand, addToGraph(GetPropertyNameIteratorSize, iterator));
+            Node* isDone = addToGraph(CompareStrictEqConstant, iterator, constantNull());
+            addToGraph(Branch, OpInfo(m_currentIndex + breakTarget), OpInfo(m_currentIndex + OPCODE_LENGTH(op_get_pnames)), isDone);
+            LAST_OPCODE(op_get_pnames);
+        }
+            
+        case op_next_pname: {
+            int dst = currentInstruction[1].u.operand;
+            int target = currentInstruction[6].u.operand;
+            Node* base = get(currentInstruction[2].u.operand);
+            Node* iterator = get(currentInstruction[5].u.operand);
+            Node* index = addToGraph(NextPropertyNameIndex, base, iterator, get(currentInstruction[3].u.operand));
+            set(dst, addToGraph(GetPropertyNameAtIndex, iterator, index, get(dst)));
+            set(currentInstruction[3].u.operand, index);
+            // The size is only read by the baseline JIT, but has to survive for OSR exit.
+            addToGraph(Phantom, get(currentInstruction[4].u.operand));
+            addToGraph(Branch, OpInfo(m_currentIndex + target), OpInfo(m_currentIndex + OPCODE_LENGTH(op_next_pname)), index);
+            LAST_OPCODE(op_next_pname);
+        }
+            
+        case op_get_by_pname: {
+            SpeculatedType prediction = getPrediction();
+            
+            addVarArgChild(get(currentInstruction[2].u.operand));
+            addVarArgChild(get(currentInstruction[3].u.operand));
+            addVarArgChild(get(currentInstruction[4].u.operand));
+            addVarArgChild(get(currentInstruction[5].u.operand));
+            addVarArgChild(get(currentInstruction[6].u.operand));
+            Node* getByVal = addToGraph(Node::VarArg, GetByValForIn, OpInfo(0), OpInfo(prediction));
+            set(currentInstruction[1].u.operand, getByVal);
+            
+            NEXT_OPCODE(op_get_by_pname);
+        }
+            
         case op_to_primitive: {
             Node* value = get(currentInstruction[2].u.operand);
             set(currentInstruction[1].u.operand, addToGraph(ToPrimitive, value));
@@ -3067,7 +3108,7 @@ bool ByteCodeParser::parseBlock(unsigned limit)
                 prediction = getPrediction();
             }
             
-            addToGraph(CheckArgumentsNotCreated);
+            addToGraph(CheckArgumentsNotCreated, OpInfo(inlineCallFrame()));
             
             unsigned argCount = inlineCallFrame()->arguments.size();
             if (JSStack::CallFrameHeaderSize + argCount > m_parameterSlots)
@@ -3343,7 +3384,7 @@ bool ByteCodeParser::parseBlock(unsigned limit)
             
         case op_get_arguments_length: {
             m_graph.m_hasArguments = true;
-            set(currentInstruction[1].u.operand, addToGraph(GetMyArgumentsLengthSafe));
+            set(currentInstruction[1].u.operand, addToGraph(GetMyArgumentsLengthSafe, OpInfo(inlineCallFrame())));
             NEXT_OPCODE(op_get_arguments_length);
         }
             
@@ -3351,7 +3392,7 @@ bool ByteCodeParser::parseBlock(unsigned limit)
             m_graph.m_hasArguments = true;
             set(currentInstruction[1].u.operand,
                 addToGraph(
-                    GetMyArgumentByValSafe, OpInfo(0), OpInfo(getPrediction()),
+                    GetMyArgumentByValSafe, OpInfo(inlineCallFrame()), OpInfo(getPrediction()),
                     get(currentInstruction[3].u.operand)));
             NEXT_OPCODE(op_get_argument_by_val);
         }
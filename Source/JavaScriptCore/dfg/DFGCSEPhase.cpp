@@ -573,6 +573,7 @@ private:
             case CreateActivation:
             case TearOffActivation:
             case ToPrimitive:
+            case ToObjectForIn:
             case NewRegexp:
             case NewArrayBuffer:
             case NewArray:
@@ -921,7 +922,7 @@ private:
             case CheckArgumentsNotCreated:
             case GetMyArgumentsLength:
             case GetMyArgumentsLengthSafe:
-                if (m_graph.uncheckedArgumentsRegisterFor(node->codeOrigin) == local)
+                if (m_graph.uncheckedArgumentsRegisterFor(node->argumentsCallFrame()) == local)
                     result.mayBeAccessed = true;
                 break;
                 
@@ -182,6 +182,9 @@ inline CapabilityLevel canCompileOpcode(OpcodeID opcodeID, CodeBlock*, Instructi
     case op_put_to_base:
     case op_typeof:
     case op_to_number:
+    case op_get_pnames:
+    case op_next_pname:
+    case op_get_by_pname:
         return CanCompile;
         
     case op_call_varargs:
@@ -86,7 +86,7 @@ private:
             case CheckArgumentsNotCreated: {
                 if (!isEmptySpeculation(
                         m_state.variables().operand(
-                            m_graph.argumentsRegisterFor(node->codeOrigin)).m_type))
+                            m_graph.argumentsRegisterFor(node->argumentsCallFrame())).m_type))
                     break;
                 node->convertToPhantom();
                 eliminated = true;
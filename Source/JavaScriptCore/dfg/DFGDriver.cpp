@@ -43,6 +43,7 @@
 #include "DFGDCEPhase.h"
 #include "DFGFixupPhase.h"
 #include "DFGJITCompiler.h"
+#include "DFGObjectAllocationSinkingPhase.h"
 #include "DFGPredictionInjectionPhase.h"
 #include "DFGPredictionPropagationPhase.h"
 #include "DFGTypeCheckHoistingPhase.h"
@@ -143,6 +144,8 @@ inline bool compile(CompileMode compileMode, ExecState* exec, CodeBlock* codeBlo
     dfg.m_fixpointState = FixpointConverged;
 
     performStoreElimination(dfg);
+    performCPSRethreading(dfg); // Allocation sinking needs to see the Phis, which CFG simplification may have dropped.
+    performObjectAllocationSinking(dfg);
     performCPSRethreading(dfg);
     performDCE(dfg);
     performVirtualRegisterAllocation(dfg);
@@ -593,6 +593,21 @@ private:
             break;
         }
             
+        case NextPropertyNameIndex: {
+            setUseKindAndUnboxIfProfitable<Int32Use>(node->child3());
+            break;
+        }
+            
+        case GetPropertyNameAtIndex: {
+            setUseKindAndUnboxIfProfitable<Int32Use>(node->child2());
+            break;
+        }
+            
+        case GetByValForIn: {
+            setUseKindAndUnboxIfProfitable<Int32Use>(m_graph.varArgChild(node, 4));
+            break;
+        }
+            
         case NewArray: {
             for (unsigned i = m_graph.varArgNumChildren(node); i--;) {
                 node->setIndexingType(
@@ -812,6 +827,9 @@ private:
         case Phi:
         case ForwardInt32ToDouble:
         case PhantomPutStructure:
+        case PhantomNewObject:
+        case PutStructureHint:
+        case PutByOffsetHint:
         case GetIndexedPropertyStorage:
         case LastNodeType:
         case MovHint:
@@ -874,6 +892,9 @@ private:
         case ForceOSRExit:
         case CheckWatchdogTimer:
         case Unreachable:
+        case ToObjectForIn:
+        case GetPropertyNameIterator:
+        case GetPropertyNameIteratorSize:
             break;
 #else
         default:
@@ -249,6 +249,8 @@ void Graph::dump(PrintStream& out, const char* prefix, Node* node)
         out.print(comma, IndexingTypeDump(node->indexingType()));
     if (node->hasExecutionCounter())
         out.print(comma, RawPointer(node->executionCounter()));
+    if (node->hasArgumentsCallFrame() && node->argumentsCallFrame() != node->codeOrigin.inlineCallFrame)
+        out.print(comma, "arguments of ", RawPointer(node->argumentsCallFrame()));
     if (op == JSConstant) {
         out.print(comma, "$", node->constantNumber());
         JSValue value = valueOfJSConstant(node);
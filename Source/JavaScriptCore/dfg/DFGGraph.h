@@ -386,28 +386,35 @@ public:
         return baselineCodeBlockFor(codeOrigin)->hasExitSite(FrequentExitSite(codeOrigin.bytecodeIndex, exitKind));
     }
     
-    int argumentsRegisterFor(const CodeOrigin& codeOrigin)
+    int argumentsRegisterFor(InlineCallFrame* inlineCallFrame)
     {
-        if (!codeOrigin.inlineCallFrame)
+        if (!inlineCallFrame)
             return m_codeBlock->argumentsRegister();
         
         return baselineCodeBlockForInlineCallFrame(
-            codeOrigin.inlineCallFrame)->argumentsRegister() +
-            codeOrigin.inlineCallFrame->stackOffset;
+            inlineCallFrame)->argumentsRegister() + inlineCallFrame->stackOffset;
     }
     
-    int uncheckedArgumentsRegisterFor(const CodeOrigin& codeOrigin)
+    int argumentsRegisterFor(const CodeOrigin& codeOrigin)
+    {
+        return argumentsRegisterFor(codeOrigin.inlineCallFrame);
+    }
+    
+    int uncheckedArgumentsRegisterFor(InlineCallFrame* inlineCallFrame)
     {
-        if (!codeOrigin.inlineCallFrame)
+        if (!inlineCallFrame)
             return m_codeBlock->uncheckedArgumentsRegister();
         
-        CodeBlock* codeBlock = baselineCodeBlockForInlineCallFrame(
-            codeOrigin.inlineCallFrame);
+        CodeBlock* codeBlock = baselineCodeBlockForInlineCallFrame(inlineCallFrame);
         if (!codeBlock->usesArguments())
             return InvalidVirtualRegister;
         
-        return codeBlock->argumentsRegister() +
-            codeOrigin.inlineCallFrame->stackOffset;
+        return codeBlock->argumentsRegister() + inlineCallFrame->stackOffset;
+    }
+    
+    int uncheckedArgumentsRegisterFor(const CodeOrigin& codeOrigin)
+    {
+        return uncheckedArgumentsRegisterFor(codeOrigin.inlineCallFrame);
     }
     
     int uncheckedActivationRegisterFor(const CodeOrigin&)
@@ -38,12 +38,19 @@ MinifiedNode MinifiedNode::fromNode(Node* node)
     MinifiedNode result;
     result.m_id = MinifiedID(node);
     result.m_op = node->op();
-    if (hasChild(node->op()))
+    result.m_child2OrInfo = 0;
+    if (hasChild(node->op())) {
         result.m_childOrInfo = MinifiedID(node->child1().node()).m_id;
-    else if (hasConstantNumber(node->op()))
+        if (node->op() == PutStructureHint)
+            result.m_child2OrInfo = bitwise_cast<uintptr_t>(node->structureTransitionData().newStructure);
+        else if (node->op() == PutByOffsetHint)
+            result.m_child2OrInfo = MinifiedID(node->child2().node()).m_id;
+    } else if (hasConstantNumber(node->op()))
         result.m_childOrInfo = node->constantNumber();
     else if (hasWeakConstant(node->op()))
         result.m_childOrInfo = bitwise_cast<uintptr_t>(node->weakConstant());
+    else if (node->op() == PhantomNewObject)
+        result.m_childOrInfo = bitwise_cast<uintptr_t>(node->structure());
     else {
         ASSERT(node->op() == PhantomArguments);
         result.m_childOrInfo = 0;
@@ -34,7 +34,11 @@
 #include "DFGMinifiedID.h"
 #include "DFGNodeType.h"
 
-namespace JSC { namespace DFG {
+namespace JSC {
+
+class Structure;
+
+namespace DFG {
 
 struct Node;
 
@@ -49,6 +53,9 @@ inline bool belongsInMinifiedGraph(NodeType type)
     case UInt32ToNumber:
     case DoubleAsInt32:
     case PhantomArguments:
+    case PhantomNewObject:
+    case PutStructureHint:
+    case PutByOffsetHint:
         return true;
     default:
         return false;
@@ -90,6 +97,21 @@ public:
         return bitwise_cast<JSCell*>(m_childOrInfo);
     }
     
+    bool hasStructure() const { return m_op == PhantomNewObject || m_op == PutStructureHint; }
+    
+    Structure* structure() const
+    {
+        ASSERT(hasStructure());
+        return bitwise_cast<Structure*>(m_op == PhantomNewObject ? m_childOrInfo : m_child2OrInfo);
+    }
+    
+    // For PutByOffsetHint, the node that was stored into the sunk object.
+    MinifiedID child2() const
+    {
+        ASSERT(m_op == PutByOffsetHint);
+        return MinifiedID::fromBits(m_child2OrInfo);
+    }
+    
     static MinifiedID getID(MinifiedNode* node) { return node->id(); }
     static bool compareByNodeIndex(const MinifiedNode& a, const MinifiedNode& b)
     {
@@ -105,6 +127,8 @@ private:
         case ForwardInt32ToDouble:
         case UInt32ToNumber:
         case DoubleAsInt32:
+        case PutStructureHint:
+        case PutByOffsetHint:
             return true;
         default:
             return false;
@@ -120,7 +144,8 @@ private:
     }
     
     MinifiedID m_id;
-    uintptr_t m_childOrInfo; // Nodes in the minified graph have only one child each.
+    uintptr_t m_childOrInfo; // Nodes in the minified graph have only one child each, except for hints.
+    uintptr_t m_child2OrInfo;
     NodeType m_op;
 };
 
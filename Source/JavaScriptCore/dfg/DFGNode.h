@@ -276,6 +276,7 @@ struct Node {
         case JSConstant:
         case WeakJSConstant:
         case PhantomArguments:
+        case PhantomNewObject:
             return true;
         default:
             return false;
@@ -383,6 +384,7 @@ struct Node {
         case JSConstant:
             return codeBlock->constantRegister(FirstConstantRegisterIndex + constantNumber()).get();
         case PhantomArguments:
+        case PhantomNewObject:
             return JSValue();
         default:
             RELEASE_ASSERT_NOT_REACHED();
@@ -757,6 +759,7 @@ struct Node {
         case GetById:
         case GetByIdFlush:
         case GetByVal:
+        case GetByValForIn:
         case GetMyArgumentByVal:
         case GetMyArgumentByValSafe:
         case Call:
@@ -825,6 +828,7 @@ struct Node {
         switch (op()) {
         case PutStructure:
         case PhantomPutStructure:
+        case PutStructureHint:
         case AllocatePropertyStorage:
         case ReallocatePropertyStorage:
             return true;
@@ -863,6 +867,7 @@ struct Node {
         case ForwardStructureTransitionWatchpoint:
         case ArrayifyToStructure:
         case NewObject:
+        case PhantomNewObject:
         case NewStringObject:
             return true;
         default:
@@ -878,7 +883,7 @@ struct Node {
     
     bool hasStorageAccessData()
     {
-        return op() == GetByOffset || op() == PutByOffset;
+        return op() == GetByOffset || op() == PutByOffset || op() == PutByOffsetHint;
     }
     
     unsigned storageAccessDataIndex()
@@ -988,6 +993,35 @@ struct Node {
         return bitwise_cast<Profiler::ExecutionCounter*>(m_opInfo);
     }
 
+    bool hasArgumentsCallFrame()
+    {
+        switch (op()) {
+        case GetMyArgumentsLength:
+        case GetMyArgumentsLengthSafe:
+        case GetMyArgumentByVal:
+        case GetMyArgumentByValSafe:
+        case CheckArgumentsNotCreated:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // The call frame whose arguments this node accesses. This is usually the node's own
+    // call frame, but arguments simplification may point it at a caller's frame when the
+    // caller's arguments were passed into an inlined callee.
+    InlineCallFrame* argumentsCallFrame()
+    {
+        ASSERT(hasArgumentsCallFrame());
+        return bitwise_cast<InlineCallFrame*>(m_opInfo);
+    }
+
+    void setArgumentsCallFrame(InlineCallFrame* inlineCallFrame)
+    {
+        ASSERT(hasArgumentsCallFrame());
+        m_opInfo = bitwise_cast<uintptr_t>(inlineCallFrame);
+    }
+
     bool shouldGenerate()
     {
         return m_refCount;
@@ -1006,6 +1040,7 @@ struct Node {
         case UInt32ToNumber:
         case DoubleAsInt32:
         case PhantomArguments:
+        case PhantomNewObject:
             return true;
         case Nop:
             return false;
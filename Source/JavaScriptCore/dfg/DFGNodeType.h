@@ -205,6 +205,13 @@ namespace JSC { namespace DFG {
     macro(NewArrayBuffer, NodeResultJS) \
     macro(NewRegexp, NodeResultJS) \
     \
+    /* Nodes left behind by allocation sinking. PhantomNewObject stands in for an */\
+    /* object whose allocation was removed; the hints record its structure and */\
+    /* field stores so that OSR exit can materialize it if it is still live. */\
+    macro(PhantomNewObject, NodeResultJS | NodeDoesNotExit) \
+    macro(PutStructureHint, NodeMustGenerate | NodeDoesNotExit) \
+    macro(PutByOffsetHint, NodeMustGenerate | NodeDoesNotExit) \
+    \
     /* Resolve nodes. */\
     macro(Resolve, NodeResultJS | NodeMustGenerate | NodeClobbersWorld) \
     macro(ResolveBase, NodeResultJS | NodeMustGenerate | NodeClobbersWorld) \
@@ -228,6 +235,15 @@ namespace JSC { namespace DFG {
     macro(NewStringObject, NodeResultJS) \
     macro(MakeRope, NodeResultJS) \
     \
+    /* Nodes for for-in enumeration. The loop index is one past the position of the */\
+    /* current name in the iterator, or zero once the names have run out. */\
+    macro(ToObjectForIn, NodeResultJS | NodeMustGenerate) \
+    macro(GetPropertyNameIterator, NodeResultJS | NodeMustGenerate | NodeClobbersWorld) \
+    macro(GetPropertyNameIteratorSize, NodeResultInt32) \
+    macro(NextPropertyNameIndex, NodeResultInt32 | NodeMustGenerate | NodeClobbersWorld) \
+    macro(GetPropertyNameAtIndex, NodeResultJS) \
+    macro(GetByValForIn, NodeResultJS | NodeMustGenerate | NodeHasVarArgs | NodeClobbersWorld) \
+    \
     /* Nodes used for activations. Activation support works by having it anchored at */\
     /* epilgoues via TearOffActivation, and all CreateActivation nodes kept alive by */\
     /* being threaded with each other. */\
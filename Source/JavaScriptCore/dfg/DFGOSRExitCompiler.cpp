@@ -70,7 +70,8 @@ void compileOSRExit(ExecState* exec)
     
     // Compute the value recoveries.
     Operands<ValueRecovery> operands;
-    codeBlock->variableEventStream().reconstruct(codeBlock, exit.m_codeOrigin, codeBlock->minifiedDFG(), exit.m_streamIndex, operands);
+    Vector<ObjectMaterialization> materializations;
+    codeBlock->variableEventStream().reconstruct(codeBlock, exit.m_codeOrigin, codeBlock->minifiedDFG(), exit.m_streamIndex, operands, materializations);
     
     // There may be an override, for forward speculations.
     if (!!exit.m_valueRecoveryOverride) {
@@ -106,7 +107,7 @@ void compileOSRExit(ExecState* exec)
             jit.add64(CCallHelpers::TrustedImm32(1), CCallHelpers::AbsoluteAddress(profilerExit->counterAddress()));
         }
         
-        exitCompiler.compileExit(exit, operands, recovery);
+        exitCompiler.compileExit(exit, operands, materializations, recovery);
         
         LinkBuffer patchBuffer(*vm, &jit, codeBlock);
         exit.m_code = FINALIZE_CODE_IF(
@@ -129,8 +130,31 @@ void compileOSRExit(ExecState* exec)
 
 void OSRExitCompiler::handleExitCounts(const OSRExit& exit)
 {
+    // Tell the tier-up telemetry about this exit if it is enabled when the exit is taken,
+    // rather than when it is compiled.
+    AssemblyHelpers::Jump telemetryDisabled = m_jit.branchTest8(
+        AssemblyHelpers::Zero, AssemblyHelpers::AbsoluteAddress(m_jit.vm()->m_tierUpTelemetry->addressOfIsEnabled()));
+#if !NUMBER_OF_ARGUMENT_REGISTERS
+    m_jit.poke(AssemblyHelpers::TrustedImmPtr(m_jit.codeBlock()), 0);
+    m_jit.poke(AssemblyHelpers::TrustedImmPtr(&exit), 1);
+#else
+    m_jit.move(AssemblyHelpers::TrustedImmPtr(m_jit.codeBlock()), GPRInfo::argumentGPR0);
+    m_jit.move(AssemblyHelpers::TrustedImmPtr(&exit), GPRInfo::argumentGPR1);
+#endif
+    m_jit.move(AssemblyHelpers::TrustedImmPtr(bitwise_cast<void*>(notifyTierUpTelemetryOfOSRExit)), GPRInfo::regT1);
+    m_jit.call(GPRInfo::regT1);
+    telemetryDisabled.link(&m_jit);
+    
     m_jit.add32(AssemblyHelpers::TrustedImm32(1), AssemblyHelpers::AbsoluteAddress(&exit.m_count));
     
+    if (exit.m_kind == WatchdogTimerFired) {
+        // We only left to service the watchdog, which may happen every time slice. Don't count
+        // that towards reoptimization, and get back into the optimized code soon.
+        m_jit.move(AssemblyHelpers::TrustedImmPtr(m_jit.baselineCodeBlock()), GPRInfo::regT0);
+        adjustExecutionCounter(m_jit.baselineCodeBlock()->counterValueForOptimizeSoon());
+        return;
+    }
+    
     m_jit.move(AssemblyHelpers::TrustedImmPtr(m_jit.codeBlock()), GPRInfo::regT0);
     
     AssemblyHelpers::Jump tooFewFails;
@@ -155,8 +179,14 @@ void OSRExitCompiler::handleExitCounts(const OSRExit& exit)
     tooFewFails.link(&m_jit);
     
     // Adjust the execution counter such that the target is to only optimize after a while.
-    int32_t activeThreshold =
-        m_jit.baselineCodeBlock()->counterValueForOptimizeAfterLongWarmUp();
+    adjustExecutionCounter(m_jit.baselineCodeBlock()->counterValueForOptimizeAfterLongWarmUp());
+    
+    doneAdjusting.link(&m_jit);
+}
+
+// Expects the baseline CodeBlock in regT0.
+void OSRExitCompiler::adjustExecutionCounter(int32_t activeThreshold)
+{
     int32_t targetValue = ExecutionCounter::applyMemoryUsageHeuristicsAndConvertToInt(
         activeThreshold, m_jit.baselineCodeBlock());
     int32_t clippedValue =
@@ -164,8 +194,6 @@ void OSRExitCompiler::handleExitCounts(const OSRExit& exit)
     m_jit.store32(AssemblyHelpers::TrustedImm32(-clippedValue), AssemblyHelpers::Address(GPRInfo::regT0, CodeBlock::offsetOfJITExecuteCounter()));
     m_jit.store32(AssemblyHelpers::TrustedImm32(activeThreshold), AssemblyHelpers::Address(GPRInfo::regT0, CodeBlock::offsetOfJITExecutionActiveThreshold()));
     m_jit.store32(AssemblyHelpers::TrustedImm32(ExecutionCounter::formattedTotalCount(clippedValue)), AssemblyHelpers::Address(GPRInfo::regT0, CodeBlock::offsetOfJITExecutionTotalCount()));
-    
-    doneAdjusting.link(&m_jit);
 }
 
 } } // namespace JSC::DFG
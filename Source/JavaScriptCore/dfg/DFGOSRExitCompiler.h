@@ -34,6 +34,7 @@
 #include "DFGCCallHelpers.h"
 #include "DFGOSRExit.h"
 #include "DFGOperations.h"
+#include "DFGVariableEventStream.h"
 
 namespace JSC {
 
@@ -48,7 +49,7 @@ public:
     {
     }
     
-    void compileExit(const OSRExit&, const Operands<ValueRecovery>&, SpeculationRecovery*);
+    void compileExit(const OSRExit&, const Operands<ValueRecovery>&, const Vector<ObjectMaterialization>&, SpeculationRecovery*);
 
 private:
 #if !ASSERT_DISABLED
@@ -72,6 +73,7 @@ private:
     }
     
     void handleExitCounts(const OSRExit&);
+    void adjustExecutionCounter(int32_t activeThreshold);
     
     CCallHelpers& m_jit;
     Vector<unsigned> m_poisonScratchIndices;
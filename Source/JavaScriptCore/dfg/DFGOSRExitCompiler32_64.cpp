@@ -34,7 +34,7 @@
 
 namespace JSC { namespace DFG {
 
-void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecovery>& operands, SpeculationRecovery* recovery)
+void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecovery>& operands, const Vector<ObjectMaterialization>& materializations, SpeculationRecovery* recovery)
 {
     // 1) Pro-forma stuff.
 #if DFG_ENABLE(DEBUG_VERBOSE)
@@ -263,14 +263,103 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
         }
     }
     
+    // Objects whose allocation was sunk need their fields and the resulting cells kept
+    // in the scratch buffer, past the slots used by the shuffling below: one slot to
+    // save a temporary register, one per field, and one per object.
+    unsigned numberOfMaterializedFields = 0;
+    for (unsigned i = 0; i < materializations.size(); ++i)
+        numberOfMaterializedFields += materializations[i].fields.size();
     unsigned scratchBufferLengthBeforeUInt32s = numberOfPoisonedVirtualRegisters + ((numberOfDisplacedVirtualRegisters * 2) <= GPRInfo::numberOfRegisters ? 0 : numberOfDisplacedVirtualRegisters);
-    ScratchBuffer* scratchBuffer = m_jit.vm()->scratchBufferForSize(sizeof(EncodedJSValue) * (scratchBufferLengthBeforeUInt32s + (haveUInt32s ? 2 : 0)));
+    unsigned materializationScratchStart = scratchBufferLengthBeforeUInt32s + (haveUInt32s ? 2 : 0);
+    unsigned scratchBufferLength = materializationScratchStart;
+    if (!materializations.isEmpty())
+        scratchBufferLength += 1 + numberOfMaterializedFields + materializations.size();
+    ScratchBuffer* scratchBuffer = m_jit.vm()->scratchBufferForSize(sizeof(EncodedJSValue) * scratchBufferLength);
     EncodedJSValue* scratchDataBuffer = scratchBuffer ? static_cast<EncodedJSValue*>(scratchBuffer->dataBuffer()) : 0;
+    EncodedJSValue* materializedFields = scratchDataBuffer + materializationScratchStart + 1;
+    EncodedJSValue* materializedObjects = materializedFields + numberOfMaterializedFields;
 
     // From here on, the code assumes that it is profitable to maximize the distance
     // between when something is computed and when it is stored.
     
-    // 5) Perform all reboxing of integers and cells, except for those in registers.
+    // 5) Box the fields of sunk objects into the scratch buffer, before any of the
+    //    registers or stack slots they live in get clobbered.
+    
+    if (!materializations.isEmpty()) {
+        EncodedJSValue* savedRegister = scratchDataBuffer + materializationScratchStart;
+        GPRReg temp = GPRInfo::regT0;
+        m_jit.store32(temp, &bitwise_cast<EncodedValueDescriptor*>(savedRegister)->asBits.payload);
+        
+        EncodedJSValue* field = materializedFields;
+        for (unsigned i = 0; i < materializations.size(); ++i) {
+            const Vector<ValueRecovery>& fields = materializations[i].fields;
+            for (unsigned j = 0; j < fields.size(); ++j, ++field) {
+                const ValueRecovery& recovery = fields[j];
+                void* tag = &bitwise_cast<EncodedValueDescriptor*>(field)->asBits.tag;
+                void* payload = &bitwise_cast<EncodedValueDescriptor*>(field)->asBits.payload;
+                switch (recovery.technique()) {
+                case InGPR:
+                    m_jit.store32(AssemblyHelpers::TrustedImm32(JSValue::CellTag), tag);
+                    m_jit.store32(recovery.gpr(), payload);
+                    break;
+                    
+                case UnboxedInt32InGPR:
+                    m_jit.store32(AssemblyHelpers::TrustedImm32(JSValue::Int32Tag), tag);
+                    m_jit.store32(recovery.gpr(), payload);
+                    break;
+                    
+                case UnboxedBooleanInGPR:
+                    m_jit.store32(AssemblyHelpers::TrustedImm32(JSValue::BooleanTag), tag);
+                    m_jit.store32(recovery.gpr(), payload);
+                    break;
+                    
+                case InPair:
+                    m_jit.store32(recovery.tagGPR(), tag);
+                    m_jit.store32(recovery.payloadGPR(), payload);
+                    break;
+                    
+                case InFPR:
+                    m_jit.storeDouble(recovery.fpr(), field);
+                    break;
+                    
+                case DisplacedInJSStack:
+                case DoubleDisplacedInJSStack:
+                    m_jit.load32(AssemblyHelpers::tagFor(recovery.virtualRegister()), temp);
+                    m_jit.store32(temp, tag);
+                    m_jit.load32(AssemblyHelpers::payloadFor(recovery.virtualRegister()), temp);
+                    m_jit.store32(temp, payload);
+                    break;
+                    
+                case Int32DisplacedInJSStack:
+                case CellDisplacedInJSStack:
+                case BooleanDisplacedInJSStack: {
+                    int32_t tagValue = JSValue::BooleanTag;
+                    if (recovery.technique() == Int32DisplacedInJSStack)
+                        tagValue = JSValue::Int32Tag;
+                    else if (recovery.technique() == CellDisplacedInJSStack)
+                        tagValue = JSValue::CellTag;
+                    m_jit.store32(AssemblyHelpers::TrustedImm32(tagValue), tag);
+                    m_jit.load32(AssemblyHelpers::payloadFor(recovery.virtualRegister()), temp);
+                    m_jit.store32(temp, payload);
+                    break;
+                }
+                    
+                case Constant:
+                    m_jit.store32(AssemblyHelpers::TrustedImm32(recovery.constant().tag()), tag);
+                    m_jit.store32(AssemblyHelpers::TrustedImm32(recovery.constant().payload()), payload);
+                    break;
+                    
+                default:
+                    RELEASE_ASSERT_NOT_REACHED();
+                    break;
+                }
+            }
+        }
+        
+        m_jit.load32(&bitwise_cast<EncodedValueDescriptor*>(savedRegister)->asBits.payload, temp);
+    }
+    
+    // 6) Perform all reboxing of integers and cells, except for those in registers.
 
     if (haveUnboxedInt32InJSStack || haveUnboxedCellInJSStack || haveUnboxedBooleanInJSStack) {
         for (size_t index = 0; index < operands.size(); ++index) {
@@ -294,7 +383,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
         }
     }
 
-    // 6) Dump all non-poisoned GPRs. For poisoned GPRs, save them into the scratch storage.
+    // 7) Dump all non-poisoned GPRs. For poisoned GPRs, save them into the scratch storage.
     //    Note that GPRs do not have a fast change (like haveFPRs) because we expect that
     //    most OSR failure points will have at least one GPR that needs to be dumped.
     
@@ -385,7 +474,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
         }
     }
     
-    // 7) Dump all doubles into the stack, or to the scratch storage if the
+    // 8) Dump all doubles into the stack, or to the scratch storage if the
     //    destination virtual register is poisoned.
     if (haveFPRs) {
         for (size_t index = 0; index < operands.size(); ++index) {
@@ -405,7 +494,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
     
     ASSERT(currentPoisonIndex == numberOfPoisonedVirtualRegisters);
     
-    // 8) Reshuffle displaced virtual registers. Optimize for the case that
+    // 9) Reshuffle displaced virtual registers. Optimize for the case that
     //    the number of displaced virtual registers is not more than the number
     //    of available physical registers.
     
@@ -529,7 +618,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
         }
     }
     
-    // 9) Dump all poisoned virtual registers.
+    // 10) Dump all poisoned virtual registers.
     
     if (numberOfPoisonedVirtualRegisters) {
         for (int virtualRegister = 0; virtualRegister < (int)operands.numberOfLocals(); ++virtualRegister) {
@@ -569,7 +658,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
         }
     }
     
-    // 10) Dump all constants. Optimize for Undefined, since that's a constant we see
+    // 11) Dump all constants. Optimize for Undefined, since that's a constant we see
     //     often.
 
     if (haveConstants) {
@@ -592,7 +681,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
         }
     }
     
-    // 12) Adjust the old JIT's execute counter. Since we are exiting OSR, we know
+    // 13) Adjust the old JIT's execute counter. Since we are exiting OSR, we know
     //     that all new calls into this code will go to the new JIT, so the execute
     //     counter only affects call frames that performed OSR exit and call frames
     //     that were still executing the old JIT at the time of another call frame's
@@ -630,7 +719,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
     
     handleExitCounts(exit);
     
-    // 13) Reify inlined call frames.
+    // 14) Reify inlined call frames.
     
     ASSERT(m_jit.baselineCodeBlock()->getJITType() == JITCode::BaselineJIT);
     m_jit.storePtr(AssemblyHelpers::TrustedImmPtr(m_jit.baselineCodeBlock()), AssemblyHelpers::addressFor((VirtualRegister)JSStack::CodeBlock));
@@ -668,7 +757,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
             m_jit.storePtr(AssemblyHelpers::TrustedImmPtr(inlineCallFrame->callee.get()), AssemblyHelpers::payloadFor((VirtualRegister)(inlineCallFrame->stackOffset + JSStack::Callee)));
     }
     
-    // 14) Create arguments if necessary and place them into the appropriate aliased
+    // 15) Create arguments if necessary and place them into the appropriate aliased
     //     registers.
     
     if (haveArguments) {
@@ -735,19 +824,72 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
         }
     }
     
-    // 15) Load the result of the last bytecode operation into regT0.
+    // 16) Allocate the objects whose allocation was sunk, and store them into every
+    //     virtual register that refers to them. The fields and the objects stay in
+    //     the scratch buffer until we are done, so that the GC can see them. The call
+    //     frame is made to look like the innermost inlined frame, so that the GC scans
+    //     all of the stack that we have written to.
+    
+    if (!materializations.isEmpty()) {
+        m_jit.move(AssemblyHelpers::TrustedImmPtr(scratchBuffer->activeLengthPtr()), GPRInfo::regT0);
+        m_jit.storePtr(AssemblyHelpers::TrustedImmPtr(scratchBufferLength * sizeof(EncodedJSValue)), GPRInfo::regT0);
+        
+        if (exit.m_codeOrigin.inlineCallFrame)
+            m_jit.addPtr(AssemblyHelpers::TrustedImm32(exit.m_codeOrigin.inlineCallFrame->stackOffset * sizeof(EncodedJSValue)), GPRInfo::callFrameRegister);
+        
+        EncodedJSValue* fields = materializedFields;
+        for (unsigned i = 0; i < materializations.size(); ++i) {
+            m_jit.setupArgumentsWithExecState(
+                AssemblyHelpers::TrustedImmPtr(materializations[i].structure),
+                AssemblyHelpers::TrustedImmPtr(fields));
+            m_jit.move(
+                AssemblyHelpers::TrustedImmPtr(
+                    bitwise_cast<void*>(operationMaterializeObject)),
+                GPRInfo::nonArgGPR0);
+            m_jit.call(GPRInfo::nonArgGPR0);
+            m_jit.store32(
+                AssemblyHelpers::TrustedImm32(JSValue::CellTag),
+                &bitwise_cast<EncodedValueDescriptor*>(materializedObjects + i)->asBits.tag);
+            m_jit.store32(
+                GPRInfo::returnValueGPR,
+                &bitwise_cast<EncodedValueDescriptor*>(materializedObjects + i)->asBits.payload);
+            fields += materializations[i].fields.size();
+        }
+        
+        if (exit.m_codeOrigin.inlineCallFrame)
+            m_jit.subPtr(AssemblyHelpers::TrustedImm32(exit.m_codeOrigin.inlineCallFrame->stackOffset * sizeof(EncodedJSValue)), GPRInfo::callFrameRegister);
+        
+        for (size_t index = 0; index < operands.size(); ++index) {
+            const ValueRecovery& recovery = operands[index];
+            if (recovery.technique() != ObjectThatWasNotCreated)
+                continue;
+            int operand = operands.operandForIndex(index);
+            m_jit.load32(
+                &bitwise_cast<EncodedValueDescriptor*>(materializedObjects + recovery.materializationIndex())->asBits.payload,
+                GPRInfo::regT0);
+            m_jit.store32(
+                AssemblyHelpers::TrustedImm32(JSValue::CellTag),
+                AssemblyHelpers::tagFor(operand));
+            m_jit.store32(GPRInfo::regT0, AssemblyHelpers::payloadFor(operand));
+        }
+        
+        m_jit.move(AssemblyHelpers::TrustedImmPtr(scratchBuffer->activeLengthPtr()), GPRInfo::regT0);
+        m_jit.storePtr(AssemblyHelpers::TrustedImmPtr(0), GPRInfo::regT0);
+    }
+    
+    // 17) Load the result of the last bytecode operation into regT0.
     
     if (exit.m_lastSetOperand != std::numeric_limits<int>::max()) {
         m_jit.load32(AssemblyHelpers::payloadFor((VirtualRegister)exit.m_lastSetOperand), GPRInfo::cachedResultRegister);
         m_jit.load32(AssemblyHelpers::tagFor((VirtualRegister)exit.m_lastSetOperand), GPRInfo::cachedResultRegister2);
     }
     
-    // 16) Adjust the call frame pointer.
+    // 18) Adjust the call frame pointer.
     
     if (exit.m_codeOrigin.inlineCallFrame)
         m_jit.addPtr(AssemblyHelpers::TrustedImm32(exit.m_codeOrigin.inlineCallFrame->stackOffset * sizeof(EncodedJSValue)), GPRInfo::callFrameRegister);
 
-    // 17) Jump into the corresponding baseline JIT code.
+    // 19) Jump into the corresponding baseline JIT code.
     
     CodeBlock* baselineCodeBlock = m_jit.baselineCodeBlockFor(exit.m_codeOrigin);
     Vector<BytecodeAndMachineOffset>& decodedCodeMap = m_jit.decodedCodeMapFor(baselineCodeBlock);
@@ -34,7 +34,7 @@
 
 namespace JSC { namespace DFG {
 
-void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecovery>& operands, SpeculationRecovery* recovery)
+void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecovery>& operands, const Vector<ObjectMaterialization>& materializations, SpeculationRecovery* recovery)
 {
     // 1) Pro-forma stuff.
 #if DFG_ENABLE(DEBUG_VERBOSE)
@@ -260,13 +260,93 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
     dataLogF(" ");
 #endif
     
-    ScratchBuffer* scratchBuffer = m_jit.vm()->scratchBufferForSize(sizeof(EncodedJSValue) * std::max(haveUInt32s ? 2u : 0u, numberOfPoisonedVirtualRegisters + (numberOfDisplacedVirtualRegisters <= GPRInfo::numberOfRegisters ? 0 : numberOfDisplacedVirtualRegisters)));
+    // Objects whose allocation was sunk need their fields and the resulting cells kept
+    // in the scratch buffer, past the slots used by the shuffling below: one slot to
+    // save a temporary register, one per field, and one per object.
+    unsigned numberOfMaterializedFields = 0;
+    for (unsigned i = 0; i < materializations.size(); ++i)
+        numberOfMaterializedFields += materializations[i].fields.size();
+    unsigned materializationScratchStart = std::max(haveUInt32s ? 2u : 0u, numberOfPoisonedVirtualRegisters + (numberOfDisplacedVirtualRegisters <= GPRInfo::numberOfRegisters ? 0 : numberOfDisplacedVirtualRegisters));
+    unsigned scratchBufferLength = materializationScratchStart;
+    if (!materializations.isEmpty())
+        scratchBufferLength += 1 + numberOfMaterializedFields + materializations.size();
+    
+    ScratchBuffer* scratchBuffer = m_jit.vm()->scratchBufferForSize(sizeof(EncodedJSValue) * scratchBufferLength);
     EncodedJSValue* scratchDataBuffer = scratchBuffer ? static_cast<EncodedJSValue*>(scratchBuffer->dataBuffer()) : 0;
+    EncodedJSValue* materializedFields = scratchDataBuffer + materializationScratchStart + 1;
+    EncodedJSValue* materializedObjects = materializedFields + numberOfMaterializedFields;
 
     // From here on, the code assumes that it is profitable to maximize the distance
     // between when something is computed and when it is stored.
     
-    // 5) Perform all reboxing of integers.
+    // 5) Box the fields of sunk objects into the scratch buffer, before any of the
+    //    registers or stack slots they live in get clobbered.
+    
+    if (!materializations.isEmpty()) {
+        EncodedJSValue* savedRegister = scratchDataBuffer + materializationScratchStart;
+        GPRReg temp = GPRInfo::regT0;
+        m_jit.store64(temp, savedRegister);
+        
+        unsigned fieldIndex = 0;
+        for (unsigned i = 0; i < materializations.size(); ++i) {
+            const Vector<ValueRecovery>& fields = materializations[i].fields;
+            for (unsigned j = 0; j < fields.size(); ++j) {
+                const ValueRecovery& recovery = fields[j];
+                switch (recovery.technique()) {
+                case InGPR:
+                case UnboxedInt32InGPR:
+                case UnboxedBooleanInGPR:
+                    if (recovery.gpr() == temp)
+                        m_jit.load64(savedRegister, temp);
+                    else
+                        m_jit.move(recovery.gpr(), temp);
+                    if (recovery.technique() == UnboxedInt32InGPR && recovery.gpr() != alreadyBoxed) {
+                        m_jit.zeroExtend32ToPtr(temp, temp);
+                        m_jit.or64(GPRInfo::tagTypeNumberRegister, temp);
+                    } else if (recovery.technique() == UnboxedBooleanInGPR)
+                        m_jit.or32(AssemblyHelpers::TrustedImm32(ValueFalse), temp);
+                    break;
+                    
+                case InFPR:
+                    m_jit.boxDouble(recovery.fpr(), temp);
+                    break;
+                    
+                case DisplacedInJSStack:
+                case CellDisplacedInJSStack:
+                    m_jit.load64(AssemblyHelpers::addressFor(recovery.virtualRegister()), temp);
+                    break;
+                    
+                case Int32DisplacedInJSStack:
+                    m_jit.load32(AssemblyHelpers::payloadFor(recovery.virtualRegister()), temp);
+                    m_jit.or64(GPRInfo::tagTypeNumberRegister, temp);
+                    break;
+                    
+                case BooleanDisplacedInJSStack:
+                    m_jit.load32(AssemblyHelpers::payloadFor(recovery.virtualRegister()), temp);
+                    m_jit.or32(AssemblyHelpers::TrustedImm32(ValueFalse), temp);
+                    break;
+                    
+                case DoubleDisplacedInJSStack:
+                    m_jit.load64(AssemblyHelpers::addressFor(recovery.virtualRegister()), temp);
+                    m_jit.sub64(GPRInfo::tagTypeNumberRegister, temp);
+                    break;
+                    
+                case Constant:
+                    m_jit.move(AssemblyHelpers::TrustedImm64(JSValue::encode(recovery.constant())), temp);
+                    break;
+                    
+                default:
+                    RELEASE_ASSERT_NOT_REACHED();
+                    break;
+                }
+                m_jit.store64(temp, materializedFields + fieldIndex++);
+            }
+        }
+        
+        m_jit.load64(savedRegister, temp);
+    }
+    
+    // 6) Perform all reboxing of integers.
     
     if (haveUnboxedInt32s || haveUInt32s) {
         for (size_t index = 0; index < operands.size(); ++index) {
@@ -325,7 +405,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
         }
     }
     
-    // 6) Dump all non-poisoned GPRs. For poisoned GPRs, save them into the scratch storage.
+    // 7) Dump all non-poisoned GPRs. For poisoned GPRs, save them into the scratch storage.
     //    Note that GPRs do not have a fast change (like haveFPRs) because we expect that
     //    most OSR failure points will have at least one GPR that needs to be dumped.
     
@@ -354,7 +434,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
     // At this point all GPRs are available for scratch use.
     
     if (haveFPRs) {
-        // 7) Box all doubles (relies on there being more GPRs than FPRs)
+        // 8) Box all doubles (relies on there being more GPRs than FPRs)
         
         for (size_t index = 0; index < operands.size(); ++index) {
             const ValueRecovery& recovery = operands[index];
@@ -365,7 +445,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
             m_jit.boxDouble(fpr, gpr);
         }
         
-        // 8) Dump all doubles into the stack, or to the scratch storage if
+        // 9) Dump all doubles into the stack, or to the scratch storage if
         //    the destination virtual register is poisoned.
         
         for (size_t index = 0; index < operands.size(); ++index) {
@@ -384,7 +464,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
     
     // At this point all GPRs and FPRs are available for scratch use.
     
-    // 9) Box all unboxed doubles in the stack.
+    // 10) Box all unboxed doubles in the stack.
     if (haveUnboxedDoubles) {
         for (size_t index = 0; index < operands.size(); ++index) {
             const ValueRecovery& recovery = operands[index];
@@ -398,7 +478,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
     
     ASSERT(currentPoisonIndex == numberOfPoisonedVirtualRegisters);
     
-    // 10) Reshuffle displaced virtual registers. Optimize for the case that
+    // 11) Reshuffle displaced virtual registers. Optimize for the case that
     //    the number of displaced virtual registers is not more than the number
     //    of available physical registers.
     
@@ -515,7 +595,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
         }
     }
     
-    // 11) Dump all poisoned virtual registers.
+    // 12) Dump all poisoned virtual registers.
     
     if (numberOfPoisonedVirtualRegisters) {
         for (int virtualRegister = 0; virtualRegister < (int)operands.numberOfLocals(); ++virtualRegister) {
@@ -538,7 +618,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
         }
     }
     
-    // 12) Dump all constants. Optimize for Undefined, since that's a constant we see
+    // 13) Dump all constants. Optimize for Undefined, since that's a constant we see
     //     often.
 
     if (haveConstants) {
@@ -556,7 +636,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
         }
     }
     
-    // 13) Adjust the old JIT's execute counter. Since we are exiting OSR, we know
+    // 14) Adjust the old JIT's execute counter. Since we are exiting OSR, we know
     //     that all new calls into this code will go to the new JIT, so the execute
     //     counter only affects call frames that performed OSR exit and call frames
     //     that were still executing the old JIT at the time of another call frame's
@@ -594,7 +674,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
     
     handleExitCounts(exit);
     
-    // 14) Reify inlined call frames.
+    // 15) Reify inlined call frames.
     
     ASSERT(m_jit.baselineCodeBlock()->getJITType() == JITCode::BaselineJIT);
     m_jit.storePtr(AssemblyHelpers::TrustedImmPtr(m_jit.baselineCodeBlock()), AssemblyHelpers::addressFor((VirtualRegister)JSStack::CodeBlock));
@@ -629,7 +709,7 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
             m_jit.store64(AssemblyHelpers::TrustedImm64(JSValue::encode(JSValue(inlineCallFrame->callee.get()))), AssemblyHelpers::addressFor((VirtualRegister)(inlineCallFrame->stackOffset + JSStack::Callee)));
     }
     
-    // 15) Create arguments if necessary and place them into the appropriate aliased
+    // 16) Create arguments if necessary and place them into the appropriate aliased
     //     registers.
     
     if (haveArguments) {
@@ -680,17 +760,59 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, const Operands<ValueRecov
         }
     }
     
-    // 16) Load the result of the last bytecode operation into regT0.
+    // 17) Allocate the objects whose allocation was sunk, and store them into every
+    //     virtual register that refers to them. The fields and the objects stay in
+    //     the scratch buffer until we are done, so that the GC can see them. The call
+    //     frame is made to look like the innermost inlined frame, so that the GC scans
+    //     all of the stack that we have written to.
+    
+    if (!materializations.isEmpty()) {
+        m_jit.move(AssemblyHelpers::TrustedImmPtr(scratchBuffer->activeLengthPtr()), GPRInfo::regT0);
+        m_jit.storePtr(AssemblyHelpers::TrustedImmPtr(scratchBufferLength * sizeof(EncodedJSValue)), GPRInfo::regT0);
+        
+        if (exit.m_codeOrigin.inlineCallFrame)
+            m_jit.addPtr(AssemblyHelpers::TrustedImm32(exit.m_codeOrigin.inlineCallFrame->stackOffset * sizeof(EncodedJSValue)), GPRInfo::callFrameRegister);
+        
+        EncodedJSValue* fields = materializedFields;
+        for (unsigned i = 0; i < materializations.size(); ++i) {
+            m_jit.setupArgumentsWithExecState(
+                AssemblyHelpers::TrustedImmPtr(materializations[i].structure),
+                AssemblyHelpers::TrustedImmPtr(fields));
+            m_jit.move(
+                AssemblyHelpers::TrustedImmPtr(
+                    bitwise_cast<void*>(operationMaterializeObject)),
+                GPRInfo::nonArgGPR0);
+            m_jit.call(GPRInfo::nonArgGPR0);
+            m_jit.store64(GPRInfo::returnValueGPR, materializedObjects + i);
+            fields += materializations[i].fields.size();
+        }
+        
+        if (exit.m_codeOrigin.inlineCallFrame)
+            m_jit.subPtr(AssemblyHelpers::TrustedImm32(exit.m_codeOrigin.inlineCallFrame->stackOffset * sizeof(EncodedJSValue)), GPRInfo::callFrameRegister);
+        
+        for (size_t index = 0; index < operands.size(); ++index) {
+            const ValueRecovery& recovery = operands[index];
+            if (recovery.technique() != ObjectThatWasNotCreated)
+                continue;
+            m_jit.load64(materializedObjects + recovery.materializationIndex(), GPRInfo::regT0);
+            m_jit.store64(GPRInfo::regT0, AssemblyHelpers::addressFor((VirtualRegister)operands.operandForIndex(index)));
+        }
+        
+        m_jit.move(AssemblyHelpers::TrustedImmPtr(scratchBuffer->activeLengthPtr()), GPRInfo::regT0);
+        m_jit.storePtr(AssemblyHelpers::TrustedImmPtr(0), GPRInfo::regT0);
+    }
+    
+    // 18) Load the result of the last bytecode operation into regT0.
     
     if (exit.m_lastSetOperand != std::numeric_limits<int>::max())
         m_jit.load64(AssemblyHelpers::addressFor((VirtualRegister)exit.m_lastSetOperand), GPRInfo::cachedResultRegister);
     
-    // 17) Adjust the call frame pointer.
+    // 19) Adjust the call frame pointer.
     
     if (exit.m_codeOrigin.inlineCallFrame)
         m_jit.addPtr(AssemblyHelpers::TrustedImm32(exit.m_codeOrigin.inlineCallFrame->stackOffset * sizeof(EncodedJSValue)), GPRInfo::callFrameRegister);
     
-    // 18) Jump into the corresponding baseline JIT code.
+    // 20) Jump into the corresponding baseline JIT code.
     
     CodeBlock* baselineCodeBlock = m_jit.baselineCodeBlockFor(exit.m_codeOrigin);
     Vector<BytecodeAndMachineOffset>& decodedCodeMap = m_jit.decodedCodeMapFor(baselineCodeBlock);
@@ -0,0 +1,354 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "DFGObjectAllocationSinkingPhase.h"
+
+#if ENABLE(DFG_JIT)
+
+#include "DFGBasicBlockInlines.h"
+#include "DFGGraph.h"
+#include "DFGPhase.h"
+#include "Operations.h"
+#include <wtf/BitVector.h>
+#include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+
+namespace JSC { namespace DFG {
+
+class ObjectAllocationSinkingPhase : public Phase {
+public:
+    ObjectAllocationSinkingPhase(Graph& graph)
+        : Phase(graph, "object allocation sinking")
+    {
+    }
+
+    bool run()
+    {
+        ASSERT(m_graph.m_form == ThreadedCPS);
+
+        findSetLocalsThatReachPhis();
+        findLocalsReadThroughArguments();
+
+        bool changed = false;
+        for (BlockIndex blockIndex = 0; blockIndex < m_graph.m_blocks.size(); ++blockIndex) {
+            BasicBlock* block = m_graph.m_blocks[blockIndex].get();
+            if (!block)
+                continue;
+            for (unsigned indexInBlock = 0; indexInBlock < block->size(); ++indexInBlock) {
+                if (block->at(indexInBlock)->op() != NewObject)
+                    continue;
+                if (!canSink(block, indexInBlock))
+                    continue;
+                sink(block, indexInBlock);
+                changed = true;
+            }
+        }
+
+        // We turned SetLocals into hints and removed Flushes; make the CPS
+        // rethreading that follows rebuild the Phi graph.
+        if (changed)
+            m_graph.dethread();
+
+        return changed;
+    }
+
+private:
+    static Node* skipLocalAccessChain(Node* node)
+    {
+        while (node->child1()
+            && (node->op() == Flush || node->op() == PhantomLocal || node->op() == GetLocal))
+            node = node->child1().node();
+        return node;
+    }
+
+    // A SetLocal whose value flows into a Phi may be read in another block, where
+    // we would no longer know about the sunk allocation.
+    void findSetLocalsThatReachPhis()
+    {
+        for (BlockIndex blockIndex = 0; blockIndex < m_graph.m_blocks.size(); ++blockIndex) {
+            BasicBlock* block = m_graph.m_blocks[blockIndex].get();
+            if (!block)
+                continue;
+            for (unsigned phiIndex = block->phis.size(); phiIndex--;) {
+                Node* phi = block->phis[phiIndex];
+                for (unsigned i = 0; i < AdjacencyList::Size; ++i) {
+                    Edge edge = phi->children.child(i);
+                    if (!edge)
+                        break;
+                    Node* source = skipLocalAccessChain(edge.node());
+                    if (source->op() == SetLocal)
+                        m_setLocalsThatReachPhis.add(source);
+                }
+            }
+        }
+    }
+
+    // Inlined code that uses the arguments object reads its parameters from the
+    // stack, so nothing may be sunk into those slots.
+    void findLocalsReadThroughArguments()
+    {
+        for (unsigned i = codeBlock()->inlineCallFrames().size(); i--;) {
+            InlineCallFrame* inlineCallFrame = &codeBlock()->inlineCallFrames()[i];
+            if (!baselineCodeBlockForInlineCallFrame(inlineCallFrame)->usesArguments())
+                continue;
+            for (unsigned argument = inlineCallFrame->arguments.size(); argument--;) {
+                int operand = inlineCallFrame->stackOffset + argumentToOperand(argument);
+                if (operand >= 0)
+                    m_localsReadThroughArguments.set(operand);
+            }
+        }
+    }
+
+    static unsigned inlineIndexFor(const StorageAccessData& storageAccessData)
+    {
+        return storageAccessData.offset - JSObject::offsetOfInlineStorage() / sizeof(EncodedJSValue);
+    }
+
+    bool usesNode(Node* node, Node* child)
+    {
+        if (node->flags() & NodeHasVarArgs) {
+            for (unsigned childIdx = node->firstChild(); childIdx < node->firstChild() + node->numChildren(); ++childIdx) {
+                if (m_graph.m_varArgChildren[childIdx].node() == child)
+                    return true;
+            }
+            return false;
+        }
+        return node->child1().node() == child
+            || node->child2().node() == child
+            || node->child3().node() == child;
+    }
+
+    bool canSinkIntoLocal(BasicBlock* block, unsigned indexInBlock)
+    {
+        Node* setLocal = block->at(indexInBlock);
+        VariableAccessData* variable = setLocal->variableAccessData();
+        if (variable->isCaptured() || variable->isArgumentsAlias())
+            return false;
+        if (operandIsArgument(variable->local()))
+            return false;
+        if (m_localsReadThroughArguments.get(variable->local()))
+            return false;
+        if (m_setLocalsThatReachPhis.contains(setLocal))
+            return false;
+
+        // The local may only be flushed, never read.
+        HashSet<Node*> accesses;
+        accesses.add(setLocal);
+        for (unsigned i = indexInBlock + 1; i < block->size(); ++i) {
+            Node* node = block->at(i);
+            if (node->flags() & NodeHasVarArgs)
+                continue;
+            if (!node->child1() || !accesses.contains(node->child1().node()))
+                continue;
+            if (node->op() != Flush && node->op() != PhantomLocal)
+                return false;
+            accesses.add(node);
+        }
+        return true;
+    }
+
+    bool canSink(BasicBlock* block, unsigned allocationIndex)
+    {
+        Node* allocation = block->at(allocationIndex);
+        Structure* structure = allocation->structure();
+        if (structure->outOfLineCapacity())
+            return false;
+
+        Vector<Node*, 8> fields(structure->inlineCapacity());
+        fields.fill(0);
+        bool sawUse = false;
+
+        for (unsigned indexInBlock = allocationIndex + 1; indexInBlock < block->size(); ++indexInBlock) {
+            Node* node = block->at(indexInBlock);
+            if (!usesNode(node, allocation))
+                continue;
+            sawUse = true;
+
+            switch (node->op()) {
+            case CheckStructure:
+            case ForwardCheckStructure:
+                if (!node->structureSet().contains(structure))
+                    return false;
+                break;
+
+            case StructureTransitionWatchpoint:
+            case ForwardStructureTransitionWatchpoint:
+                if (node->structure() != structure)
+                    return false;
+                break;
+
+            case PutStructure:
+            case PhantomPutStructure: {
+                StructureTransitionData& transition = node->structureTransitionData();
+                if (transition.previousStructure != structure)
+                    return false;
+                if (transition.newStructure->outOfLineCapacity())
+                    return false;
+                structure = transition.newStructure;
+                break;
+            }
+
+            case PutByOffset: {
+                if (node->child1().node() != allocation || node->child2().node() != allocation)
+                    return false;
+                if (node->child3()->op() == PhantomArguments)
+                    return false;
+                unsigned inlineIndex = inlineIndexFor(m_graph.m_storageAccessData[node->storageAccessDataIndex()]);
+                if (inlineIndex >= fields.size())
+                    return false;
+                fields[inlineIndex] = node->child3().node();
+                break;
+            }
+
+            case GetByOffset: {
+                if (node->child1().node() != allocation || node->child2().node() != allocation)
+                    return false;
+                unsigned inlineIndex = inlineIndexFor(m_graph.m_storageAccessData[node->storageAccessDataIndex()]);
+                if (inlineIndex >= fields.size() || !fields[inlineIndex])
+                    return false;
+                break;
+            }
+
+            case SetLocal:
+                if (!canSinkIntoLocal(block, indexInBlock))
+                    return false;
+                break;
+
+            case Phantom:
+                break;
+
+            default:
+                return false;
+            }
+        }
+
+        // An allocation that nobody uses will be killed by DCE anyway.
+        return sawUse;
+    }
+
+    void sink(BasicBlock* block, unsigned allocationIndex)
+    {
+        Node* allocation = block->at(allocationIndex);
+        allocation->setOpAndDefaultFlags(PhantomNewObject);
+
+        Vector<Node*, 8> fields(allocation->structure()->inlineCapacity());
+        fields.fill(0);
+        HashSet<Node*> flushedLocals;
+        m_replacements.clear();
+
+        for (unsigned indexInBlock = allocationIndex + 1; indexInBlock < block->size(); ++indexInBlock) {
+            Node* node = block->at(indexInBlock);
+
+            if (!m_replacements.isEmpty())
+                DFG_NODE_DO_TO_CHILDREN(m_graph, node, replaceLoadedField);
+
+            if ((node->op() == Flush || node->op() == PhantomLocal)
+                && flushedLocals.contains(node->child1().node())) {
+                flushedLocals.add(node);
+                node->setOpAndDefaultFlags(Nop);
+                node->children.reset();
+                continue;
+            }
+
+            if (!usesNode(node, allocation))
+                continue;
+
+            switch (node->op()) {
+            case CheckStructure:
+            case ForwardCheckStructure:
+            case StructureTransitionWatchpoint:
+            case ForwardStructureTransitionWatchpoint:
+                // Keep the allocation alive for OSR exit at this point.
+                node->convertToPhantom();
+                node->children.setChild1(Edge(allocation));
+                break;
+
+            case PutStructure:
+            case PhantomPutStructure:
+                node->setOpAndDefaultFlags(PutStructureHint);
+                node->children.setChild1(Edge(allocation));
+                break;
+
+            case PutByOffset: {
+                Edge value = node->child3();
+                fields[inlineIndexFor(m_graph.m_storageAccessData[node->storageAccessDataIndex()])] = value.node();
+                node->setOpAndDefaultFlags(PutByOffsetHint);
+                node->children = AdjacencyList(AdjacencyList::Fixed, Edge(allocation), Edge(value.node()), Edge());
+                break;
+            }
+
+            case GetByOffset: {
+                Node* value = fields[inlineIndexFor(m_graph.m_storageAccessData[node->storageAccessDataIndex()])];
+                ASSERT(value);
+                m_replacements.add(node, value);
+                node->convertToPhantom();
+                node->children = AdjacencyList(AdjacencyList::Fixed, Edge(allocation), Edge(), Edge());
+                break;
+            }
+
+            case SetLocal:
+                node->child1().setUseKind(UntypedUse);
+                node->variableAccessData()->mergeShouldNeverUnbox(true);
+                flushedLocals.add(node);
+                break;
+
+            case Phantom:
+                for (unsigned i = 0; i < AdjacencyList::Size; ++i) {
+                    if (node->children.child(i).node() == allocation)
+                        node->children.child(i).setUseKind(UntypedUse);
+                }
+                break;
+
+            default:
+                RELEASE_ASSERT_NOT_REACHED();
+                break;
+            }
+        }
+    }
+
+    void replaceLoadedField(Node*, Edge& edge)
+    {
+        HashMap<Node*, Node*>::iterator iter = m_replacements.find(edge.node());
+        if (iter == m_replacements.end())
+            return;
+        edge.setNode(iter->value);
+    }
+
+    HashMap<Node*, Node*> m_replacements;
+    HashSet<Node*> m_setLocalsThatReachPhis;
+    BitVector m_localsReadThroughArguments;
+};
+
+bool performObjectAllocationSinking(Graph& graph)
+{
+    SamplingRegion samplingRegion("DFG Object Allocation Sinking Phase");
+    return runPhase<ObjectAllocationSinkingPhase>(graph);
+}
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
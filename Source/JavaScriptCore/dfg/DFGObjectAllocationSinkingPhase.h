@@ -20,31 +20,34 @@
  * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
  * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
- * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include "config.h"
-#include "Watchdog.h"
+#ifndef DFGObjectAllocationSinkingPhase_h
+#define DFGObjectAllocationSinkingPhase_h
 
-namespace JSC {
+#include <wtf/Platform.h>
 
-// This is a stub for platforms that have not implemented this functionality.
-// In this case, the platform timer here never fires.
+#if ENABLE(DFG_JIT)
 
-void Watchdog::initTimer()
-{
-}
+#include "DFGCommon.h"
 
-void Watchdog::destroyTimer()
-{
-}
+namespace JSC { namespace DFG {
 
-void Watchdog::startTimer(double)
-{
-}
+class Graph;
 
-void Watchdog::stopTimer()
-{
-}
+// Block-local scalar replacement of object allocations. A NewObject whose only
+// uses within its basic block are structure checks, structure transitions, and
+// inline property stores and loads - plus stores into locals that are never read
+// back - is turned into a PhantomNewObject. Loads are replaced with the values
+// that were stored, and the stores become hints that OSR exit uses to allocate
+// and fill in the object if baseline code still needs it.
+
+bool performObjectAllocationSinking(Graph&);
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
+#endif // DFGObjectAllocationSinkingPhase_h
 
-} // namespace JSC
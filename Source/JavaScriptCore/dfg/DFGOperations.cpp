@@ -39,6 +39,7 @@
 #include "JIT.h"
 #include "JITExceptions.h"
 #include "JSActivation.h"
+#include "JSPropertyNameIterator.h"
 #include "VM.h"
 #include "JSNameScope.h"
 #include "NameInstance.h"
@@ -1318,6 +1319,45 @@ EncodedJSValue DFG_OPERATION operationToPrimitive(ExecState* exec, EncodedJSValu
     return JSValue::encode(JSValue::decode(value).toPrimitive(exec));
 }
 
+EncodedJSValue DFG_OPERATION operationToObjectForIn(ExecState* exec, EncodedJSValue encodedValue)
+{
+    VM* vm = &exec->vm();
+    NativeCallFrameTracer tracer(vm, exec);
+    
+    JSValue value = JSValue::decode(encodedValue);
+    if (value.isUndefinedOrNull())
+        return encodedValue;
+    return JSValue::encode(value.toObject(exec));
+}
+
+EncodedJSValue DFG_OPERATION operationGetPropertyNameIterator(ExecState* exec, EncodedJSValue encodedBase)
+{
+    VM* vm = &exec->vm();
+    NativeCallFrameTracer tracer(vm, exec);
+    
+    JSValue base = JSValue::decode(encodedBase);
+    if (base.isUndefinedOrNull())
+        return JSValue::encode(jsNull());
+    return JSValue::encode(JSPropertyNameIterator::forObject(exec, asObject(base)));
+}
+
+// Returns one past the position of the next name, starting at i, that is still a property
+// of base, or zero if there are none left.
+int32_t DFG_OPERATION operationNextPropertyNameIndex(ExecState* exec, JSCell* base, JSCell* iteratorCell, int32_t i)
+{
+    VM* vm = &exec->vm();
+    NativeCallFrameTracer tracer(vm, exec);
+    
+    JSPropertyNameIterator* iterator = jsCast<JSPropertyNameIterator*>(iteratorCell);
+    for (size_t index = i; index < iterator->size(); ++index) {
+        if (iterator->get(exec, asObject(base), index))
+            return index + 1;
+        if (exec->hadException())
+            return 0;
+    }
+    return 0;
+}
+
 char* DFG_OPERATION operationNewArray(ExecState* exec, Structure* arrayStructure, void* buffer, size_t size)
 {
     VM* vm = &exec->vm();
@@ -1397,6 +1437,18 @@ JSCell* DFG_OPERATION operationCreateInlinedArguments(
     return result;
 }
 
+JSCell* DFG_OPERATION operationMaterializeObject(ExecState* exec, Structure* structure, EncodedJSValue* fields)
+{
+    VM& vm = exec->vm();
+    NativeCallFrameTracer tracer(&vm, exec);
+    // Called from OSR exit, like operationCreateArguments. The fields live in a
+    // scratch buffer that the exit has made visible to the GC.
+    JSFinalObject* result = JSFinalObject::create(exec, structure);
+    for (unsigned i = structure->inlineSize(); i--;)
+        result->putDirect(vm, i, JSValue::decode(fields[i]));
+    return result;
+}
+
 void DFG_OPERATION operationTearOffArguments(ExecState* exec, JSCell* argumentsCell, JSCell* activationCell)
 {
     ASSERT(exec->codeBlock()->usesArguments());
@@ -1787,6 +1839,12 @@ extern "C" void DFG_OPERATION triggerReoptimizationNow(CodeBlock* codeBlock)
     codeBlock->reoptimize();
 }
 
+extern "C" void DFG_OPERATION notifyTierUpTelemetryOfOSRExit(CodeBlock* codeBlock, OSRExit* exit)
+{
+    if (Profiler::TierUpTelemetry* telemetry = codeBlock->vm()->enabledTierUpTelemetry())
+        telemetry->notifyOSRExit(codeBlock, *exit);
+}
+
 } // extern "C"
 } } // namespace JSC::DFG
 
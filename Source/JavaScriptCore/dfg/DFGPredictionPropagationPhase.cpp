@@ -448,6 +448,38 @@ private:
             break;
         }
             
+        case ToObjectForIn: {
+            SpeculatedType child = node->child1()->prediction();
+            if (child) {
+                SpeculatedType result = child & (SpecObject | SpecOther);
+                if (child & ~(SpecObject | SpecOther))
+                    result |= SpecObjectOther | SpecStringObject;
+                changed |= mergePrediction(result);
+            }
+            break;
+        }
+            
+        case GetPropertyNameIterator: {
+            changed |= setPrediction(SpecCellOther | SpecOther);
+            break;
+        }
+            
+        case GetPropertyNameIteratorSize:
+        case NextPropertyNameIndex: {
+            changed |= setPrediction(SpecInt32);
+            break;
+        }
+            
+        case GetPropertyNameAtIndex: {
+            changed |= mergePrediction(SpecString | node->child3()->prediction());
+            break;
+        }
+            
+        case GetByValForIn: {
+            changed |= mergePrediction(node->getHeapPrediction());
+            break;
+        }
+            
         case CreateArguments: {
             changed |= setPrediction(SpecArguments);
             break;
@@ -478,6 +510,9 @@ private:
         case GetMyArgumentByVal:
         case PhantomPutStructure:
         case PhantomArguments:
+        case PhantomNewObject:
+        case PutStructureHint:
+        case PutByOffsetHint:
         case CheckArray:
         case Arrayify:
         case ArrayifyToStructure:
@@ -1611,6 +1611,33 @@ void SpeculativeJIT::compileMovHintAndCheck(Node* node)
     noResult(node);
 }
 
+void SpeculativeJIT::compilePutStructureHint(Node* node)
+{
+    m_jit.addWeakReferenceTransition(
+        node->codeOrigin.codeOriginOwner(),
+        node->structureTransitionData().previousStructure,
+        node->structureTransitionData().newStructure);
+    
+    m_stream->appendAndLog(VariableEvent::objectHint(MinifiedID(node)));
+    noResult(node);
+}
+
+void SpeculativeJIT::compilePutByOffsetHint(Node* node)
+{
+    // Like a MovHint, except that the value is associated with a slot of an object
+    // that was never allocated rather than with a bytecode operand.
+    Node* value = node->child2().node();
+    noticeOSRBirth(value);
+    
+    if (value->op() == UInt32ToNumber)
+        noticeOSRBirth(value->child1().node());
+    
+    StorageAccessData& storageAccessData = m_jit.graph().m_storageAccessData[node->storageAccessDataIndex()];
+    unsigned inlineOffset = storageAccessData.offset - JSObject::offsetOfInlineStorage() / sizeof(EncodedJSValue);
+    m_stream->appendAndLog(VariableEvent::objectHint(MinifiedID(node), inlineOffset));
+    noResult(node);
+}
+
 void SpeculativeJIT::compileInlineStart(Node* node)
 {
     InlineCallFrame* inlineCallFrame = node->codeOrigin.inlineCallFrame;
@@ -692,6 +692,8 @@ public:
     
     void compileMovHint(Node*);
     void compileMovHintAndCheck(Node*);
+    void compilePutStructureHint(Node*);
+    void compilePutByOffsetHint(Node*);
     void compileInlineStart(Node*);
 
     void nonSpeculativeUInt32ToNumber(Node*);
@@ -1004,6 +1006,12 @@ public:
         return appendCallWithExceptionCheckSetResult(operation, result);
     }
 
+    JITCompiler::Call callOperation(Z_DFGOperation_ECCZ operation, GPRReg result, GPRReg arg1, GPRReg arg2, GPRReg arg3)
+    {
+        m_jit.setupArgumentsWithExecState(arg1, arg2, arg3);
+        return appendCallWithExceptionCheckSetResult(operation, result);
+    }
+
     JITCompiler::Call callOperation(V_DFGOperation_EC operation, GPRReg arg1)
     {
         m_jit.setupArgumentsWithExecState(arg1);
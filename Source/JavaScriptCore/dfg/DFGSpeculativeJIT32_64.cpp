@@ -33,6 +33,7 @@
 #include "DFGCallArrayAllocatorSlowPathGenerator.h"
 #include "DFGSlowPathGenerator.h"
 #include "JSActivation.h"
+#include "JSPropertyNameIterator.h"
 #include "ObjectPrototype.h"
 #include "Operations.h"
 
@@ -1959,6 +1960,11 @@ void SpeculativeJIT::compile(Node* node)
         initConstantInfo(node);
         break;
 
+    case PhantomNewObject:
+        m_jit.addWeakReference(node->structure());
+        initConstantInfo(node);
+        break;
+
     case WeakJSConstant:
         m_jit.addWeakReference(node->weakConstant());
         initConstantInfo(node);
@@ -2128,12 +2134,12 @@ void SpeculativeJIT::compile(Node* node)
         noResult(node);
         recordSetLocal(node->local(), ValueSource(ValueInJSStack));
 
-        // If we're storing an arguments object that has been optimized away,
-        // our variable event stream for OSR exit now reflects the optimized
-        // value (JSValue()). On the slow path, we want an arguments object
-        // instead. We add an additional move hint to show OSR exit that it
-        // needs to reconstruct the arguments object.
-        if (node->child1()->op() == PhantomArguments)
+        // If we're storing an arguments object or an object whose allocation was
+        // sunk, our variable event stream for OSR exit now reflects the optimized
+        // value (JSValue()). On the slow path, we want a real object instead. We
+        // add an additional move hint to show OSR exit that it needs to
+        // reconstruct the object.
+        if (node->child1()->op() == PhantomArguments || node->child1()->op() == PhantomNewObject)
             compileMovHint(node);
 
         break;
@@ -3303,6 +3309,108 @@ void SpeculativeJIT::compile(Node* node)
         break;
     }
         
+    case ToObjectForIn: {
+        JSValueOperand value(this, node->child1());
+        GPRReg valueTagGPR = value.tagGPR();
+        GPRReg valuePayloadGPR = value.payloadGPR();
+        
+        flushRegisters();
+        GPRResult2 resultTag(this);
+        GPRResult resultPayload(this);
+        callOperation(operationToObjectForIn, resultTag.gpr(), resultPayload.gpr(), valueTagGPR, valuePayloadGPR);
+        
+        jsValueResult(resultTag.gpr(), resultPayload.gpr(), node);
+        break;
+    }
+        
+    case GetPropertyNameIterator: {
+        JSValueOperand base(this, node->child1());
+        GPRReg baseTagGPR = base.tagGPR();
+        GPRReg basePayloadGPR = base.payloadGPR();
+        
+        flushRegisters();
+        GPRResult2 resultTag(this);
+        GPRResult resultPayload(this);
+        callOperation(operationGetPropertyNameIterator, resultTag.gpr(), resultPayload.gpr(), baseTagGPR, basePayloadGPR);
+        
+        jsValueResult(resultTag.gpr(), resultPayload.gpr(), node);
+        break;
+    }
+        
+    case GetPropertyNameIteratorSize: {
+        JSValueOperand iterator(this, node->child1());
+        GPRTemporary result(this);
+        
+        GPRReg resultGPR = result.gpr();
+        
+        // The iterator is null if there is nothing to enumerate.
+        m_jit.move(TrustedImm32(0), resultGPR);
+        MacroAssembler::Jump notCell = m_jit.branch32(MacroAssembler::NotEqual, iterator.tagGPR(), TrustedImm32(JSValue::CellTag));
+        m_jit.load32(MacroAssembler::Address(iterator.payloadGPR(), OBJECT_OFFSETOF(JSPropertyNameIterator, m_jsStringsSize)), resultGPR);
+        notCell.link(&m_jit);
+        
+        integerResult(resultGPR, node);
+        break;
+    }
+        
+    case NextPropertyNameIndex: {
+        JSValueOperand base(this, node->child1());
+        JSValueOperand iterator(this, node->child2());
+        SpeculateIntegerOperand index(this, node->child3());
+        GPRReg basePayloadGPR = base.payloadGPR();
+        GPRReg iteratorPayloadGPR = iterator.payloadGPR();
+        GPRReg indexGPR = index.gpr();
+        
+        flushRegisters();
+        GPRResult result(this);
+        callOperation(operationNextPropertyNameIndex, result.gpr(), basePayloadGPR, iteratorPayloadGPR, indexGPR);
+        
+        integerResult(result.gpr(), node);
+        break;
+    }
+        
+    case GetPropertyNameAtIndex: {
+        JSValueOperand iterator(this, node->child1());
+        SpeculateIntegerOperand index(this, node->child2());
+        JSValueOperand oldValue(this, node->child3());
+        GPRTemporary resultTag(this);
+        GPRTemporary resultPayload(this);
+        
+        GPRReg indexGPR = index.gpr();
+        GPRReg resultTagGPR = resultTag.gpr();
+        GPRReg resultPayloadGPR = resultPayload.gpr();
+        
+        m_jit.move(oldValue.tagGPR(), resultTagGPR);
+        m_jit.move(oldValue.payloadGPR(), resultPayloadGPR);
+        MacroAssembler::Jump done = m_jit.branchTest32(MacroAssembler::Zero, indexGPR);
+        m_jit.loadPtr(MacroAssembler::Address(iterator.payloadGPR(), OBJECT_OFFSETOF(JSPropertyNameIterator, m_jsStrings)), resultPayloadGPR);
+        m_jit.load32(MacroAssembler::BaseIndex(resultPayloadGPR, indexGPR, MacroAssembler::TimesEight, OBJECT_OFFSETOF(JSValue, u.asBits.tag) - static_cast<int>(sizeof(JSValue))), resultTagGPR);
+        m_jit.load32(MacroAssembler::BaseIndex(resultPayloadGPR, indexGPR, MacroAssembler::TimesEight, OBJECT_OFFSETOF(JSValue, u.asBits.payload) - static_cast<int>(sizeof(JSValue))), resultPayloadGPR);
+        done.link(&m_jit);
+        
+        jsValueResult(resultTagGPR, resultPayloadGPR, node);
+        break;
+    }
+        
+    case GetByValForIn: {
+        JSValueOperand base(this, m_jit.graph().varArgChild(node, 0));
+        JSValueOperand property(this, m_jit.graph().varArgChild(node, 1));
+        SpeculateIntegerOperand index(this, m_jit.graph().varArgChild(node, 4));
+        GPRReg baseTagGPR = base.tagGPR();
+        GPRReg basePayloadGPR = base.payloadGPR();
+        GPRReg propertyTagGPR = property.tagGPR();
+        GPRReg propertyPayloadGPR = property.payloadGPR();
+        index.gpr();
+        
+        flushRegisters();
+        GPRResult2 resultTag(this);
+        GPRResult resultPayload(this);
+        callOperation(operationGetByVal, resultTag.gpr(), resultPayload.gpr(), baseTagGPR, basePayloadGPR, propertyTagGPR, propertyPayloadGPR);
+        
+        jsValueResult(resultTag.gpr(), resultPayload.gpr(), node);
+        break;
+    }
+        
     case ToPrimitive: {
         RELEASE_ASSERT(node->child1().useKind() == UntypedUse);
         JSValueOperand op1(this, node->child1());
@@ -4128,6 +4236,14 @@ void SpeculativeJIT::compile(Node* node)
         break;
     }
         
+    case PutStructureHint:
+        compilePutStructureHint(node);
+        break;
+        
+    case PutByOffsetHint:
+        compilePutByOffsetHint(node);
+        break;
+        
     case PutByOffset: {
 #if ENABLE(WRITE_BARRIER_PROFILING)
         SpeculateCellOperand base(this, node->child2());
@@ -4656,12 +4772,12 @@ void SpeculativeJIT::compile(Node* node)
     case CheckArgumentsNotCreated: {
         ASSERT(!isEmptySpeculation(
             m_state.variables().operand(
-                m_jit.graph().argumentsRegisterFor(node->codeOrigin)).m_type));
+                m_jit.graph().argumentsRegisterFor(node->argumentsCallFrame())).m_type));
         speculationCheck(
             Uncountable, JSValueRegs(), 0,
             m_jit.branch32(
                 JITCompiler::NotEqual,
-                JITCompiler::tagFor(m_jit.argumentsRegisterFor(node->codeOrigin)),
+                JITCompiler::tagFor(m_jit.argumentsRegisterFor(node->argumentsCallFrame())),
                 TrustedImm32(JSValue::EmptyValueTag)));
         noResult(node);
         break;
@@ -4670,19 +4786,20 @@ void SpeculativeJIT::compile(Node* node)
     case GetMyArgumentsLength: {
         GPRTemporary result(this);
         GPRReg resultGPR = result.gpr();
+        InlineCallFrame* inlineCallFrame = node->argumentsCallFrame();
         
         if (!isEmptySpeculation(
                 m_state.variables().operand(
-                    m_jit.graph().argumentsRegisterFor(node->codeOrigin)).m_type)) {
+                    m_jit.graph().argumentsRegisterFor(inlineCallFrame)).m_type)) {
             speculationCheck(
                 ArgumentsEscaped, JSValueRegs(), 0,
                 m_jit.branch32(
                     JITCompiler::NotEqual,
-                    JITCompiler::tagFor(m_jit.argumentsRegisterFor(node->codeOrigin)),
+                    JITCompiler::tagFor(m_jit.argumentsRegisterFor(inlineCallFrame)),
                     TrustedImm32(JSValue::EmptyValueTag)));
         }
         
-        ASSERT(!node->codeOrigin.inlineCallFrame);
+        ASSERT(!inlineCallFrame);
         m_jit.load32(JITCompiler::payloadFor(JSStack::ArgumentCount), resultGPR);
         m_jit.sub32(TrustedImm32(1), resultGPR);
         integerResult(resultGPR, node);
@@ -4731,27 +4848,28 @@ void SpeculativeJIT::compile(Node* node)
         GPRReg indexGPR = index.gpr();
         GPRReg resultPayloadGPR = resultPayload.gpr();
         GPRReg resultTagGPR = resultTag.gpr();
+        InlineCallFrame* inlineCallFrame = node->argumentsCallFrame();
         
         if (!isEmptySpeculation(
                 m_state.variables().operand(
-                    m_jit.graph().argumentsRegisterFor(node->codeOrigin)).m_type)) {
+                    m_jit.graph().argumentsRegisterFor(inlineCallFrame)).m_type)) {
             speculationCheck(
                 ArgumentsEscaped, JSValueRegs(), 0,
                 m_jit.branch32(
                     JITCompiler::NotEqual,
-                    JITCompiler::tagFor(m_jit.argumentsRegisterFor(node->codeOrigin)),
+                    JITCompiler::tagFor(m_jit.argumentsRegisterFor(inlineCallFrame)),
                     TrustedImm32(JSValue::EmptyValueTag)));
         }
             
         m_jit.add32(TrustedImm32(1), indexGPR, resultPayloadGPR);
             
-        if (node->codeOrigin.inlineCallFrame) {
+        if (inlineCallFrame) {
             speculationCheck(
                 Uncountable, JSValueRegs(), 0,
                 m_jit.branch32(
                     JITCompiler::AboveOrEqual,
                     resultPayloadGPR,
-                    Imm32(node->codeOrigin.inlineCallFrame->arguments.size())));
+                    Imm32(inlineCallFrame->arguments.size())));
         } else {
             speculationCheck(
                 Uncountable, JSValueRegs(), 0,
@@ -4763,11 +4881,11 @@ void SpeculativeJIT::compile(Node* node)
         
         JITCompiler::JumpList slowArgument;
         JITCompiler::JumpList slowArgumentOutOfBounds;
-        if (const SlowArgument* slowArguments = m_jit.symbolTableFor(node->codeOrigin)->slowArguments()) {
+        if (const SlowArgument* slowArguments = m_jit.symbolTableFor(inlineCallFrame)->slowArguments()) {
             slowArgumentOutOfBounds.append(
                 m_jit.branch32(
                     JITCompiler::AboveOrEqual, indexGPR,
-                    Imm32(m_jit.symbolTableFor(node->codeOrigin)->parameterCount())));
+                    Imm32(m_jit.symbolTableFor(inlineCallFrame)->parameterCount())));
 
             COMPILE_ASSERT(sizeof(SlowArgument) == 8, SlowArgument_size_is_eight_bytes);
             m_jit.move(ImmPtr(slowArguments), resultPayloadGPR);
@@ -4780,12 +4898,12 @@ void SpeculativeJIT::compile(Node* node)
             m_jit.load32(
                 JITCompiler::BaseIndex(
                     GPRInfo::callFrameRegister, resultPayloadGPR, JITCompiler::TimesEight,
-                    m_jit.offsetOfLocals(node->codeOrigin) + OBJECT_OFFSETOF(EncodedValueDescriptor, asBits.tag)),
+                    m_jit.offsetOfLocals(inlineCallFrame) + OBJECT_OFFSETOF(EncodedValueDescriptor, asBits.tag)),
                 resultTagGPR);
             m_jit.load32(
                 JITCompiler::BaseIndex(
                     GPRInfo::callFrameRegister, resultPayloadGPR, JITCompiler::TimesEight,
-                    m_jit.offsetOfLocals(node->codeOrigin) + OBJECT_OFFSETOF(EncodedValueDescriptor, asBits.payload)),
+                    m_jit.offsetOfLocals(inlineCallFrame) + OBJECT_OFFSETOF(EncodedValueDescriptor, asBits.payload)),
                 resultPayloadGPR);
             slowArgument.append(m_jit.jump());
         }
@@ -4796,12 +4914,12 @@ void SpeculativeJIT::compile(Node* node)
         m_jit.load32(
             JITCompiler::BaseIndex(
                 GPRInfo::callFrameRegister, resultPayloadGPR, JITCompiler::TimesEight,
-                m_jit.offsetOfArgumentsIncludingThis(node->codeOrigin) + OBJECT_OFFSETOF(EncodedValueDescriptor, asBits.tag)),
+                m_jit.offsetOfArgumentsIncludingThis(inlineCallFrame) + OBJECT_OFFSETOF(EncodedValueDescriptor, asBits.tag)),
             resultTagGPR);
         m_jit.load32(
             JITCompiler::BaseIndex(
                 GPRInfo::callFrameRegister, resultPayloadGPR, JITCompiler::TimesEight,
-                m_jit.offsetOfArgumentsIncludingThis(node->codeOrigin) + OBJECT_OFFSETOF(EncodedValueDescriptor, asBits.payload)),
+                m_jit.offsetOfArgumentsIncludingThis(inlineCallFrame) + OBJECT_OFFSETOF(EncodedValueDescriptor, asBits.payload)),
             resultPayloadGPR);
             
         slowArgument.link(&m_jit);
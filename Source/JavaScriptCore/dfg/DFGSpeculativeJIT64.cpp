@@ -33,7 +33,9 @@
 #include "DFGCallArrayAllocatorSlowPathGenerator.h"
 #include "DFGSlowPathGenerator.h"
 #include "JSCJSValueInlines.h"
+#include "JSPropertyNameIterator.h"
 #include "ObjectPrototype.h"
+#include "StructureChain.h"
 
 namespace JSC { namespace DFG {
 
@@ -1922,6 +1924,11 @@ void SpeculativeJIT::compile(Node* node)
         initConstantInfo(node);
         break;
 
+    case PhantomNewObject:
+        m_jit.addWeakReference(node->structure());
+        initConstantInfo(node);
+        break;
+
     case WeakJSConstant:
         m_jit.addWeakReference(node->weakConstant());
         initConstantInfo(node);
@@ -2068,12 +2075,12 @@ void SpeculativeJIT::compile(Node* node)
 
         recordSetLocal(node->local(), ValueSource(ValueInJSStack));
 
-        // If we're storing an arguments object that has been optimized away,
-        // our variable event stream for OSR exit now reflects the optimized
-        // value (JSValue()). On the slow path, we want an arguments object
-        // instead. We add an additional move hint to show OSR exit that it
-        // needs to reconstruct the arguments object.
-        if (node->child1()->op() == PhantomArguments)
+        // If we're storing an arguments object or an object whose allocation was
+        // sunk, our variable event stream for OSR exit now reflects the optimized
+        // value (JSValue()). On the slow path, we want a real object instead. We
+        // add an additional move hint to show OSR exit that it needs to
+        // reconstruct the object.
+        if (node->child1()->op() == PhantomArguments || node->child1()->op() == PhantomNewObject)
             compileMovHint(node);
 
         break;
@@ -3225,6 +3232,208 @@ void SpeculativeJIT::compile(Node* node)
         break;
     }
         
+    case ToObjectForIn: {
+        JSValueOperand value(this, node->child1());
+        GPRTemporary result(this, value);
+        GPRTemporary scratch(this);
+        
+        GPRReg valueGPR = value.gpr();
+        GPRReg resultGPR = result.gpr();
+        GPRReg scratchGPR = scratch.gpr();
+        
+        value.use();
+        
+        // Objects, undefined and null are passed through; anything else is boxed.
+        MacroAssembler::JumpList slowCases;
+        m_jit.move(valueGPR, resultGPR);
+        MacroAssembler::Jump notCell = m_jit.branchTest64(MacroAssembler::NonZero, valueGPR, GPRInfo::tagMaskRegister);
+        m_jit.loadPtr(MacroAssembler::Address(valueGPR, JSCell::structureOffset()), scratchGPR);
+        slowCases.append(m_jit.branch8(MacroAssembler::Below, MacroAssembler::Address(scratchGPR, Structure::typeInfoTypeOffset()), TrustedImm32(ObjectType)));
+        MacroAssembler::Jump done = m_jit.jump();
+        
+        notCell.link(&m_jit);
+        m_jit.move(valueGPR, scratchGPR);
+        m_jit.and64(MacroAssembler::TrustedImm32(~TagBitUndefined), scratchGPR);
+        slowCases.append(m_jit.branch64(MacroAssembler::NotEqual, scratchGPR, MacroAssembler::TrustedImm64(ValueNull)));
+        
+        done.link(&m_jit);
+        addSlowPathGenerator(
+            slowPathCall(slowCases, this, operationToObjectForIn, resultGPR, valueGPR));
+        
+        jsValueResult(resultGPR, node, UseChildrenCalledExplicitly);
+        break;
+    }
+        
+    case GetPropertyNameIterator: {
+        JSValueOperand base(this, node->child1());
+        GPRReg baseGPR = base.gpr();
+        
+        flushRegisters();
+        GPRResult result(this);
+        callOperation(operationGetPropertyNameIterator, result.gpr(), baseGPR);
+        
+        jsValueResult(result.gpr(), node);
+        break;
+    }
+        
+    case GetPropertyNameIteratorSize: {
+        JSValueOperand iterator(this, node->child1());
+        GPRTemporary result(this);
+        
+        GPRReg iteratorGPR = iterator.gpr();
+        GPRReg resultGPR = result.gpr();
+        
+        // The iterator is null if there is nothing to enumerate.
+        m_jit.move(TrustedImm32(0), resultGPR);
+        MacroAssembler::Jump notCell = m_jit.branchTest64(MacroAssembler::NonZero, iteratorGPR, GPRInfo::tagMaskRegister);
+        m_jit.load32(MacroAssembler::Address(iteratorGPR, OBJECT_OFFSETOF(JSPropertyNameIterator, m_jsStringsSize)), resultGPR);
+        notCell.link(&m_jit);
+        
+        integerResult(resultGPR, node);
+        break;
+    }
+        
+    case NextPropertyNameIndex: {
+        JSValueOperand base(this, node->child1());
+        JSValueOperand iterator(this, node->child2());
+        SpeculateIntegerOperand index(this, node->child3());
+        GPRTemporary result(this);
+        GPRTemporary structure(this);
+        GPRTemporary chain(this);
+        
+        GPRReg baseGPR = base.gpr();
+        GPRReg iteratorGPR = iterator.gpr();
+        GPRReg indexGPR = index.gpr();
+        GPRReg resultGPR = result.gpr();
+        GPRReg structureGPR = structure.gpr();
+        GPRReg chainGPR = chain.gpr();
+        
+        MacroAssembler::JumpList slowCases;
+        
+        m_jit.move(TrustedImm32(0), resultGPR);
+        MacroAssembler::Jump done = m_jit.branch32(MacroAssembler::AboveOrEqual, indexGPR, MacroAssembler::Address(iteratorGPR, OBJECT_OFFSETOF(JSPropertyNameIterator, m_jsStringsSize)));
+        
+        // Indexed properties can be deleted without a structure change, so they are
+        // always checked in the slow path.
+        slowCases.append(m_jit.branch32(MacroAssembler::Below, indexGPR, MacroAssembler::Address(iteratorGPR, OBJECT_OFFSETOF(JSPropertyNameIterator, m_cachedIndexedLength))));
+        
+        m_jit.loadPtr(MacroAssembler::Address(baseGPR, JSCell::structureOffset()), structureGPR);
+        slowCases.append(m_jit.branchPtr(MacroAssembler::NotEqual, structureGPR, MacroAssembler::Address(iteratorGPR, OBJECT_OFFSETOF(JSPropertyNameIterator, m_cachedStructure))));
+        
+        m_jit.loadPtr(MacroAssembler::Address(iteratorGPR, OBJECT_OFFSETOF(JSPropertyNameIterator, m_cachedPrototypeChain)), chainGPR);
+        m_jit.loadPtr(MacroAssembler::Address(chainGPR, OBJECT_OFFSETOF(StructureChain, m_vector)), chainGPR);
+        MacroAssembler::Jump chainMatches = m_jit.branchTestPtr(MacroAssembler::Zero, MacroAssembler::Address(chainGPR));
+        MacroAssembler::Label checkPrototype = m_jit.label();
+        m_jit.load64(MacroAssembler::Address(structureGPR, Structure::prototypeOffset()), structureGPR);
+        slowCases.append(m_jit.branchTest64(MacroAssembler::NonZero, structureGPR, GPRInfo::tagMaskRegister));
+        m_jit.loadPtr(MacroAssembler::Address(structureGPR, JSCell::structureOffset()), structureGPR);
+        slowCases.append(m_jit.branchPtr(MacroAssembler::NotEqual, structureGPR, MacroAssembler::Address(chainGPR)));
+        m_jit.addPtr(TrustedImm32(sizeof(Structure*)), chainGPR);
+        m_jit.branchTestPtr(MacroAssembler::NonZero, MacroAssembler::Address(chainGPR)).linkTo(checkPrototype, &m_jit);
+        chainMatches.link(&m_jit);
+        
+        m_jit.move(indexGPR, resultGPR);
+        m_jit.add32(TrustedImm32(1), resultGPR);
+        
+        done.link(&m_jit);
+        addSlowPathGenerator(
+            slowPathCall(
+                slowCases, this, operationNextPropertyNameIndex, resultGPR,
+                baseGPR, iteratorGPR, indexGPR));
+        
+        integerResult(resultGPR, node);
+        break;
+    }
+        
+    case GetPropertyNameAtIndex: {
+        JSValueOperand iterator(this, node->child1());
+        SpeculateIntegerOperand index(this, node->child2());
+        JSValueOperand oldValue(this, node->child3());
+        GPRTemporary result(this);
+        
+        GPRReg iteratorGPR = iterator.gpr();
+        GPRReg indexGPR = index.gpr();
+        GPRReg resultGPR = result.gpr();
+        
+        m_jit.move(oldValue.gpr(), resultGPR);
+        MacroAssembler::Jump done = m_jit.branchTest32(MacroAssembler::Zero, indexGPR);
+        m_jit.loadPtr(MacroAssembler::Address(iteratorGPR, OBJECT_OFFSETOF(JSPropertyNameIterator, m_jsStrings)), resultGPR);
+        m_jit.load64(MacroAssembler::BaseIndex(resultGPR, indexGPR, MacroAssembler::TimesEight, -static_cast<int>(sizeof(JSValue))), resultGPR);
+        done.link(&m_jit);
+        
+        jsValueResult(resultGPR, node);
+        break;
+    }
+        
+    case GetByValForIn: {
+        JSValueOperand base(this, m_jit.graph().varArgChild(node, 0));
+        JSValueOperand property(this, m_jit.graph().varArgChild(node, 1));
+        JSValueOperand expected(this, m_jit.graph().varArgChild(node, 2));
+        JSValueOperand iterator(this, m_jit.graph().varArgChild(node, 3));
+        SpeculateIntegerOperand index(this, m_jit.graph().varArgChild(node, 4));
+        GPRTemporary result(this);
+        GPRTemporary scratch(this);
+        
+        GPRReg baseGPR = base.gpr();
+        GPRReg propertyGPR = property.gpr();
+        GPRReg iteratorGPR = iterator.gpr();
+        GPRReg indexGPR = index.gpr();
+        GPRReg resultGPR = result.gpr();
+        GPRReg scratchGPR = scratch.gpr();
+        
+        MacroAssembler::JumpList slowCases;
+        MacroAssembler::JumpList done;
+        
+        // The fast paths only apply while the loop's own key is being looked up on an
+        // object that still has the structure the names were cached for.
+        slowCases.append(m_jit.branch64(MacroAssembler::NotEqual, propertyGPR, expected.gpr()));
+        slowCases.append(m_jit.branchTest64(MacroAssembler::NonZero, baseGPR, GPRInfo::tagMaskRegister));
+        m_jit.loadPtr(MacroAssembler::Address(baseGPR, JSCell::structureOffset()), scratchGPR);
+        slowCases.append(m_jit.branchPtr(MacroAssembler::NotEqual, scratchGPR, MacroAssembler::Address(iteratorGPR, OBJECT_OFFSETOF(JSPropertyNameIterator, m_cachedStructure))));
+        
+        m_jit.move(indexGPR, resultGPR);
+        m_jit.sub32(TrustedImm32(1), resultGPR);
+        MacroAssembler::Jump isNamed = m_jit.branch32(MacroAssembler::AboveOrEqual, resultGPR, MacroAssembler::Address(iteratorGPR, OBJECT_OFFSETOF(JSPropertyNameIterator, m_cachedIndexedLength)));
+        
+        // Dense indexed storage: load the element, unless it has become a hole.
+        MacroAssembler::JumpList isDense;
+        m_jit.load8(MacroAssembler::Address(scratchGPR, Structure::indexingTypeOffset()), scratchGPR);
+        m_jit.and32(TrustedImm32(IndexingShapeMask), scratchGPR);
+        isDense.append(m_jit.branch32(MacroAssembler::Equal, scratchGPR, TrustedImm32(Int32Shape)));
+        isDense.append(m_jit.branch32(MacroAssembler::Equal, scratchGPR, TrustedImm32(ContiguousShape)));
+        slowCases.append(m_jit.jump());
+        isDense.link(&m_jit);
+        m_jit.loadPtr(MacroAssembler::Address(baseGPR, JSObject::butterflyOffset()), scratchGPR);
+        slowCases.append(m_jit.branch32(MacroAssembler::AboveOrEqual, resultGPR, MacroAssembler::Address(scratchGPR, Butterfly::offsetOfPublicLength())));
+        m_jit.load64(MacroAssembler::BaseIndex(scratchGPR, resultGPR, MacroAssembler::TimesEight), resultGPR);
+        slowCases.append(m_jit.branchTest64(MacroAssembler::Zero, resultGPR));
+        done.append(m_jit.jump());
+        
+        // Named properties: the slot number is the position of the name after the
+        // indexed ones, and maps to the inline storage first and then out-of-line.
+        isNamed.link(&m_jit);
+        m_jit.sub32(MacroAssembler::Address(iteratorGPR, OBJECT_OFFSETOF(JSPropertyNameIterator, m_cachedIndexedLength)), resultGPR);
+        slowCases.append(m_jit.branch32(MacroAssembler::AboveOrEqual, resultGPR, MacroAssembler::Address(iteratorGPR, OBJECT_OFFSETOF(JSPropertyNameIterator, m_numCacheableSlots))));
+        MacroAssembler::Jump isOutOfLine = m_jit.branch32(MacroAssembler::AboveOrEqual, resultGPR, MacroAssembler::Address(iteratorGPR, OBJECT_OFFSETOF(JSPropertyNameIterator, m_cachedStructureInlineCapacity)));
+        m_jit.zeroExtend32ToPtr(resultGPR, resultGPR);
+        m_jit.load64(MacroAssembler::BaseIndex(baseGPR, resultGPR, MacroAssembler::TimesEight, JSObject::offsetOfInlineStorage()), resultGPR);
+        done.append(m_jit.jump());
+        
+        isOutOfLine.link(&m_jit);
+        m_jit.sub32(MacroAssembler::Address(iteratorGPR, OBJECT_OFFSETOF(JSPropertyNameIterator, m_cachedStructureInlineCapacity)), resultGPR);
+        m_jit.neg32(resultGPR);
+        m_jit.signExtend32ToPtr(resultGPR, resultGPR);
+        m_jit.loadPtr(MacroAssembler::Address(baseGPR, JSObject::butterflyOffset()), scratchGPR);
+        m_jit.load64(MacroAssembler::BaseIndex(scratchGPR, resultGPR, MacroAssembler::TimesEight, -2 * static_cast<int>(sizeof(EncodedJSValue))), resultGPR);
+        
+        done.link(&m_jit);
+        addSlowPathGenerator(
+            slowPathCall(slowCases, this, operationGetByVal, resultGPR, baseGPR, propertyGPR));
+        
+        jsValueResult(resultGPR, node);
+        break;
+    }
+        
     case ToPrimitive: {
         RELEASE_ASSERT(node->child1().useKind() == UntypedUse);
         JSValueOperand op1(this, node->child1());
@@ -4023,6 +4232,14 @@ void SpeculativeJIT::compile(Node* node)
         break;
     }
         
+    case PutStructureHint:
+        compilePutStructureHint(node);
+        break;
+        
+    case PutByOffsetHint:
+        compilePutByOffsetHint(node);
+        break;
+        
     case PutByOffset: {
 #if ENABLE(WRITE_BARRIER_PROFILING)
         SpeculateCellOperand base(this, node->child2());
@@ -4516,19 +4733,20 @@ void SpeculativeJIT::compile(Node* node)
     case GetMyArgumentsLength: {
         GPRTemporary result(this);
         GPRReg resultGPR = result.gpr();
+        InlineCallFrame* inlineCallFrame = node->argumentsCallFrame();
         
         if (!isEmptySpeculation(
                 m_state.variables().operand(
-                    m_jit.graph().argumentsRegisterFor(node->codeOrigin)).m_type)) {
+                    m_jit.graph().argumentsRegisterFor(inlineCallFrame)).m_type)) {
             speculationCheck(
                 ArgumentsEscaped, JSValueRegs(), 0,
                 m_jit.branchTest64(
                     JITCompiler::NonZero,
                     JITCompiler::addressFor(
-                        m_jit.argumentsRegisterFor(node->codeOrigin))));
+                        m_jit.argumentsRegisterFor(inlineCallFrame))));
         }
         
-        RELEASE_ASSERT(!node->codeOrigin.inlineCallFrame);
+        RELEASE_ASSERT(!inlineCallFrame);
         m_jit.load32(JITCompiler::payloadFor(JSStack::ArgumentCount), resultGPR);
         m_jit.sub32(TrustedImm32(1), resultGPR);
         integerResult(resultGPR, node);
@@ -4572,26 +4790,27 @@ void SpeculativeJIT::compile(Node* node)
         GPRTemporary result(this);
         GPRReg indexGPR = index.gpr();
         GPRReg resultGPR = result.gpr();
+        InlineCallFrame* inlineCallFrame = node->argumentsCallFrame();
 
         if (!isEmptySpeculation(
                 m_state.variables().operand(
-                    m_jit.graph().argumentsRegisterFor(node->codeOrigin)).m_type)) {
+                    m_jit.graph().argumentsRegisterFor(inlineCallFrame)).m_type)) {
             speculationCheck(
                 ArgumentsEscaped, JSValueRegs(), 0,
                 m_jit.branchTest64(
                     JITCompiler::NonZero,
                     JITCompiler::addressFor(
-                        m_jit.argumentsRegisterFor(node->codeOrigin))));
+                        m_jit.argumentsRegisterFor(inlineCallFrame))));
         }
 
         m_jit.add32(TrustedImm32(1), indexGPR, resultGPR);
-        if (node->codeOrigin.inlineCallFrame) {
+        if (inlineCallFrame) {
             speculationCheck(
                 Uncountable, JSValueRegs(), 0,
                 m_jit.branch32(
                     JITCompiler::AboveOrEqual,
                     resultGPR,
-                    Imm32(node->codeOrigin.inlineCallFrame->arguments.size())));
+                    Imm32(inlineCallFrame->arguments.size())));
         } else {
             speculationCheck(
                 Uncountable, JSValueRegs(), 0,
@@ -4603,11 +4822,11 @@ void SpeculativeJIT::compile(Node* node)
 
         JITCompiler::JumpList slowArgument;
         JITCompiler::JumpList slowArgumentOutOfBounds;
-        if (const SlowArgument* slowArguments = m_jit.symbolTableFor(node->codeOrigin)->slowArguments()) {
+        if (const SlowArgument* slowArguments = m_jit.symbolTableFor(inlineCallFrame)->slowArguments()) {
             slowArgumentOutOfBounds.append(
                 m_jit.branch32(
                     JITCompiler::AboveOrEqual, indexGPR,
-                    Imm32(m_jit.symbolTableFor(node->codeOrigin)->parameterCount())));
+                    Imm32(m_jit.symbolTableFor(inlineCallFrame)->parameterCount())));
 
             COMPILE_ASSERT(sizeof(SlowArgument) == 8, SlowArgument_size_is_eight_bytes);
             m_jit.move(ImmPtr(slowArguments), resultGPR);
@@ -4619,7 +4838,7 @@ void SpeculativeJIT::compile(Node* node)
             m_jit.signExtend32ToPtr(resultGPR, resultGPR);
             m_jit.load64(
                 JITCompiler::BaseIndex(
-                    GPRInfo::callFrameRegister, resultGPR, JITCompiler::TimesEight, m_jit.offsetOfLocals(node->codeOrigin)),
+                    GPRInfo::callFrameRegister, resultGPR, JITCompiler::TimesEight, m_jit.offsetOfLocals(inlineCallFrame)),
                 resultGPR);
             slowArgument.append(m_jit.jump());
         }
@@ -4630,7 +4849,7 @@ void SpeculativeJIT::compile(Node* node)
             
         m_jit.load64(
             JITCompiler::BaseIndex(
-                GPRInfo::callFrameRegister, resultGPR, JITCompiler::TimesEight, m_jit.offsetOfArgumentsIncludingThis(node->codeOrigin)),
+                GPRInfo::callFrameRegister, resultGPR, JITCompiler::TimesEight, m_jit.offsetOfArgumentsIncludingThis(inlineCallFrame)),
             resultGPR);
 
         slowArgument.link(&m_jit);
@@ -4721,13 +4940,13 @@ void SpeculativeJIT::compile(Node* node)
     case CheckArgumentsNotCreated: {
         ASSERT(!isEmptySpeculation(
             m_state.variables().operand(
-                m_jit.graph().argumentsRegisterFor(node->codeOrigin)).m_type));
+                m_jit.graph().argumentsRegisterFor(node->argumentsCallFrame())).m_type));
         speculationCheck(
             ArgumentsEscaped, JSValueRegs(), 0,
             m_jit.branchTest64(
                 JITCompiler::NonZero,
                 JITCompiler::addressFor(
-                    m_jit.argumentsRegisterFor(node->codeOrigin))));
+                    m_jit.argumentsRegisterFor(node->argumentsCallFrame()))));
         noResult(node);
         break;
     }
@@ -60,6 +60,9 @@ void VariableEvent::dump(PrintStream& out) const
     case SetLocalEvent:
         out.printf("SetLocal(r%d, %s)", operand(), dataFormatToString(dataFormat()));
         break;
+    case ObjectHintEvent:
+        out.print("ObjectHint(", id(), ", ", inlineOffset(), ")");
+        break;
     default:
         RELEASE_ASSERT_NOT_REACHED();
         break;
@@ -65,6 +65,11 @@ enum VariableEventKind {
     // bytecode operand that it's associated with.
     SetLocalEvent,
     
+    // An ObjectHintEvent means that a PutStructureHint or PutByOffsetHint has
+    // changed the state that OSR exit would give to an object whose allocation
+    // was sunk. The hint node itself is in the minified graph.
+    ObjectHintEvent,
+    
     // Used to indicate an uninitialized VariableEvent. Don't use for other
     // purposes.
     InvalidEventKind
@@ -173,6 +178,15 @@ public:
         return event;
     }
     
+    static VariableEvent objectHint(MinifiedID hintID, unsigned inlineOffset = 0)
+    {
+        VariableEvent event;
+        event.m_id = hintID;
+        event.u.virtualReg = inlineOffset;
+        event.m_kind = ObjectHintEvent;
+        return event;
+    }
+    
     VariableEventKind kind() const
     {
         return static_cast<VariableEventKind>(m_kind);
@@ -182,7 +196,8 @@ public:
     {
         ASSERT(m_kind == BirthToFill || m_kind == Fill
                || m_kind == BirthToSpill || m_kind == Spill
-               || m_kind == Death || m_kind == MovHintEvent);
+               || m_kind == Death || m_kind == MovHintEvent
+               || m_kind == ObjectHintEvent);
         return m_id;
     }
     
@@ -239,6 +254,12 @@ public:
         return u.virtualReg;
     }
     
+    unsigned inlineOffset() const
+    {
+        ASSERT(m_kind == ObjectHintEvent);
+        return u.virtualReg;
+    }
+    
     const VariableRepresentation& variableRepresentation() const { return u; }
     
     void dump(PrintStream&) const;
@@ -255,6 +276,8 @@ private:
     //   - The virtual register.
     // For MovHintEvent, SetLocalEvent:
     //   - The bytecode operand.
+    // For ObjectHintEvent:
+    //   - The inline storage slot being stored to, if any.
     // For Death:
     //   - Unused.
     VariableRepresentation u;
@@ -78,9 +78,21 @@ struct MinifiedGenerationInfo {
     }
 };
 
+struct ObjectHintState {
+    ObjectHintState()
+        : structure(0)
+    {
+    }
+    
+    Structure* structure;
+    Vector<MinifiedID> fields; // Indexed by inline offset.
+};
+
+typedef HashMap<MinifiedID, MinifiedGenerationInfo> GenerationInfoMap;
+
 } // namespace
 
-bool VariableEventStream::tryToSetConstantRecovery(ValueRecovery& recovery, CodeBlock* codeBlock, MinifiedNode* node) const
+static bool tryToSetConstantRecovery(ValueRecovery& recovery, CodeBlock* codeBlock, MinifiedNode* node)
 {
     if (!node)
         return false;
@@ -105,9 +117,125 @@ bool VariableEventStream::tryToSetConstantRecovery(ValueRecovery& recovery, Code
     return false;
 }
 
+static ValueRecovery recoveryForNode(
+    CodeBlock* codeBlock, MinifiedGraph& graph, GenerationInfoMap& generationInfos, MinifiedID sourceID)
+{
+    ValueRecovery recovery;
+    MinifiedNode* node = graph.at(sourceID);
+    if (tryToSetConstantRecovery(recovery, codeBlock, node))
+        return recovery;
+    
+    MinifiedGenerationInfo info = generationInfos.get(sourceID);
+    if (info.format == DataFormatNone) {
+        // Try to see if there is an alternate node that would contain the value we want.
+        // There are four possibilities:
+        //
+        // Int32ToDouble: We can use this in place of the original node, but
+        //    we'd rather not; so we use it only if it is the only remaining
+        //    live version.
+        //
+        // ValueToInt32: If the only remaining live version of the value is
+        //    ValueToInt32, then we can use it.
+        //
+        // UInt32ToNumber: If the only live version of the value is a UInt32ToNumber
+        //    then the only remaining uses are ones that want a properly formed number
+        //    rather than a UInt32 intermediate.
+        //
+        // DoubleAsInt32: Same as UInt32ToNumber.
+        //
+        // The reverse of the above: This node could be a UInt32ToNumber, but its
+        //    alternative is still alive. This means that the only remaining uses of
+        //    the number would be fine with a UInt32 intermediate.
+        
+        bool found = false;
+        
+        if (node && node->op() == UInt32ToNumber) {
+            MinifiedID id = node->child1();
+            if (tryToSetConstantRecovery(recovery, codeBlock, graph.at(id)))
+                return recovery;
+            info = generationInfos.get(id);
+            if (info.format != DataFormatNone)
+                found = true;
+        }
+        
+        if (!found) {
+            MinifiedID int32ToDoubleID;
+            MinifiedID valueToInt32ID;
+            MinifiedID uint32ToNumberID;
+            MinifiedID doubleAsInt32ID;
+            
+            GenerationInfoMap::iterator iter = generationInfos.begin();
+            GenerationInfoMap::iterator end = generationInfos.end();
+            for (; iter != end; ++iter) {
+                MinifiedID id = iter->key;
+                node = graph.at(id);
+                if (!node)
+                    continue;
+                if (!node->hasChild1())
+                    continue;
+                if (node->child1() != sourceID)
+                    continue;
+                if (iter->value.format == DataFormatNone)
+                    continue;
+                switch (node->op()) {
+                case Int32ToDouble:
+                case ForwardInt32ToDouble:
+                    int32ToDoubleID = id;
+                    break;
+                case ValueToInt32:
+                    valueToInt32ID = id;
+                    break;
+                case UInt32ToNumber:
+                    uint32ToNumberID = id;
+                    break;
+                case DoubleAsInt32:
+                    doubleAsInt32ID = id;
+                    break;
+                default:
+                    break;
+                }
+            }
+            
+            MinifiedID idToUse;
+            if (!!doubleAsInt32ID)
+                idToUse = doubleAsInt32ID;
+            else if (!!int32ToDoubleID)
+                idToUse = int32ToDoubleID;
+            else if (!!valueToInt32ID)
+                idToUse = valueToInt32ID;
+            else if (!!uint32ToNumberID)
+                idToUse = uint32ToNumberID;
+            
+            if (!!idToUse) {
+                info = generationInfos.get(idToUse);
+                ASSERT(info.format != DataFormatNone);
+                found = true;
+            }
+        }
+        
+        if (!found)
+            return ValueRecovery::constant(jsUndefined());
+    }
+    
+    ASSERT(info.format != DataFormatNone);
+    
+    if (info.filled) {
+        if (info.format == DataFormatDouble)
+            return ValueRecovery::inFPR(info.u.fpr);
+#if USE(JSVALUE32_64)
+        if (info.format & DataFormatJS)
+            return ValueRecovery::inPair(info.u.pair.tagGPR, info.u.pair.payloadGPR);
+#endif
+        return ValueRecovery::inGPR(info.u.gpr, info.format);
+    }
+    
+    return ValueRecovery::displacedInJSStack(static_cast<VirtualRegister>(info.u.virtualReg), info.format);
+}
+
 void VariableEventStream::reconstruct(
     CodeBlock* codeBlock, CodeOrigin codeOrigin, MinifiedGraph& graph,
-    unsigned index, Operands<ValueRecovery>& valueRecoveries) const
+    unsigned index, Operands<ValueRecovery>& valueRecoveries,
+    Vector<ObjectMaterialization>& materializations) const
 {
     ASSERT(codeBlock->getJITType() == JITCode::DFGJIT);
     CodeBlock* baselineCodeBlock = codeBlock->baselineVersion();
@@ -118,6 +246,8 @@ void VariableEventStream::reconstruct(
     else
         numVariables = baselineCodeBlock->m_numCalleeRegisters;
     
+    materializations.clear();
+    
     // Crazy special case: if we're at index == 0 then this must be an argument check
     // failure, in which case all variables are already set up. The recoveries should
     // reflect this.
@@ -139,7 +269,8 @@ void VariableEventStream::reconstruct(
 
     // Step 2: Create a mock-up of the DFG's state and execute the events.
     Operands<ValueSource> operandSources(codeBlock->numParameters(), numVariables);
-    HashMap<MinifiedID, MinifiedGenerationInfo> generationInfos;
+    GenerationInfoMap generationInfos;
+    HashMap<MinifiedID, ObjectHintState> objectStates;
     for (unsigned i = startIndex; i < index; ++i) {
         const VariableEvent& event = at(i);
         switch (event.kind()) {
@@ -156,7 +287,7 @@ void VariableEventStream::reconstruct(
         case Fill:
         case Spill:
         case Death: {
-            HashMap<MinifiedID, MinifiedGenerationInfo>::iterator iter = generationInfos.find(event.id());
+            GenerationInfoMap::iterator iter = generationInfos.find(event.id());
             ASSERT(iter != generationInfos.end());
             iter->value.update(event);
             break;
@@ -169,14 +300,31 @@ void VariableEventStream::reconstruct(
             if (operandSources.hasOperand(event.operand()))
                 operandSources.setOperand(event.operand(), ValueSource::forDataFormat(event.dataFormat()));
             break;
+        case ObjectHintEvent: {
+            MinifiedNode* hint = graph.at(event.id());
+            ASSERT(hint);
+            ObjectHintState& state = objectStates.add(hint->child1(), ObjectHintState()).iterator->value;
+            if (hint->op() == PutStructureHint) {
+                state.structure = hint->structure();
+                break;
+            }
+            ASSERT(hint->op() == PutByOffsetHint);
+            unsigned offset = event.inlineOffset();
+            if (offset >= state.fields.size())
+                state.fields.resize(offset + 1);
+            state.fields[offset] = hint->child2();
+            break;
+        }
         default:
             RELEASE_ASSERT_NOT_REACHED();
             break;
         }
     }
     
-    // Step 3: Compute value recoveries!
+    // Step 3: Compute value recoveries! Operands that refer to a sunk allocation share
+    // a single materialization per object.
     valueRecoveries = Operands<ValueRecovery>(codeBlock->numParameters(), numVariables);
+    HashMap<MinifiedID, unsigned> materializationIndices;
     for (unsigned i = 0; i < operandSources.size(); ++i) {
         ValueSource& source = operandSources[i];
         if (source.isTriviallyRecoverable()) {
@@ -186,122 +334,27 @@ void VariableEventStream::reconstruct(
         
         ASSERT(source.kind() == HaveNode);
         MinifiedNode* node = graph.at(source.id());
-        if (tryToSetConstantRecovery(valueRecoveries[i], codeBlock, node))
+        if (!node || node->op() != PhantomNewObject) {
+            valueRecoveries[i] = recoveryForNode(codeBlock, graph, generationInfos, source.id());
             continue;
-        
-        MinifiedGenerationInfo info = generationInfos.get(source.id());
-        if (info.format == DataFormatNone) {
-            // Try to see if there is an alternate node that would contain the value we want.
-            // There are four possibilities:
-            //
-            // Int32ToDouble: We can use this in place of the original node, but
-            //    we'd rather not; so we use it only if it is the only remaining
-            //    live version.
-            //
-            // ValueToInt32: If the only remaining live version of the value is
-            //    ValueToInt32, then we can use it.
-            //
-            // UInt32ToNumber: If the only live version of the value is a UInt32ToNumber
-            //    then the only remaining uses are ones that want a properly formed number
-            //    rather than a UInt32 intermediate.
-            //
-            // DoubleAsInt32: Same as UInt32ToNumber.
-            //
-            // The reverse of the above: This node could be a UInt32ToNumber, but its
-            //    alternative is still alive. This means that the only remaining uses of
-            //    the number would be fine with a UInt32 intermediate.
-            
-            bool found = false;
-            
-            if (node && node->op() == UInt32ToNumber) {
-                MinifiedID id = node->child1();
-                if (tryToSetConstantRecovery(valueRecoveries[i], codeBlock, graph.at(id)))
-                    continue;
-                info = generationInfos.get(id);
-                if (info.format != DataFormatNone)
-                    found = true;
-            }
-            
-            if (!found) {
-                MinifiedID int32ToDoubleID;
-                MinifiedID valueToInt32ID;
-                MinifiedID uint32ToNumberID;
-                MinifiedID doubleAsInt32ID;
-                
-                HashMap<MinifiedID, MinifiedGenerationInfo>::iterator iter = generationInfos.begin();
-                HashMap<MinifiedID, MinifiedGenerationInfo>::iterator end = generationInfos.end();
-                for (; iter != end; ++iter) {
-                    MinifiedID id = iter->key;
-                    node = graph.at(id);
-                    if (!node)
-                        continue;
-                    if (!node->hasChild1())
-                        continue;
-                    if (node->child1() != source.id())
-                        continue;
-                    if (iter->value.format == DataFormatNone)
-                        continue;
-                    switch (node->op()) {
-                    case Int32ToDouble:
-                    case ForwardInt32ToDouble:
-                        int32ToDoubleID = id;
-                        break;
-                    case ValueToInt32:
-                        valueToInt32ID = id;
-                        break;
-                    case UInt32ToNumber:
-                        uint32ToNumberID = id;
-                        break;
-                    case DoubleAsInt32:
-                        doubleAsInt32ID = id;
-                        break;
-                    default:
-                        break;
-                    }
-                }
-                
-                MinifiedID idToUse;
-                if (!!doubleAsInt32ID)
-                    idToUse = doubleAsInt32ID;
-                else if (!!int32ToDoubleID)
-                    idToUse = int32ToDoubleID;
-                else if (!!valueToInt32ID)
-                    idToUse = valueToInt32ID;
-                else if (!!uint32ToNumberID)
-                    idToUse = uint32ToNumberID;
-                
-                if (!!idToUse) {
-                    info = generationInfos.get(idToUse);
-                    ASSERT(info.format != DataFormatNone);
-                    found = true;
-                }
-            }
-            
-            if (!found) {
-                valueRecoveries[i] = ValueRecovery::constant(jsUndefined());
-                continue;
-            }
         }
         
-        ASSERT(info.format != DataFormatNone);
-        
-        if (info.filled) {
-            if (info.format == DataFormatDouble) {
-                valueRecoveries[i] = ValueRecovery::inFPR(info.u.fpr);
-                continue;
-            }
-#if USE(JSVALUE32_64)
-            if (info.format & DataFormatJS) {
-                valueRecoveries[i] = ValueRecovery::inPair(info.u.pair.tagGPR, info.u.pair.payloadGPR);
-                continue;
+        HashMap<MinifiedID, unsigned>::AddResult result = materializationIndices.add(source.id(), materializations.size());
+        if (result.isNewEntry) {
+            ObjectHintState state = objectStates.get(source.id());
+            ObjectMaterialization materialization;
+            materialization.structure = state.structure ? state.structure : node->structure();
+            unsigned numberOfFields = materialization.structure->inlineSize();
+            materialization.fields.resize(numberOfFields);
+            for (unsigned fieldIndex = 0; fieldIndex < numberOfFields; ++fieldIndex) {
+                if (fieldIndex < state.fields.size() && !!state.fields[fieldIndex])
+                    materialization.fields[fieldIndex] = recoveryForNode(codeBlock, graph, generationInfos, state.fields[fieldIndex]);
+                else
+                    materialization.fields[fieldIndex] = ValueRecovery::constant(jsUndefined());
             }
-#endif
-            valueRecoveries[i] = ValueRecovery::inGPR(info.u.gpr, info.format);
-            continue;
+            materializations.append(materialization);
         }
-        
-        valueRecoveries[i] =
-            ValueRecovery::displacedInJSStack(static_cast<VirtualRegister>(info.u.virtualReg), info.format);
+        valueRecoveries[i] = ValueRecovery::objectThatWasNotCreated(result.iterator->value);
     }
     
     // Step 4: Make sure that for locals that coincide with true call frame headers, the exit compiler knows
@@ -34,10 +34,18 @@
 #include "DFGMinifiedGraph.h"
 #include "DFGVariableEvent.h"
 #include "Operands.h"
+#include "ValueRecovery.h"
 #include <wtf/Vector.h>
 
 namespace JSC { namespace DFG {
 
+// Describes an object whose allocation was sunk, and that OSR exit must allocate
+// and fill in because some bytecode operand still refers to it.
+struct ObjectMaterialization {
+    Structure* structure;
+    Vector<ValueRecovery> fields; // One per inline storage slot.
+};
+
 class VariableEventStream : public Vector<VariableEvent> {
 public:
     void appendAndLog(const VariableEvent& event)
@@ -50,11 +58,9 @@ public:
     
     void reconstruct(
         CodeBlock*, CodeOrigin, MinifiedGraph&,
-        unsigned index, Operands<ValueRecovery>&) const;
+        unsigned index, Operands<ValueRecovery>&, Vector<ObjectMaterialization>&) const;
 
 private:
-    bool tryToSetConstantRecovery(ValueRecovery&, CodeBlock*, MinifiedNode*) const;
-    
     void logEvent(const VariableEvent&);
 };
 
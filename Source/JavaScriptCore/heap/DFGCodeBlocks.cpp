@@ -89,6 +89,17 @@ void DFGCodeBlocks::traceMarkedCodeBlocks(SlotVisitor& visitor)
     }
 }
 
+void DFGCodeBlocks::gatherInlinedExecutables(HashSet<ExecutableBase*>& executables)
+{
+    for (HashSet<CodeBlock*>::iterator iter = m_set.begin(); iter != m_set.end(); ++iter) {
+        if (!(*iter)->m_rareData)
+            continue;
+        SegmentedVector<InlineCallFrame, 4>& inlineCallFrames = (*iter)->m_rareData->m_inlineCallFrames;
+        for (size_t i = 0; i < inlineCallFrames.size(); ++i)
+            executables.add(inlineCallFrames[i].executable.get());
+    }
+}
+
 #else // ENABLE(DFG_JIT)
 
 void DFGCodeBlocks::jettison(PassOwnPtr<CodeBlock>)
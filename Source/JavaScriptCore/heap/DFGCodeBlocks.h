@@ -33,6 +33,7 @@
 namespace JSC {
 
 class CodeBlock;
+class ExecutableBase;
 class SlotVisitor;
 
 // DFGCodeBlocks notifies the garbage collector about optimized code blocks that
@@ -75,6 +76,11 @@ public:
     // Trace all marked code blocks (i.e. are referenced from call frames). The CodeBlock
     // is free to make use of m_dfgData->isMarked and m_dfgData->isJettisoned.
     void traceMarkedCodeBlocks(SlotVisitor&);
+    
+    // Add the executables of all functions that have been inlined into some DFG code
+    // block. OSR exit from that code rebuilds their frames using their baseline code
+    // blocks, so those must not be thrown away while the DFG code block lives.
+    void gatherInlinedExecutables(HashSet<ExecutableBase*>&);
 
 private:
     friend class CodeBlock;
@@ -91,6 +97,7 @@ public:
     void mark(void*) { }
     void deleteUnmarkedJettisonedCodeBlocks() { }
     void traceMarkedCodeBlocks(SlotVisitor&) { }
+    void gatherInlinedExecutables(HashSet<ExecutableBase*>&) { }
 };
 #endif
 
@@ -26,6 +26,7 @@
 #include "CopiedSpace.h"
 #include "CopiedSpaceInlines.h"
 #include "CopyVisitorInlines.h"
+#include "ExecutableAllocator.h"
 #include "GCActivityCallback.h"
 #include "HeapRootVisitor.h"
 #include "HeapStatistics.h"
@@ -262,6 +263,7 @@ Heap::Heap(VM* vm, HeapType heapType)
     , m_vm(vm)
     , m_lastGCLength(0)
     , m_lastCodeDiscardTime(WTF::currentTime())
+    , m_lastColdCodeCheckTime(WTF::currentTime())
     , m_activityCallback(DefaultGCActivityCallback::create(this))
     , m_sweeper(IncrementalSweeper::create(this))
 {
@@ -689,6 +691,61 @@ void Heap::deleteUnmarkedCompiledCode()
     m_jitStubRoutines.deleteUnmarkedJettisonedStubRoutines();
 }
 
+void Heap::deleteColdCompiledCode()
+{
+#if ENABLE(JIT)
+    // Function code that was not entered since the previous check is thrown away when
+    // executable memory is scarce or fragmented; the function starts over in the LLInt
+    // and tiers up again if it gets hot. This keeps a long-running page from slowly
+    // filling the pool with code it no longer runs.
+    bool shouldEvict = Options::alwaysEvictColdCode() || ExecutableAllocator::underMemoryPressure() || ExecutableAllocator::isFragmented();
+
+    // Code that may be running has to stay. Every JS frame holds its callee, so scanning the
+    // JS stack finds the functions that are running, like VM::releaseExecutableMemory() does.
+    // Functions inlined into DFG code have to stay too, since OSR exit needs their baseline
+    // code blocks.
+    HashSet<ExecutableBase*> mayBeNeeded;
+    if (shouldEvict) {
+        if (m_vm->dynamicGlobalObject) {
+            HashSet<JSCell*> roots;
+            getConservativeRegisterRoots(roots);
+            for (HashSet<JSCell*>::iterator iter = roots.begin(); iter != roots.end(); ++iter) {
+                JSCell* cell = *iter;
+                if (cell->inherits(&FunctionExecutable::s_info))
+                    mayBeNeeded.add(jsCast<FunctionExecutable*>(cell));
+                else if (cell->inherits(&JSFunction::s_info) && !jsCast<JSFunction*>(cell)->isHostFunction())
+                    mayBeNeeded.add(jsCast<JSFunction*>(cell)->jsExecutable());
+            }
+        }
+        m_dfgCodeBlocks.gatherInlinedExecutables(mayBeNeeded);
+    }
+
+    unsigned evictedCount = 0;
+    for (ExecutableBase* current = m_compiledCode.head(); current; current = current->next()) {
+        if (!current->isFunctionExecutable())
+            continue;
+        FunctionExecutable* executable = static_cast<FunctionExecutable*>(current);
+        // This resets the entry flags even if nothing is evicted, so that each check only
+        // looks at the interval since the previous one.
+        if (!executable->isColdSinceLastCheck() || !shouldEvict || mayBeNeeded.contains(executable))
+            continue;
+        executable->unlinkIncomingCalls();
+        executable->clearCodeIfNotCompiling();
+        evictedCount++;
+    }
+
+    if (Options::logColdCodeEviction()) {
+#if ENABLE(EXECUTABLE_ALLOCATOR_FIXED)
+        WTF::MetaAllocator::Statistics statistics = ExecutableAllocator::currentStatistics();
+        dataLogF("Cold code check: evicted %u functions; executable memory: %zu bytes allocated of %zu, %zu free chunks, largest %zu bytes\n",
+            evictedCount, statistics.bytesAllocated, statistics.bytesReserved, statistics.numberOfFreeChunks, statistics.largestFreeChunkSize);
+#else
+        dataLogF("Cold code check: evicted %u functions\n", evictedCount);
+#endif
+    }
+#endif // ENABLE(JIT)
+}
+
 void Heap::collectAllGarbage()
 {
     if (!m_isSafeToCollect)
@@ -713,6 +770,12 @@ void Heap::collect(SweepToggle sweepToggle)
 
     m_activityCallback->willCollect();
 
+#if ENABLE(SAMPLING_PROFILER)
+    // Samples name CodeBlocks that this collection may destroy, so resolve them first.
+    if (m_vm->m_samplingProfiler)
+        m_vm->m_samplingProfiler->processPendingSamples();
+#endif
+
     double lastGCStartTime = WTF::currentTime();
     if (lastGCStartTime - m_lastCodeDiscardTime > minute) {
         deleteAllCompiledCode();
@@ -724,6 +787,12 @@ void Heap::collect(SweepToggle sweepToggle)
         m_objectSpace.canonicalizeCellLivenessData();
     }
 
+    if (Options::useColdCodeEviction() && lastGCStartTime - m_lastColdCodeCheckTime > Options::coldCodeEvictionIntervalSeconds()) {
+        GCPHASE(DeleteColdCode);
+        deleteColdCompiledCode();
+        m_lastColdCodeCheckTime = WTF::currentTime();
+    }
+
     markRoots();
     
     {
@@ -751,6 +820,11 @@ void Heap::collect(SweepToggle sweepToggle)
         m_vm->smallStrings.finalizeSmallStrings();
     }
 
+    {
+        GCPHASE(FinalizeNumericStrings);
+        m_vm->numericStrings.finalizeJSStrings();
+    }
+
     {
         GCPHASE(DeleteCodeBlocks);
         deleteUnmarkedCompiledCode();
@@ -137,6 +137,7 @@ namespace JSC {
 
         JS_EXPORT_PRIVATE void protect(JSValue);
         JS_EXPORT_PRIVATE bool unprotect(JSValue); // True when the protect count drops to 0.
+        bool hasProtectedValues() const { return !m_protectedValues.isEmpty(); }
         
         void jettisonDFGCodeBlock(PassOwnPtr<CodeBlock>);
 
@@ -217,6 +218,7 @@ namespace JSC {
         void harvestWeakReferences();
         void finalizeUnconditionalFinalizers();
         void deleteUnmarkedCompiledCode();
+        void deleteColdCompiledCode();
         void zombifyDeadObjects();
         void markDeadObjects();
 
@@ -262,6 +264,7 @@ namespace JSC {
         VM* m_vm;
         double m_lastGCLength;
         double m_lastCodeDiscardTime;
+        double m_lastColdCodeCheckTime;
 
         DoublyLinkedList<ExecutableBase> m_compiledCode;
         
@@ -30,6 +30,9 @@
 #include "JSObject.h"
 #include "Operations.h"
 #include "Options.h"
+#include "PropertyMapHashTable.h"
+#include "Structure.h"
+#include "StructureRareData.h"
 #include <stdlib.h>
 #if OS(UNIX)
 #include <sys/resource.h>
@@ -227,6 +230,69 @@ inline size_t StorageStatistics::storageCapacity()
     return m_storageCapacity;
 }
 
+class StructureStatistics : public MarkedBlock::VoidFunctor {
+public:
+    StructureStatistics();
+
+    void operator()(JSCell*);
+
+    size_t structureCount() { return m_structureCount; }
+    size_t dictionaryCount() { return m_dictionaryCount; }
+    size_t structureBytes() { return m_structureBytes; }
+    size_t transitionTableBytes() { return m_transitionTableBytes; }
+    size_t propertyTableCount() { return m_propertyTableCount; }
+    size_t propertyTableBytes() { return m_propertyTableBytes; }
+    size_t rareDataCount() { return m_rareDataCount; }
+    size_t rareDataBytes() { return m_rareDataBytes; }
+
+private:
+    size_t m_structureCount;
+    size_t m_dictionaryCount;
+    size_t m_structureBytes;
+    size_t m_transitionTableBytes;
+    size_t m_propertyTableCount;
+    size_t m_propertyTableBytes;
+    size_t m_rareDataCount;
+    size_t m_rareDataBytes;
+};
+
+inline StructureStatistics::StructureStatistics()
+    : m_structureCount(0)
+    , m_dictionaryCount(0)
+    , m_structureBytes(0)
+    , m_transitionTableBytes(0)
+    , m_propertyTableCount(0)
+    , m_propertyTableBytes(0)
+    , m_rareDataCount(0)
+    , m_rareDataBytes(0)
+{
+}
+
+inline void StructureStatistics::operator()(JSCell* cell)
+{
+    const ClassInfo* classInfo = cell->classInfo();
+    if (classInfo == &Structure::s_info) {
+        Structure* structure = jsCast<Structure*>(cell);
+        ++m_structureCount;
+        if (structure->isDictionary())
+            ++m_dictionaryCount;
+        m_structureBytes += MarkedBlock::blockFor(cell)->cellSize();
+        m_transitionTableBytes += structure->transitionTableSizeInMemory();
+        return;
+    }
+
+    if (classInfo == &PropertyTable::s_info) {
+        ++m_propertyTableCount;
+        m_propertyTableBytes += jsCast<PropertyTable*>(cell)->sizeInMemory();
+        return;
+    }
+
+    if (classInfo == &StructureRareData::s_info) {
+        ++m_rareDataCount;
+        m_rareDataBytes += MarkedBlock::blockFor(cell)->cellSize();
+    }
+}
+
 void HeapStatistics::showObjectStatistics(Heap* heap)
 {
     dataLogF("\n=== Heap Statistics: ===\n");
@@ -249,6 +315,16 @@ void HeapStatistics::showObjectStatistics(Heap* heap)
     }
     dataLogF("wasted .property storage: %ldkB (%ld%%)\n", wastedPropertyStorageBytes, wastedPropertyStoragePercent);
     dataLogF("objects with out-of-line .property storage: %ld (%ld%%)\n", objectWithOutOfLineStorageCount, objectsWithOutOfLineStoragePercent);
+
+    StructureStatistics structureStatistics;
+    heap->m_objectSpace.forEachLiveCell(structureStatistics);
+    dataLogF("structures: %ld (%ld dictionaries), %ldkB\n", static_cast<long>(structureStatistics.structureCount()),
+        static_cast<long>(structureStatistics.dictionaryCount()), static_cast<long>(structureStatistics.structureBytes() / KB));
+    dataLogF("structure transition tables: %ldkB\n", static_cast<long>(structureStatistics.transitionTableBytes() / KB));
+    dataLogF("property tables: %ld, %ldkB\n", static_cast<long>(structureStatistics.propertyTableCount()),
+        static_cast<long>(structureStatistics.propertyTableBytes() / KB));
+    dataLogF("structure rare data: %ld, %ldkB\n", static_cast<long>(structureStatistics.rareDataCount()),
+        static_cast<long>(structureStatistics.rareDataBytes() / KB));
 }
 
 } // namespace JSC
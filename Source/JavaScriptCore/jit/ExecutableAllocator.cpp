@@ -212,6 +212,12 @@ double ExecutableAllocator::memoryPressureMultiplier(size_t addedMemoryUsage)
 
 }
 
+bool ExecutableAllocator::isFragmented()
+{
+    // The demand allocator maps more memory when it runs out of large chunks.
+    return false;
+}
+
 PassRefPtr<ExecutableMemoryHandle> ExecutableAllocator::allocate(VM&, size_t sizeInBytes, void* ownerUID, JITCompilationEffort effort)
 {
     RefPtr<ExecutableMemoryHandle> result = allocator()->allocate(sizeInBytes, ownerUID);
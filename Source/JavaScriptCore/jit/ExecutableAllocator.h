@@ -127,6 +127,14 @@ public:
     static bool underMemoryPressure();
     
     static double memoryPressureMultiplier(size_t addedMemoryUsage);
+
+    // True when the free executable memory is split up so badly that large compilations
+    // are likely to fail even though the pool as a whole is not full.
+    static bool isFragmented();
+
+#if ENABLE(EXECUTABLE_ALLOCATOR_FIXED)
+    static WTF::MetaAllocator::Statistics currentStatistics();
+#endif
     
 #if ENABLE(META_ALLOCATOR_PROFILE)
     static void dumpProfile();
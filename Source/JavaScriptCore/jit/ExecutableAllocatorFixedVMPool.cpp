@@ -155,6 +155,21 @@ double ExecutableAllocator::memoryPressureMultiplier(size_t addedMemoryUsage)
     return result;
 }
 
+bool ExecutableAllocator::isFragmented()
+{
+    // Code is allocated in many sizes and freed in no particular order, so over time the
+    // free space turns into a sea of small holes. Once the biggest hole holds less than a
+    // quarter of the free space, most of that space is out of reach of a large compilation.
+    MetaAllocator::Statistics statistics = allocator->currentStatistics();
+    size_t bytesFree = statistics.bytesReserved - statistics.bytesAllocated;
+    return statistics.largestFreeChunkSize < bytesFree / 4;
+}
+
+MetaAllocator::Statistics ExecutableAllocator::currentStatistics()
+{
+    return allocator->currentStatistics();
+}
+
 PassRefPtr<ExecutableMemoryHandle> ExecutableAllocator::allocate(VM& vm, size_t sizeInBytes, void* ownerUID, JITCompilationEffort effort)
 {
     RefPtr<ExecutableMemoryHandle> result = allocator->allocate(sizeInBytes, ownerUID);
@@ -620,6 +620,9 @@ JITCode JIT::privateCompile(CodePtr* functionEntryArityCheck, JITCompilationEffo
 
     Jump stackCheck;
     if (m_codeBlock->codeType() == FunctionCode) {
+        if (Options::useColdCodeEviction())
+            store8(TrustedImm32(1), m_codeBlock->addressOfWasEnteredRecently());
+
 #if ENABLE(DFG_JIT)
 #if DFG_ENABLE(SUCCESS_STATS)
         static SamplingCounter counter("orignalJIT");
@@ -53,8 +53,11 @@ inline bool jitCompileIfAppropriate(ExecState* exec, OwnPtr<CodeBlockType>& code
     JITCode oldJITCode = jitCode;
     
     bool dfgCompiled = false;
-    if (jitType == JITCode::DFGJIT)
+    if (jitType == JITCode::DFGJIT) {
         dfgCompiled = DFG::tryCompile(exec, codeBlock.get(), jitCode, bytecodeIndex);
+        if (Profiler::TierUpTelemetry* telemetry = vm.enabledTierUpTelemetry())
+            telemetry->notifyDFGCompilation(codeBlock.get(), dfgCompiled, bytecodeIndex);
+    }
     if (dfgCompiled) {
         if (codeBlock->alternative())
             codeBlock->alternative()->unlinkIncomingCalls();
@@ -69,6 +72,8 @@ inline bool jitCompileIfAppropriate(ExecState* exec, OwnPtr<CodeBlockType>& code
             jitCode = oldJITCode;
             return false;
         }
+        if (Profiler::TierUpTelemetry* telemetry = vm.enabledTierUpTelemetry())
+            telemetry->notifyBaselineCompilation(codeBlock.get());
     }
     codeBlock->setJITCode(jitCode, MacroAssemblerCodePtr());
     
@@ -91,8 +96,11 @@ inline bool jitCompileFunctionIfAppropriate(ExecState* exec, OwnPtr<FunctionCode
     MacroAssemblerCodePtr oldJITCodeWithArityCheck = jitCodeWithArityCheck;
     
     bool dfgCompiled = false;
-    if (jitType == JITCode::DFGJIT)
+    if (jitType == JITCode::DFGJIT) {
         dfgCompiled = DFG::tryCompileFunction(exec, codeBlock.get(), jitCode, jitCodeWithArityCheck, bytecodeIndex);
+        if (Profiler::TierUpTelemetry* telemetry = vm.enabledTierUpTelemetry())
+            telemetry->notifyDFGCompilation(codeBlock.get(), dfgCompiled, bytecodeIndex);
+    }
     if (dfgCompiled) {
         if (codeBlock->alternative())
             codeBlock->alternative()->unlinkIncomingCalls();
@@ -109,6 +117,8 @@ inline bool jitCompileFunctionIfAppropriate(ExecState* exec, OwnPtr<FunctionCode
             jitCodeWithArityCheck = oldJITCodeWithArityCheck;
             return false;
         }
+        if (Profiler::TierUpTelemetry* telemetry = vm.enabledTierUpTelemetry())
+            telemetry->notifyBaselineCompilation(codeBlock.get());
     }
     codeBlock->setJITCode(jitCode, jitCodeWithArityCheck);
     
@@ -927,6 +927,10 @@ void JIT::emit_op_next_pname(Instruction* currentInstruction)
     loadPtr(Address(regT0, JSCell::structureOffset()), regT2);
     callHasProperty.append(branchPtr(NotEqual, regT2, Address(Address(regT1, OBJECT_OFFSETOF(JSPropertyNameIterator, m_cachedStructure)))));
 
+    // Indexed properties can be deleted without a structure change.
+    load32(intPayloadFor(i), regT3);
+    callHasProperty.append(branch32(BelowOrEqual, regT3, Address(regT1, OBJECT_OFFSETOF(JSPropertyNameIterator, m_cachedIndexedLength))));
+
     // Test base's prototype chain
     loadPtr(Address(Address(regT1, OBJECT_OFFSETOF(JSPropertyNameIterator, m_cachedPrototypeChain))), regT3);
     loadPtr(Address(regT3, OBJECT_OFFSETOF(StructureChain, m_vector)), regT3);
@@ -3260,11 +3260,7 @@ DEFINE_STUB_FUNCTION(JSPropertyNameIterator*, op_get_pnames)
 
     CallFrame* callFrame = stackFrame.callFrame;
     JSObject* o = stackFrame.args[0].jsObject();
-    Structure* structure = o->structure();
-    JSPropertyNameIterator* jsPropertyNameIterator = structure->enumerationCache();
-    if (!jsPropertyNameIterator || jsPropertyNameIterator->cachedPrototypeChain() != structure->prototypeChain(callFrame))
-        jsPropertyNameIterator = JSPropertyNameIterator::create(callFrame, o);
-    return jsPropertyNameIterator;
+    return JSPropertyNameIterator::forObject(callFrame, o);
 }
 
 DEFINE_STUB_FUNCTION(int, has_property)
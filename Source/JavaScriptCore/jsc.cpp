@@ -139,6 +139,7 @@ public:
         , m_dump(false)
         , m_exitCode(false)
         , m_profile(false)
+        , m_sample(false)
     {
         parseArguments(argc, argv);
     }
@@ -150,6 +151,8 @@ public:
     Vector<String> m_arguments;
     bool m_profile;
     String m_profilerOutput;
+    bool m_sample;
+    String m_samplerOutput;
 
     void parseArguments(int, char**);
 };
@@ -701,6 +704,9 @@ static NO_RETURN void printUsageStatement(bool help = false)
     fprintf(stderr, "  -s         Installs signal handlers that exit on a crash (Unix platforms only)\n");
 #endif
     fprintf(stderr, "  -p <file>  Outputs profiling data to a file\n");
+#if ENABLE(SAMPLING_PROFILER)
+    fprintf(stderr, "  -S <file>  Samples the running script and outputs folded stacks to a file\n");
+#endif
     fprintf(stderr, "  -x         Output exit code before terminating\n");
     fprintf(stderr, "\n");
     fprintf(stderr, "  --options                  Dumps all JSC VM options and exits\n");
@@ -746,6 +752,15 @@ void CommandLine::parseArguments(int argc, char** argv)
             m_profilerOutput = argv[i];
             continue;
         }
+#if ENABLE(SAMPLING_PROFILER)
+        if (!strcmp(arg, "-S")) {
+            if (++i == argc)
+                printUsageStatement();
+            m_sample = true;
+            m_samplerOutput = argv[i];
+            continue;
+        }
+#endif
         if (!strcmp(arg, "-s")) {
 #if HAVE(SIGNAL_H)
             signal(SIGILL, _exit);
@@ -811,6 +826,14 @@ int jscmain(int argc, char** argv)
 
     if (options.m_profile && !vm->m_perBytecodeProfiler)
         vm->m_perBytecodeProfiler = adoptPtr(new Profiler::Database(*vm));
+
+#if ENABLE(SAMPLING_PROFILER)
+    if (options.m_sample) {
+        if (!vm->m_samplingProfiler)
+            vm->m_samplingProfiler = adoptPtr(new SamplingProfiler(*vm));
+        vm->m_samplingProfiler->start();
+    }
+#endif
     
     GlobalObject* globalObject = GlobalObject::create(*vm, GlobalObject::createStructure(*vm, jsNull()), options.m_arguments);
     bool success = runWithScripts(globalObject, options.m_scripts, options.m_dump);
@@ -827,6 +850,16 @@ int jscmain(int argc, char** argv)
             fprintf(stderr, "could not save profiler output.\n");
     }
 
+#if ENABLE(SAMPLING_PROFILER)
+    if (options.m_sample) {
+        SamplingProfiler& samplingProfiler = *vm->m_samplingProfiler;
+        samplingProfiler.stop();
+        samplingProfiler.processPendingSamples();
+        if (!samplingProfiler.saveFoldedStacks(options.m_samplerOutput.utf8().data()))
+            fprintf(stderr, "could not save sampling profiler output.\n");
+    }
+#endif
+
     return result;
 }
 
@@ -1263,6 +1263,7 @@ _llint_op_get_by_pname:
     loadi 24[PC], t0
     loadi [cfr, t0, 8], t0
     subi 1, t0
+    subi JSPropertyNameIterator::m_cachedIndexedLength[t3], t0
     biaeq t0, JSPropertyNameIterator::m_numCacheableSlots[t3], .opGetByPnameSlow
     bilt t0, JSPropertyNameIterator::m_cachedStructureInlineCapacity[t3], .opGetByPnameInlineProperty
     addi firstOutOfLineOffset, t0
@@ -1272,11 +1273,13 @@ _llint_op_get_by_pname:
     loadi 4[PC], t0
     storei t1, TagOffset[cfr, t0, 8]
     storei t3, PayloadOffset[cfr, t0, 8]
-    dispatch(7)
+    loadi 28[PC], t0
+    valueProfile(t1, t3, t0)
+    dispatch(8)
 
 .opGetByPnameSlow:
     callSlowPath(_llint_slow_path_get_by_pname)
-    dispatch(7)
+    dispatch(8)
 
 
 macro contiguousPutByVal(storeCallback)
@@ -1702,6 +1705,7 @@ _llint_op_next_pname:
     loadi PayloadOffset[cfr, t3, 8], t3
     loadp JSCell::m_structure[t3], t1
     bpneq t1, JSPropertyNameIterator::m_cachedStructure[t2], .opNextPnameSlow
+    bilteq t0, JSPropertyNameIterator::m_cachedIndexedLength[t2], .opNextPnameSlow
     loadp JSPropertyNameIterator::m_cachedPrototypeChain[t2], t0
     loadp StructureChain::m_vector[t0], t0
     btpz [t0], .opNextPnameTarget
@@ -1101,6 +1101,7 @@ _llint_op_get_by_pname:
     loadisFromInstruction(6, t3)
     loadi PayloadOffset[cfr, t3, 8], t3
     subi 1, t3
+    subi JSPropertyNameIterator::m_cachedIndexedLength[t1], t3
     biaeq t3, JSPropertyNameIterator::m_numCacheableSlots[t1], .opGetByPnameSlow
     bilt t3, JSPropertyNameIterator::m_cachedStructureInlineCapacity[t1], .opGetByPnameInlineProperty
     addi firstOutOfLineOffset, t3
@@ -1109,11 +1110,13 @@ _llint_op_get_by_pname:
     loadPropertyAtVariableOffset(t3, t0, t0)
     loadisFromInstruction(1, t1)
     storeq t0, [cfr, t1, 8]
-    dispatch(7)
+    loadpFromInstruction(7, t1)
+    valueProfile(t0, t1)
+    dispatch(8)
 
 .opGetByPnameSlow:
     callSlowPath(_llint_slow_path_get_by_pname)
-    dispatch(7)
+    dispatch(8)
 
 
 macro contiguousPutByVal(storeCallback)
@@ -1538,6 +1541,7 @@ _llint_op_next_pname:
     loadq [cfr, t3, 8], t3
     loadp JSCell::m_structure[t3], t1
     bpneq t1, JSPropertyNameIterator::m_cachedStructure[t2], .opNextPnameSlow
+    bilteq t0, JSPropertyNameIterator::m_cachedIndexedLength[t2], .opNextPnameSlow
     loadp JSPropertyNameIterator::m_cachedPrototypeChain[t2], t0
     loadp StructureChain::m_vector[t0], t0
     btpz [t0], .opNextPnameTarget
@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ProfilerTierUpTelemetry.h"
+
+#include "CodeBlock.h"
+#include "DFGOSRExit.h"
+#include "JSGlobalObject.h"
+#include "ObjectConstructor.h"
+#include "Operations.h"
+#include "Options.h"
+#include <wtf/CurrentTime.h>
+#include <wtf/DataLog.h>
+
+namespace JSC { namespace Profiler {
+
+TierUpTelemetry::TierUpTelemetry()
+    : m_isEnabled(false)
+    , m_droppedEvents(0)
+{
+}
+
+TierUpTelemetry::~TierUpTelemetry()
+{
+}
+
+void TierUpTelemetry::setEnabled(bool enabled)
+{
+    m_isEnabled = enabled;
+
+    // We only learn about CodeBlock destruction while enabled.
+    if (!enabled)
+        m_functionsByCodeBlock.clear();
+}
+
+void TierUpTelemetry::clear()
+{
+    m_functionsByCodeBlock.clear();
+    m_functionsByHash.clear();
+    m_functions.clear();
+    m_events.clear();
+    m_droppedEvents = 0;
+}
+
+static String functionName(ScriptExecutable* executable)
+{
+    switch (executable->structure()->typeInfo().type()) {
+    case FunctionExecutableType: {
+        FunctionExecutable* functionExecutable = jsCast<FunctionExecutable*>(executable);
+        String name = functionExecutable->name().string();
+        if (name.isEmpty())
+            name = functionExecutable->inferredName().string();
+        return name.isEmpty() ? ASCIILiteral("(anonymous function)") : name;
+    }
+    case EvalExecutableType:
+        return ASCIILiteral("(eval)");
+    default:
+        return ASCIILiteral("(program)");
+    }
+}
+
+TierUpTelemetry::Function* TierUpTelemetry::functionFor(CodeBlock* codeBlock)
+{
+    HashMap<CodeBlock*, Function*>::iterator iter = m_functionsByCodeBlock.find(codeBlock);
+    if (iter != m_functionsByCodeBlock.end())
+        return iter->value;
+
+    // Every tier of a function shares the same hash, so this finds the same Function for the
+    // baseline and DFG versions of a CodeBlock and for CodeBlocks created after a jettison.
+    CodeBlockHash hash = codeBlock->hash();
+    Function* function;
+    HashMap<unsigned, Function*, WTF::IntHash<unsigned>, WTF::UnsignedWithZeroKeyHashTraits<unsigned> >::iterator hashIter = m_functionsByHash.find(hash.hash());
+    if (hashIter != m_functionsByHash.end())
+        function = hashIter->value;
+    else {
+        ScriptExecutable* executable = codeBlock->ownerExecutable();
+        m_functions.append(Function(hash, functionName(executable), executable->sourceURL(), executable->lineNo()));
+        function = &m_functions.last();
+        m_functionsByHash.add(hash.hash(), function);
+    }
+    m_functionsByCodeBlock.add(codeBlock, function);
+    return function;
+}
+
+TierUpTelemetry::Event& TierUpTelemetry::appendEvent(EventKind kind, Function* function)
+{
+    if (m_events.size() >= Options::maximumTierUpEvents() && !m_events.isEmpty()) {
+        m_events.removeFirst();
+        m_droppedEvents++;
+    }
+
+    Event event;
+    event.kind = kind;
+    event.time = currentTimeMS();
+    event.function = function;
+    event.bytecodeIndex = UINT_MAX;
+    event.exitKind = ExitKindUnset;
+    m_events.append(event);
+    return m_events.last();
+}
+
+void TierUpTelemetry::notifyBaselineCompilation(CodeBlock* codeBlock)
+{
+    ASSERT(m_isEnabled);
+    Function* function = functionFor(codeBlock);
+    function->baselineCompilations++;
+
+    Event& event = appendEvent(BaselineCompilation, function);
+    if (Options::logTierUpEvents())
+        dumpEvent(WTF::dataFile(), event);
+}
+
+void TierUpTelemetry::notifyDFGCompilation(CodeBlock* codeBlock, bool succeeded, unsigned osrEntryBytecodeIndex)
+{
+    ASSERT(m_isEnabled);
+    Function* function = functionFor(codeBlock);
+    if (succeeded)
+        function->dfgCompilations++;
+    else
+        function->dfgCompilationFailures++;
+
+    Event& event = appendEvent(succeeded ? DFGCompilation : DFGCompilationFailure, function);
+    event.bytecodeIndex = osrEntryBytecodeIndex;
+    if (Options::logTierUpEvents())
+        dumpEvent(WTF::dataFile(), event);
+}
+
+void TierUpTelemetry::notifyOSRExit(CodeBlock* codeBlock, const DFG::OSRExit& exit)
+{
+    ASSERT(m_isEnabled);
+    Function* function = functionFor(codeBlock);
+    function->osrExits++;
+
+    Event& event = appendEvent(OSRExitTaken, function);
+    event.bytecodeIndex = exit.m_codeOrigin.bytecodeIndex;
+    event.exitKind = exit.m_kind;
+
+    Vector<CodeOrigin> stack = exit.m_codeOrigin.inlineStack();
+    for (unsigned i = 0; i < stack.size(); ++i) {
+        Origin origin;
+        origin.function = i ? functionFor(stack[i].inlineCallFrame->baselineCodeBlock()) : function;
+        origin.bytecodeIndex = stack[i].bytecodeIndex;
+        event.origin.append(origin);
+    }
+
+    if (Options::logTierUpEvents())
+        dumpEvent(WTF::dataFile(), event);
+}
+
+void TierUpTelemetry::notifyJettison(CodeBlock* codeBlock)
+{
+    ASSERT(m_isEnabled);
+    Function* function = functionFor(codeBlock);
+    function->jettisons++;
+
+    Event& event = appendEvent(Jettison, function);
+    if (Options::logTierUpEvents())
+        dumpEvent(WTF::dataFile(), event);
+}
+
+void TierUpTelemetry::notifyReoptimization(CodeBlock* baselineCodeBlock)
+{
+    ASSERT(m_isEnabled);
+    Function* function = functionFor(baselineCodeBlock);
+    function->reoptimizations++;
+
+    Event& event = appendEvent(Reoptimization, function);
+    if (Options::logTierUpEvents())
+        dumpEvent(WTF::dataFile(), event);
+}
+
+void TierUpTelemetry::notifyDestruction(CodeBlock* codeBlock)
+{
+    m_functionsByCodeBlock.remove(codeBlock);
+}
+
+const char* TierUpTelemetry::eventKindToString(EventKind kind)
+{
+    switch (kind) {
+    case BaselineCompilation:
+        return "BaselineCompilation";
+    case DFGCompilation:
+        return "DFGCompilation";
+    case DFGCompilationFailure:
+        return "DFGCompilationFailure";
+    case OSRExitTaken:
+        return "OSRExit";
+    case Jettison:
+        return "Jettison";
+    case Reoptimization:
+        return "Reoptimization";
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return 0;
+}
+
+void TierUpTelemetry::dumpEvent(PrintStream& out, const Event& event) const
+{
+    out.print("Tier-up: ", eventKindToString(event.kind), " of ", event.function->name, "#", event.function->hash);
+    if (event.kind == OSRExitTaken) {
+        out.print(" (", exitKindToString(event.exitKind), ") at");
+        for (unsigned i = 0; i < event.origin.size(); ++i)
+            out.print(i ? " --> " : " ", event.origin[i].function->name, "#", event.origin[i].function->hash, ":bc#", event.origin[i].bytecodeIndex);
+    } else if (event.bytecodeIndex != UINT_MAX)
+        out.print(" for entry at bc#", event.bytecodeIndex);
+    out.print(", exits: ", event.function->osrExits, ", reoptimizations: ", event.function->reoptimizations, "\n");
+}
+
+static JSValue hashToJS(ExecState* exec, CodeBlockHash hash)
+{
+    return jsString(exec, String::fromUTF8(toCString(hash)));
+}
+
+JSValue TierUpTelemetry::toJS(ExecState* exec, bool shouldClearEvents)
+{
+    VM& vm = exec->vm();
+    JSObject* result = constructEmptyObject(exec);
+
+    JSArray* functions = constructEmptyArray(exec, 0);
+    for (unsigned i = 0; i < m_functions.size(); ++i) {
+        const Function& function = m_functions[i];
+        JSObject* functionObject = constructEmptyObject(exec);
+        functionObject->putDirect(vm, exec->propertyNames().hash, hashToJS(exec, function.hash));
+        functionObject->putDirect(vm, exec->propertyNames().name, jsString(exec, function.name));
+        functionObject->putDirect(vm, exec->propertyNames().url, jsString(exec, function.url));
+        functionObject->putDirect(vm, exec->propertyNames().line, jsNumber(function.line));
+
+        JSObject* counters = constructEmptyObject(exec);
+        counters->putDirect(vm, exec->propertyNames().baselineCompilations, jsNumber(function.baselineCompilations));
+        counters->putDirect(vm, exec->propertyNames().dfgCompilations, jsNumber(function.dfgCompilations));
+        counters->putDirect(vm, exec->propertyNames().dfgCompilationFailures, jsNumber(function.dfgCompilationFailures));
+        counters->putDirect(vm, exec->propertyNames().osrExits, jsNumber(function.osrExits));
+        counters->putDirect(vm, exec->propertyNames().jettisons, jsNumber(function.jettisons));
+        counters->putDirect(vm, exec->propertyNames().reoptimizations, jsNumber(function.reoptimizations));
+        functionObject->putDirect(vm, exec->propertyNames().counters, counters);
+
+        functions->putDirectIndex(exec, i, functionObject);
+    }
+    result->putDirect(vm, exec->propertyNames().functions, functions);
+
+    JSArray* events = constructEmptyArray(exec, 0);
+    unsigned index = 0;
+    for (Deque<Event>::const_iterator iter = m_events.begin(); iter != m_events.end(); ++iter) {
+        const Event& event = *iter;
+        JSObject* eventObject = constructEmptyObject(exec);
+        eventObject->putDirect(vm, exec->propertyNames().kind, jsString(exec, ASCIILiteral(eventKindToString(event.kind))));
+        eventObject->putDirect(vm, exec->propertyNames().time, jsNumber(event.time));
+        eventObject->putDirect(vm, exec->propertyNames().hash, hashToJS(exec, event.function->hash));
+        eventObject->putDirect(vm, exec->propertyNames().name, jsString(exec, event.function->name));
+        if (event.bytecodeIndex != UINT_MAX)
+            eventObject->putDirect(vm, exec->propertyNames().bytecodeIndex, jsNumber(event.bytecodeIndex));
+        if (event.kind == OSRExitTaken) {
+            eventObject->putDirect(vm, exec->propertyNames().exitKind, jsString(exec, ASCIILiteral(exitKindToString(event.exitKind))));
+            JSArray* origin = constructEmptyArray(exec, 0);
+            for (unsigned i = 0; i < event.origin.size(); ++i) {
+                JSObject* originObject = constructEmptyObject(exec);
+                originObject->putDirect(vm, exec->propertyNames().hash, hashToJS(exec, event.origin[i].function->hash));
+                originObject->putDirect(vm, exec->propertyNames().name, jsString(exec, event.origin[i].function->name));
+                originObject->putDirect(vm, exec->propertyNames().bytecodeIndex, jsNumber(event.origin[i].bytecodeIndex));
+                origin->putDirectIndex(exec, i, originObject);
+            }
+            eventObject->putDirect(vm, exec->propertyNames().origin, origin);
+        }
+        events->putDirectIndex(exec, index++, eventObject);
+    }
+    result->putDirect(vm, exec->propertyNames().events, events);
+    result->putDirect(vm, exec->propertyNames().droppedEvents, jsNumber(m_droppedEvents));
+
+    if (shouldClearEvents) {
+        m_events.clear();
+        m_droppedEvents = 0;
+    }
+
+    return result;
+}
+
+} } // namespace JSC::Profiler
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ProfilerTierUpTelemetry_h
+#define ProfilerTierUpTelemetry_h
+
+#include "CodeBlockHash.h"
+#include "ExitKind.h"
+#include "JSCJSValue.h"
+#include <wtf/Deque.h>
+#include <wtf/FastAllocBase.h>
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/PrintStream.h>
+#include <wtf/SegmentedVector.h>
+#include <wtf/Vector.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+class CodeBlock;
+
+namespace DFG {
+struct OSRExit;
+}
+
+namespace Profiler {
+
+// Records, while enabled, every time a function moves between tiers: baseline and DFG
+// compilations, OSR exits, jettisons and reoptimizations. Unlike the Database, this is meant
+// to be left on in production and switched on and off at run time, so it only keeps
+// per-function counters plus a bounded log of the most recent events.
+class TierUpTelemetry {
+    WTF_MAKE_FAST_ALLOCATED; WTF_MAKE_NONCOPYABLE(TierUpTelemetry);
+public:
+    enum EventKind {
+        BaselineCompilation,
+        DFGCompilation,
+        DFGCompilationFailure,
+        OSRExitTaken,
+        Jettison,
+        Reoptimization
+    };
+
+    TierUpTelemetry();
+    ~TierUpTelemetry();
+
+    bool isEnabled() const { return m_isEnabled; }
+    JS_EXPORT_PRIVATE void setEnabled(bool);
+
+    // OSR exit code tests this before calling out, so that exits are seen no matter whether
+    // telemetry was on when the exit was compiled.
+    const bool* addressOfIsEnabled() const { return &m_isEnabled; }
+
+    void notifyBaselineCompilation(CodeBlock*);
+    void notifyDFGCompilation(CodeBlock*, bool succeeded, unsigned osrEntryBytecodeIndex);
+    void notifyOSRExit(CodeBlock*, const DFG::OSRExit&);
+    void notifyJettison(CodeBlock*);
+    void notifyReoptimization(CodeBlock* baselineCodeBlock);
+    void notifyDestruction(CodeBlock*);
+
+    // Forgets all counters and events.
+    JS_EXPORT_PRIVATE void clear();
+
+    // Converts the counters and the logged events to a JavaScript object that is suitable for
+    // JSON stringification. If shouldClearEvents is true, the events are removed from the log,
+    // so that a client polling this sees each event once.
+    JS_EXPORT_PRIVATE JSValue toJS(ExecState*, bool shouldClearEvents);
+
+    static const char* eventKindToString(EventKind);
+
+private:
+    struct Function {
+        Function(CodeBlockHash hash, const String& name, const String& url, unsigned line)
+            : hash(hash)
+            , name(name)
+            , url(url)
+            , line(line)
+            , baselineCompilations(0)
+            , dfgCompilations(0)
+            , dfgCompilationFailures(0)
+            , osrExits(0)
+            , jettisons(0)
+            , reoptimizations(0)
+        {
+        }
+
+        CodeBlockHash hash;
+        String name;
+        String url;
+        unsigned line;
+        unsigned baselineCompilations;
+        unsigned dfgCompilations;
+        unsigned dfgCompilationFailures;
+        unsigned osrExits;
+        unsigned jettisons;
+        unsigned reoptimizations;
+    };
+
+    struct Origin {
+        Function* function;
+        unsigned bytecodeIndex;
+    };
+
+    struct Event {
+        EventKind kind;
+        double time;
+        Function* function;
+        unsigned bytecodeIndex;
+        ExitKind exitKind;
+        Vector<Origin, 1> origin; // For OSR exits, the inline stack of the exit, outermost first.
+    };
+
+    Function* functionFor(CodeBlock*);
+    Event& appendEvent(EventKind, Function*);
+    void dumpEvent(PrintStream&, const Event&) const;
+
+    bool m_isEnabled;
+    SegmentedVector<Function, 16> m_functions;
+    HashMap<unsigned, Function*, WTF::IntHash<unsigned>, WTF::UnsignedWithZeroKeyHashTraits<unsigned> > m_functionsByHash;
+    HashMap<CodeBlock*, Function*> m_functionsByCodeBlock;
+    Deque<Event> m_events;
+    unsigned m_droppedEvents;
+};
+
+} } // namespace JSC::Profiler
+
+#endif // ProfilerTierUpTelemetry_h
@@ -0,0 +1,504 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SamplingProfiler.h"
+
+#if ENABLE(SAMPLING_PROFILER)
+
+#include "CallFrame.h"
+#include "CodeBlock.h"
+#include "ExecutableAllocator.h"
+#include "Interpreter.h"
+#include "JSCellInlines.h"
+#include "JSStack.h"
+#include "LLIntData.h"
+#include "Options.h"
+#include "Profile.h"
+#include "ProfileNode.h"
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <ucontext.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/FilePrintStream.h>
+#include <wtf/StringPrintStream.h>
+
+namespace JSC {
+
+static const unsigned maximumStackDepth = 256;
+static const unsigned maximumPendingSamples = 4096;
+static const unsigned maximumPendingFrames = 64 * 1024;
+static const double maximumSuspensionWait = 0.1;
+
+// The JS thread is interrupted with a signal. Its handler publishes the interrupted PC and
+// call frame register, then spins until the sampler thread has finished reading its stack.
+// Requests are numbered so that a handler that runs after its sampler gave up waiting does
+// not keep the thread parked.
+static const int SigSample = SIGPROF;
+
+struct SuspendedThreadState {
+    void* volatile pc;
+    void* volatile callFrameRegister;
+    volatile unsigned request;
+    volatile unsigned suspendedForRequest;
+    volatile unsigned resumeRequest;
+};
+
+static SuspendedThreadState suspendedThreadState;
+
+static Mutex& suspensionMutex()
+{
+    AtomicallyInitializedStatic(Mutex&, mutex = *new Mutex);
+    return mutex;
+}
+
+static void sampleSignalHandler(int, siginfo_t*, void* context)
+{
+    unsigned request = suspendedThreadState.request;
+    mcontext_t& machineContext = static_cast<ucontext_t*>(context)->uc_mcontext;
+    suspendedThreadState.pc = reinterpret_cast<void*>(machineContext.gregs[REG_RIP]);
+    suspendedThreadState.callFrameRegister = reinterpret_cast<void*>(machineContext.gregs[REG_R13]);
+    suspendedThreadState.suspendedForRequest = request;
+    while (suspendedThreadState.resumeRequest != request)
+        sched_yield();
+}
+
+static void installSignalHandlerIfNecessary()
+{
+    static bool didInstall;
+    if (didInstall)
+        return;
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = sampleSignalHandler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigfillset(&action.sa_mask);
+    sigaction(SigSample, &action, 0);
+    didInstall = true;
+}
+
+SamplingProfiler::SamplingProfiler(VM& vm)
+    : m_vm(vm)
+    , m_interval(Options::sampleIntervalMicroseconds() / 1000000.0)
+    , m_samplerThread(0)
+    , m_shouldStop(false)
+    , m_codeBlockSerial(0)
+    , m_llintBegin(LLInt::getCodePtr(llint_begin))
+    , m_llintEnd(LLInt::getCodePtr(llint_end))
+    , m_root(CallIdentifier("(root)", String(), 0), UnknownTier)
+    , m_sampleCount(0)
+    , m_droppedSampleCount(0)
+{
+    m_rawSamples.reserveInitialCapacity(maximumPendingSamples);
+    m_rawFrames.reserveInitialCapacity(maximumPendingFrames);
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    stop();
+}
+
+void SamplingProfiler::start()
+{
+    if (m_samplerThread)
+        return;
+    {
+        MutexLocker locker(suspensionMutex());
+        installSignalHandlerIfNecessary();
+    }
+    m_targetThread = pthread_self();
+    m_shouldStop = false;
+    m_samplerThread = createThread(threadEntryPoint, this, "JavaScriptCore::SamplingProfiler");
+}
+
+void SamplingProfiler::stop()
+{
+    if (!m_samplerThread)
+        return;
+    {
+        MutexLocker locker(m_lock);
+        m_shouldStop = true;
+        m_condition.signal();
+    }
+    waitForThreadCompletion(m_samplerThread);
+    m_samplerThread = 0;
+}
+
+void SamplingProfiler::threadEntryPoint(void* profiler)
+{
+    static_cast<SamplingProfiler*>(profiler)->samplerThreadBody();
+}
+
+void SamplingProfiler::samplerThreadBody()
+{
+    MutexLocker locker(m_lock);
+    while (!m_shouldStop) {
+        m_condition.timedWait(m_lock, currentTime() + m_interval);
+        if (m_shouldStop)
+            break;
+        takeSample();
+    }
+}
+
+void SamplingProfiler::takeSample()
+{
+    MutexLocker locker(suspensionMutex());
+
+    unsigned request = suspendedThreadState.request + 1;
+    suspendedThreadState.request = request;
+    if (pthread_kill(m_targetThread, SigSample))
+        return;
+
+    double deadline = currentTime() + maximumSuspensionWait;
+    while (suspendedThreadState.suspendedForRequest != request) {
+        if (currentTime() > deadline) {
+            suspendedThreadState.resumeRequest = request;
+            return;
+        }
+        sched_yield();
+    }
+
+    recordStack(suspendedThreadState.pc, suspendedThreadState.callFrameRegister);
+
+    suspendedThreadState.resumeRequest = request;
+}
+
+bool SamplingProfiler::isJSCodePC(void* pc) const
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(pc);
+    if (address - startOfFixedExecutableMemoryPool < fixedExecutableMemoryPoolSize)
+        return true;
+    return isLLIntPC(pc);
+}
+
+bool SamplingProfiler::isLLIntPC(void* pc) const
+{
+    return pc >= m_llintBegin && pc <= m_llintEnd;
+}
+
+// Runs on the sampler thread while the JS thread is parked in the signal handler. Nothing
+// here may allocate or take a lock, and nothing read from the stack may be dereferenced
+// except stack slots themselves, which are bounds checked against the JSStack.
+void SamplingProfiler::recordStack(void* pc, void* callFrameRegister)
+{
+    if (!m_vm.dynamicGlobalObject)
+        return; // Not running JS.
+
+    if (m_rawSamples.size() == m_rawSamples.capacity() || m_rawFrames.size() + maximumStackDepth > m_rawFrames.capacity()) {
+        ++m_droppedSampleCount;
+        return;
+    }
+
+    // In LLInt or JIT code the call frame register is current. Anywhere else, we are in C++
+    // code that was called from JS, and that call recorded its caller in topCallFrame.
+    bool isInJSCode = isJSCodePC(pc);
+    CallFrame* frame = isInJSCode ? static_cast<CallFrame*>(callFrameRegister) : m_vm.topCallFrame->removeHostCallFrameFlag();
+
+    JSStack& stack = m_vm.interpreter->stack();
+    Register* stackBegin = stack.begin();
+    Register* stackEnd = stack.end();
+
+    RawSample sample;
+    sample.firstFrame = m_rawFrames.size();
+    sample.codeBlockSerial = m_codeBlockSerial;
+    sample.topFrameIsAtCall = !isInJSCode;
+
+    void* framePC = isInJSCode ? pc : 0;
+    for (unsigned depth = 0; depth < maximumStackDepth && frame; ++depth) {
+        Register* registers = frame->registers();
+        if (registers + JSStack::ArgumentCount < stackBegin || registers > stackEnd)
+            break;
+        if (reinterpret_cast<uintptr_t>(registers) % sizeof(Register))
+            break;
+
+        RawFrame rawFrame;
+        rawFrame.codeBlock = frame->codeBlock();
+        rawFrame.pc = framePC;
+        rawFrame.codeOriginIndex = frame->codeOriginIndexForDFG();
+        m_rawFrames.uncheckedAppend(rawFrame);
+
+        framePC = registers[JSStack::ReturnPC].vPC();
+        CallFrame* callerFrame = frame->callerFrame();
+        if (callerFrame->hasHostCallFrameFlag()) {
+            // The caller called into C++, which re-entered JS; we do not know where from.
+            callerFrame = callerFrame->removeHostCallFrameFlag();
+            framePC = 0;
+        }
+        if (callerFrame >= frame)
+            break;
+        frame = callerFrame;
+    }
+
+    sample.frameCount = m_rawFrames.size() - sample.firstFrame;
+    if (!sample.frameCount)
+        return;
+    m_rawSamples.uncheckedAppend(sample);
+}
+
+void SamplingProfiler::noticeCodeBlockCreation(CodeBlock* codeBlock)
+{
+    m_liveCodeBlocks.set(codeBlock, ++m_codeBlockSerial);
+}
+
+void SamplingProfiler::noticeCodeBlockDestruction(CodeBlock* codeBlock)
+{
+    m_liveCodeBlocks.remove(codeBlock);
+}
+
+static CallIdentifier callIdentifierFor(ExecutableBase* executable)
+{
+    if (FunctionExecutable* functionExecutable = jsDynamicCast<FunctionExecutable*>(executable)) {
+        String name = functionExecutable->name().string();
+        if (name.isEmpty())
+            name = functionExecutable->inferredName().string();
+        if (name.isEmpty())
+            name = "(anonymous function)";
+        return CallIdentifier(name, functionExecutable->sourceURL(), functionExecutable->lineNo());
+    }
+    if (ScriptExecutable* scriptExecutable = jsDynamicCast<ScriptExecutable*>(executable)) {
+        const char* name = executable->structure()->typeInfo().type() == EvalExecutableType ? "(eval)" : "(program)";
+        return CallIdentifier(name, scriptExecutable->sourceURL(), scriptExecutable->lineNo());
+    }
+    return CallIdentifier("(unknown)", String(), 0);
+}
+
+static SamplingProfiler::Tier tierFor(CodeBlock* codeBlock)
+{
+    switch (codeBlock->getJITType()) {
+    case JITCode::InterpreterThunk:
+        return SamplingProfiler::LLIntTier;
+    case JITCode::BaselineJIT:
+        return SamplingProfiler::BaselineTier;
+    case JITCode::DFGJIT:
+        return SamplingProfiler::DFGTier;
+    default:
+        return SamplingProfiler::UnknownTier;
+    }
+}
+
+void SamplingProfiler::resolveFrame(const RawFrame& rawFrame, unsigned codeBlockSerial, bool isAtCall, Vector<ResolvedFrame, 32>& frames)
+{
+    CodeBlock* codeBlock = rawFrame.codeBlock;
+    if (!codeBlock) {
+        ResolvedFrame frame = { CallIdentifier("(native code)", String(), 0), NativeTier };
+        frames.append(frame);
+        return;
+    }
+
+    HashMap<CodeBlock*, unsigned>::iterator iter = m_liveCodeBlocks.find(codeBlock);
+    if (iter == m_liveCodeBlocks.end() || iter->value > codeBlockSerial) {
+        // Most likely a frame that was still being set up when the sample was taken.
+        ResolvedFrame frame = { CallIdentifier("(unknown)", String(), 0), UnknownTier };
+        frames.append(frame);
+        return;
+    }
+
+    // A CodeBlock is replaced when it gets to the DFG, but runs both in the LLInt and the
+    // baseline JIT, so use the PC to tell those apart.
+    Tier tier = isLLIntPC(rawFrame.pc) ? LLIntTier : tierFor(codeBlock);
+
+#if ENABLE(DFG_JIT)
+    // Only a frame that is stopped at a call knows which inlined code it is in.
+    if (tier == DFGTier && isAtCall && codeBlock->hasCodeOrigins()) {
+        CodeOrigin codeOrigin;
+        bool hasCodeOrigin = false;
+        if (rawFrame.pc)
+            hasCodeOrigin = codeBlock->codeOriginForReturn(ReturnAddressPtr(rawFrame.pc), codeOrigin);
+        if (!hasCodeOrigin && codeBlock->canGetCodeOrigin(rawFrame.codeOriginIndex)) {
+            codeOrigin = codeBlock->codeOrigin(rawFrame.codeOriginIndex);
+            hasCodeOrigin = true;
+        }
+        if (hasCodeOrigin) {
+            for (InlineCallFrame* inlineCallFrame = codeOrigin.inlineCallFrame; inlineCallFrame; inlineCallFrame = inlineCallFrame->caller.inlineCallFrame) {
+                ResolvedFrame frame = { callIdentifierFor(inlineCallFrame->executable.get()), DFGInlinedTier };
+                frames.append(frame);
+            }
+        }
+    }
+#else
+    UNUSED_PARAM(isAtCall);
+#endif
+
+    ResolvedFrame frame = { callIdentifierFor(codeBlock->ownerExecutable()), tier };
+    frames.append(frame);
+}
+
+SamplingProfiler::StackNode* SamplingProfiler::StackNode::childFor(const ResolvedFrame& frame)
+{
+    for (size_t i = 0; i < children.size(); ++i) {
+        StackNode* child = children[i].get();
+        if (child->tier == frame.tier && child->identifier == frame.identifier)
+            return child;
+    }
+    children.append(adoptPtr(new StackNode(frame.identifier, frame.tier)));
+    return children.last().get();
+}
+
+void SamplingProfiler::processPendingSamples()
+{
+    MutexLocker locker(m_lock);
+
+    Vector<ResolvedFrame, 32> frames;
+    for (size_t i = 0; i < m_rawSamples.size(); ++i) {
+        const RawSample& sample = m_rawSamples[i];
+        frames.shrink(0);
+        for (unsigned j = 0; j < sample.frameCount; ++j) {
+            bool isAtCall = j || sample.topFrameIsAtCall;
+            resolveFrame(m_rawFrames[sample.firstFrame + j], sample.codeBlockSerial, isAtCall, frames);
+        }
+
+        StackNode* node = &m_root;
+        node->totalSamples++;
+        for (size_t j = frames.size(); j--;) {
+            node = node->childFor(frames[j]);
+            node->totalSamples++;
+        }
+        node->selfSamples++;
+        m_sampleCount++;
+    }
+
+    // Vector::shrink() keeps the capacity, so the sampler can keep appending without allocating.
+    m_rawSamples.shrink(0);
+    m_rawFrames.shrink(0);
+}
+
+const char* SamplingProfiler::tierName(Tier tier)
+{
+    switch (tier) {
+    case NativeTier:
+        return "Native";
+    case LLIntTier:
+        return "LLInt";
+    case BaselineTier:
+        return "Baseline";
+    case DFGTier:
+        return "DFG";
+    case DFGInlinedTier:
+        return "DFG inlined";
+    case UnknownTier:
+        break;
+    }
+    return "Unknown";
+}
+
+static void addToProfileNode(ProfileNode* head, ProfileNode* parent, const Vector<OwnPtr<SamplingProfiler::StackNode> >&, double interval);
+
+PassRefPtr<Profile> SamplingProfiler::createProfile(const String& title, unsigned uid)
+{
+    processPendingSamples();
+
+    MutexLocker locker(m_lock);
+    RefPtr<Profile> profile = Profile::create(title, uid);
+    double intervalInMilliseconds = m_interval * 1000;
+    ProfileNode* head = profile->head();
+    addToProfileNode(head, head, m_root.children, intervalInMilliseconds);
+    head->setTotalTime(m_root.totalSamples * intervalInMilliseconds);
+    return profile.release();
+}
+
+// Tiers are merged here, since the inspector shows one node per function.
+static void addToProfileNode(ProfileNode* head, ProfileNode* parent, const Vector<OwnPtr<SamplingProfiler::StackNode> >& stackNodes, double interval)
+{
+    for (size_t i = 0; i < stackNodes.size(); ++i) {
+        SamplingProfiler::StackNode* stackNode = stackNodes[i].get();
+
+        ProfileNode* node = 0;
+        const Vector<RefPtr<ProfileNode> >& children = parent->children();
+        for (size_t j = 0; j < children.size(); ++j) {
+            if (children[j]->callIdentifier() == stackNode->identifier) {
+                node = children[j].get();
+                break;
+            }
+        }
+        if (!node) {
+            RefPtr<ProfileNode> newNode = ProfileNode::create(0, stackNode->identifier, head, parent);
+            node = newNode.get();
+            parent->addChild(newNode.release());
+        }
+
+        node->setSelfTime(node->selfTime() + stackNode->selfSamples * interval);
+        node->setTotalTime(node->totalTime() + stackNode->totalSamples * interval);
+        addToProfileNode(head, node, stackNode->children, interval);
+    }
+}
+
+static void appendFoldedFrameName(StringBuilder& builder, const CallIdentifier& identifier, SamplingProfiler::Tier tier)
+{
+    // ';' separates frames and the line ends with a space and the count, so keep those out.
+    StringBuilder name;
+    name.append(identifier.m_name);
+    if (!identifier.m_url.isEmpty()) {
+        name.append(" (");
+        name.append(identifier.m_url);
+        name.append(':');
+        name.appendNumber(identifier.m_lineNumber);
+        name.append(')');
+    }
+    builder.append(name.toString().replace(';', ':').replace('\n', ' '));
+    builder.append(" [");
+    builder.append(SamplingProfiler::tierName(tier));
+    builder.append(']');
+}
+
+static void dumpFoldedStacks(PrintStream& out, StringBuilder& prefix, const SamplingProfiler::StackNode& node)
+{
+    unsigned prefixLength = prefix.length();
+    if (node.selfSamples)
+        out.print(prefix.toString(), " ", node.selfSamples, "\n");
+    for (size_t i = 0; i < node.children.size(); ++i) {
+        const SamplingProfiler::StackNode& child = *node.children[i];
+        if (prefixLength)
+            prefix.append(';');
+        appendFoldedFrameName(prefix, child.identifier, child.tier);
+        dumpFoldedStacks(out, prefix, child);
+        prefix.resize(prefixLength);
+    }
+}
+
+void SamplingProfiler::dumpFoldedStacks(PrintStream& out) const
+{
+    MutexLocker locker(const_cast<Mutex&>(m_lock));
+    StringBuilder prefix;
+    for (size_t i = 0; i < m_root.children.size(); ++i) {
+        const StackNode& child = *m_root.children[i];
+        appendFoldedFrameName(prefix, child.identifier, child.tier);
+        JSC::dumpFoldedStacks(out, prefix, child);
+        prefix.resize(0);
+    }
+}
+
+bool SamplingProfiler::saveFoldedStacks(const char* filename) const
+{
+    OwnPtr<FilePrintStream> out = FilePrintStream::open(filename, "w");
+    if (!out)
+        return false;
+    dumpFoldedStacks(*out);
+    return true;
+}
+
+} // namespace JSC
+
+#endif // ENABLE(SAMPLING_PROFILER)
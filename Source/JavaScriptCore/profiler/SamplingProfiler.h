@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SamplingProfiler_h
+#define SamplingProfiler_h
+
+#include <wtf/Platform.h>
+
+#if ENABLE(SAMPLING_PROFILER)
+
+#include "CallIdentifier.h"
+#include <pthread.h>
+#include <wtf/FastAllocBase.h>
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/PrintStream.h>
+#include <wtf/Threading.h>
+#include <wtf/ThreadingPrimitives.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+class CodeBlock;
+class Profile;
+class VM;
+
+// A statistical profiler: a helper thread periodically interrupts the thread running JS and
+// records the call frames it finds. Frames are attributed to the tier that was running them
+// (LLInt, baseline JIT or DFG), and DFG frames are expanded into the functions inlined at the
+// sampled call site. While the JS thread is interrupted, the sampler only copies raw stack
+// slots; those are resolved into functions later on the VM's own thread, where candidate
+// CodeBlocks are checked against the set of live ones before they are used.
+//
+// The VM creates a SamplingProfiler when Options::useSamplingProfiler() is set, so that it
+// sees every CodeBlock come and go; sampling itself only happens between start() and stop().
+class SamplingProfiler {
+    WTF_MAKE_FAST_ALLOCATED; WTF_MAKE_NONCOPYABLE(SamplingProfiler);
+public:
+    enum Tier { UnknownTier, NativeTier, LLIntTier, BaselineTier, DFGTier, DFGInlinedTier };
+
+    JS_EXPORT_PRIVATE SamplingProfiler(VM&);
+    ~SamplingProfiler();
+
+    // The thread that calls start() is the one that gets sampled.
+    JS_EXPORT_PRIVATE void start();
+    JS_EXPORT_PRIVATE void stop();
+    bool isRunning() const { return !!m_samplerThread; }
+
+    void noticeCodeBlockCreation(CodeBlock*);
+    void noticeCodeBlockDestruction(CodeBlock*);
+
+    // Resolves the samples taken so far into stacks of functions. Must be called on the VM's
+    // thread, with its API lock held.
+    JS_EXPORT_PRIVATE void processPendingSamples();
+
+    unsigned sampleCount() const { return m_sampleCount; }
+    unsigned droppedSampleCount() const { return m_droppedSampleCount; }
+
+    // Builds a profile, in the same shape as the ones the LegacyProfiler produces, where each
+    // node's time is the number of samples it appeared in times the sampling interval.
+    JS_EXPORT_PRIVATE PassRefPtr<Profile> createProfile(const String& title, unsigned uid);
+
+    // Writes one line per distinct stack, outermost frame first and followed by its sample
+    // count, which is the folded format that flame graph tools take as input.
+    JS_EXPORT_PRIVATE void dumpFoldedStacks(PrintStream&) const;
+    JS_EXPORT_PRIVATE bool saveFoldedStacks(const char* filename) const;
+
+    static const char* tierName(Tier);
+
+    struct ResolvedFrame {
+        CallIdentifier identifier;
+        Tier tier;
+    };
+
+    // Samples are aggregated into a tree of stacks, rooted at the outermost frame.
+    struct StackNode {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        StackNode(const CallIdentifier& identifier, Tier tier)
+            : identifier(identifier)
+            , tier(tier)
+            , selfSamples(0)
+            , totalSamples(0)
+        {
+        }
+
+        StackNode* childFor(const ResolvedFrame&);
+
+        CallIdentifier identifier;
+        Tier tier;
+        unsigned selfSamples;
+        unsigned totalSamples;
+        Vector<OwnPtr<StackNode> > children;
+    };
+
+private:
+    struct RawFrame {
+        CodeBlock* codeBlock;
+        void* pc; // The sampled PC for the top frame, otherwise where its callee returns to; 0 if not known.
+        unsigned codeOriginIndex;
+    };
+
+    struct RawSample {
+        unsigned firstFrame;
+        unsigned frameCount;
+        unsigned codeBlockSerial;
+        bool topFrameIsAtCall;
+    };
+
+    static void threadEntryPoint(void*);
+    void samplerThreadBody();
+    void takeSample();
+    void recordStack(void* pc, void* callFrameRegister);
+    bool isJSCodePC(void*) const;
+    bool isLLIntPC(void*) const;
+
+    void resolveFrame(const RawFrame&, unsigned codeBlockSerial, bool isAtCall, Vector<ResolvedFrame, 32>&);
+
+    VM& m_vm;
+    double m_interval;
+
+    Mutex m_lock;
+    ThreadCondition m_condition;
+    ThreadIdentifier m_samplerThread;
+    pthread_t m_targetThread;
+    bool m_shouldStop;
+
+    // Every live CodeBlock, mapped to the serial number it was created with. A raw frame
+    // naming a CodeBlock is only trusted if that CodeBlock was already alive when the sample
+    // was taken and has not died since.
+    HashMap<CodeBlock*, unsigned> m_liveCodeBlocks;
+    unsigned m_codeBlockSerial;
+
+    // Filled by the sampler thread without allocating, since the JS thread may be interrupted
+    // while holding the malloc lock; drained by processPendingSamples().
+    Vector<RawSample> m_rawSamples;
+    Vector<RawFrame> m_rawFrames;
+
+    void* m_llintBegin;
+    void* m_llintEnd;
+
+    StackNode m_root;
+    unsigned m_sampleCount;
+    unsigned m_droppedSampleCount;
+};
+
+} // namespace JSC
+
+#endif // ENABLE(SAMPLING_PROFILER)
+
+#endif // SamplingProfiler_h
@@ -393,6 +393,23 @@ void Arguments::tearOff(CallFrame* callFrame, InlineCallFrame* inlineCallFrame)
         inlineCallFrame);
 }
 
+// The DFG may keep a caller's arguments object optimized away even after passing it
+// into an inlined callee, in which case the callee's parameter slot holds the empty
+// value. Should anyone need the callee's arguments, reify a copy of the caller's.
+static Arguments* createArgumentsForCaller(VM& vm, Register* registers, InlineCallFrame* inlineCallFrame)
+{
+    CallFrame* machineCallFrame = CallFrame::create(registers - inlineCallFrame->stackOffset);
+    Arguments* arguments;
+    if (InlineCallFrame* callerInlineCallFrame = inlineCallFrame->caller.inlineCallFrame) {
+        arguments = Arguments::create(vm, machineCallFrame, callerInlineCallFrame);
+        arguments->tearOff(machineCallFrame, callerInlineCallFrame);
+    } else {
+        arguments = Arguments::create(vm, machineCallFrame);
+        arguments->tearOff(machineCallFrame);
+    }
+    return arguments;
+}
+
 void Arguments::tearOffForInlineCallFrame(VM& vm, Register* registers, InlineCallFrame* inlineCallFrame)
 {
     for (size_t i = 0; i < m_numArguments; ++i) {
@@ -431,6 +448,8 @@ void Arguments::tearOffForInlineCallFrame(VM& vm, Register* registers, InlineCal
             RELEASE_ASSERT_NOT_REACHED();
             break;
         }
+        if (!value)
+            value = createArgumentsForCaller(vm, registers, inlineCallFrame);
         trySetArgument(vm, i, value);
     }
 }
@@ -71,7 +71,7 @@ static EncodedJSValue JSC_HOST_CALL arrayProtoFuncLastIndexOf(ExecState*);
 
 namespace JSC {
 
-static inline bool isNumericCompareFunction(ExecState* exec, CallType callType, const CallData& callData)
+static inline bool isNumericCompareFunction(ExecState* exec, CallType callType, const CallData& callData, NumericSortOrder& order)
 {
     if (callType != CallTypeJS)
         return false;
@@ -82,7 +82,16 @@ static inline bool isNumericCompareFunction(ExecState* exec, CallType callType,
     if (error)
         return false;
 
-    return executable->generatedBytecodeForCall().isNumericCompareFunction();
+    CodeBlock& codeBlock = executable->generatedBytecodeForCall();
+    if (codeBlock.isNumericCompareFunction()) {
+        order = NumericSortAscending;
+        return true;
+    }
+    if (codeBlock.isReverseNumericCompareFunction()) {
+        order = NumericSortDescending;
+        return true;
+    }
+    return false;
 }
 
 // ------------------------------ ArrayPrototype ----------------------------
@@ -615,8 +624,9 @@ static bool attemptFastSort(ExecState* exec, JSObject* thisObj, JSValue function
         || shouldUseSlowPut(thisObj->structure()->indexingType()))
         return false;
     
-    if (isNumericCompareFunction(exec, callType, callData))
-        asArray(thisObj)->sortNumeric(exec, function, callType, callData);
+    NumericSortOrder order;
+    if (isNumericCompareFunction(exec, callType, callData, order))
+        asArray(thisObj)->sortNumeric(exec, function, callType, callData, order);
     else if (callType != CallTypeNone)
         asArray(thisObj)->sort(exec, function, callType, callData);
     else
@@ -697,27 +707,39 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncSort(ExecState* exec)
     if (attemptFastSort(exec, thisObj, function, callData, callType))
         return JSValue::encode(thisObj);
     
-    // Assume that for small-ish arrays, doing the slow sort directly is better.
-    if (length < 1000)
-        return performSlowSort(exec, thisObj, length, function, callData, callType) ? JSValue::encode(thisObj) : JSValue::encode(jsUndefined());
-    
-    JSGlobalObject* globalObject = JSGlobalObject::create(
-        exec->vm(), JSGlobalObject::createStructure(exec->vm(), jsNull()));
+    // Copy the values into a flat array that the fast sorts can handle, sort that, and copy
+    // the result back. The flat array only needs a fresh global object if this one's arrays
+    // have been forced into slow put mode.
+    JSGlobalObject* globalObject = exec->lexicalGlobalObject();
+    if (globalObject->isHavingABadTime()) {
+        globalObject = JSGlobalObject::create(
+            exec->vm(), JSGlobalObject::createStructure(exec->vm(), jsNull()));
+    }
     JSArray* flatArray = constructEmptyArray(globalObject->globalExec(), 0);
     if (exec->hadException())
         return JSValue::encode(jsUndefined());
     
-    PropertyNameArray nameArray(exec);
-    thisObj->methodTable()->getPropertyNames(thisObj, exec, nameArray, IncludeDontEnumProperties);
-    if (exec->hadException())
-        return JSValue::encode(jsUndefined());
+    // For small-ish lengths, probing every index is cheaper than enumerating property names.
+    Vector<uint32_t, 0, UnsafeVectorOverflow> candidateKeys;
+    if (length < 1000) {
+        candidateKeys.reserveInitialCapacity(length);
+        for (unsigned i = 0; i < length; ++i)
+            candidateKeys.uncheckedAppend(i);
+    } else {
+        PropertyNameArray nameArray(exec);
+        thisObj->methodTable()->getPropertyNames(thisObj, exec, nameArray, IncludeDontEnumProperties);
+        if (exec->hadException())
+            return JSValue::encode(jsUndefined());
+        for (size_t i = 0; i < nameArray.size(); ++i) {
+            uint32_t index = PropertyName(nameArray[i]).asIndex();
+            if (index != PropertyName::NotAnIndex && index < length)
+                candidateKeys.append(index);
+        }
+    }
 
     Vector<uint32_t, 0, UnsafeVectorOverflow> keys;
-    for (size_t i = 0; i < nameArray.size(); ++i) {
-        PropertyName name = nameArray[i];
-        uint32_t index = name.asIndex();
-        if (index == PropertyName::NotAnIndex)
-            continue;
+    for (size_t i = 0; i < candidateKeys.size(); ++i) {
+        uint32_t index = candidateKeys[i];
         
         JSValue value = getOrHole(thisObj, exec, index);
         if (exec->hadException())
@@ -54,6 +54,7 @@
     macro(anonymous) \
     macro(apply) \
     macro(arguments) \
+    macro(baselineCompilations) \
     macro(bind) \
     macro(bytecode) \
     macro(bytecodeIndex) \
@@ -71,14 +72,19 @@
     macro(counters) \
     macro(description) \
     macro(descriptions) \
+    macro(dfgCompilationFailures) \
+    macro(dfgCompilations) \
     macro(displayName) \
     macro(document) \
+    macro(droppedEvents) \
     macro(enumerable) \
     macro(eval) \
+    macro(events) \
     macro(exec) \
     macro(executionCount) \
     macro(exitKind) \
     macro(fromCharCode) \
+    macro(functions) \
     macro(get) \
     macro(global) \
     macro(hasOwnProperty) \
@@ -93,9 +99,12 @@
     macro(isArray) \
     macro(isPrototypeOf) \
     macro(isWatchpoint) \
+    macro(jettisons) \
     macro(join) \
+    macro(kind) \
     macro(lastIndex) \
     macro(length) \
+    macro(line) \
     macro(message) \
     macro(multiline) \
     macro(name) \
@@ -111,11 +120,13 @@
     macro(profiledBytecodes) \
     macro(propertyIsEnumerable) \
     macro(prototype) \
+    macro(reoptimizations) \
     macro(set) \
     macro(source) \
     macro(sourceCode) \
     macro(stack) \
     macro(test) \
+    macro(time) \
     macro(toExponential) \
     macro(toFixed) \
     macro(toISOString) \
@@ -123,6 +134,7 @@
     macro(toLocaleString) \
     macro(toPrecision) \
     macro(toString) \
+    macro(url) \
     macro(value) \
     macro(valueOf) \
     macro(window) \
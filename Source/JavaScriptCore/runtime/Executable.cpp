@@ -655,6 +655,38 @@ void FunctionExecutable::unlinkCalls()
 #endif
 }
 
+#if ENABLE(JIT)
+static bool isColdSinceLastCheck(CodeBlock* codeBlock, bool& hasMachineCode)
+{
+    bool result = true;
+    for (; codeBlock; codeBlock = codeBlock->alternative()) {
+        JITCode::JITType jitType = codeBlock->getJITType();
+        if (jitType == JITCode::BaselineJIT || JITCode::isOptimizingJIT(jitType))
+            hasMachineCode = true;
+        if (codeBlock->wasEnteredRecently())
+            result = false;
+        codeBlock->clearWasEnteredRecently();
+    }
+    return result;
+}
+
+bool FunctionExecutable::isColdSinceLastCheck()
+{
+    bool hasMachineCode = false;
+    bool callIsCold = JSC::isColdSinceLastCheck(m_codeBlockForCall.get(), hasMachineCode);
+    bool constructIsCold = JSC::isColdSinceLastCheck(m_codeBlockForConstruct.get(), hasMachineCode);
+    return hasMachineCode && callIsCold && constructIsCold;
+}
+
+void FunctionExecutable::unlinkIncomingCalls()
+{
+    for (CodeBlock* codeBlock = m_codeBlockForCall.get(); codeBlock; codeBlock = codeBlock->alternative())
+        codeBlock->unlinkIncomingCalls();
+    for (CodeBlock* codeBlock = m_codeBlockForConstruct.get(); codeBlock; codeBlock = codeBlock->alternative())
+        codeBlock->unlinkIncomingCalls();
+}
+#endif
+
 FunctionExecutable* FunctionExecutable::fromGlobalCode(const Identifier& name, ExecState* exec, Debugger* debugger, const SourceCode& source, JSObject** exception)
 {
     UnlinkedFunctionExecutable* unlinkedFunction = UnlinkedFunctionExecutable::fromGlobalCode(name, exec, debugger, source, exception);
@@ -755,6 +755,18 @@ namespace JSC {
 
         void clearCode();
 
+#if ENABLE(JIT)
+        // Used by cold code eviction (see Heap::deleteColdCompiledCode()). Returns true if this
+        // function has machine code and none of its CodeBlocks, including the ones that the DFG
+        // replaced, have been entered since the previous call. Either way, the entry flags are
+        // reset, so that the next call looks at a fresh interval.
+        bool isColdSinceLastCheck();
+
+        // Repatches every call that was linked to this function's code, so that the code can be
+        // thrown away while its callers live on.
+        void unlinkIncomingCalls();
+#endif
+
     private:
         FunctionExecutable(VM&, const SourceCode&, UnlinkedFunctionExecutable*, unsigned firstLine, unsigned lastLine, unsigned startColumn);
 
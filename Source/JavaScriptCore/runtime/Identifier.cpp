@@ -137,6 +137,14 @@ PassRefPtr<StringImpl> Identifier::addSlowCase(VM* vm, StringImpl* r)
     // in ::add() in the header, so we should never get here with a zero length string.
     ASSERT(r->length());
 
+    // Identifier tables belong to one thread, so a string that other threads can hold
+    // cannot become an identifier itself.
+    if (r->isThreadShared()) {
+        if (r->is8Bit())
+            return add(vm, r->characters8(), r->length());
+        return add(vm, r->characters16(), r->length());
+    }
+
     if (r->length() == 1) {
         UChar c = (*r)[0];
         if (c <= maxSingleCharacterString)
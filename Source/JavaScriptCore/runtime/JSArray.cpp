@@ -34,7 +34,6 @@
 #include "IndexingHeaderInlines.h"
 #include "PropertyNameArray.h"
 #include "Reject.h"
-#include <wtf/AVLTree.h>
 #include <wtf/Assertions.h>
 #include <wtf/OwnPtr.h>
 #include <Operations.h>
@@ -226,13 +225,6 @@ bool JSArray::deleteProperty(JSCell* cell, ExecState* exec, PropertyName propert
     return JSObject::deleteProperty(thisObject, exec, propertyName);
 }
 
-static int compareKeysForQSort(const void* a, const void* b)
-{
-    unsigned da = *static_cast<const unsigned*>(a);
-    unsigned db = *static_cast<const unsigned*>(b);
-    return (da > db) - (da < db);
-}
-
 void JSArray::getOwnNonIndexPropertyNames(JSObject* object, ExecState* exec, PropertyNameArray& propertyNames, EnumerationMode mode)
 {
     JSArray* thisObject = jsCast<JSArray*>(object);
@@ -348,38 +340,24 @@ bool JSArray::setLengthWithArrayStorage(ExecState* exec, unsigned newLength, boo
             return reject(exec, throwException, StrictModeReadonlyPropertyWriteError);
 
         if (newLength < length) {
-            // Copy any keys we might be interested in into a vector.
-            Vector<unsigned, 0, UnsafeVectorOverflow> keys;
-            keys.reserveInitialCapacity(min(map->size(), static_cast<size_t>(length - newLength)));
-            SparseArrayValueMap::const_iterator end = map->end();
-            for (SparseArrayValueMap::const_iterator it = map->begin(); it != end; ++it) {
-                unsigned index = static_cast<unsigned>(it->key);
-                if (index < length && index >= newLength)
-                    keys.append(index);
-            }
-
             // Check if the array is in sparse mode. If so there may be non-configurable
-            // properties, so we have to perform deletion with caution, if not we can
-            // delete values in any order.
+            // properties, and deletion has to stop, from the top down, at the first of them.
+            unsigned deletionEnd = newLength;
             if (map->sparseMode()) {
-                qsort(keys.begin(), keys.size(), sizeof(unsigned), compareKeysForQSort);
-                unsigned i = keys.size();
-                while (i) {
-                    unsigned index = keys[--i];
-                    SparseArrayValueMap::iterator it = map->find(index);
-                    ASSERT(it != map->notFound());
-                    if (it->value.attributes & DontDelete) {
-                        storage->setLength(index + 1);
-                        return reject(exec, throwException, "Unable to delete property.");
-                    }
-                    map->remove(it);
+                SparseArrayValueMap::const_iterator end = map->end();
+                for (SparseArrayValueMap::const_iterator it = map->lowerBound(newLength); it != end && it.key() < length; ++it) {
+                    if (it.value().attributes & DontDelete)
+                        deletionEnd = it.key() + 1;
                 }
-            } else {
-                for (unsigned i = 0; i < keys.size(); ++i)
-                    map->remove(keys[i]);
-                if (map->isEmpty())
-                    deallocateSparseIndexMap();
             }
+
+            map->removeRange(deletionEnd, length);
+            if (deletionEnd > newLength) {
+                storage->setLength(deletionEnd);
+                return reject(exec, throwException, "Unable to delete property.");
+            }
+            if (map->isEmpty() && !map->sparseMode())
+                deallocateSparseIndexMap();
         }
     }
 
@@ -678,14 +656,36 @@ void JSArray::push(ExecState* exec, JSValue value)
     }
 }
 
+// The generic shift and unshift in ArrayPrototype read each hole through the prototype chain.
+// Moving holes as holes does the same thing only if nothing on the chain can supply an indexed
+// property. Arrays only override property lookup to provide "length".
+static bool prototypeChainMayHaveIndexedProperties(JSObject* object)
+{
+    for (JSValue prototype = object->prototype(); !prototype.isNull(); prototype = asObject(prototype)->prototype()) {
+        JSObject* current = asObject(prototype);
+        Structure* structure = current->structure();
+        if (hasIndexedProperties(structure->indexingType()))
+            return true;
+        if (structure->typeInfo().overridesGetOwnPropertySlot()
+            && current->classInfo() != &JSArray::s_info && current->classInfo() != &ArrayPrototype::s_info)
+            return true;
+    }
+    return false;
+}
+
 bool JSArray::shiftCountWithArrayStorage(unsigned startIndex, unsigned count, ArrayStorage* storage)
 {
     unsigned oldLength = storage->length();
     RELEASE_ASSERT(count <= oldLength);
     
-    // If the array contains holes or is otherwise in an abnormal state,
-    // use the generic algorithm in ArrayPrototype.
-    if (oldLength != storage->m_numValuesInVector || inSparseIndexingMode() || shouldUseSlowPut(structure()->indexingType()))
+    // If the array is in an abnormal state, use the generic algorithm in ArrayPrototype.
+    if (inSparseIndexingMode() || shouldUseSlowPut(structure()->indexingType()))
+        return false;
+
+    // Holes can be moved along with the values, as long as nothing on the prototype chain
+    // could show through them.
+    bool hasHoles = oldLength != storage->m_numValuesInVector;
+    if (hasHoles && prototypeChainMayHaveIndexedProperties(this))
         return false;
 
     if (!oldLength)
@@ -693,9 +693,16 @@ bool JSArray::shiftCountWithArrayStorage(unsigned startIndex, unsigned count, Ar
     
     unsigned length = oldLength - count;
     
-    storage->m_numValuesInVector -= count;
     storage->setLength(length);
     
+    // The sparse map only holds indices beyond the vector. The vector shrinks by at most count
+    // below, so its entries stay beyond it once they have moved down by count.
+    if (SparseArrayValueMap* map = storage->m_sparseMap.get()) {
+        map->shiftEntriesDown(startIndex, count);
+        if (map->isEmpty())
+            deallocateSparseIndexMap();
+    }
+
     unsigned vectorLength = storage->vectorLength();
     if (!vectorLength)
         return true;
@@ -708,6 +715,13 @@ bool JSArray::shiftCountWithArrayStorage(unsigned startIndex, unsigned count, Ar
     
     unsigned usedVectorLength = min(vectorLength, oldLength);
     
+    if (hasHoles) {
+        unsigned end = min(startIndex + count, usedVectorLength);
+        for (unsigned i = startIndex; i < end; ++i)
+            storage->m_numValuesInVector -= !!storage->m_vector[i];
+    } else
+        storage->m_numValuesInVector -= count;
+
     vectorLength -= count;
     storage->setVectorLength(vectorLength);
     
@@ -834,21 +848,36 @@ bool JSArray::unshiftCountWithArrayStorage(ExecState* exec, unsigned startIndex,
 
     RELEASE_ASSERT(startIndex <= length);
 
-    // If the array contains holes or is otherwise in an abnormal state,
-    // use the generic algorithm in ArrayPrototype.
-    if (length != storage->m_numValuesInVector || storage->inSparseMode() || shouldUseSlowPut(structure()->indexingType()))
+    // If the array is in an abnormal state, use the generic algorithm in ArrayPrototype.
+    if (storage->inSparseMode() || shouldUseSlowPut(structure()->indexingType()))
         return false;
 
-    bool moveFront = !startIndex || startIndex < length / 2;
+    // Holes can be moved along with the values, as long as nothing on the prototype chain
+    // could show through them.
+    if (length != storage->m_numValuesInVector && prototypeChainMayHaveIndexedProperties(this))
+        return false;
 
     unsigned vectorLength = storage->vectorLength();
+    unsigned usedVectorLength = min(vectorLength, length);
+    SparseArrayValueMap* map = storage->m_sparseMap.get();
+
+    // Nothing in the vector moves if the new values go beyond it.
+    if (startIndex >= vectorLength && length > vectorLength) {
+        if (map)
+            map->shiftEntriesUp(startIndex, count);
+        return true;
+    }
+
+    // The sparse map only holds indices beyond the vector. Growing the vector at its front by
+    // exactly count keeps it that way once the map's entries have moved up by count.
+    bool moveFront = map || !startIndex || startIndex < length / 2;
 
     if (moveFront && storage->m_indexBias >= count) {
         m_butterfly = storage->butterfly()->unshift(structure(), count);
         storage = m_butterfly->arrayStorage();
         storage->m_indexBias -= count;
         storage->setVectorLength(vectorLength + count);
-    } else if (!moveFront && vectorLength - length >= count)
+    } else if (!moveFront && vectorLength - usedVectorLength >= count)
         storage = storage->butterfly()->arrayStorage();
     else if (unshiftCountSlowCase(exec->vm(), moveFront, count))
         storage = arrayStorage();
@@ -857,13 +886,16 @@ bool JSArray::unshiftCountWithArrayStorage(ExecState* exec, unsigned startIndex,
         return true;
     }
 
+    if (map)
+        map->shiftEntriesUp(startIndex, count);
+
     WriteBarrier<Unknown>* vector = storage->m_vector;
 
     if (startIndex) {
         if (moveFront)
             memmove(vector, vector + count, startIndex * sizeof(JSValue));
-        else if (length - startIndex)
-            memmove(vector + startIndex + count, vector + startIndex, (length - startIndex) * sizeof(JSValue));
+        else if (usedVectorLength - startIndex)
+            memmove(vector + startIndex + count, vector + startIndex, (usedVectorLength - startIndex) * sizeof(JSValue));
     }
 
     for (unsigned i = 0; i < count; i++)
@@ -954,35 +986,34 @@ bool JSArray::unshiftCountWithAnyIndexingType(ExecState* exec, unsigned startInd
     }
 }
 
-static int compareNumbersForQSortWithInt32(const void* a, const void* b)
-{
-    int32_t ia = static_cast<const JSValue*>(a)->asInt32();
-    int32_t ib = static_cast<const JSValue*>(b)->asInt32();
-    return ia - ib;
-}
-
-static int compareNumbersForQSortWithDouble(const void* a, const void* b)
-{
-    double da = *static_cast<const double*>(a);
-    double db = *static_cast<const double*>(b);
-    return (da > db) - (da < db);
-}
+// Orders numbers the way an (a - b) or (b - a) compare function does. NaN, which such a
+// function cannot order consistently, always sorts last so that these remain strict weak
+// orderings that std::sort can rely on.
+template<NumericSortOrder order>
+struct NumberComparator {
+    bool operator()(double a, double b) const
+    {
+        if (UNLIKELY(a != a || b != b))
+            return a == a;
+        return order == NumericSortAscending ? a < b : b < a;
+    }
+    bool operator()(JSValue a, JSValue b) const { return (*this)(a.asNumber(), b.asNumber()); }
+};
 
-static int compareNumbersForQSort(const void* a, const void* b)
-{
-    double da = static_cast<const JSValue*>(a)->asNumber();
-    double db = static_cast<const JSValue*>(b)->asNumber();
-    return (da > db) - (da < db);
-}
+template<NumericSortOrder order>
+struct Int32Comparator {
+    bool operator()(JSValue a, JSValue b) const
+    {
+        return order == NumericSortAscending ? a.asInt32() < b.asInt32() : b.asInt32() < a.asInt32();
+    }
+};
 
-static int compareByStringPairForQSort(const void* a, const void* b)
+static inline bool compareByStringPair(const ValueStringPair& a, const ValueStringPair& b)
 {
-    const ValueStringPair* va = static_cast<const ValueStringPair*>(a);
-    const ValueStringPair* vb = static_cast<const ValueStringPair*>(b);
-    return codePointCompare(va->second, vb->second);
+    return codePointCompare(a.second, b.second) < 0;
 }
 
-template<IndexingType indexingType>
+template<IndexingType indexingType, NumericSortOrder order>
 void JSArray::sortNumericVector(ExecState* exec, JSValue compareFunction, CallType callType, const CallData& callData)
 {
     ASSERT(indexingType == ArrayWithInt32 || indexingType == ArrayWithDouble || indexingType == ArrayWithContiguous || indexingType == ArrayWithArrayStorage);
@@ -1022,51 +1053,56 @@ void JSArray::sortNumericVector(ExecState* exec, JSValue compareFunction, CallTy
     if (!allValuesAreNumbers)
         return sort(exec, compareFunction, callType, callData);
     
-    // For numeric comparison, which is fast, qsort is faster than mergesort. We
-    // also don't require mergesort's stability, since there's no user visible
-    // side-effect from swapping the order of equal primitive values.
-    int (*compare)(const void*, const void*);
+    // The values are sorted in place in their unboxed form; no JS is run. Equal int32s are
+    // indistinguishable, so their relative order does not matter, but doubles may be +0
+    // and -0, which the compare function considers equal, so those sorts must be stable.
+    ASSERT(data.length() >= newRelevantLength);
     switch (indexingType) {
-    case ArrayWithInt32:
-        compare = compareNumbersForQSortWithInt32;
+    case ArrayWithInt32: {
+        JSValue* begin = reinterpret_cast<JSValue*>(data.data());
+        std::sort(begin, begin + newRelevantLength, Int32Comparator<order>());
         break;
+    }
         
-    case ArrayWithDouble:
-        compare = compareNumbersForQSortWithDouble;
-        ASSERT(sizeof(WriteBarrier<Unknown>) == sizeof(double));
+    case ArrayWithDouble: {
+        COMPILE_ASSERT(sizeof(WriteBarrier<Unknown>) == sizeof(double), double_storage_matches_value_storage);
+        double* begin = butterfly()->contiguousDouble().data();
+        std::stable_sort(begin, begin + newRelevantLength, NumberComparator<order>());
         break;
+    }
         
-    default:
-        compare = compareNumbersForQSort;
+    default: {
+        JSValue* begin = reinterpret_cast<JSValue*>(data.data());
+        std::stable_sort(begin, begin + newRelevantLength, NumberComparator<order>());
         break;
     }
-    ASSERT(data.length() >= newRelevantLength);
-    qsort(data.data(), newRelevantLength, sizeof(WriteBarrier<Unknown>), compare);
-    return;
+    }
 }
 
+template<NumericSortOrder order>
 void JSArray::sortNumeric(ExecState* exec, JSValue compareFunction, CallType callType, const CallData& callData)
 {
     ASSERT(!inSparseIndexingMode());
 
     switch (structure()->indexingType()) {
     case ArrayClass:
+    case ArrayWithUndecided:
         return;
         
     case ArrayWithInt32:
-        sortNumericVector<ArrayWithInt32>(exec, compareFunction, callType, callData);
+        sortNumericVector<ArrayWithInt32, order>(exec, compareFunction, callType, callData);
         break;
         
     case ArrayWithDouble:
-        sortNumericVector<ArrayWithDouble>(exec, compareFunction, callType, callData);
+        sortNumericVector<ArrayWithDouble, order>(exec, compareFunction, callType, callData);
         break;
         
     case ArrayWithContiguous:
-        sortNumericVector<ArrayWithContiguous>(exec, compareFunction, callType, callData);
+        sortNumericVector<ArrayWithContiguous, order>(exec, compareFunction, callType, callData);
         return;
 
     case ArrayWithArrayStorage:
-        sortNumericVector<ArrayWithArrayStorage>(exec, compareFunction, callType, callData);
+        sortNumericVector<ArrayWithArrayStorage, order>(exec, compareFunction, callType, callData);
         return;
         
     default:
@@ -1075,6 +1111,14 @@ void JSArray::sortNumeric(ExecState* exec, JSValue compareFunction, CallType cal
     }
 }
 
+void JSArray::sortNumeric(ExecState* exec, JSValue compareFunction, CallType callType, const CallData& callData, NumericSortOrder order)
+{
+    if (order == NumericSortAscending)
+        sortNumeric<NumericSortAscending>(exec, compareFunction, callType, callData);
+    else
+        sortNumeric<NumericSortDescending>(exec, compareFunction, callType, callData);
+}
+
 template <IndexingType> struct ContiguousTypeAccessor {
     typedef WriteBarrier<Unknown> Type;
     static JSValue getAsValue(ContiguousData<Type> data, size_t i) { return data[i].get(); }
@@ -1123,15 +1167,11 @@ void JSArray::sortCompactedVector(ExecState* exec, ContiguousData<StorageType> d
         
     Heap::heap(this)->pushTempSortVector(&values);
         
-    bool isSortingPrimitiveValues = true;
-
     for (size_t i = 0; i < relevantLength; i++) {
         JSValue value = ContiguousTypeAccessor<indexingType>::getAsValue(data, i);
         ASSERT(indexingType != ArrayWithInt32 || value.isInt32());
         ASSERT(!value.isUndefined());
         values[i].first = value;
-        if (indexingType != ArrayWithDouble && indexingType != ArrayWithInt32)
-            isSortingPrimitiveValues = isSortingPrimitiveValues && value.isPrimitive();
     }
         
     // FIXME: The following loop continues to call toString on subsequent values even after
@@ -1148,16 +1188,10 @@ void JSArray::sortCompactedVector(ExecState* exec, ContiguousData<StorageType> d
     // FIXME: Since we sort by string value, a fast algorithm might be to use a radix sort. That would be O(N) rather
     // than O(N log N).
         
-#if HAVE(MERGESORT)
-    if (isSortingPrimitiveValues)
-        qsort(values.begin(), values.size(), sizeof(ValueStringPair), compareByStringPairForQSort);
-    else
-        mergesort(values.begin(), values.size(), sizeof(ValueStringPair), compareByStringPairForQSort);
-#else
-    // FIXME: The qsort library function is likely to not be a stable sort.
-    // ECMAScript-262 does not specify a stable sort, but in practice, browsers perform a stable sort.
-    qsort(values.begin(), values.size(), sizeof(ValueStringPair), compareByStringPairForQSort);
-#endif
+    // Distinct values can have the same string value (e.g. 1 and "1"), so this sort must be stable.
+    // No JS runs during the sort, so it is fine for std::stable_sort to move values out of the
+    // GC-visible temporary vector.
+    std::stable_sort(values.begin(), values.end(), compareByStringPair);
     
     // If the toString function changed the length of the array or vector storage,
     // increase the length to handle the orignal number of actual values.
@@ -1246,83 +1280,112 @@ void JSArray::sort(ExecState* exec)
     }
 }
 
-struct AVLTreeNodeForArrayCompare {
-    JSValue value;
-
-    // Child pointers.  The high bit of gt is robbed and used as the
-    // balance factor sign.  The high bit of lt is robbed and used as
-    // the magnitude of the balance factor.
-    int32_t gt;
-    int32_t lt;
-};
-
-struct AVLTreeAbstractorForArrayCompare {
-    typedef int32_t handle; // Handle is an index into m_nodes vector.
-    typedef JSValue key;
-    typedef int32_t size;
-
-    Vector<AVLTreeNodeForArrayCompare, 0, UnsafeVectorOverflow> m_nodes;
-    ExecState* m_exec;
-    JSValue m_compareFunction;
-    CallType m_compareCallType;
-    const CallData* m_compareCallData;
-    OwnPtr<CachedCall> m_cachedCall;
-
-    handle get_less(handle h) { return m_nodes[h].lt & 0x7FFFFFFF; }
-    void set_less(handle h, handle lh) { m_nodes[h].lt &= 0x80000000; m_nodes[h].lt |= lh; }
-    handle get_greater(handle h) { return m_nodes[h].gt & 0x7FFFFFFF; }
-    void set_greater(handle h, handle gh) { m_nodes[h].gt &= 0x80000000; m_nodes[h].gt |= gh; }
-
-    int get_balance_factor(handle h)
-    {
-        if (m_nodes[h].gt & 0x80000000)
-            return -1;
-        return static_cast<unsigned>(m_nodes[h].lt) >> 31;
-    }
-
-    void set_balance_factor(handle h, int bf)
+class ArraySortComparator {
+public:
+    ArraySortComparator(ExecState* exec, JSValue compareFunction, CallType callType, const CallData& callData)
+        : m_exec(exec)
+        , m_compareFunction(compareFunction)
+        , m_compareCallType(callType)
+        , m_compareCallData(callData)
     {
-        if (bf == 0) {
-            m_nodes[h].lt &= 0x7FFFFFFF;
-            m_nodes[h].gt &= 0x7FFFFFFF;
-        } else {
-            m_nodes[h].lt |= 0x80000000;
-            if (bf < 0)
-                m_nodes[h].gt |= 0x80000000;
-            else
-                m_nodes[h].gt &= 0x7FFFFFFF;
-        }
+        if (callType == CallTypeJS)
+            m_cachedCall = adoptPtr(new CachedCall(exec, jsCast<JSFunction*>(compareFunction), 2));
     }
 
-    int compare_key_key(key va, key vb)
+    // Returns true only if the compare function reports a as strictly less than b. Once an
+    // exception has been raised no more JS is run, and everything compares as equal.
+    bool lessThan(JSValue a, JSValue b)
     {
-        ASSERT(!va.isUndefined());
-        ASSERT(!vb.isUndefined());
+        ASSERT(!a.isUndefined());
+        ASSERT(!b.isUndefined());
 
         if (m_exec->hadException())
-            return 1;
+            return false;
 
         double compareResult;
         if (m_cachedCall) {
             m_cachedCall->setThis(jsUndefined());
-            m_cachedCall->setArgument(0, va);
-            m_cachedCall->setArgument(1, vb);
+            m_cachedCall->setArgument(0, a);
+            m_cachedCall->setArgument(1, b);
             compareResult = m_cachedCall->call().toNumber(m_cachedCall->newCallFrame(m_exec));
         } else {
             MarkedArgumentBuffer arguments;
-            arguments.append(va);
-            arguments.append(vb);
-            compareResult = call(m_exec, m_compareFunction, m_compareCallType, *m_compareCallData, jsUndefined(), arguments).toNumber(m_exec);
+            arguments.append(a);
+            arguments.append(b);
+            compareResult = call(m_exec, m_compareFunction, m_compareCallType, m_compareCallData, jsUndefined(), arguments).toNumber(m_exec);
         }
-        return (compareResult < 0) ? -1 : 1; // Not passing equality through, because we need to store all values, even if equivalent.
+        return compareResult < 0;
     }
 
-    int compare_key_node(key k, handle h) { return compare_key_key(k, m_nodes[h].value); }
-    int compare_node_node(handle h1, handle h2) { return compare_key_key(m_nodes[h1].value, m_nodes[h2].value); }
-
-    static handle null() { return 0x7FFFFFFF; }
+private:
+    ExecState* m_exec;
+    JSValue m_compareFunction;
+    CallType m_compareCallType;
+    const CallData& m_compareCallData;
+    OwnPtr<CachedCall> m_cachedCall;
 };
 
+// Stable bottom-up merge sort of the values in the first members of buffer, using scratch as
+// the other half of the ping-pong. Both vectors must be registered as temp sort vectors since
+// the compare function can trigger GC: every pass reads one and writes the other, so the
+// source of a pass always holds every value. Runs are seeded with insertion sort, and two
+// runs that are already in order are copied without merging, so presorted input costs only
+// about n comparisons.
+static void mergeSortWithCompareFunction(Vector<ValueStringPair, 0, UnsafeVectorOverflow>& buffer, Vector<ValueStringPair, 0, UnsafeVectorOverflow>& scratch, ArraySortComparator& comparator)
+{
+    static const size_t initialRunLength = 8;
+
+    size_t size = buffer.size();
+    ASSERT(scratch.size() == size);
+
+    for (size_t runStart = 0; runStart < size; runStart += initialRunLength) {
+        size_t runEnd = min(runStart + initialRunLength, size);
+        for (size_t i = runStart + 1; i < runEnd; ++i) {
+            JSValue value = buffer[i].first;
+            size_t j = i;
+            for (; j > runStart && comparator.lessThan(value, buffer[j - 1].first); --j)
+                buffer[j].first = buffer[j - 1].first;
+            buffer[j].first = value;
+        }
+    }
+
+    ValueStringPair* source = buffer.data();
+    ValueStringPair* destination = scratch.data();
+    for (size_t width = initialRunLength; width < size; width *= 2) {
+        for (size_t left = 0; left < size; left += 2 * width) {
+            size_t middle = min(left + width, size);
+            size_t right = min(left + 2 * width, size);
+
+            if (middle == right || !comparator.lessThan(source[middle].first, source[middle - 1].first)) {
+                for (size_t i = left; i < right; ++i)
+                    destination[i].first = source[i].first;
+                continue;
+            }
+
+            size_t leftIndex = left;
+            size_t rightIndex = middle;
+            size_t i = left;
+            while (leftIndex < middle && rightIndex < right) {
+                // Take from the right run only when it is strictly less, which keeps the sort stable.
+                if (comparator.lessThan(source[rightIndex].first, source[leftIndex].first))
+                    destination[i++].first = source[rightIndex++].first;
+                else
+                    destination[i++].first = source[leftIndex++].first;
+            }
+            while (leftIndex < middle)
+                destination[i++].first = source[leftIndex++].first;
+            while (rightIndex < right)
+                destination[i++].first = source[rightIndex++].first;
+        }
+        std::swap(source, destination);
+    }
+
+    if (source != buffer.data()) {
+        for (size_t i = 0; i < size; ++i)
+            buffer[i].first = source[i].first;
+    }
+}
+
 template<IndexingType indexingType>
 void JSArray::sortVector(ExecState* exec, JSValue compareFunction, CallType callType, const CallData& callData)
 {
@@ -1331,85 +1394,70 @@ void JSArray::sortVector(ExecState* exec, JSValue compareFunction, CallType call
     
     // FIXME: This ignores exceptions raised in the compare function or in toNumber.
         
-    // The maximum tree depth is compiled in - but the caller is clearly up to no good
-    // if a larger array is passed.
-    ASSERT(m_butterfly->publicLength() <= static_cast<unsigned>(std::numeric_limits<int>::max()));
-    if (m_butterfly->publicLength() > static_cast<unsigned>(std::numeric_limits<int>::max()))
-        return;
-        
     unsigned usedVectorLength = relevantLength<indexingType>();
-    unsigned nodeCount = usedVectorLength;
-        
-    if (!nodeCount)
+    if (!usedVectorLength)
         return;
         
-    AVLTree<AVLTreeAbstractorForArrayCompare, 44> tree; // Depth 44 is enough for 2^31 items
-    tree.abstractor().m_exec = exec;
-    tree.abstractor().m_compareFunction = compareFunction;
-    tree.abstractor().m_compareCallType = callType;
-    tree.abstractor().m_compareCallData = &callData;
-    tree.abstractor().m_nodes.grow(nodeCount);
-        
-    if (callType == CallTypeJS)
-        tree.abstractor().m_cachedCall = adoptPtr(new CachedCall(exec, jsCast<JSFunction*>(compareFunction), 2));
+    // FIXME: If the compare function modifies the array, the vector, map, etc. could be modified
+    // right out from under us while we're sorting here.
         
-    if (!tree.abstractor().m_nodes.begin()) {
+    Vector<ValueStringPair, 0, UnsafeVectorOverflow> values;
+    if (!values.tryReserveCapacity(usedVectorLength)) {
         throwOutOfMemoryError(exec);
         return;
     }
         
-    // FIXME: If the compare function modifies the array, the vector, map, etc. could be modified
-    // right out from under us while we're building the tree here.
-        
-    unsigned numDefined = 0;
     unsigned numUndefined = 0;
     
-    // Iterate over the array, ignoring missing values, counting undefined ones, and inserting all other ones into the tree.
-    for (; numDefined < usedVectorLength; ++numDefined) {
-        if (numDefined >= m_butterfly->vectorLength())
-            break;
-        JSValue v = getHolyIndexQuickly(numDefined);
-        if (!v || v.isUndefined())
-            break;
-        tree.abstractor().m_nodes[numDefined].value = v;
-        tree.insert(numDefined);
-    }
-    for (unsigned i = numDefined; i < usedVectorLength; ++i) {
+    // Iterate over the array, ignoring missing values, counting undefined ones, and collecting all other ones.
+    for (unsigned i = 0; i < usedVectorLength; ++i) {
         if (i >= m_butterfly->vectorLength())
             break;
         JSValue v = getHolyIndexQuickly(i);
-        if (v) {
-            if (v.isUndefined())
-                ++numUndefined;
-            else {
-                tree.abstractor().m_nodes[numDefined].value = v;
-                tree.insert(numDefined);
-                ++numDefined;
-            }
-        }
+        if (!v)
+            continue;
+        if (v.isUndefined())
+            ++numUndefined;
+        else
+            values.uncheckedAppend(ValueStringPair(v, String()));
     }
     
+    unsigned numDefined = values.size();
+    Vector<ValueStringPair, 0, UnsafeVectorOverflow> scratch;
+    if (!scratch.tryReserveCapacity(numDefined)) {
+        throwOutOfMemoryError(exec);
+        return;
+    }
+    scratch.resize(numDefined);
+    
+    Heap::heap(this)->pushTempSortVector(&values);
+    Heap::heap(this)->pushTempSortVector(&scratch);
+    {
+        ArraySortComparator comparator(exec, compareFunction, callType, callData);
+        mergeSortWithCompareFunction(values, scratch, comparator);
+    }
+    Heap::heap(this)->popTempSortVector(&scratch);
+    
     unsigned newUsedVectorLength = numDefined + numUndefined;
         
     // The array size may have changed. Figure out the new bounds.
     unsigned newestUsedVectorLength = currentRelevantLength();
         
-    unsigned elementsToExtractThreshold = min(min(newestUsedVectorLength, numDefined), static_cast<unsigned>(tree.abstractor().m_nodes.size()));
+    unsigned elementsToExtractThreshold = min(newestUsedVectorLength, numDefined);
     unsigned undefinedElementsThreshold = min(newestUsedVectorLength, newUsedVectorLength);
     unsigned clearElementsThreshold = min(newestUsedVectorLength, usedVectorLength);
         
     // Copy the values back into m_storage.
-    AVLTree<AVLTreeAbstractorForArrayCompare, 44>::Iterator iter;
-    iter.start_iter_least(tree);
     VM& vm = exec->vm();
     for (unsigned i = 0; i < elementsToExtractThreshold; ++i) {
         ASSERT(i < butterfly()->vectorLength());
         if (structure()->indexingType() == ArrayWithDouble)
-            butterfly()->contiguousDouble()[i] = tree.abstractor().m_nodes[*iter].value.asNumber();
+            butterfly()->contiguousDouble()[i] = values[i].first.asNumber();
         else
-            currentIndexingData()[i].set(vm, this, tree.abstractor().m_nodes[*iter].value);
-        ++iter;
+            currentIndexingData()[i].set(vm, this, values[i].first);
     }
+    Heap::heap(this)->popTempSortVector(&values);
+
     // Put undefined values back in.
     switch (structure()->indexingType()) {
     case ArrayWithInt32:
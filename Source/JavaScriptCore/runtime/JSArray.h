@@ -30,6 +30,10 @@ namespace JSC {
 class JSArray;
 class LLIntOffsetsExtractor;
 
+// The orders imposed by (a - b) and (b - a) compare functions, which sortNumeric() applies
+// without calling the function.
+enum NumericSortOrder { NumericSortAscending, NumericSortDescending };
+
 class JSArray : public JSNonFinalObject {
     friend class LLIntOffsetsExtractor;
     friend class Walker;
@@ -66,7 +70,7 @@ public:
 
     void sort(ExecState*);
     void sort(ExecState*, JSValue compareFunction, CallType, const CallData&);
-    void sortNumeric(ExecState*, JSValue compareFunction, CallType, const CallData&);
+    void sortNumeric(ExecState*, JSValue compareFunction, CallType, const CallData&, NumericSortOrder);
 
     void push(ExecState*, JSValue);
     JSValue pop(ExecState*);
@@ -158,7 +162,10 @@ private:
     bool unshiftCountWithArrayStorage(ExecState*, unsigned startIndex, unsigned count, ArrayStorage*);
     bool unshiftCountSlowCase(VM&, bool, unsigned);
 
-    template<IndexingType indexingType>
+    template<NumericSortOrder>
+    void sortNumeric(ExecState*, JSValue compareFunction, CallType, const CallData&);
+
+    template<IndexingType indexingType, NumericSortOrder>
     void sortNumericVector(ExecState*, JSValue compareFunction, CallType, const CallData&);
         
     template<IndexingType indexingType, typename StorageType>
@@ -298,9 +298,9 @@ JSString* JSValue::toStringSlowCase(ExecState* exec) const
     VM& vm = exec->vm();
     ASSERT(!isString());
     if (isInt32())
-        return jsString(&vm, vm.numericStrings.add(asInt32()));
+        return vm.numericStrings.addJSString(vm, asInt32());
     if (isDouble())
-        return jsString(&vm, vm.numericStrings.add(asDouble()));
+        return vm.numericStrings.addJSString(vm, asDouble());
     if (isTrue())
         return vm.smallStrings.trueString();
     if (isFalse())
@@ -110,21 +110,27 @@ static inline double timeToMS(double hour, double min, double sec, double ms)
     return (((hour * minutesPerHour + min) * secondsPerMinute + sec) * msPerSecond + ms);
 }
 
-static inline int msToSeconds(double ms)
+// Splits a day count relative to 1970-01-01 into its civil date, without the
+// year estimation and month-by-month searches of the generic WTF helpers. This
+// works in 400 year eras starting on March 1st, so that the leap day is the
+// last day of the (shifted) year.
+static inline void daysToCivil(int days, int& year, int& month, int& monthDay, int& yearDay)
 {
-    double result = fmod(floor(ms / msPerSecond), secondsPerMinute);
-    if (result < 0)
-        result += secondsPerMinute;
-    return static_cast<int>(result);
-}
-
-// 0: Sunday, 1: Monday, etc.
-static inline int msToWeekDay(double ms)
-{
-    int wd = (static_cast<int>(msToDays(ms)) + 4) % 7;
-    if (wd < 0)
-        wd += 7;
-    return wd;
+    const int daysFromEraStartTo1970 = 719468; // From 0000-03-01.
+    const int daysPerEra = 146097;
+    
+    int z = days + daysFromEraStartTo1970;
+    int era = (z >= 0 ? z : z - (daysPerEra - 1)) / daysPerEra;
+    int dayOfEra = z - era * daysPerEra; // [0, 146096]
+    int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / (daysPerEra - 1)) / 365; // [0, 399]
+    int dayOfMarchYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100); // [0, 365]
+    int marchMonth = (5 * dayOfMarchYear + 2) / 153; // [0, 11], 0 is March.
+    bool isJanuaryOrFebruary = marchMonth >= 10;
+    
+    year = yearOfEra + era * 400 + isJanuaryOrFebruary;
+    month = marchMonth + (isJanuaryOrFebruary ? -10 : 2);
+    monthDay = dayOfMarchYear - (153 * marchMonth + 2) / 5 + 1;
+    yearDay = isJanuaryOrFebruary ? dayOfMarchYear - 306 : dayOfMarchYear + 59 + isLeapYear(year);
 }
 
 // Get the combined UTC + DST offset for the time passed in.
@@ -175,6 +181,35 @@ static LocalTimeOffset localTimeOffset(ExecState* exec, double ms)
             cache.offset = offset;
             return offset;
         }
+    } else if (start <= end) {
+        // Dates are frequently walked backwards too (think of a calendar
+        // that pages through previous months), so grow the interval towards
+        // the past the same way we grow it towards the future.
+        double newStart = start - cache.increment;
+
+        if (newStart <= ms) {
+            LocalTimeOffset startOffset = calculateLocalTimeOffset(newStart);
+            if (cache.offset == startOffset) {
+                cache.start = newStart;
+                cache.increment = msPerMonth;
+                return startOffset;
+            }
+            LocalTimeOffset offset = calculateLocalTimeOffset(ms);
+            if (offset == startOffset) {
+                // The DST offset change lies between the given time and the
+                // old start of the interval.
+                cache.start = newStart;
+                cache.end = ms;
+                cache.increment = msPerMonth;
+            } else {
+                // The change lies between the new start of the interval and
+                // the given time.
+                cache.increment /= 3;
+                cache.start = ms;
+            }
+            cache.offset = offset;
+            return offset;
+        }
     }
 
     // Compute the DST offset for the time and shrink the cache interval
@@ -209,14 +244,25 @@ void msToGregorianDateTime(ExecState* exec, double ms, bool outputIsUTC, Gregori
         ms += localTime.offset;
     }
 
-    const int year = msToYear(ms);
-    tm.setSecond(msToSeconds(ms));
-    tm.setMinute(msToMinutes(ms));
-    tm.setHour(msToHours(ms));
-    tm.setWeekDay(msToWeekDay(ms));
-    tm.setYearDay(dayInYear(ms, year));
-    tm.setMonthDay(dayInMonthFromDayInYear(tm.yearDay(), isLeapYear(year)));
-    tm.setMonth(monthFromDayInYear(tm.yearDay(), isLeapYear(year)));
+    // Time values are at most 10^8 days away from the epoch, so everything
+    // below fits in an int.
+    double days = msToDays(ms);
+    int msInDay = static_cast<int>(ms - days * msPerDay);
+    int year;
+    int month;
+    int monthDay;
+    int yearDay;
+    daysToCivil(static_cast<int>(days), year, month, monthDay, yearDay);
+    
+    int weekDay = (static_cast<int>(days) + 4) % 7; // 1970-01-01 was a Thursday.
+    int secondsInDay = msInDay / 1000;
+    tm.setSecond(secondsInDay % 60);
+    tm.setMinute((secondsInDay / 60) % 60);
+    tm.setHour(secondsInDay / 3600);
+    tm.setWeekDay(weekDay < 0 ? weekDay + 7 : weekDay);
+    tm.setYearDay(yearDay);
+    tm.setMonthDay(monthDay);
+    tm.setMonth(month);
     tm.setYear(year);
     tm.setIsDST(localTime.isDST);
     tm.setUtcOffset(localTime.offset / WTF::msPerSecond);
@@ -240,13 +286,14 @@ double parseDateFromNullTerminatedCharacters(ExecState* exec, const char* dateSt
 
 double parseDate(ExecState* exec, const String& date)
 {
-    if (date == exec->vm().cachedDateString)
-        return exec->vm().cachedDateStringValue;
+    ParsedDateCache::Entry& entry = exec->vm().parsedDateCache.lookup(date);
+    if (date == entry.string)
+        return entry.value;
     double value = parseES5DateFromNullTerminatedCharacters(date.utf8().data());
     if (std::isnan(value))
         value = parseDateFromNullTerminatedCharacters(exec, date.utf8().data());
-    exec->vm().cachedDateString = date;
-    exec->vm().cachedDateStringValue = value;
+    entry.string = date;
+    entry.value = value;
     return value;
 }
 
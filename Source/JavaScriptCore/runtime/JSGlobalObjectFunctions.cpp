@@ -1,7 +1,7 @@
 /*
  *  Copyright (C) 1999-2002 Harri Porten (porten@kde.org)
  *  Copyright (C) 2001 Peter Kelly (pmk@post.com)
- *  Copyright (C) 2003, 2004, 2005, 2006, 2007, 2008, 2009, 2012 Apple Inc. All rights reserved.
+ *  Copyright (C) 2003, 2004, 2005, 2006, 2007, 2008, 2009, 2012, 2013 Apple Inc. All rights reserved.
  *  Copyright (C) 2007 Cameron Zwarich (cwzwarich@uwaterloo.ca)
  *  Copyright (C) 2007 Maks Orlovich
  *
@@ -231,6 +231,91 @@ double parseIntOverflow(const UChar* s, int length, int radix)
     return number;
 }
 
+// Consumes the run of decimal digits at data and accumulates them into value, which wraps
+// around if there are more than 19 of them. Returns the number of digits in the run.
+template <typename CharType>
+static ALWAYS_INLINE unsigned consumeDecimalDigits(const CharType*& data, const CharType* end, uint64_t& value)
+{
+    const CharType* start = data;
+    for (; data < end && isASCIIDigit(*data); ++data)
+        value = value * 10 + (*data - '0');
+    return data - start;
+}
+
+// Tests eight characters for all being digits with one 64-bit load, and if they are, converts
+// them with three multiplications rather than eight.
+static ALWAYS_INLINE bool readEightDecimalDigits(const LChar* data, uint32_t& value)
+{
+#if CPU(BIG_ENDIAN)
+    UNUSED_PARAM(data);
+    UNUSED_PARAM(value);
+    return false;
+#else
+    uint64_t chunk;
+    memcpy(&chunk, data, sizeof(chunk));
+    if (((chunk & 0xF0F0F0F0F0F0F0F0ull) | (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) != 0x3333333333333333ull)
+        return false;
+    chunk -= 0x3030303030303030ull;
+    chunk = chunk * 10 + (chunk >> 8);
+    chunk = ((chunk & 0x000000FF000000FFull) * (100 + (1000000ull << 32)) + ((chunk >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32))) >> 32;
+    value = static_cast<uint32_t>(chunk);
+    return true;
+#endif
+}
+
+static ALWAYS_INLINE unsigned consumeDecimalDigits(const LChar*& data, const LChar* end, uint64_t& value)
+{
+    const LChar* start = data;
+    uint32_t eightDigits;
+    while (end - data >= 8 && readEightDecimalDigits(data, eightDigits)) {
+        value = value * 100000000 + eightDigits;
+        data += 8;
+    }
+    for (; data < end && isASCIIDigit(*data); ++data)
+        value = value * 10 + (*data - '0');
+    return data - start;
+}
+
+// With at most this many digits in all, a decimal number without an exponent is an integer that
+// a double holds exactly, divided by a power of ten that a double also holds exactly. A single
+// division rounds that correctly, so the general algorithm is not needed.
+static const unsigned maxDigitsInSimpleDecimalLiteral = 15;
+
+// Parses [+-]digits[.digits] forms that fit maxDigitsInSimpleDecimalLiteral. Returns false,
+// without consuming anything, for all other input.
+template <typename CharType>
+static ALWAYS_INLINE bool parseSimpleDecimalLiteral(const CharType*& data, const CharType* end, double& result)
+{
+    static const double powersOfTen[maxDigitsInSimpleDecimalLiteral + 1] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15
+    };
+
+    const CharType* p = data;
+    bool negative = false;
+    if (*p == '+' || *p == '-') {
+        negative = *p == '-';
+        ++p;
+    }
+
+    uint64_t mantissa = 0;
+    unsigned digitCount = consumeDecimalDigits(p, end, mantissa);
+    unsigned fractionDigitCount = 0;
+    if (p < end && *p == '.') {
+        ++p;
+        fractionDigitCount = consumeDecimalDigits(p, end, mantissa);
+        digitCount += fractionDigitCount;
+    }
+    if (!digitCount || digitCount > maxDigitsInSimpleDecimalLiteral)
+        return false;
+    if (p < end && (*p | 0x20) == 'e')
+        return false;
+
+    double number = static_cast<double>(mantissa) / powersOfTen[fractionDigitCount];
+    result = negative ? -number : number;
+    data = p;
+    return true;
+}
+
 // ES5.1 15.1.2.2
 template <typename CharType>
 ALWAYS_INLINE
@@ -285,6 +370,17 @@ static double parseInt(const String& s, const CharType* data, int radix)
     //     and if R is not 2, 4, 8, 10, 16, or 32, then mathInt may be an implementation-dependent approximation to the
     //     mathematical integer value that is represented by Z in radix-R notation.)
     // 14. Let number be the Number value for mathInt.
+    if (radix == 10) {
+        const CharType* digits = data + p;
+        uint64_t value = 0;
+        unsigned digitCount = consumeDecimalDigits(digits, data + length, value);
+        // 12. If Z is empty, return NaN.
+        if (!digitCount)
+            return QNaN;
+        if (digitCount <= maxDigitsInSimpleDecimalLiteral)
+            return sign * static_cast<double>(value);
+    }
+
     int firstDigitPosition = p;
     bool sawDigit = false;
     double number = 0;
@@ -366,8 +462,12 @@ static double jsStrDecimalLiteral(const CharType*& data, const CharType* end)
 {
     RELEASE_ASSERT(data < end);
 
+    double number;
+    if (parseSimpleDecimalLiteral(data, end, number))
+        return number;
+
     size_t parsedLength;
-    double number = parseDouble(data, end - data, parsedLength);
+    number = parseDouble(data, end - data, parsedLength);
     if (parsedLength) {
         data += parsedLength;
         return number;
@@ -245,13 +245,13 @@ Local<Unknown> Stringifier::stringify(Handle<Unknown> value)
     PropertyNameForFunctionCall emptyPropertyName(m_exec->vm().propertyNames->emptyIdentifier);
     object->putDirect(m_exec->vm(), m_exec->vm().propertyNames->emptyIdentifier, value.get());
 
-    StringBuilder result;
+    StringBuilder result(StringBuilder::Chunked);
     if (appendStringifiedValue(result, value.get(), object, emptyPropertyName) != StringifySucceeded)
         return Local<Unknown>(m_exec->vm(), jsUndefined());
     if (m_exec->hadException())
         return Local<Unknown>(m_exec->vm(), jsNull());
 
-    return Local<Unknown>(m_exec->vm(), jsString(m_exec, result.toString()));
+    return Local<Unknown>(m_exec->vm(), jsString(m_exec, result));
 }
 
 template <typename CharType>
@@ -319,9 +319,8 @@ bool JSObject::getOwnPropertySlotByIndex(JSCell* cell, ExecState* exec, unsigned
                 return true;
             }
         } else if (SparseArrayValueMap* map = storage->m_sparseMap.get()) {
-            SparseArrayValueMap::iterator it = map->find(i);
-            if (it != map->notFound()) {
-                it->value.get(slot);
+            if (SparseArrayEntry* entry = map->find(i)) {
+                entry->get(slot);
                 return true;
             }
         }
@@ -555,7 +554,7 @@ ArrayStorage* JSObject::enterDictionaryIndexingModeWhenArrayStorageAlreadyExists
         // This will always be a new entry in the map, so no need to check we can write,
         // and attributes are default so no need to set them.
         if (value)
-            map->add(this, i).iterator->value.set(vm, this, value);
+            map->add(this, i).entry->set(vm, this, value);
     }
 
     Butterfly* newButterfly = storage->butterfly()->resizeArray(vm, structure(), 0, ArrayStorage::sizeFor(0));
@@ -1311,11 +1310,10 @@ bool JSObject::deletePropertyByIndex(JSCell* cell, ExecState* exec, unsigned i)
                 --storage->m_numValuesInVector;
             }
         } else if (SparseArrayValueMap* map = storage->m_sparseMap.get()) {
-            SparseArrayValueMap::iterator it = map->find(i);
-            if (it != map->notFound()) {
-                if (it->value.attributes & DontDelete)
+            if (SparseArrayEntry* entry = map->find(i)) {
+                if (entry->attributes & DontDelete)
                     return false;
-                map->remove(it);
+                map->remove(i);
             }
         }
         
@@ -1471,6 +1469,7 @@ void JSObject::getOwnPropertyNames(JSObject* object, ExecState* exec, PropertyNa
     // FIXME: Filling PropertyNameArray with an identifier for every integer
     // is incredibly inefficient for large arrays. We need a different approach,
     // which almost certainly means a different structure for PropertyNameArray.
+    bool isFirstToAddNames = !propertyNames.size();
     switch (object->structure()->indexingType()) {
     case ALL_BLANK_INDEXING_TYPES:
     case ALL_UNDECIDED_INDEXING_TYPES:
@@ -1485,6 +1484,8 @@ void JSObject::getOwnPropertyNames(JSObject* object, ExecState* exec, PropertyNa
                 continue;
             propertyNames.add(Identifier::from(exec, i));
         }
+        if (isFirstToAddNames && propertyNames.size() == usedLength)
+            propertyNames.setNumDenseIndexedNamesForObject(object, usedLength);
         break;
     }
         
@@ -1497,6 +1498,8 @@ void JSObject::getOwnPropertyNames(JSObject* object, ExecState* exec, PropertyNa
                 continue;
             propertyNames.add(Identifier::from(exec, i));
         }
+        if (isFirstToAddNames && propertyNames.size() == usedLength)
+            propertyNames.setNumDenseIndexedNamesForObject(object, usedLength);
         break;
     }
         
@@ -1510,18 +1513,12 @@ void JSObject::getOwnPropertyNames(JSObject* object, ExecState* exec, PropertyNa
         }
         
         if (SparseArrayValueMap* map = storage->m_sparseMap.get()) {
-            Vector<unsigned, 0, UnsafeVectorOverflow> keys;
-            keys.reserveInitialCapacity(map->size());
-            
+            // The map hands out its entries in index order, so there is nothing to sort.
             SparseArrayValueMap::const_iterator end = map->end();
             for (SparseArrayValueMap::const_iterator it = map->begin(); it != end; ++it) {
-                if (mode == IncludeDontEnumProperties || !(it->value.attributes & DontEnum))
-                    keys.uncheckedAppend(static_cast<unsigned>(it->key));
+                if (mode == IncludeDontEnumProperties || !(it.value().attributes & DontEnum))
+                    propertyNames.add(Identifier::from(exec, it.key()));
             }
-            
-            std::sort(keys.begin(), keys.end());
-            for (unsigned i = 0; i < keys.size(); ++i)
-                propertyNames.add(Identifier::from(exec, keys[i]));
         }
         break;
     }
@@ -1537,11 +1534,12 @@ void JSObject::getOwnNonIndexPropertyNames(JSObject* object, ExecState* exec, Pr
 {
     getClassPropertyNames(exec, object->classInfo(), propertyNames, mode, object->staticFunctionsReified());
 
-    bool canCachePropertiesFromStructure = !propertyNames.size();
+    size_t numDenseIndexedNames = propertyNames.numDenseIndexedNames();
+    bool canCachePropertiesFromStructure = propertyNames.size() == numDenseIndexedNames;
     object->structure()->getPropertyNamesFromStructure(exec->vm(), propertyNames, mode);
 
     if (canCachePropertiesFromStructure)
-        propertyNames.setNumCacheableSlotsForObject(object, propertyNames.size());
+        propertyNames.setNumCacheableSlotsForObject(object, propertyNames.size() - numDenseIndexedNames);
 }
 
 double JSObject::toNumber(ExecState* exec) const
@@ -1630,6 +1628,8 @@ bool JSObject::removeDirect(VM& vm, PropertyName propertyName)
         if (offset == invalidOffset)
             return false;
         putDirectUndefined(offset);
+        if (structure()->shouldFlattenAfterDeletion())
+            flattenDictionaryObject(vm);
         return true;
     }
 
@@ -1715,14 +1715,14 @@ bool JSObject::defineOwnIndexedProperty(ExecState* exec, unsigned index, Propert
 
     // 1. Let current be the result of calling the [[GetOwnProperty]] internal method of O with property name P.
     SparseArrayValueMap::AddResult result = map->add(this, index);
-    SparseArrayEntry* entryInMap = &result.iterator->value;
+    SparseArrayEntry* entryInMap = result.entry;
 
     // 2. Let extensible be the value of the [[Extensible]] internal property of O.
     // 3. If current is undefined and extensible is false, then Reject.
     // 4. If current is undefined and extensible is true, then
     if (result.isNewEntry) {
         if (!isExtensible()) {
-            map->remove(result.iterator);
+            map->remove(index);
             return reject(exec, throwException, "Attempting to define property on object that is not extensible.");
         }
 
@@ -1824,6 +1824,58 @@ void JSObject::deallocateSparseIndexMap()
         arrayStorage->m_sparseMap.clear();
 }
 
+// Called when an array's sparse map has been folded back into its vector, at which point it
+// may only be using ArrayStorage because it used to be sparse. Give such arrays back the
+// indexing shape that the JITs handle inline. Arrays that have left their global object's
+// original structures may be relied on to keep their indexing type, so they are left alone.
+void JSObject::convertArrayStorageToDenseShapeIfPossible(VM& vm)
+{
+    ASSERT(hasArrayStorage(structure()->indexingType()));
+    ArrayStorage* storage = arrayStorage();
+    if (storage->m_sparseMap)
+        return;
+
+    JSGlobalObject* globalObject = structure()->globalObject();
+    if (!globalObject || structure() != globalObject->originalArrayStructureForIndexingType(ArrayWithArrayStorage))
+        return;
+
+    unsigned length = storage->length();
+    unsigned vectorLength = storage->vectorLength();
+    ASSERT(length <= vectorLength);
+
+    IndexingType indexingType = ArrayWithInt32;
+    for (unsigned i = 0; i < length && indexingType != ArrayWithContiguous; ++i) {
+        JSValue value = storage->m_vector[i].get();
+        if (!value || value.isInt32())
+            continue;
+        if (value.isDouble() && value.asDouble() == value.asDouble())
+            indexingType = ArrayWithDouble;
+        else
+            indexingType = ArrayWithContiguous;
+    }
+
+    Structure* newStructure = globalObject->originalArrayStructureForIndexingType(indexingType);
+    if (newStructure->indexingType() != indexingType)
+        return;
+
+    ASSERT(!structure()->outOfLineCapacity());
+    Butterfly* newButterfly = Butterfly::createUninitialized(vm, 0, 0, true, vectorLength * sizeof(EncodedJSValue));
+    newButterfly->setPublicLength(length);
+    newButterfly->setVectorLength(vectorLength);
+    for (unsigned i = 0; i < vectorLength; ++i) {
+        JSValue value = i < length ? storage->m_vector[i].get() : JSValue();
+        if (indexingType == ArrayWithDouble)
+            newButterfly->contiguousDouble()[i] = value ? value.asNumber() : QNaN;
+        else if (value)
+            newButterfly->contiguous()[i].setWithoutWriteBarrier(value);
+        else
+            newButterfly->contiguous()[i].clear();
+    }
+
+    structure()->notifyTransitionFromThisStructure();
+    setButterfly(vm, newButterfly, newStructure);
+}
+
 bool JSObject::attemptToInterceptPutByIndexOnHoleForPrototype(ExecState* exec, JSValue thisValue, unsigned i, JSValue value, bool shouldThrow)
 {
     for (JSObject* current = this; ;) {
@@ -1834,9 +1886,9 @@ bool JSObject::attemptToInterceptPutByIndexOnHoleForPrototype(ExecState* exec, J
         
         ArrayStorage* storage = current->arrayStorageOrNull();
         if (storage && storage->m_sparseMap) {
-            SparseArrayValueMap::iterator iter = storage->m_sparseMap->find(i);
-            if (iter != storage->m_sparseMap->notFound() && (iter->value.attributes & (Accessor | ReadOnly))) {
-                iter->value.put(exec, thisValue, storage->m_sparseMap.get(), value, shouldThrow);
+            SparseArrayEntry* entry = storage->m_sparseMap->find(i);
+            if (entry && (entry->attributes & (Accessor | ReadOnly))) {
+                entry->put(exec, thisValue, storage->m_sparseMap.get(), value, shouldThrow);
                 return true;
             }
         }
@@ -1978,7 +2030,7 @@ void JSObject::putByIndexBeyondVectorLengthWithArrayStorage(ExecState* exec, uns
     WriteBarrier<Unknown>* vector = storage->m_vector;
     SparseArrayValueMap::const_iterator end = map->end();
     for (SparseArrayValueMap::const_iterator it = map->begin(); it != end; ++it)
-        vector[it->key].set(vm, this, it->value.getNonSparseMode());
+        vector[it.key()].set(vm, this, it.value().getNonSparseMode());
     deallocateSparseIndexMap();
 
     // Store the new property into the vector.
@@ -1986,6 +2038,8 @@ void JSObject::putByIndexBeyondVectorLengthWithArrayStorage(ExecState* exec, uns
     if (!valueSlot)
         ++storage->m_numValuesInVector;
     valueSlot.set(vm, this, value);
+
+    convertArrayStorageToDenseShapeIfPossible(vm);
 }
 
 void JSObject::putByIndexBeyondVectorLength(ExecState* exec, unsigned i, JSValue value, bool shouldThrow)
@@ -2124,7 +2178,7 @@ bool JSObject::putDirectIndexBeyondVectorLengthWithArrayStorage(ExecState* exec,
     WriteBarrier<Unknown>* vector = storage->m_vector;
     SparseArrayValueMap::const_iterator end = map->end();
     for (SparseArrayValueMap::const_iterator it = map->begin(); it != end; ++it)
-        vector[it->key].set(vm, this, it->value.getNonSparseMode());
+        vector[it.key()].set(vm, this, it.value().getNonSparseMode());
     deallocateSparseIndexMap();
 
     // Store the new property into the vector.
@@ -2132,6 +2186,8 @@ bool JSObject::putDirectIndexBeyondVectorLengthWithArrayStorage(ExecState* exec,
     if (!valueSlot)
         ++storage->m_numValuesInVector;
     valueSlot.set(vm, this, value);
+
+    convertArrayStorageToDenseShapeIfPossible(vm);
     return true;
 }
 
@@ -2446,10 +2502,10 @@ bool JSObject::getOwnPropertyDescriptor(JSObject* object, ExecState* exec, Prope
             return true;
         }
         if (SparseArrayValueMap* map = storage->m_sparseMap.get()) {
-            SparseArrayValueMap::iterator it = map->find(i);
-            if (it == map->notFound())
+            SparseArrayEntry* entry = map->find(i);
+            if (!entry)
                 return false;
-            it->value.get(descriptor);
+            entry->get(descriptor);
             return true;
         }
         return false;
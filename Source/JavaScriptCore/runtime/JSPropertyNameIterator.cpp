@@ -29,50 +29,60 @@
 #include "config.h"
 #include "JSPropertyNameIterator.h"
 
+#include "ArrayPrototype.h"
+#include "JSArray.h"
 #include "JSGlobalObject.h"
 
 namespace JSC {
 
 const ClassInfo JSPropertyNameIterator::s_info = { "JSPropertyNameIterator", 0, 0, 0, CREATE_METHOD_TABLE(JSPropertyNameIterator) };
 
-inline JSPropertyNameIterator::JSPropertyNameIterator(ExecState* exec, PropertyNameArrayData* propertyNameArrayData, size_t numCacheableSlots)
+inline JSPropertyNameIterator::JSPropertyNameIterator(ExecState* exec, PropertyNameArrayData* propertyNameArrayData, size_t numCacheableSlots, size_t numDenseIndexedNames)
     : JSCell(exec->vm(), exec->vm().propertyNameIteratorStructure.get())
+    , m_cachedIndexedLength(numDenseIndexedNames)
     , m_numCacheableSlots(numCacheableSlots)
     , m_jsStringsSize(propertyNameArrayData->propertyNameVector().size())
     , m_jsStrings(adoptArrayPtr(new WriteBarrier<Unknown>[m_jsStringsSize]))
 {
 }
 
-JSPropertyNameIterator* JSPropertyNameIterator::create(ExecState* exec, JSObject* o)
+// Arrays override property enumeration only to report their "length", which is not
+// enumerable, so their enumerable names still come from the structure and indexed storage.
+static inline bool enumeratesFromStructure(Structure* structure)
 {
-    ASSERT(!o->structure()->enumerationCache() ||
-            o->structure()->enumerationCache()->cachedStructure() != o->structure() ||
-            o->structure()->enumerationCache()->cachedPrototypeChain() != o->structure()->prototypeChain(exec));
+    return !structure->typeInfo().overridesGetPropertyNames()
+        || structure->classInfo() == &JSArray::s_info
+        || structure->classInfo() == &ArrayPrototype::s_info;
+}
 
+JSPropertyNameIterator* JSPropertyNameIterator::create(ExecState* exec, JSObject* o)
+{
     PropertyNameArray propertyNames(exec);
     o->methodTable()->getPropertyNames(o, exec, propertyNames, ExcludeDontEnumProperties);
     size_t numCacheableSlots = 0;
     if (!o->structure()->hasNonEnumerableProperties() && !o->structure()->hasGetterSetterProperties()
-        && !o->structure()->isUncacheableDictionary() && !o->structure()->typeInfo().overridesGetPropertyNames())
+        && !o->structure()->isUncacheableDictionary() && enumeratesFromStructure(o->structure()))
         numCacheableSlots = propertyNames.numCacheableSlots();
     
-    JSPropertyNameIterator* jsPropertyNameIterator = new (NotNull, allocateCell<JSPropertyNameIterator>(*exec->heap())) JSPropertyNameIterator(exec, propertyNames.data(), numCacheableSlots);
+    JSPropertyNameIterator* jsPropertyNameIterator = new (NotNull, allocateCell<JSPropertyNameIterator>(*exec->heap())) JSPropertyNameIterator(exec, propertyNames.data(), numCacheableSlots, propertyNames.numDenseIndexedNames());
     jsPropertyNameIterator->finishCreation(exec, propertyNames.data(), o);
 
     if (o->structure()->isDictionary())
         return jsPropertyNameIterator;
 
-    if (o->structure()->typeInfo().overridesGetPropertyNames())
+    if (!enumeratesFromStructure(o->structure()))
         return jsPropertyNameIterator;
     
-    if (hasIndexingHeader(o->structure()->indexingType()))
+    unsigned indexedLength;
+    if (!cacheableIndexedLength(o, indexedLength) || indexedLength != propertyNames.numDenseIndexedNames())
         return jsPropertyNameIterator;
     
     size_t count = normalizePrototypeChain(exec, o);
     StructureChain* structureChain = o->structure()->prototypeChain(exec);
     WriteBarrier<Structure>* structure = structureChain->head();
     for (size_t i = 0; i < count; ++i) {
-        if (structure[i]->typeInfo().overridesGetPropertyNames())
+        // Indexed properties can be added to a prototype without changing its structure.
+        if (!enumeratesFromStructure(structure[i].get()) || hasIndexingHeader(structure[i]->indexingType()))
             return jsPropertyNameIterator;
     }
 
@@ -90,8 +100,10 @@ void JSPropertyNameIterator::destroy(JSCell* cell)
 JSValue JSPropertyNameIterator::get(ExecState* exec, JSObject* base, size_t i)
 {
     JSValue identifier = m_jsStrings[i].get();
-    if (m_cachedStructure.get() == base->structure() && m_cachedPrototypeChain.get() == base->structure()->prototypeChain(exec))
-        return identifier;
+    if (m_cachedStructure.get() == base->structure() && m_cachedPrototypeChain.get() == base->structure()->prototypeChain(exec)) {
+        if (i >= m_cachedIndexedLength || base->canGetIndexQuickly(i))
+            return identifier;
+    }
 
     if (!base->hasProperty(exec, Identifier(exec, asString(identifier)->value(exec))))
         return JSValue();
@@ -40,14 +40,29 @@ namespace JSC {
     class JSObject;
     class LLIntOffsetsExtractor;
 
+    namespace DFG {
+    class SpeculativeJIT;
+    }
+
     class JSPropertyNameIterator : public JSCell {
         friend class JIT;
+        friend class DFG::SpeculativeJIT;
 
     public:
         typedef JSCell Base;
 
         static JSPropertyNameIterator* create(ExecState*, JSObject*);
 
+        // Returns the object's structure's enumeration cache if it can be used for this object,
+        // and a new iterator otherwise.
+        static JSPropertyNameIterator* forObject(ExecState*, JSObject*);
+
+        // An object whose indexed properties live in int32, double or contiguous storage can
+        // share a cached iterator with other objects of its structure, provided they have the
+        // same public length: the iterator's first names are then "0", "1", ... up to that
+        // length. Holes are found while iterating. Returns false for other indexed storage.
+        static bool cacheableIndexedLength(JSObject*, unsigned& length);
+
         static const bool needsDestruction = true;
         static const bool hasImmortalStructure = true;
         static void destroy(JSCell*);
@@ -69,6 +84,7 @@ namespace JSC {
             m_cachedStructure.set(vm, this, structure);
         }
         Structure* cachedStructure() { return m_cachedStructure.get(); }
+        unsigned cachedIndexedLength() const { return m_cachedIndexedLength; }
 
         void setCachedPrototypeChain(VM& vm, StructureChain* cachedPrototypeChain) { m_cachedPrototypeChain.set(vm, this, cachedPrototypeChain); }
         StructureChain* cachedPrototypeChain() { return m_cachedPrototypeChain.get(); }
@@ -88,16 +104,47 @@ namespace JSC {
     private:
         friend class LLIntOffsetsExtractor;
         
-        JSPropertyNameIterator(ExecState*, PropertyNameArrayData* propertyNameArrayData, size_t numCacheableSlot);
+        JSPropertyNameIterator(ExecState*, PropertyNameArrayData* propertyNameArrayData, size_t numCacheableSlot, size_t numDenseIndexedNames);
 
         WriteBarrier<Structure> m_cachedStructure;
         WriteBarrier<StructureChain> m_cachedPrototypeChain;
-        uint32_t m_numCacheableSlots;
+        uint32_t m_cachedIndexedLength; // Names before this index are array indices, which the structure check does not cover.
+        uint32_t m_numCacheableSlots; // Counted from m_cachedIndexedLength.
         uint32_t m_jsStringsSize;
         unsigned m_cachedStructureInlineCapacity;
         OwnArrayPtr<WriteBarrier<Unknown> > m_jsStrings;
     };
 
+    inline bool JSPropertyNameIterator::cacheableIndexedLength(JSObject* object, unsigned& length)
+    {
+        switch (object->structure()->indexingType()) {
+        case ALL_BLANK_INDEXING_TYPES:
+        case ALL_UNDECIDED_INDEXING_TYPES:
+            length = 0;
+            return true;
+        case ALL_INT32_INDEXING_TYPES:
+        case ALL_DOUBLE_INDEXING_TYPES:
+        case ALL_CONTIGUOUS_INDEXING_TYPES:
+            length = object->butterfly()->publicLength();
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    inline JSPropertyNameIterator* JSPropertyNameIterator::forObject(ExecState* exec, JSObject* object)
+    {
+        Structure* structure = object->structure();
+        JSPropertyNameIterator* iterator = structure->enumerationCache();
+        unsigned indexedLength;
+        if (iterator
+            && iterator->cachedPrototypeChain() == structure->prototypeChain(exec)
+            && cacheableIndexedLength(object, indexedLength)
+            && iterator->m_cachedIndexedLength == indexedLength)
+            return iterator;
+        return create(exec, object);
+    }
+
     ALWAYS_INLINE JSPropertyNameIterator* Register::propertyNameIterator() const
     {
         return jsCast<JSPropertyNameIterator*>(jsValue().asCell());
@@ -325,6 +325,7 @@ public:
 private:
     friend JSValue jsString(ExecState*, Register*, unsigned);
     friend JSValue jsStringFromArguments(ExecState*, JSValue);
+    friend JSValue jsString(ExecState*, StringBuilder&);
 
     JS_EXPORT_PRIVATE void resolveRope(ExecState*) const;
     void resolveRopeSlowCase8(LChar*) const;
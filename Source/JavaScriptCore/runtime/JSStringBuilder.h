@@ -64,7 +64,7 @@ public:
             m_okay &= buffer8.tryAppend(reinterpret_cast<const LChar*>(str), len);
             return;
         }
-        m_okay &= buffer8.tryReserveCapacity(buffer16.size() + len);
+        m_okay &= buffer16.tryReserveCapacity(buffer16.size() + len);
         for (size_t i = 0; i < len; i++) {
             UChar u = static_cast<unsigned char>(str[i]);
             m_okay &= buffer16.tryAppend(&u, 1);
@@ -77,7 +77,7 @@ public:
             m_okay &= buffer8.tryAppend(str, len);
             return;
         }
-        m_okay &= buffer8.tryReserveCapacity(buffer16.size() + len);
+        m_okay &= buffer16.tryReserveCapacity(buffer16.size() + len);
         for (size_t i = 0; i < len; i++) {
             UChar u = str[i];
             m_okay &= buffer16.tryAppend(&u, 1);
@@ -108,6 +108,17 @@ public:
         m_okay &= buffer16.tryAppend(str.characters(), length);
     }
 
+    void append(const String& str, unsigned offset, unsigned length)
+    {
+        ASSERT(offset + length <= str.length());
+        if (!length)
+            return;
+        if (str.is8Bit())
+            append(str.characters8() + offset, length);
+        else
+            append(str.characters16() + offset, length);
+    }
+
     void upConvert()
     {
         ASSERT(m_is8Bit);
@@ -41,6 +41,14 @@ GlobalMemoryStatistics globalMemoryStatistics()
     stats.JITBytes = ExecutableAllocator::committedByteCount();
 #else
     stats.JITBytes = 0;
+#endif
+#if ENABLE(EXECUTABLE_ALLOCATOR_FIXED)
+    WTF::MetaAllocator::Statistics JITStatistics = ExecutableAllocator::currentStatistics();
+    stats.JITFreeChunkCount = JITStatistics.numberOfFreeChunks;
+    stats.JITLargestFreeChunkBytes = JITStatistics.largestFreeChunkSize;
+#else
+    stats.JITFreeChunkCount = 0;
+    stats.JITLargestFreeChunkBytes = 0;
 #endif
     return stats;
 }
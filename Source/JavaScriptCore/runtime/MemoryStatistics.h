@@ -35,6 +35,8 @@ namespace JSC {
 struct GlobalMemoryStatistics {
     size_t stackBytes;
     size_t JITBytes;
+    size_t JITFreeChunkCount;
+    size_t JITLargestFreeChunkBytes;
 };
 
 JS_EXPORT_PRIVATE GlobalMemoryStatistics globalMemoryStatistics();
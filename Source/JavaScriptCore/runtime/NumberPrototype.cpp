@@ -481,7 +481,7 @@ static inline EncodedJSValue integerValueToString(ExecState* exec, int32_t radix
 
     if (radix == 10) {
         VM* vm = &exec->vm();
-        return JSValue::encode(jsString(vm, vm->numericStrings.add(value)));
+        return JSValue::encode(vm->numericStrings.addJSString(*vm, value));
     }
 
     return JSValue::encode(jsString(exec, toStringWithRadix(value, radix)));
@@ -504,7 +504,7 @@ EncodedJSValue JSC_HOST_CALL numberProtoFuncToString(ExecState* exec)
 
     if (radix == 10) {
         VM* vm = &exec->vm();
-        return JSValue::encode(jsString(vm, vm->numericStrings.add(doubleValue)));
+        return JSValue::encode(vm->numericStrings.addJSString(*vm, doubleValue));
     }
 
     if (!std::isfinite(doubleValue))
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "NumericStrings.h"
+
+#include "JSString.h"
+#include "Operations.h"
+
+namespace JSC {
+
+static inline void finalize(JSString*& string)
+{
+    if (!string || Heap::isMarked(string))
+        return;
+    string = 0;
+}
+
+NumericStrings::NumericStrings()
+{
+    for (unsigned i = 0; i < smallIntCacheSize; ++i)
+        smallIntJSStrings[i] = 0;
+}
+
+JSString* NumericStrings::addJSString(VM& vm, double d)
+{
+    CacheEntry<double>& entry = lookup(d);
+    if (!entry.value.isNull() && d == entry.key) {
+        if (!entry.jsString)
+            entry.jsString = jsString(&vm, entry.value);
+        return entry.jsString;
+    }
+    entry.key = d;
+    entry.value = String::numberToStringECMAScript(d);
+    entry.jsString = jsString(&vm, entry.value);
+    return entry.jsString;
+}
+
+JSString* NumericStrings::addJSString(VM& vm, int i)
+{
+    if (static_cast<unsigned>(i) < smallIntCacheSize) {
+        JSString*& string = smallIntJSStrings[i];
+        if (!string)
+            string = jsString(&vm, lookupSmallString(static_cast<unsigned>(i)));
+        return string;
+    }
+    CacheEntry<int>& entry = lookup(i);
+    if (!entry.value.isNull() && i == entry.key) {
+        if (!entry.jsString)
+            entry.jsString = jsString(&vm, entry.value);
+        return entry.jsString;
+    }
+    entry.key = i;
+    entry.value = String::number(i);
+    entry.jsString = jsString(&vm, entry.value);
+    return entry.jsString;
+}
+
+void NumericStrings::finalizeJSStrings()
+{
+    for (unsigned i = 0; i < cacheSize; ++i) {
+        finalize(doubleCache[i].jsString);
+        finalize(intCache[i].jsString);
+    }
+    for (unsigned i = 0; i < smallIntCacheSize; ++i)
+        finalize(smallIntJSStrings[i]);
+}
+
+} // namespace JSC
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2009 Apple Inc. All Rights Reserved.
+ * Copyright (C) 2009, 2013 Apple Inc. All Rights Reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions
@@ -32,8 +32,13 @@
 
 namespace JSC {
 
+    class JSString;
+    class VM;
+
     class NumericStrings {
     public:
+        NumericStrings();
+
         ALWAYS_INLINE String add(double d)
         {
             CacheEntry<double>& entry = lookup(d);
@@ -41,24 +46,26 @@ namespace JSC {
                 return entry.value;
             entry.key = d;
             entry.value = String::numberToStringECMAScript(d);
+            entry.jsString = 0;
             return entry.value;
         }
 
         ALWAYS_INLINE String add(int i)
         {
-            if (static_cast<unsigned>(i) < cacheSize)
+            if (static_cast<unsigned>(i) < smallIntCacheSize)
                 return lookupSmallString(static_cast<unsigned>(i));
             CacheEntry<int>& entry = lookup(i);
             if (!entry.value.isNull() && i == entry.key)
                 return entry.value;
             entry.key = i;
             entry.value = String::number(i);
+            entry.jsString = 0;
             return entry.value;
         }
 
         ALWAYS_INLINE String add(unsigned i)
         {
-            if (i < cacheSize)
+            if (i < smallIntCacheSize)
                 return lookupSmallString(static_cast<unsigned>(i));
             CacheEntry<unsigned>& entry = lookup(i);
             if (!entry.value.isNull() && i == entry.key)
@@ -67,13 +74,29 @@ namespace JSC {
             entry.value = String::number(i);
             return entry.value;
         }
+
+        // Like add(), but also caches the JSString, so that converting the same number to a
+        // string again does not allocate. The cached JSStrings are weak: the ones that a
+        // collection finds unmarked are dropped by finalizeJSStrings().
+        JSString* addJSString(VM&, double);
+        JSString* addJSString(VM&, int);
+
+        void finalizeJSStrings();
+
     private:
-        static const size_t cacheSize = 64;
+        static const size_t cacheSize = 256;
+        static const size_t smallIntCacheSize = 256;
 
         template<typename T>
         struct CacheEntry {
+            CacheEntry()
+                : jsString(0)
+            {
+            }
+
             T key;
             String value;
+            JSString* jsString;
         };
 
         CacheEntry<double>& lookup(double d) { return doubleCache[WTF::FloatHash<double>::hash(d) & (cacheSize - 1)]; }
@@ -81,7 +104,7 @@ namespace JSC {
         CacheEntry<unsigned>& lookup(unsigned i) { return unsignedCache[WTF::IntHash<unsigned>::hash(i) & (cacheSize - 1)]; }
         ALWAYS_INLINE const String& lookupSmallString(unsigned i)
         {
-            ASSERT(i < cacheSize);
+            ASSERT(i < smallIntCacheSize);
             if (smallIntCache[i].isNull())
                 smallIntCache[i] = String::number(i);
             return smallIntCache[i];
@@ -90,7 +113,8 @@ namespace JSC {
         FixedArray<CacheEntry<double>, cacheSize> doubleCache;
         FixedArray<CacheEntry<int>, cacheSize> intCache;
         FixedArray<CacheEntry<unsigned>, cacheSize> unsignedCache;
-        FixedArray<String, cacheSize> smallIntCache;
+        FixedArray<String, smallIntCacheSize> smallIntCache;
+        FixedArray<JSString*, smallIntCacheSize> smallIntJSStrings;
     };
 
 } // namespace JSC
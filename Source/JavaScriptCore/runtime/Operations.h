@@ -29,6 +29,7 @@
 #include "JSProxy.h"
 #include "JSString.h"
 #include "StructureInlines.h"
+#include <wtf/text/StringBuilder.h>
 
 namespace JSC {
 
@@ -95,6 +96,23 @@ ALWAYS_INLINE JSValue jsString(ExecState* exec, Register* strings, unsigned coun
     return ropeBuilder.release();
 }
 
+// A chunked builder's chunks become the fibers of a rope, rather than being copied into one string.
+inline JSValue jsString(ExecState* exec, StringBuilder& builder)
+{
+    VM* vm = &exec->vm();
+    unsigned numberOfChunks = builder.numberOfChunks();
+    if (numberOfChunks <= 1)
+        return jsString(vm, builder.toString());
+
+    JSRopeString::RopeBuilder ropeBuilder(*vm);
+    for (unsigned i = 0; i < numberOfChunks; ++i) {
+        if (!ropeBuilder.append(jsString(vm, builder.chunk(i))))
+            return throwOutOfMemoryError(exec);
+    }
+
+    return ropeBuilder.release();
+}
+
 ALWAYS_INLINE JSValue jsStringFromArguments(ExecState* exec, JSValue thisValue)
 {
     VM* vm = &exec->vm();
@@ -111,6 +111,12 @@ typedef OptionRange optionRange;
     v(bool, validateGraphAtEachPhase, false) \
     \
     v(bool, enableProfiler, false) \
+    v(bool, useSamplingProfiler, false) \
+    v(unsigned, sampleIntervalMicroseconds, 1000) \
+    \
+    v(bool, useTierUpTelemetry, false) \
+    v(bool, logTierUpEvents, false) \
+    v(unsigned, maximumTierUpEvents, 4096) \
     \
     v(unsigned, maximumOptimizationCandidateInstructionCount, 10000) \
     \
@@ -166,7 +172,17 @@ typedef OptionRange optionRange;
     v(bool, objectsAreImmortal, false) \
     v(bool, showObjectStatistics, false) \
     \
+    /* Function code that has not been entered for this long is discarded when executable */ \
+    /* memory runs low or becomes fragmented. */ \
+    v(bool, useColdCodeEviction, true) \
+    v(bool, alwaysEvictColdCode, false) \
+    v(bool, logColdCodeEviction, false) \
+    v(double, coldCodeEvictionIntervalSeconds, 30) \
+    \
     v(unsigned, gcMaxHeapSize, 0) \
+    \
+    /* Released API context groups are kept, up to this many, to be reused by new ones. */ \
+    v(unsigned, maximumRecycledContextGroups, 0) \
     v(bool, recordGCPauseTimes, false) \
     v(bool, logHeapStatisticsAtExit, false) 
 
@@ -196,8 +196,9 @@ public:
     // Copy this PropertyTable, ensuring the copy has at least the capacity provided.
     PropertyTable* copy(VM&, JSCell* owner, unsigned newCapacity);
 
-#ifndef NDEBUG
     size_t sizeInMemory();
+
+#ifndef NDEBUG
     void checkConsistency();
 #endif
 
@@ -464,7 +465,6 @@ inline PropertyTable* PropertyTable::copy(VM& vm, JSCell* owner, unsigned newCap
     return PropertyTable::clone(vm, owner, newCapacity, *this);
 }
 
-#ifndef NDEBUG
 inline size_t PropertyTable::sizeInMemory()
 {
     size_t result = sizeof(PropertyTable) + dataSize();
@@ -472,7 +472,6 @@ inline size_t PropertyTable::sizeInMemory()
         result += (m_deletedOffsets->capacity() * sizeof(PropertyOffset));
     return result;
 }
-#endif
 
 inline void PropertyTable::reinsert(const ValueType& entry)
 {
@@ -56,6 +56,7 @@ namespace JSC {
             : m_data(PropertyNameArrayData::create())
             , m_vm(vm)
             , m_numCacheableSlots(0)
+            , m_numDenseIndexedNames(0)
             , m_baseObject(0)
         {
         }
@@ -64,6 +65,7 @@ namespace JSC {
             : m_data(PropertyNameArrayData::create())
             , m_vm(&exec->vm())
             , m_numCacheableSlots(0)
+            , m_numDenseIndexedNames(0)
             , m_baseObject(0)
         {
         }
@@ -94,6 +96,15 @@ namespace JSC {
                 return;
             m_numCacheableSlots = numCacheableSlots;
         }
+        // The base object's indexed properties come first. If it stores them without holes, the
+        // first numDenseIndexedNames() names are "0", "1", ... up to its public length.
+        size_t numDenseIndexedNames() const { return m_numDenseIndexedNames; }
+        void setNumDenseIndexedNamesForObject(JSObject* object, size_t numDenseIndexedNames)
+        {
+            if (object != m_baseObject)
+                return;
+            m_numDenseIndexedNames = numDenseIndexedNames;
+        }
         void setBaseObject(JSObject* object)
         {
             if (m_baseObject)
@@ -108,6 +119,7 @@ namespace JSC {
         IdentifierSet m_set;
         VM* m_vm;
         size_t m_numCacheableSlots;
+        size_t m_numDenseIndexedNames;
         JSObject* m_baseObject;
     };
 
@@ -57,6 +57,7 @@ namespace JSC {
 
         MatchResult performMatch(VM&, RegExp*, JSString*, const String&, int startOffset, int** ovector);
         MatchResult performMatch(VM&, RegExp*, JSString*, const String&, int startOffset);
+        void recordMatch(VM&, RegExp*, JSString*, const MatchResult&);
 
         void setMultiline(bool multiline) { m_multiline = multiline; }
         bool multiline() const { return m_multiline; }
@@ -128,6 +129,14 @@ namespace JSC {
         return result;
     }
 
+    // Callers that run a regular expression repeatedly over the same input (e.g. a global
+    // String.prototype.replace) can match directly and only record the final result here.
+    ALWAYS_INLINE void RegExpConstructor::recordMatch(VM& vm, RegExp* regExp, JSString* string, const MatchResult& result)
+    {
+        ASSERT(result.start != WTF::notFound);
+        m_cachedResult.record(vm, this, regExp, string, result);
+    }
+
 } // namespace JSC
 
 #endif // RegExpConstructor_h
@@ -26,6 +26,7 @@
 #include "config.h"
 #include "SparseArrayValueMap.h"
 
+#include "ArrayConventions.h"
 #include "ClassInfo.h"
 #include "GetterSetter.h"
 #include "JSObject.h"
@@ -34,6 +35,7 @@
 #include "Reject.h"
 #include "SlotVisitor.h"
 #include "Structure.h"
+#include <algorithm>
 
 namespace JSC {
 
@@ -41,6 +43,9 @@ const ClassInfo SparseArrayValueMap::s_info = { "SparseArrayValueMap", 0, 0, 0,
 
 SparseArrayValueMap::SparseArrayValueMap(VM& vm)
     : Base(vm, vm.sparseArrayValueMapStructure.get())
+    , m_orderedPagesNeedSorting(false)
+    , m_emptyPageCount(0)
+    , m_size(0)
     , m_flags(Normal)
     , m_reportedCapacity(0)
 {
@@ -48,6 +53,7 @@ SparseArrayValueMap::SparseArrayValueMap(VM& vm)
 
 SparseArrayValueMap::~SparseArrayValueMap()
 {
+    deleteAllValues(m_pages);
 }
 
 void SparseArrayValueMap::finishCreation(VM& vm)
@@ -72,30 +78,212 @@ Structure* SparseArrayValueMap::createStructure(VM& vm, JSGlobalObject* globalOb
     return Structure::create(vm, globalObject, prototype, TypeInfo(CompoundType, StructureFlags), &s_info);
 }
 
-SparseArrayValueMap::AddResult SparseArrayValueMap::add(JSObject* array, unsigned i)
+SparseArrayEntry& SparseArrayValueMap::addEntry(unsigned i, bool& isNewEntry)
 {
-    SparseArrayEntry entry;
-    entry.setWithoutWriteBarrier(jsUndefined());
+    unsigned pageNumber = i >> entriesPerPageShift;
+    unsigned entryIndex = i & (entriesPerPage - 1);
+
+    PageMap::AddResult result = m_pages.add(pageNumber, 0);
+    Page* page = result.iterator->value;
+    if (result.isNewEntry) {
+        page = new Page(pageNumber);
+        result.iterator->value = page;
+        if (!m_orderedPages.isEmpty() && m_orderedPages.last()->number > pageNumber)
+            m_orderedPagesNeedSorting = true;
+        m_orderedPages.append(page);
+
+        // Only report growth past the most pages we have ever held, so that a map that keeps
+        // filling and emptying the same pages does not look like it keeps allocating.
+        size_t capacity = m_pages.size() * sizeof(Page);
+        if (capacity > m_reportedCapacity) {
+            Heap::heap(this)->reportExtraMemoryCost(capacity - m_reportedCapacity);
+            m_reportedCapacity = capacity;
+        }
+    } else if (!page->presentEntries)
+        --m_emptyPageCount;
+
+    SparseArrayEntry& entry = page->entries[entryIndex];
+    isNewEntry = !(page->presentEntries & (1 << entryIndex));
+    if (isNewEntry) {
+        page->presentEntries |= 1 << entryIndex;
+        ++m_size;
+        entry.setWithoutWriteBarrier(jsUndefined());
+        entry.attributes = 0;
+    }
+    return entry;
+}
+
+SparseArrayValueMap::AddResult SparseArrayValueMap::add(JSObject*, unsigned i)
+{
+    bool isNewEntry;
+    SparseArrayEntry& entry = addEntry(i, isNewEntry);
+    return AddResult(&entry, isNewEntry);
+}
 
-    AddResult result = m_map.add(i, entry);
-    size_t capacity = m_map.capacity();
-    if (capacity != m_reportedCapacity) {
-        Heap::heap(array)->reportExtraMemoryCost((capacity - m_reportedCapacity) * (sizeof(unsigned) + sizeof(WriteBarrier<Unknown>)));
-        m_reportedCapacity = capacity;
+void SparseArrayValueMap::removeEntry(Page* page, unsigned entryIndex)
+{
+    ASSERT(page->presentEntries & (1 << entryIndex));
+    page->presentEntries &= ~(1 << entryIndex);
+    page->entries[entryIndex].clear();
+    page->entries[entryIndex].attributes = 0;
+    --m_size;
+    if (!page->presentEntries)
+        ++m_emptyPageCount;
+}
+
+void SparseArrayValueMap::remove(unsigned i)
+{
+    Page* page = m_pages.get(i >> entriesPerPageShift);
+    unsigned entryIndex = i & (entriesPerPage - 1);
+    if (!page || !(page->presentEntries & (1 << entryIndex)))
+        return;
+    removeEntry(page, entryIndex);
+    removeEmptyPagesIfNecessary();
+}
+
+bool SparseArrayValueMap::pageIsBefore(const Page* a, const Page* b)
+{
+    return a->number < b->number;
+}
+
+void SparseArrayValueMap::sortPagesIfNecessary()
+{
+    if (!m_orderedPagesNeedSorting)
+        return;
+    std::sort(m_orderedPages.begin(), m_orderedPages.end(), pageIsBefore);
+    m_orderedPagesNeedSorting = false;
+}
+
+void SparseArrayValueMap::removeEmptyPagesIfNecessary()
+{
+    // Sweeping is linear in the number of pages, so only do it once a good fraction of them
+    // are empty.
+    if (m_emptyPageCount < 16 || m_emptyPageCount < m_orderedPages.size() / 2)
+        return;
+
+    size_t liveCount = 0;
+    for (size_t i = 0; i < m_orderedPages.size(); ++i) {
+        Page* page = m_orderedPages[i];
+        if (page->presentEntries) {
+            m_orderedPages[liveCount++] = page;
+            continue;
+        }
+        m_pages.remove(page->number);
+        delete page;
     }
-    return result;
+    m_orderedPages.shrink(liveCount);
+    m_orderedPages.shrinkToFit();
+    m_emptyPageCount = 0;
+}
+
+size_t SparseArrayValueMap::firstPageNotBelow(unsigned pageNumber)
+{
+    sortPagesIfNecessary();
+
+    size_t begin = 0;
+    size_t end = m_orderedPages.size();
+    while (begin < end) {
+        size_t middle = begin + (end - begin) / 2;
+        if (m_orderedPages[middle]->number < pageNumber)
+            begin = middle + 1;
+        else
+            end = middle;
+    }
+    return begin;
+}
+
+SparseArrayValueMap::const_iterator SparseArrayValueMap::lowerBound(unsigned i)
+{
+    unsigned pageNumber = i >> entriesPerPageShift;
+    size_t pageIndex = firstPageNotBelow(pageNumber);
+    Page* const* page = m_orderedPages.begin() + pageIndex;
+    unsigned entryIndex = 0;
+    if (pageIndex < m_orderedPages.size() && (*page)->number == pageNumber)
+        entryIndex = i & (entriesPerPage - 1);
+    return const_iterator(page, m_orderedPages.end(), entryIndex);
+}
+
+void SparseArrayValueMap::removeRange(unsigned begin, unsigned end)
+{
+    if (begin >= end)
+        return;
+
+    for (size_t pageIndex = firstPageNotBelow(begin >> entriesPerPageShift); pageIndex < m_orderedPages.size(); ++pageIndex) {
+        Page* page = m_orderedPages[pageIndex];
+        unsigned firstIndex = page->firstIndex();
+        if (firstIndex >= end)
+            break;
+        for (unsigned entryIndex = 0; entryIndex < entriesPerPage; ++entryIndex) {
+            unsigned index = firstIndex + entryIndex;
+            if (index >= begin && index < end && (page->presentEntries & (1 << entryIndex)))
+                removeEntry(page, entryIndex);
+        }
+    }
+    removeEmptyPagesIfNecessary();
+}
+
+namespace {
+
+struct MovedEntry {
+    unsigned index;
+    JSValue value;
+    unsigned attributes;
+};
+
+}
+
+void SparseArrayValueMap::reindexEntries(unsigned start, unsigned removedCount, unsigned addedCount)
+{
+    // Take out every entry at or above start, then put back the ones that survive at their
+    // new indices. Entries move within this map, so they need no write barrier.
+    Vector<MovedEntry, 0, UnsafeVectorOverflow> movedEntries;
+    for (size_t pageIndex = firstPageNotBelow(start >> entriesPerPageShift); pageIndex < m_orderedPages.size(); ++pageIndex) {
+        Page* page = m_orderedPages[pageIndex];
+        unsigned firstIndex = page->firstIndex();
+        for (unsigned entryIndex = 0; entryIndex < entriesPerPage; ++entryIndex) {
+            unsigned index = firstIndex + entryIndex;
+            if (index < start || !(page->presentEntries & (1 << entryIndex)))
+                continue;
+            if (index - start >= removedCount) {
+                ASSERT(static_cast<uint64_t>(index) - removedCount + addedCount <= MAX_ARRAY_INDEX);
+                SparseArrayEntry& entry = page->entries[entryIndex];
+                MovedEntry movedEntry = { index - removedCount + addedCount, entry.SparseArrayEntry::Base::get(), entry.attributes };
+                movedEntries.append(movedEntry);
+            }
+            removeEntry(page, entryIndex);
+        }
+    }
+
+    for (size_t i = 0; i < movedEntries.size(); ++i) {
+        bool isNewEntry;
+        SparseArrayEntry& entry = addEntry(movedEntries[i].index, isNewEntry);
+        ASSERT(isNewEntry);
+        entry.setWithoutWriteBarrier(movedEntries[i].value);
+        entry.attributes = movedEntries[i].attributes;
+    }
+    removeEmptyPagesIfNecessary();
+}
+
+void SparseArrayValueMap::shiftEntriesDown(unsigned start, unsigned count)
+{
+    reindexEntries(start, count, 0);
+}
+
+void SparseArrayValueMap::shiftEntriesUp(unsigned start, unsigned count)
+{
+    reindexEntries(start, 0, count);
 }
 
 void SparseArrayValueMap::putEntry(ExecState* exec, JSObject* array, unsigned i, JSValue value, bool shouldThrow)
 {
     AddResult result = add(array, i);
-    SparseArrayEntry& entry = result.iterator->value;
+    SparseArrayEntry& entry = *result.entry;
 
     // To save a separate find & add, we first always add to the sparse map.
     // In the uncommon case that this is a new property, and the array is not
     // extensible, this is not the right thing to have done - so remove again.
     if (result.isNewEntry && !array->isExtensible()) {
-        remove(result.iterator);
+        remove(i);
         if (shouldThrow)
             throwTypeError(exec, StrictModeReadonlyPropertyWriteError);
         return;
@@ -107,13 +295,13 @@ void SparseArrayValueMap::putEntry(ExecState* exec, JSObject* array, unsigned i,
 bool SparseArrayValueMap::putDirect(ExecState* exec, JSObject* array, unsigned i, JSValue value, unsigned attributes, PutDirectIndexMode mode)
 {
     AddResult result = add(array, i);
-    SparseArrayEntry& entry = result.iterator->value;
+    SparseArrayEntry& entry = *result.entry;
 
     // To save a separate find & add, we first always add to the sparse map.
     // In the uncommon case that this is a new property, and the array is not
     // extensible, this is not the right thing to have done - so remove again.
     if (mode != PutDirectIndexLikePutDirect && result.isNewEntry && !array->isExtensible()) {
-        remove(result.iterator);
+        remove(i);
         return reject(exec, mode == PutDirectIndexShouldThrow, "Attempting to define property on object that is not extensible.");
     }
 
@@ -206,9 +394,13 @@ void SparseArrayValueMap::visitChildren(JSCell* thisObject, SlotVisitor& visitor
     Base::visitChildren(thisObject, visitor);
     
     SparseArrayValueMap* thisMap = jsCast<SparseArrayValueMap*>(thisObject);
-    iterator end = thisMap->m_map.end();
-    for (iterator it = thisMap->m_map.begin(); it != end; ++it)
-        visitor.append(&it->value);
+    for (size_t pageIndex = 0; pageIndex < thisMap->m_orderedPages.size(); ++pageIndex) {
+        Page* page = thisMap->m_orderedPages[pageIndex];
+        for (unsigned entryIndex = 0; entryIndex < entriesPerPage; ++entryIndex) {
+            if (page->presentEntries & (1 << entryIndex))
+                visitor.append(&page->entries[entryIndex]);
+        }
+    }
 }
 
 } // namespace JSC
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2011, 2012 Apple Inc. All rights reserved.
+ * Copyright (C) 2011, 2012, 2013 Apple Inc. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions
@@ -33,6 +33,7 @@
 #include "WriteBarrier.h"
 #include <wtf/HashMap.h>
 #include <wtf/Platform.h>
+#include <wtf/Vector.h>
 
 namespace JSC {
 
@@ -52,12 +53,36 @@ struct SparseArrayEntry : public WriteBarrier<Unknown> {
     unsigned attributes;
 };
 
+// Entries are kept in pages of entriesPerPage consecutive indices, found through a hash table
+// keyed by page number. Indices that are near each other, which is what most sparse arrays hold,
+// share a page and a single lookup. The pages are also listed in index order, so that entries
+// can be walked in order, and ranges of entries removed or moved, in time proportional to the
+// number of entries involved rather than to the span of indices they cover.
 class SparseArrayValueMap : public JSCell {
 public:
     typedef JSCell Base;
-    
+
+    static const unsigned entriesPerPageShift = 4;
+    static const unsigned entriesPerPage = 1 << entriesPerPageShift;
+
 private:
-    typedef HashMap<uint64_t, SparseArrayEntry, WTF::IntHash<uint64_t>, WTF::UnsignedWithZeroKeyHashTraits<uint64_t> > Map;
+    struct Page {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        explicit Page(unsigned number)
+            : number(number)
+            , presentEntries(0)
+        {
+        }
+
+        unsigned firstIndex() const { return number << entriesPerPageShift; }
+
+        unsigned number;
+        unsigned presentEntries; // Bit i is set if entries[i] holds a property.
+        SparseArrayEntry entries[entriesPerPage];
+    };
+
+    typedef HashMap<unsigned, Page*, WTF::IntHash<unsigned>, WTF::UnsignedWithZeroKeyHashTraits<unsigned> > PageMap;
 
     enum Flags {
         Normal = 0,
@@ -74,10 +99,64 @@ private:
 
 public:
     static JS_EXPORTDATA const ClassInfo s_info;
-    
-    typedef Map::iterator iterator;
-    typedef Map::const_iterator const_iterator;
-    typedef Map::AddResult AddResult;
+
+    struct AddResult {
+        AddResult(SparseArrayEntry* entry, bool isNewEntry)
+            : entry(entry)
+            , isNewEntry(isNewEntry)
+        {
+        }
+
+        SparseArrayEntry* entry;
+        bool isNewEntry;
+    };
+
+    // Walks the entries in index order. Any change to the map invalidates its iterators.
+    class const_iterator {
+    public:
+        unsigned key() const { return (*m_page)->firstIndex() + m_entryIndex; }
+        const SparseArrayEntry& value() const { return (*m_page)->entries[m_entryIndex]; }
+
+        const_iterator& operator++()
+        {
+            ++m_entryIndex;
+            skipAbsentEntries();
+            return *this;
+        }
+
+        bool operator==(const const_iterator& other) const { return m_page == other.m_page && m_entryIndex == other.m_entryIndex; }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class SparseArrayValueMap;
+
+        const_iterator(Page* const* page, Page* const* end, unsigned entryIndex)
+            : m_page(page)
+            , m_end(end)
+            , m_entryIndex(entryIndex)
+        {
+            skipAbsentEntries();
+        }
+
+        void skipAbsentEntries()
+        {
+            for (; m_page != m_end; ++m_page, m_entryIndex = 0) {
+                unsigned remainingEntries = (*m_page)->presentEntries >> m_entryIndex;
+                if (!remainingEntries)
+                    continue;
+                while (!(remainingEntries & 1)) {
+                    remainingEntries >>= 1;
+                    ++m_entryIndex;
+                }
+                return;
+            }
+            m_entryIndex = 0;
+        }
+
+        Page* const* m_page;
+        Page* const* m_end;
+        unsigned m_entryIndex;
+    };
 
     static SparseArrayValueMap* create(VM&);
     
@@ -113,22 +192,62 @@ public:
     void putEntry(ExecState*, JSObject*, unsigned, JSValue, bool shouldThrow);
     bool putDirect(ExecState*, JSObject*, unsigned, JSValue, unsigned attributes, PutDirectIndexMode);
     AddResult add(JSObject*, unsigned);
-    iterator find(unsigned i) { return m_map.find(i); }
-    // This should ASSERT the remove is valid (check the result of the find).
-    void remove(iterator it) { m_map.remove(it); }
-    void remove(unsigned i) { m_map.remove(i); }
+    void remove(unsigned);
+    // Removes every entry with an index in [begin, end).
+    void removeRange(unsigned begin, unsigned end);
+    // Removes the entries in [start, start + count) and moves every entry above them down by count.
+    void shiftEntriesDown(unsigned start, unsigned count);
+    // Moves every entry at or above start up by count. The caller must make sure that the
+    // moved indices stay valid array indices.
+    void shiftEntriesUp(unsigned start, unsigned count);
+
+    // Entries do not move until they are removed, so the result stays valid until then.
+    SparseArrayEntry* find(unsigned i)
+    {
+        Page* page = m_pages.get(i >> entriesPerPageShift);
+        unsigned entryIndex = i & (entriesPerPage - 1);
+        if (!page || !(page->presentEntries & (1 << entryIndex)))
+            return 0;
+        return &page->entries[entryIndex];
+    }
 
     // These methods do not mutate the contents of the map.
-    iterator notFound() { return m_map.end(); }
-    bool isEmpty() const { return m_map.isEmpty(); }
-    bool contains(unsigned i) const { return m_map.contains(i); }
-    size_t size() const { return m_map.size(); }
-    // Only allow const begin/end iteration.
-    const_iterator begin() const { return m_map.begin(); }
-    const_iterator end() const { return m_map.end(); }
+    bool isEmpty() const { return !m_size; }
+    bool contains(unsigned i) const
+    {
+        Page* page = m_pages.get(i >> entriesPerPageShift);
+        return page && (page->presentEntries & (1 << (i & (entriesPerPage - 1))));
+    }
+    size_t size() const { return m_size; }
+
+    const_iterator begin()
+    {
+        sortPagesIfNecessary();
+        return const_iterator(m_orderedPages.begin(), m_orderedPages.end(), 0);
+    }
+    const_iterator end()
+    {
+        return const_iterator(m_orderedPages.end(), m_orderedPages.end(), 0);
+    }
+    // Returns an iterator to the first entry with an index that is not less than i.
+    const_iterator lowerBound(unsigned i);
 
 private:
-    Map m_map;
+    SparseArrayEntry& addEntry(unsigned, bool& isNewEntry);
+    void removeEntry(Page*, unsigned entryIndex);
+    void reindexEntries(unsigned start, unsigned removedCount, unsigned addedCount);
+    size_t firstPageNotBelow(unsigned pageNumber);
+    static bool pageIsBefore(const Page*, const Page*);
+    void sortPagesIfNecessary();
+    void removeEmptyPagesIfNecessary();
+
+    PageMap m_pages;
+    // All pages, sorted by number unless m_orderedPagesNeedSorting is set. Pages that become
+    // empty stay here, and in m_pages, until enough of them accumulate to be worth sweeping.
+    Vector<Page*> m_orderedPages;
+    bool m_orderedPagesNeedSorting;
+    unsigned m_emptyPageCount;
+    size_t m_size;
     Flags m_flags;
     size_t m_reportedCapacity;
 };
@@ -160,9 +160,20 @@ static inline JSString* jsStringWithReuse(ExecState* exec, JSValue originalValue
 }
 
 template <typename CharType>
-static NEVER_INLINE String substituteBackreferencesSlow(const String& replacement, const String& source, const int* ovector, RegExp* reg, size_t i)
+static inline void appendSubstring(Vector<CharType>& buffer, const String& string, unsigned start, unsigned length)
+{
+    buffer.append(string.getCharactersWithUpconvert<CharType>() + start, length);
+}
+
+static inline void appendSubstring(JSStringBuilder& builder, const String& string, unsigned start, unsigned length)
+{
+    builder.append(string, start, length);
+}
+
+// Appends replacement to output with its $-patterns expanded; i is the index of the first '$'.
+template <typename OutputType>
+static void appendSubstitutedBackreferences(OutputType& substitutedReplacement, const String& replacement, const String& source, const int* ovector, RegExp* reg, size_t i)
 {
-    Vector<CharType> substitutedReplacement;
     int offset = 0;
     do {
         if (i + 1 == replacement.length())
@@ -172,7 +183,7 @@ static NEVER_INLINE String substituteBackreferencesSlow(const String& replacemen
         if (ref == '$') {
             // "$$" -> "$"
             ++i;
-            substitutedReplacement.append(replacement.getCharactersWithUpconvert<CharType>() + offset, i - offset);
+            appendSubstring(substitutedReplacement, replacement, offset, i - offset);
             offset = i + 1;
             continue;
         }
@@ -212,16 +223,22 @@ static NEVER_INLINE String substituteBackreferencesSlow(const String& replacemen
             continue;
 
         if (i - offset)
-            substitutedReplacement.append(replacement.getCharactersWithUpconvert<CharType>() + offset, i - offset);
+            appendSubstring(substitutedReplacement, replacement, offset, i - offset);
         i += 1 + advance;
         offset = i + 1;
         if (backrefStart >= 0)
-            substitutedReplacement.append(source.getCharactersWithUpconvert<CharType>() + backrefStart, backrefLength);
+            appendSubstring(substitutedReplacement, source, backrefStart, backrefLength);
     } while ((i = replacement.find('$', i + 1)) != notFound);
 
     if (replacement.length() - offset)
-        substitutedReplacement.append(replacement.getCharactersWithUpconvert<CharType>() + offset, replacement.length() - offset);
+        appendSubstring(substitutedReplacement, replacement, offset, replacement.length() - offset);
+}
 
+template <typename CharType>
+static NEVER_INLINE String substituteBackreferencesSlow(const String& replacement, const String& source, const int* ovector, RegExp* reg, size_t i)
+{
+    Vector<CharType> substitutedReplacement;
+    appendSubstitutedBackreferences(substitutedReplacement, replacement, source, ovector, reg, i);
     substitutedReplacement.shrinkToFit();
     return String::adopt(substitutedReplacement);
 }
@@ -406,13 +423,14 @@ static NEVER_INLINE EncodedJSValue removeUsingRegExpSearch(ExecState* exec, JSSt
 
     Vector<StringRange, 16> sourceRanges;
     VM* vm = &exec->vm();
-    RegExpConstructor* regExpConstructor = exec->lexicalGlobalObject()->regExpConstructor();
     unsigned sourceLen = source.length();
+    MatchResult lastMatch = MatchResult::failed();
 
     while (true) {
-        MatchResult result = regExpConstructor->performMatch(*vm, regExp, string, source, startPosition);
+        MatchResult result = regExp->match(*vm, source, startPosition);
         if (!result)
             break;
+        lastMatch = result;
 
         if (lastIndex < result.start)
             sourceRanges.append(StringRange(lastIndex, result.start - lastIndex));
@@ -428,6 +446,10 @@ static NEVER_INLINE EncodedJSValue removeUsingRegExpSearch(ExecState* exec, JSSt
         }
     }
 
+    // Nothing observable happens between matches, so only the last one needs to be cached.
+    if (lastMatch)
+        exec->lexicalGlobalObject()->regExpConstructor()->recordMatch(*vm, regExp, string, lastMatch);
+
     if (!lastIndex)
         return JSValue::encode(string);
 
@@ -437,6 +459,62 @@ static NEVER_INLINE EncodedJSValue removeUsingRegExpSearch(ExecState* exec, JSSt
     return JSValue::encode(jsSpliceSubstrings(exec, string, source, sourceRanges.data(), sourceRanges.size()));
 }
 
+// Global replace with a replacement string: no user code can run between matches, so
+// the regular expression is run over the subject with a single ovector and the result
+// is appended directly into the builder, expanding $-patterns in place rather than
+// materializing a String per match. Only the final match is recorded on the RegExp
+// constructor, whose cached result stays lazy until RegExp.lastMatch & co. are read.
+static NEVER_INLINE EncodedJSValue replaceAllUsingRegExpSearchWithString(ExecState* exec, JSString* string, const String& source, RegExp* regExp, const String& replacement)
+{
+    VM* vm = &exec->vm();
+    unsigned sourceLen = source.length();
+    size_t firstDollar = replacement.find('$');
+    bool needsSubpatterns = firstDollar != notFound;
+
+    Vector<int, 32> ovector;
+    JSStringBuilder builder;
+    MatchResult lastMatch = MatchResult::failed();
+    size_t lastIndex = 0;
+    unsigned startPosition = 0;
+
+    while (true) {
+        MatchResult result = MatchResult::failed();
+        if (needsSubpatterns) {
+            int position = regExp->match(*vm, source, startPosition, ovector);
+            if (position != -1)
+                result = MatchResult(position, ovector[1]);
+        } else
+            result = regExp->match(*vm, source, startPosition);
+        if (!result)
+            break;
+        lastMatch = result;
+
+        builder.append(source, lastIndex, result.start - lastIndex);
+        if (needsSubpatterns)
+            appendSubstitutedBackreferences(builder, replacement, source, ovector.data(), regExp, firstDollar);
+        else
+            builder.append(replacement);
+
+        lastIndex = result.end;
+        startPosition = lastIndex;
+
+        // special case of empty match
+        if (result.empty()) {
+            startPosition++;
+            if (startPosition > sourceLen)
+                break;
+        }
+    }
+
+    if (!lastMatch)
+        return JSValue::encode(string);
+
+    exec->lexicalGlobalObject()->regExpConstructor()->recordMatch(*vm, regExp, string, lastMatch);
+
+    builder.append(source, lastIndex, sourceLen - lastIndex);
+    return JSValue::encode(builder.build(exec));
+}
+
 static NEVER_INLINE EncodedJSValue replaceUsingRegExpSearch(ExecState* exec, JSString* string, JSValue searchValue)
 {
     JSValue replaceValue = exec->argument(1);
@@ -460,8 +538,11 @@ static NEVER_INLINE EncodedJSValue replaceUsingRegExpSearch(ExecState* exec, JSS
         if (exec->hadException())
             return JSValue::encode(JSValue());
 
-        if (callType == CallTypeNone && !replacementString.length())
-            return removeUsingRegExpSearch(exec, string, source, regExp);
+        if (callType == CallTypeNone) {
+            if (!replacementString.length())
+                return removeUsingRegExpSearch(exec, string, source, regExp);
+            return replaceAllUsingRegExpSearchWithString(exec, string, source, regExp, replacementString);
+        }
     }
 
     RegExpConstructor* regExpConstructor = exec->lexicalGlobalObject()->regExpConstructor();
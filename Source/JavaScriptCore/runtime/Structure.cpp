@@ -65,11 +65,7 @@ static HashSet<Structure*>& liveStructureSet = *(new HashSet<Structure*>);
 
 bool StructureTransitionTable::contains(StringImpl* rep, unsigned attributes) const
 {
-    if (isUsingSingleSlot()) {
-        Structure* transition = singleTransition();
-        return transition && transition->m_nameInPrevious == rep && transition->m_attributesInPrevious == attributes;
-    }
-    return map()->get(make_pair(rep, attributes));
+    return get(rep, attributes);
 }
 
 inline Structure* StructureTransitionTable::get(StringImpl* rep, unsigned attributes) const
@@ -78,6 +74,15 @@ inline Structure* StructureTransitionTable::get(StringImpl* rep, unsigned attrib
         Structure* transition = singleTransition();
         return (transition && transition->m_nameInPrevious == rep && transition->m_attributesInPrevious == attributes) ? transition : 0;
     }
+    if (isUsingArray()) {
+        TransitionArray* array = this->array();
+        for (unsigned i = 0; i < array->size; ++i) {
+            Structure* transition = liveTransition(array->transitions[i]);
+            if (transition && transition->m_nameInPrevious == rep && transition->m_attributesInPrevious == attributes)
+                return transition;
+        }
+        return 0;
+    }
     return map()->get(make_pair(rep, attributes));
 }
 
@@ -94,10 +99,38 @@ inline void StructureTransitionTable::add(VM& vm, Structure* structure)
 
         // This handles the second transition being added
         // (or the first transition being despecified!)
-        setMap(new TransitionMap());
+        setArray(new TransitionArray);
         add(vm, existingTransition);
     }
 
+    if (isUsingArray()) {
+        TransitionArray* array = this->array();
+
+        // Replace a transition with the same key (which happens when a transition is
+        // despecified), or one whose target has died, before growing.
+        for (unsigned i = 0; i < array->size; ++i) {
+            Structure* transition = liveTransition(array->transitions[i]);
+            if (transition && (transition->m_nameInPrevious != structure->m_nameInPrevious || transition->m_attributesInPrevious != structure->m_attributesInPrevious))
+                continue;
+            WeakSet::deallocate(array->transitions[i]);
+            array->transitions[i] = WeakSet::allocate(reinterpret_cast<JSCell*>(structure));
+            return;
+        }
+
+        if (array->size < TransitionArray::capacity) {
+            array->transitions[array->size++] = WeakSet::allocate(reinterpret_cast<JSCell*>(structure));
+            return;
+        }
+
+        // The array is full of live transitions, so move them to a map.
+        Vector<Structure*, TransitionArray::capacity> existingTransitions;
+        for (unsigned i = 0; i < array->size; ++i)
+            existingTransitions.append(liveTransition(array->transitions[i]));
+        setMap(new TransitionMap());
+        for (unsigned i = 0; i < existingTransitions.size(); ++i)
+            add(vm, existingTransitions[i]);
+    }
+
     // Add the structure to the map.
 
     // Newer versions of the STL have an std::make_pair function that takes rvalue references.
@@ -106,6 +139,16 @@ inline void StructureTransitionTable::add(VM& vm, Structure* structure)
     map()->set(make_pair(structure->m_nameInPrevious, +structure->m_attributesInPrevious), structure);
 }
 
+size_t StructureTransitionTable::sizeInMemory() const
+{
+    if (isUsingSingleSlot())
+        return weakImpl() ? sizeof(WeakImpl) : 0;
+    if (isUsingArray())
+        return sizeof(TransitionArray) + array()->size * sizeof(WeakImpl);
+    TransitionMap* map = this->map();
+    return sizeof(TransitionMap) + map->capacity() * sizeof(TransitionMap::ValueType) + map->size() * sizeof(WeakImpl);
+}
+
 void Structure::dumpStatistics()
 {
 #if DUMP_STRUCTURE_ID_STATISTICS
@@ -246,13 +289,15 @@ void Structure::materializePropertyMap(VM& vm)
 
     Structure* structure = this;
 
-    // Search for the last Structure with a property table.
+    // Search for the last Structure with a property table. Besides pinned tables, this
+    // finds tables that an earlier lookup materialized, and that the collector has not
+    // thrown away yet, so that the Structures along a transition chain share the work of
+    // rebuilding instead of each replaying the chain from its root.
     while ((structure = structure->previousID())) {
-        if (structure->m_isPinnedPropertyTable) {
-            ASSERT(structure->propertyTable());
-            ASSERT(!structure->previousID());
+        if (PropertyTable* table = structure->propertyTable().get()) {
+            ASSERT(!structure->m_isPinnedPropertyTable || !structure->previousID());
 
-            propertyTable().set(vm, this, structure->propertyTable()->copy(vm, 0, numberOfSlotsForLastOffset(m_offset, m_inlineCapacity)));
+            propertyTable().set(vm, this, table->copy(vm, 0, numberOfSlotsForLastOffset(m_offset, m_inlineCapacity)));
             break;
         }
 
@@ -658,6 +703,16 @@ Structure* Structure::flattenDictionaryStructure(VM& vm, JSObject* object)
     return this;
 }
 
+bool Structure::shouldFlattenAfterDeletion()
+{
+    ASSERT(isUncacheableDictionary());
+    PropertyTable* table = propertyTable().get();
+    if (!table)
+        return false;
+    unsigned deletedOffsetCount = table->propertyStorageSize() - table->size();
+    return deletedOffsetCount >= s_minimumDeletedOffsetsForFlattening && deletedOffsetCount > table->size();
+}
+
 PropertyOffset Structure::addPropertyWithoutTransition(VM& vm, PropertyName propertyName, unsigned attributes, JSCell* specificValue)
 {
     ASSERT(!enumerationCache());
@@ -112,6 +112,11 @@ public:
 
     Structure* flattenDictionaryStructure(VM&, JSObject*);
 
+    // Deleting from an uncacheable dictionary leaves holes in the object's property storage,
+    // which are only reused by later additions. Once there are more holes than properties,
+    // and enough of them to matter, the object is better off flattened.
+    bool shouldFlattenAfterDeletion();
+
     static const bool needsDestruction = true;
     static const bool hasImmortalStructure = true;
     static void destroy(JSCell*);
@@ -249,6 +254,9 @@ public:
     }
 
     bool hasNonEnumerableProperties() const { return m_hasNonEnumerableProperties; }
+
+    // Bytes this Structure allocates outside of the heap to track its transitions.
+    size_t transitionTableSizeInMemory() const { return m_transitionTable.sizeInMemory(); }
         
     bool isEmpty() const
     {
@@ -435,6 +443,8 @@ private:
 
     static const int s_maxTransitionLength = 64;
 
+    static const unsigned s_minimumDeletedOffsetsForFlattening = 8;
+
     static const unsigned maxSpecificFunctionThrashCount = 3;
         
     WriteBarrier<JSGlobalObject> m_globalObject;
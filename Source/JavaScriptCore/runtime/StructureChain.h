@@ -40,8 +40,13 @@ namespace JSC {
     class LLIntOffsetsExtractor;
     class Structure;
 
+    namespace DFG {
+    class SpeculativeJIT;
+    }
+
     class StructureChain : public JSCell {
         friend class JIT;
+        friend class DFG::SpeculativeJIT;
 
     public:
         typedef JSCell Base;
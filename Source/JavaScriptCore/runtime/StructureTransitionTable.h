@@ -91,7 +91,13 @@ inline IndexingType newIndexingType(IndexingType oldType, NonPropertyTransition
 }
 
 class StructureTransitionTable {
+    // m_data holds one of three representations, told apart by its low bits. Most
+    // Structures have at most one transition, which is kept as a single weak slot. A
+    // few more are kept in a small array of weak slots, matched against each target's
+    // m_nameInPrevious and m_attributesInPrevious, before we pay for a hash map.
     static const intptr_t UsingSingleSlotFlag = 1;
+    static const intptr_t UsingArrayFlag = 2;
+    static const intptr_t RepresentationMask = UsingSingleSlotFlag | UsingArrayFlag;
 
     struct Hash {
         typedef std::pair<RefPtr<StringImpl>, unsigned> Key;
@@ -113,6 +119,20 @@ class StructureTransitionTable {
 
     typedef WeakGCMap<Hash::Key, Structure, Hash> TransitionMap;
 
+    struct TransitionArray {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        static const unsigned capacity = 6;
+
+        TransitionArray()
+            : size(0)
+        {
+        }
+
+        unsigned size;
+        WeakImpl* transitions[capacity];
+    };
+
 public:
     StructureTransitionTable()
         : m_data(UsingSingleSlotFlag)
@@ -121,6 +141,14 @@ public:
 
     ~StructureTransitionTable()
     {
+        if (isUsingArray()) {
+            TransitionArray* array = this->array();
+            for (unsigned i = 0; i < array->size; ++i)
+                WeakSet::deallocate(array->transitions[i]);
+            delete array;
+            return;
+        }
+
         if (!isUsingSingleSlot()) {
             delete map();
             return;
@@ -136,18 +164,32 @@ public:
     inline bool contains(StringImpl* rep, unsigned attributes) const;
     inline Structure* get(StringImpl* rep, unsigned attributes) const;
 
+    // Bytes allocated outside of the owning Structure to hold the transitions.
+    size_t sizeInMemory() const;
+
 private:
     bool isUsingSingleSlot() const
     {
         return m_data & UsingSingleSlotFlag;
     }
 
+    bool isUsingArray() const
+    {
+        return m_data & UsingArrayFlag;
+    }
+
     TransitionMap* map() const
     {
-        ASSERT(!isUsingSingleSlot());
+        ASSERT(!(m_data & RepresentationMask));
         return reinterpret_cast<TransitionMap*>(m_data);
     }
 
+    TransitionArray* array() const
+    {
+        ASSERT(isUsingArray());
+        return reinterpret_cast<TransitionArray*>(m_data & ~UsingArrayFlag);
+    }
+
     WeakImpl* weakImpl() const
     {
         ASSERT(isUsingSingleSlot());
@@ -155,26 +197,43 @@ private:
     }
 
     void setMap(TransitionMap* map)
+    {
+        ASSERT(isUsingArray());
+
+        TransitionArray* array = this->array();
+        for (unsigned i = 0; i < array->size; ++i)
+            WeakSet::deallocate(array->transitions[i]);
+        delete array;
+
+        // This implicitly clears the flags that indicate we're not using a map.
+        m_data = reinterpret_cast<intptr_t>(map);
+
+        ASSERT(!(m_data & RepresentationMask));
+    }
+
+    void setArray(TransitionArray* array)
     {
         ASSERT(isUsingSingleSlot());
-        
+
         if (WeakImpl* impl = this->weakImpl())
             WeakSet::deallocate(impl);
 
-        // This implicitly clears the flag that indicates we're using a single transition
-        m_data = reinterpret_cast<intptr_t>(map);
+        m_data = reinterpret_cast<intptr_t>(array) | UsingArrayFlag;
 
-        ASSERT(!isUsingSingleSlot());
+        ASSERT(isUsingArray());
+    }
+
+    static Structure* liveTransition(WeakImpl* impl)
+    {
+        if (impl && impl->state() == WeakImpl::Live)
+            return reinterpret_cast<Structure*>(impl->jsValue().asCell());
+        return 0;
     }
 
     Structure* singleTransition() const
     {
         ASSERT(isUsingSingleSlot());
-        if (WeakImpl* impl = this->weakImpl()) {
-            if (impl->state() == WeakImpl::Live)
-                return reinterpret_cast<Structure*>(impl->jsValue().asCell());
-        }
-        return 0;
+        return liveTransition(this->weakImpl());
     }
     
     void setSingleTransition(VM&, Structure* structure)
@@ -53,6 +53,7 @@
 #include "Lexer.h"
 #include "Lookup.h"
 #include "Nodes.h"
+#include "OpaqueJSString.h"
 #include "ParserArena.h"
 #include "RegExpCache.h"
 #include "RegExpObject.h"
@@ -257,6 +258,14 @@ VM::VM(VMType vmType, HeapType heapType)
         m_perBytecodeProfiler->registerToSaveAtExit(pathOut.toCString().data());
     }
 
+    m_tierUpTelemetry = adoptPtr(new Profiler::TierUpTelemetry);
+    m_tierUpTelemetry->setEnabled(Options::useTierUpTelemetry());
+
+#if ENABLE(SAMPLING_PROFILER)
+    if (Options::useSamplingProfiler())
+        m_samplingProfiler = adoptPtr(new SamplingProfiler(*this));
+#endif
+
 #if ENABLE(DFG_JIT)
     if (canUseJIT())
         m_dfgState = adoptPtr(new DFG::LongLivedState());
@@ -267,6 +276,10 @@ VM::~VM()
 {
     // Clear this first to ensure that nobody tries to remove themselves from it.
     m_perBytecodeProfiler.clear();
+    m_tierUpTelemetry.clear();
+#if ENABLE(SAMPLING_PROFILER)
+    m_samplingProfiler.clear();
+#endif
     
     ASSERT(m_apiLock->currentThreadIsHoldingLock());
     m_apiLock->willDestroyVM(this);
@@ -315,6 +328,7 @@ VM::~VM()
 
     delete emptyList;
 
+    m_opaqueJSStringIdentifierCache.clear();
     delete propertyNames;
     if (vmType != Default)
         deleteIdentifierTable(identifierTable);
@@ -331,11 +345,102 @@ VM::~VM()
 #endif
 }
 
+OpaqueJSStringIdentifierCache& VM::opaqueJSStringIdentifierCache()
+{
+    if (!m_opaqueJSStringIdentifierCache)
+        m_opaqueJSStringIdentifierCache = adoptPtr(new OpaqueJSStringIdentifierCache);
+    return *m_opaqueJSStringIdentifierCache;
+}
+
+// Context groups that were released and kept for reuse. Guarded by GlobalJSLock.
+static Vector<VM*>& recycledContextGroups()
+{
+    static Vector<VM*>* groups = new Vector<VM*>;
+    return *groups;
+}
+
 PassRefPtr<VM> VM::createContextGroup(HeapType heapType)
 {
+    if (heapType == SmallHeap) {
+        GlobalJSLock globalLock;
+        Vector<VM*>& groups = recycledContextGroups();
+        if (!groups.isEmpty()) {
+            VM* vm = groups.last();
+            groups.removeLast();
+            return adoptRef(vm);
+        }
+    }
     return adoptRef(new VM(APIContextGroup, heapType));
 }
 
+void VM::deref()
+{
+    if (hasOneRef() && recycleContextGroup())
+        return;
+    ThreadSafeRefCounted<VM>::deref();
+}
+
+// Most of what it costs to create a context is building its VM: the heap and its threads, the
+// identifier table, the common structures and strings, the static property tables and the JIT
+// thunks. A released context group keeps all of those, along with its code cache, for the
+// next group to use. Nothing that the released group's contexts created is reachable from
+// the new group; those objects are finalized by its next collection rather than right away.
+bool VM::recycleContextGroup()
+{
+    if (vmType != APIContextGroup || clientData || !m_apiLock->currentThreadIsHoldingLock())
+        return false;
+
+    // The client still holds values that it protected in this group.
+    if (heap.hasProtectedValues())
+        return false;
+
+    GlobalJSLock globalLock;
+    Vector<VM*>& groups = recycledContextGroups();
+    if (groups.size() >= Options::maximumRecycledContextGroups())
+        return false;
+
+    // Forget what the previous client configured.
+    if (watchdog.isEnabled()) {
+        watchdog.setTimeLimit(*this, std::numeric_limits<double>::infinity());
+        watchdog.setTimeSlice(*this, std::numeric_limits<double>::infinity());
+    }
+    m_tierUpTelemetry->clear();
+    m_tierUpTelemetry->setEnabled(Options::useTierUpTelemetry());
+#if ENABLE(SAMPLING_PROFILER)
+    if (m_samplingProfiler && m_samplingProfiler->isRunning())
+        m_samplingProfiler->stop();
+#endif
+    exception = JSValue();
+
+    groups.append(this);
+    return true;
+}
+
+void VM::setMaximumRecycledContextGroups(unsigned maximum)
+{
+    Vector<VM*> groupsToDestroy;
+    {
+        GlobalJSLock globalLock;
+        Options::maximumRecycledContextGroups() = maximum;
+        Vector<VM*>& groups = recycledContextGroups();
+        while (groups.size() > maximum) {
+            groupsToDestroy.append(groups.last());
+            groups.removeLast();
+        }
+    }
+
+    for (size_t i = 0; i < groupsToDestroy.size(); ++i) {
+        VM* vm = groupsToDestroy[i];
+        IdentifierTable* savedIdentifierTable;
+        {
+            JSLockHolder lock(vm);
+            savedIdentifierTable = wtfThreadData().setCurrentIdentifierTable(vm->identifierTable);
+            vm->deref();
+        }
+        wtfThreadData().setCurrentIdentifierTable(savedIdentifierTable);
+    }
+}
+
 PassRefPtr<VM> VM::create(HeapType heapType)
 {
     return adoptRef(new VM(Default, heapType));
@@ -425,8 +530,7 @@ VM::ClientData::~ClientData()
 void VM::resetDateCache()
 {
     localTimeOffsetCache.reset();
-    cachedDateString = String();
-    cachedDateStringValue = QNaN;
+    parsedDateCache.reset();
     dateInstanceCache.reset();
 }
 
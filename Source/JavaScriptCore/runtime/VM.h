@@ -42,8 +42,10 @@
 #include "MacroAssemblerCodeRef.h"
 #include "NumericStrings.h"
 #include "ProfilerDatabase.h"
+#include "ProfilerTierUpTelemetry.h"
 #include "PrivateName.h"
 #include "PrototypeMap.h"
+#include "SamplingProfiler.h"
 #include "SmallStrings.h"
 #include "Strong.h"
 #include "ThunkGenerators.h"
@@ -63,6 +65,8 @@
 #include <wtf/ListHashSet.h>
 #endif
 
+class OpaqueJSStringIdentifierCache;
+
 namespace JSC {
 
     class CodeBlock;
@@ -124,6 +128,33 @@ namespace JSC {
         double increment;
     };
 
+    // Results of parsing date strings. Pages tend to parse the same handful of
+    // strings over and over, often interleaved, so keep more than just the last
+    // one around.
+    struct ParsedDateCache {
+        static const size_t cacheSize = 16;
+
+        struct Entry {
+            Entry()
+                : value(QNaN)
+            {
+            }
+
+            String string;
+            double value;
+        };
+
+        void reset()
+        {
+            for (size_t i = 0; i < cacheSize; ++i)
+                m_cache[i] = Entry();
+        }
+
+        Entry& lookup(const String& string) { return m_cache[(string.impl() ? string.impl()->hash() : 0) & (cacheSize - 1)]; }
+
+        FixedArray<Entry, cacheSize> m_cache;
+    };
+
 #if ENABLE(DFG_JIT)
     class ConservativeRoots;
 
@@ -191,9 +222,18 @@ namespace JSC {
         static PassRefPtr<VM> createContextGroup(HeapType = SmallHeap);
         JS_EXPORT_PRIVATE ~VM();
 
+        // When the last reference to a context group goes away, its VM may be kept for reuse by
+        // a later createContextGroup() instead of being destroyed; see recycleContextGroup().
+        void deref();
+
+        // Sets Options::maximumRecycledContextGroups(), destroying the kept VMs that no longer fit.
+        static void setMaximumRecycledContextGroups(unsigned);
+
         void makeUsableFromMultipleThreads() { heap.machineThreads().makeUsableFromMultipleThreads(); }
 
     private:
+        bool recycleContextGroup();
+
         RefPtr<JSLock> m_apiLock;
 
     public:
@@ -375,11 +415,15 @@ namespace JSC {
 
         LocalTimeOffsetCache localTimeOffsetCache;
         
-        String cachedDateString;
-        double cachedDateStringValue;
+        ParsedDateCache parsedDateCache;
 
         LegacyProfiler* m_enabledProfiler;
         OwnPtr<Profiler::Database> m_perBytecodeProfiler;
+        OwnPtr<Profiler::TierUpTelemetry> m_tierUpTelemetry;
+        Profiler::TierUpTelemetry* enabledTierUpTelemetry() { return m_tierUpTelemetry && m_tierUpTelemetry->isEnabled() ? m_tierUpTelemetry.get() : 0; }
+#if ENABLE(SAMPLING_PROFILER)
+        OwnPtr<SamplingProfiler> m_samplingProfiler;
+#endif
         RegExpCache* m_regExpCache;
         BumpPointerAllocator m_regExpAllocator;
 
@@ -400,6 +444,8 @@ namespace JSC {
         JS_EXPORT_PRIVATE void stopSampling();
         JS_EXPORT_PRIVATE void dumpSampleData(ExecState* exec);
         RegExpCache* regExpCache() { return m_regExpCache; }
+
+        OpaqueJSStringIdentifierCache& opaqueJSStringIdentifierCache();
 #if ENABLE(REGEXP_TRACING)
         void addRegExpToTrace(PassRefPtr<RegExp> regExp);
 #endif
@@ -494,6 +540,7 @@ namespace JSC {
 #endif
         bool m_inDefineOwnProperty;
         RefPtr<CodeCache> m_codeCache;
+        OwnPtr<OpaqueJSStringIdentifierCache> m_opaqueJSStringIdentifierCache;
         RefCountedArray<StackFrame> m_exceptionStack;
 
         TypedArrayDescriptor m_int8ArrayDescriptor;
@@ -40,11 +40,17 @@ Watchdog::Watchdog()
     , m_limit(NO_LIMIT)
     , m_startTime(0)
     , m_elapsedTime(0)
+    , m_timeSlice(NO_LIMIT)
+    , m_timeSliceElapsedTime(0)
     , m_reentryCount(0)
     , m_isStopped(true)
     , m_callback(0)
     , m_callbackData1(0)
     , m_callbackData2(0)
+    , m_timeSliceCallback(0)
+    , m_timeSliceCallbackData1(0)
+    , m_timeSliceCallbackData2(0)
+    , m_isYielding(false)
 {
     initTimer();
 }
@@ -61,12 +67,15 @@ void Watchdog::setTimeLimit(VM& vm, double limit,
 {
     bool wasEnabled = isEnabled();
 
-    if (!m_isStopped)
+    if (!m_isStopped) {
+        updateElapsedTime();
         stopCountdown();
+    }
 
     m_didFire = false; // Reset the watchdog.
 
     m_limit = limit;
+    m_elapsedTime = 0;
     m_callback = callback;
     m_callbackData1 = data1;
     m_callbackData2 = data2;
@@ -78,7 +87,7 @@ void Watchdog::setTimeLimit(VM& vm, double limit,
     // However, if the timeout is already enabled, and we're just changing the
     // timeout value, then any existing JITted code will have the appropriate
     // polling checks. Hence, there is no need to re-do this flushing.
-    if (!wasEnabled) {
+    if (!wasEnabled && isEnabled()) {
         // And if we've previously compiled any functions, we need to revert
         // them because they don't have the needed polling checks yet.
         vm.releaseExecutableMemory();
@@ -87,6 +96,28 @@ void Watchdog::setTimeLimit(VM& vm, double limit,
     startCountdownIfNeeded();
 }
 
+void Watchdog::setTimeSlice(VM& vm, double seconds, TimeSliceCallback callback, void* data1, void* data2)
+{
+    bool wasEnabled = isEnabled();
+
+    if (!m_isStopped) {
+        updateElapsedTime();
+        stopCountdown();
+    }
+
+    m_timeSlice = callback ? seconds : NO_LIMIT;
+    m_timeSliceElapsedTime = 0;
+    m_timeSliceCallback = callback;
+    m_timeSliceCallbackData1 = data1;
+    m_timeSliceCallbackData2 = data2;
+
+    // Time slices are serviced by the same polling checks as the time limit.
+    if (!wasEnabled && isEnabled())
+        vm.releaseExecutableMemory();
+
+    startCountdownIfNeeded();
+}
+
 bool Watchdog::didFire(ExecState* exec)
 {
     if (m_didFire)
@@ -95,12 +126,10 @@ bool Watchdog::didFire(ExecState* exec)
     if (!m_timerDidFire)
         return false;
     m_timerDidFire = false;
+    updateElapsedTime();
     stopCountdown();
 
-    double currentTime = currentCPUTime();
-    double deltaTime = currentTime - m_startTime;
-    double totalElapsedTime = m_elapsedTime + deltaTime;
-    if (totalElapsedTime > m_limit) {
+    if (m_elapsedTime > m_limit) {
         // Case 1: the allowed CPU time has elapsed.
 
         // If m_callback is not set, then we terminate by default.
@@ -112,27 +141,37 @@ bool Watchdog::didFire(ExecState* exec)
             return true;
         }
 
-        // The m_callback may have set a new limit. So, we may need to restart
-        // the countdown.
-        startCountdownIfNeeded();
+        // The script gets another period of the allowed time. The m_callback
+        // may also have set a new limit, and restarted the countdown for it.
+        m_elapsedTime = 0;
+        m_startTime = currentCPUTime();
+    }
+
+    if (m_timeSliceElapsedTime >= m_timeSlice && !m_isYielding) {
+        // Case 2: the script has used up its time slice. Let the client run,
+        // e.g. to handle pending input, and then resume the script.
+        m_isYielding = true;
+        m_timeSliceCallback(exec, m_timeSliceCallbackData1, m_timeSliceCallbackData2);
+        m_isYielding = false;
 
-    } else {
-        // Case 2: the allowed CPU time has NOT elapsed.
+        // The callback may have restarted the countdown without the time slice.
+        stopCountdown();
 
-        // Tell the timer to alarm us again when it thinks we've reached the
-        // end of the allowed time.
-        double remainingTime = m_limit - totalElapsedTime;
-        m_elapsedTime = totalElapsedTime;
-        m_startTime = currentTime;
-        startCountdown(remainingTime);
+        // The CPU time that the client used is not charged to the script.
+        m_timeSliceElapsedTime = 0;
+        m_startTime = currentCPUTime();
     }
 
+    // Tell the timer to alarm us again when it thinks we've reached the end
+    // of the allowed time or of the time slice.
+    startCountdownIfNeeded();
+
     return false;
 }
 
 bool Watchdog::isEnabled()
 {
-    return (m_limit != NO_LIMIT);
+    return (m_limit != NO_LIMIT) || (m_timeSlice != NO_LIMIT);
 }
 
 void Watchdog::fire()
@@ -143,8 +182,11 @@ void Watchdog::fire()
 void Watchdog::arm()
 {
     m_reentryCount++;
-    if (m_reentryCount == 1)
+    if (m_reentryCount == 1) {
+        m_elapsedTime = 0;
+        m_timeSliceElapsedTime = 0;
         startCountdownIfNeeded();
+    }
 }
 
 void Watchdog::disarm()
@@ -155,6 +197,23 @@ void Watchdog::disarm()
     m_reentryCount--;
 }
 
+void Watchdog::updateElapsedTime()
+{
+    double currentTime = currentCPUTime();
+    double deltaTime = currentTime - m_startTime;
+    m_elapsedTime += deltaTime;
+    m_timeSliceElapsedTime += deltaTime;
+    m_startTime = currentTime;
+}
+
+double Watchdog::timeUntilNextCheck()
+{
+    double remainingTime = m_limit - m_elapsedTime;
+    if (!m_isYielding)
+        remainingTime = std::min(remainingTime, m_timeSlice - m_timeSliceElapsedTime);
+    return std::max(remainingTime, 0.0);
+}
+
 void Watchdog::startCountdownIfNeeded()
 {
     if (!m_isStopped)
@@ -164,9 +223,8 @@ void Watchdog::startCountdownIfNeeded()
         return; // Not executing JS script. No need to start.
 
     if (isEnabled()) {
-        m_elapsedTime = 0;
         m_startTime = currentCPUTime();
-        startCountdown(m_limit);
+        startCountdown(timeUntilNextCheck());
     }
 }
 
@@ -28,6 +28,8 @@
 
 #if PLATFORM(MAC) || PLATFORM(IOS)
 #include <dispatch/dispatch.h>    
+#else
+#include <wtf/Threading.h>
 #endif
 
 namespace JSC {
@@ -45,6 +47,12 @@ public:
     typedef bool (*ShouldTerminateCallback)(ExecState*, void* data1, void* data2);
     void setTimeLimit(VM&, double seconds, ShouldTerminateCallback = 0, void* data1 = 0, void* data2 = 0);
 
+    // Every time script has run for the given amount of CPU time, it is paused at the next
+    // watchdog check and the callback is called. When the callback returns, the script
+    // resumes where it left off. Passing a null callback turns time slicing off.
+    typedef void (*TimeSliceCallback)(ExecState*, void* data1, void* data2);
+    void setTimeSlice(VM&, double seconds, TimeSliceCallback = 0, void* data1 = 0, void* data2 = 0);
+
     // This version of didFire() will check the elapsed CPU time and call the
     // callback (if needed) to determine if the watchdog should fire.
     bool didFire(ExecState*);
@@ -62,6 +70,8 @@ public:
 private:
     void arm();
     void disarm();
+    void updateElapsedTime();
+    double timeUntilNextCheck();
     void startCountdownIfNeeded();
     void startCountdown(double limit);
     void stopCountdown();
@@ -85,6 +95,8 @@ private:
     double m_limit;
     double m_startTime;
     double m_elapsedTime;
+    double m_timeSlice;
+    double m_timeSliceElapsedTime;
 
     int m_reentryCount;
     bool m_isStopped;
@@ -93,9 +105,23 @@ private:
     void* m_callbackData1;
     void* m_callbackData2;
 
+    TimeSliceCallback m_timeSliceCallback;
+    void* m_timeSliceCallbackData1;
+    void* m_timeSliceCallbackData2;
+    bool m_isYielding;
+
 #if PLATFORM(MAC) || PLATFORM(IOS)
     dispatch_queue_t m_queue;
     dispatch_source_t m_timer;
+#else
+    static void timerThreadEntryPoint(void*);
+    void timerThreadBody();
+
+    Mutex m_timerLock;
+    ThreadCondition m_timerCondition;
+    ThreadIdentifier m_timerThread;
+    double m_timerDeadline; // In wall clock time; infinity while the timer is stopped.
+    bool m_timerShouldExit;
 #endif
 
     friend class Watchdog::Scope;
@@ -0,0 +1,42 @@
+(function () {
+    // Identifiers of the lengths found in scripts and markup: short locals, DOM style
+    // names and long qualified names. Each comes in an 8-bit and a 16-bit version.
+    var words = ["node", "element", "attribute", "listener", "document", "parser", "tokenizer", "selector", "style", "child"];
+
+    function makeIdentifier(index, parts, suffix) {
+        var result = "";
+        for (var i = 0; i < parts; ++i)
+            result += words[(index + i * 7) % words.length];
+        return result + index + suffix;
+    }
+
+    var identifiers = [];
+    for (var parts = 1; parts <= 8; parts *= 2) {
+        for (var i = 0; i < 250; ++i) {
+            identifiers.push(makeIdentifier(i, parts, ""));
+            identifiers.push(makeIdentifier(i, parts, "é一"));
+        }
+    }
+
+    // Parsing hashes every identifier in the source into the identifier table.
+    var source = "var sum = 0;\n";
+    for (var i = 0; i < identifiers.length; ++i)
+        source += "var " + identifiers[i] + " = " + i + "; sum += " + identifiers[i] + ";\n";
+    source += "return sum;";
+
+    var result = 0;
+    for (var i = 0; i < 40; ++i)
+        result += new Function(source + "//" + i)();
+
+    // Property names built at run time are hashed when they are looked up.
+    var object = {};
+    for (var i = 0; i < identifiers.length; ++i)
+        object[identifiers[i]] = i;
+    for (var i = 0; i < 20; ++i) {
+        for (var j = 0; j < identifiers.length; ++j)
+            result += object[identifiers[j].substring(0, identifiers[j].length - 1) + identifiers[j].charAt(identifiers[j].length - 1)];
+    }
+
+    if (result != 119940000)
+        throw "Bad result: " + result;
+})();
@@ -0,0 +1,34 @@
+(function () {
+    // A document of the shape web applications serialize: many small records, some long
+    // text fields, and a few non-Latin-1 strings, several megabytes in all.
+    var longText = "";
+    while (longText.length < 20000)
+        longText += "Lorem ipsum dolor sit amet, consectetur adipiscing elit. ";
+
+    var records = [];
+    for (var i = 0; i < 20000; ++i) {
+        records.push({
+            id: i,
+            name: "record" + i,
+            tags: ["alpha", "beta", "gamma"],
+            enabled: !(i % 3),
+            score: i / 8,
+            text: (i % 100) ? "short text " + i : longText,
+            label: (i % 1000) ? "label" : "étiquette ☃"
+        });
+    }
+    var document = { title: "benchmark", records: records };
+
+    var result = 0;
+    for (var i = 0; i < 8; ++i) {
+        var json = JSON.stringify(document);
+        result += json.length;
+        result += json.charCodeAt(json.length >> 1);
+    }
+    var indented = JSON.stringify(document, null, 2);
+    result += indented.length;
+    result += JSON.parse(indented).records.length;
+
+    if (result != 62767176)
+        throw "Bad result: " + result;
+})();
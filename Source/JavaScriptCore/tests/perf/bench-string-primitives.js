@@ -0,0 +1,40 @@
+(function () {
+    // String sizes typical of tag names, class names and identifiers, attribute values
+    // and text nodes. Each size comes in an 8-bit and a 16-bit version.
+    var sizes = [8, 32, 256, 4096];
+    var iterations = [200000, 100000, 20000, 1000];
+
+    function makeString(length, extraCharacter) {
+        var result = "";
+        while (result.length < length)
+            result += "abcdefghijklmnopqrstuvwxyz0123456789-_";
+        return result.substring(0, length - 1) + extraCharacter;
+    }
+
+    function copy(string) {
+        // Builds a separate string with the same characters, so equality has to compare them.
+        return (" " + string).substring(1).split("").join("");
+    }
+
+    var result = 0;
+    for (var i = 0; i < sizes.length; ++i) {
+        var samples = [makeString(sizes[i], "z"), makeString(sizes[i], "☃")];
+        for (var j = 0; j < samples.length; ++j) {
+            var string = samples[j];
+            var same = copy(string);
+            var upper = string.toUpperCase();
+            var mixed = string.substring(0, string.length >> 1) + upper.substring(string.length >> 1);
+            for (var k = 0; k < iterations[i]; ++k) {
+                result += string.indexOf("#");
+                result += string.indexOf("z");
+                if (string == same)
+                    ++result;
+                result += string.toLowerCase().length;
+                result += mixed.toLowerCase().length;
+                result += string.toUpperCase().length;
+            }
+        }
+    }
+    if (result != 91346000)
+        throw "Bad result: " + result;
+})();
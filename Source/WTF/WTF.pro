@@ -91,6 +91,7 @@ HEADERS += \
     MessageQueue.h \
     MetaAllocator.h \
     MetaAllocatorHandle.h \
+    MPSCQueue.h \
     Noncopyable.h \
     NonCopyingSort.h \
     NotFound.h \
@@ -137,6 +138,8 @@ HEADERS += \
     StringExtras.h \
     StringHasher.h \
     StringPrintStream.h \
+    SwissHashTable.h \
+    TaskScheduler.h \
     TCPackedCache.h \
     TCSpinLock.h \
     TCSystemAlloc.h \
@@ -154,6 +157,7 @@ HEADERS += \
     text/StringHash.h \
     text/StringImpl.h \
     text/StringOperators.h \
+    text/StringSIMD.h \
     text/TextPosition.h \
     text/WTFString.h \
     threads/BinarySemaphore.h \
@@ -228,6 +232,7 @@ SOURCES += \
     SHA1.cpp \
     StackBounds.cpp \
     StringPrintStream.cpp \
+    TaskScheduler.cpp \
     TCSystemAlloc.cpp \
     Threading.cpp \
     TypeTraits.cpp \
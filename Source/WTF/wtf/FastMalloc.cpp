@@ -400,6 +400,16 @@ FastMallocStatistics fastMallocStatistics()
     return statistics;
 }
 
+size_t fastMallocSizeClassStatistics(FastMallocSizeClassStatistics*, size_t)
+{
+    return 0;
+}
+
+size_t fastMallocThreadCacheStatistics(FastMallocThreadCacheStatistics*, size_t)
+{
+    return 0;
+}
+
 size_t fastMallocSize(const void* p)
 {
 #if ENABLE(WTF_MALLOC_VALIDATION)
@@ -2679,6 +2689,7 @@ class TCMalloc_ThreadCache {
   size_t        size_;                  // Combined size of data
   ThreadIdentifier tid_;                // Which thread owns it
   bool          in_setspecific_;           // Called pthread_setspecific?
+  volatile bool scavenge_requested_;    // Set by the scavenger thread
   FreeList      list_[kNumClasses];     // Array indexed by size-class
 
   // We sample allocations, biased by the size of the allocation
@@ -2706,6 +2717,10 @@ class TCMalloc_ThreadCache {
   // Total byte size in cache
   size_t Size() const { return size_; }
 
+#ifdef WTF_CHANGES
+  uintptr_t platformThreadHandle() const { return (uintptr_t)tid_; }
+#endif
+
   ALWAYS_INLINE void* Allocate(size_t size);
   void Deallocate(HardenedSLL ptr, size_t size_class);
 
@@ -2730,6 +2745,11 @@ class TCMalloc_ThreadCache {
   static void                  DeleteCache(TCMalloc_ThreadCache* heap);
   static void                  BecomeIdle();
   static void                  RecomputeThreadCacheSize();
+  // Asks every thread to give back the objects it has not touched since its
+  // last scavenge the next time it frees memory.  Only the owning thread may
+  // modify its cache, so this cannot release anything itself.
+  // REQUIRES: pageheap_lock is held.
+  static void                  RequestScavenge();
 
 #ifdef WTF_CHANGES
   template <class Finder, class Reader>
@@ -2783,6 +2803,7 @@ void TCMalloc_PageHeap::periodicScavenge()
 {
     SpinLockHolder h(&pageheap_lock);
     pageheap->scavenge();
+    TCMalloc_ThreadCache::RequestScavenge();
 
     if (shouldScavenge()) {
         rescheduleScavenger();
@@ -2834,6 +2855,7 @@ void TCMalloc_PageHeap::scavengerThread()
         {
             SpinLockHolder h(&pageheap_lock);
             pageheap->scavenge();
+            TCMalloc_ThreadCache::RequestScavenge();
         }
     }
 }
@@ -3215,6 +3237,7 @@ void TCMalloc_ThreadCache::Init(ThreadIdentifier tid, uintptr_t entropy) {
   prev_ = NULL;
   tid_  = tid;
   in_setspecific_ = false;
+  scavenge_requested_ = false;
   entropy_ = entropy;
 #if ENABLE(TCMALLOC_HARDENING)
   ASSERT(entropy_);
@@ -3271,7 +3294,7 @@ inline void TCMalloc_ThreadCache::Deallocate(HardenedSLL ptr, size_t cl) {
   if (list->length() > kMaxFreeListLength) {
     ReleaseToCentralCache(cl, num_objects_to_move[cl]);
   }
-  if (size_ >= per_thread_cache_size) Scavenge();
+  if (size_ >= per_thread_cache_size || scavenge_requested_) Scavenge();
 }
 
 // Remove some objects of class "cl" from central cache and add to thread heap
@@ -3314,11 +3337,20 @@ inline void TCMalloc_ThreadCache::Scavenge() {
   // pretty soon and the low-water marks will be high on that call.
   //int64 start = CycleClock::Now();
 
+  // When the background scavenger asked for this pass the thread has been
+  // idle for a while, so the low-water mark objects are released in full.
+  const bool idle = scavenge_requested_;
+  scavenge_requested_ = false;
+
   for (size_t cl = 0; cl < kNumClasses; cl++) {
     FreeList* list = &list_[cl];
     const int lowmark = list->lowwatermark();
     if (lowmark > 0) {
-      const int drop = (lowmark > 1) ? lowmark/2 : 1;
+      int drop = idle ? lowmark : ((lowmark > 1) ? lowmark/2 : 1);
+      // Round down to whole batches so that everything we release lands in
+      // the transfer cache instead of being threaded back onto the spans.
+      const int batch_size = num_objects_to_move[cl];
+      if (drop > batch_size) drop -= drop % batch_size;
       ReleaseToCentralCache(cl, drop);
     }
     list->clear_lowwatermark();
@@ -3596,6 +3628,12 @@ void TCMalloc_ThreadCache::RecomputeThreadCacheSize() {
   per_thread_cache_size = space;
 }
 
+void TCMalloc_ThreadCache::RequestScavenge() {
+  ASSERT(pageheap_lock.IsHeld());
+  for (TCMalloc_ThreadCache* h = thread_heaps; h != NULL; h = h->next_)
+    h->scavenge_requested_ = true;
+}
+
 void TCMalloc_ThreadCache::Print() const {
   for (size_t cl = 0; cl < kNumClasses; ++cl) {
     MESSAGE("      %5" PRIuS " : %4d len; %4d lo\n",
@@ -4638,9 +4676,48 @@ void releaseFastMallocFreeMemory()
         threadCache->Cleanup();
 
     SpinLockHolder h(&pageheap_lock);
+    // Other threads trim their own caches the next time they free memory.
+    TCMalloc_ThreadCache::RequestScavenge();
     pageheap->ReleaseFreePages();
 }
 
+size_t fastMallocSizeClassStatistics(FastMallocSizeClassStatistics* statistics, size_t maxCount)
+{
+    // Size class 0 is never used.
+    const size_t sizeClassCount = kNumClasses - 1;
+    size_t count = std::min(maxCount, sizeClassCount);
+
+    SpinLockHolder lockHolder(&pageheap_lock);
+    for (size_t i = 0; i < count; ++i) {
+        size_t cl = i + 1;
+        statistics[i].objectSize = ByteSizeForClass(cl);
+        statistics[i].centralCacheFreeBytes = ByteSizeForClass(cl) * central_cache[cl].length();
+        statistics[i].transferCacheFreeBytes = ByteSizeForClass(cl) * central_cache[cl].tc_length();
+        statistics[i].threadCacheFreeBytes = 0;
+        for (TCMalloc_ThreadCache* threadCache = thread_heaps; threadCache; threadCache = threadCache->next_)
+            statistics[i].threadCacheFreeBytes += ByteSizeForClass(cl) * threadCache->freelist_length(cl);
+    }
+
+    return sizeClassCount;
+}
+
+size_t fastMallocThreadCacheStatistics(FastMallocThreadCacheStatistics* statistics, size_t maxCount)
+{
+    TCMalloc_ThreadCache* currentThreadCache = TCMalloc_ThreadCache::GetCacheIfPresent();
+
+    SpinLockHolder lockHolder(&pageheap_lock);
+    size_t count = 0;
+    for (TCMalloc_ThreadCache* threadCache = thread_heaps; threadCache; threadCache = threadCache->next_, ++count) {
+        if (count >= maxCount)
+            continue;
+        statistics[count].platformThreadHandle = threadCache->platformThreadHandle();
+        statistics[count].isCurrentThread = threadCache == currentThreadCache;
+        statistics[count].freeListBytes = threadCache->Size();
+    }
+
+    return count;
+}
+
 FastMallocStatistics fastMallocStatistics()
 {
     FastMallocStatistics statistics;
@@ -23,6 +23,7 @@
 
 #include <wtf/Platform.h>
 #include <wtf/PossiblyNull.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <new>
 
@@ -90,6 +91,26 @@ namespace WTF {
     };
     WTF_EXPORT_PRIVATE FastMallocStatistics fastMallocStatistics();
 
+    // Free memory held by each size class, split by where it is cached. threadCacheFreeBytes
+    // is summed over all threads.
+    struct FastMallocSizeClassStatistics {
+        size_t objectSize;
+        size_t centralCacheFreeBytes;
+        size_t transferCacheFreeBytes;
+        size_t threadCacheFreeBytes;
+    };
+    // Fills in at most maxCount entries and returns the number of size classes.
+    WTF_EXPORT_PRIVATE size_t fastMallocSizeClassStatistics(FastMallocSizeClassStatistics*, size_t maxCount);
+
+    struct FastMallocThreadCacheStatistics {
+        uintptr_t platformThreadHandle;
+        bool isCurrentThread;
+        size_t freeListBytes;
+    };
+    // Fills in at most maxCount entries and returns the number of thread caches, which
+    // may change between calls.
+    WTF_EXPORT_PRIVATE size_t fastMallocThreadCacheStatistics(FastMallocThreadCacheStatistics*, size_t maxCount);
+
     // This defines a type which holds an unsigned integer and is the same
     // size as the minimally aligned memory allocation.
     typedef unsigned long long AllocAlignmentInteger;
@@ -21,7 +21,7 @@
 #ifndef WTF_HashMap_h
 #define WTF_HashMap_h
 
-#include <wtf/HashTable.h>
+#include <wtf/SwissHashTable.h>
 
 namespace WTF {
 
@@ -61,8 +61,8 @@ namespace WTF {
 
         typedef HashArg HashFunctions;
 
-        typedef HashTable<KeyType, ValueType, KeyValuePairKeyExtractor<ValueType>,
-            HashFunctions, ValueTraits, KeyTraits> HashTableType;
+        typedef typename HashTableForTraits<KeyType, ValueType, KeyValuePairKeyExtractor<ValueType>,
+            HashFunctions, ValueTraits, KeyTraits>::Type HashTableType;
 
         class HashMapKeysProxy;
         class HashMapValuesProxy;
@@ -22,7 +22,7 @@
 #define WTF_HashSet_h
 
 #include <wtf/FastAllocBase.h>
-#include <wtf/HashTable.h>
+#include <wtf/SwissHashTable.h>
 
 namespace WTF {
 
@@ -43,8 +43,8 @@ namespace WTF {
         typedef typename ValueTraits::TraitType ValueType;
 
     private:
-        typedef HashTable<ValueType, ValueType, IdentityExtractor,
-            HashFunctions, ValueTraits, ValueTraits> HashTableType;
+        typedef typename HashTableForTraits<ValueType, ValueType, IdentityExtractor,
+            HashFunctions, ValueTraits, ValueTraits>::Type HashTableType;
 
     public:
         typedef HashTableConstIteratorAdapter<HashTableType, ValueType> iterator;
@@ -53,6 +53,10 @@ namespace WTF {
         // The starting table size. Can be overridden when we know beforehand that
         // a hash table will have at least N entries.
         static const int minimumTableSize = 8;
+
+        // The useSwissTable flag makes HashMap and HashSet store their contents in a
+        // SwissHashTable rather than a HashTable.
+        static const bool useSwissTable = false;
     };
 
     // Default integer traits disallow both 0 and -1 as keys (max value instead of -1 for unsigned).
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MPSCQueue_h
+#define MPSCQueue_h
+
+#include <wtf/Atomics.h>
+#include <wtf/FastAllocBase.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Threading.h>
+
+namespace WTF {
+
+// A multi-producer, single-consumer queue. Any thread may enqueue without taking a lock:
+// producers push onto a singly linked list with a compare-and-swap, and the consumer
+// detaches the whole list at once and hands it out in FIFO order. dequeueAll() must only
+// be called by one thread at a time; callers with several consumers have to serialize
+// it with a lock of their own.
+//
+// waitForItems() spins for a while before blocking, and the number of spins adapts to
+// whether spinning has recently paid off. A producer only touches the mutex when a
+// consumer is actually blocked.
+template<typename T>
+class MPSCQueue {
+    WTF_MAKE_NONCOPYABLE(MPSCQueue); WTF_MAKE_FAST_ALLOCATED;
+public:
+    MPSCQueue()
+        : m_head(0)
+        , m_waiterCount(0)
+        , m_spinLimit(initialSpinLimit)
+    {
+    }
+
+    ~MPSCQueue()
+    {
+        deleteNodes(takeAll());
+    }
+
+    // Returns true if there was nothing queued before this item, which producers can use to
+    // decide whether the consumer needs to be scheduled. Items that the consumer has already
+    // dequeued but not yet processed do not count.
+    bool enqueue(const T& value)
+    {
+        Node* node = new Node(value);
+        bool wasEmpty = push(node);
+
+        // Pairs with the fence in waitForItems(): either we see the waiter, or it sees our node.
+        // A locked compare-and-swap is already a full barrier on x86.
+#if !ENABLE(COMPARE_AND_SWAP) || !(CPU(X86) || CPU(X86_64))
+        storeLoadFence();
+#endif
+        if (m_waiterCount) {
+            MutexLocker locker(m_waitMutex);
+            m_waitCondition.broadcast();
+        }
+        return wasEmpty;
+    }
+
+    // Only meaningful as a hint while producers are running.
+    bool isEmpty() const { return !m_head; }
+
+    // Appends everything that has been enqueued so far to the container, oldest first.
+    // Returns the number of items appended.
+    template<typename Container>
+    size_t dequeueAll(Container& container)
+    {
+        if (!m_head)
+            return 0;
+
+        // The list is in LIFO order; reverse it before handing it out.
+        Node* reversed = 0;
+        for (Node* node = takeAll(); node;) {
+            Node* next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+
+        size_t count = 0;
+        for (Node* node = reversed; node; ++count) {
+            Node* next = node->next;
+            container.append(node->value);
+            delete node;
+            node = next;
+        }
+        return count;
+    }
+
+    // Returns false if absoluteTime passed while the queue was still empty.
+    bool waitForItems(double absoluteTime)
+    {
+        for (unsigned i = 0; i < m_spinLimit; ++i) {
+            if (m_head) {
+                if (m_spinLimit < maxSpinLimit)
+                    m_spinLimit *= 2;
+                return true;
+            }
+            yield();
+        }
+        if (m_spinLimit > minSpinLimit)
+            m_spinLimit /= 2;
+
+        MutexLocker locker(m_waitMutex);
+        ++m_waiterCount;
+        storeLoadFence();
+        bool timedOut = false;
+        while (!m_head && !timedOut)
+            timedOut = !m_waitCondition.timedWait(m_waitMutex, absoluteTime);
+        --m_waiterCount;
+        return !!m_head;
+    }
+
+private:
+    static const unsigned minSpinLimit = 1;
+    static const unsigned initialSpinLimit = 16;
+    static const unsigned maxSpinLimit = 256;
+
+    struct Node {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        Node(const T& value)
+            : value(value)
+            , next(0)
+        {
+        }
+
+        T value;
+        Node* next;
+    };
+
+#if ENABLE(COMPARE_AND_SWAP)
+    bool push(Node* node)
+    {
+        Node* head;
+        do {
+            head = m_head;
+            node->next = head;
+            // Make the node's contents visible before the node itself.
+            storeStoreFence();
+        } while (!weakCompareAndSwap(reinterpret_cast<void*volatile*>(&m_head), head, node));
+        return !head;
+    }
+
+    Node* takeAll()
+    {
+        Node* head;
+        do {
+            head = m_head;
+        } while (head && !weakCompareAndSwap(reinterpret_cast<void*volatile*>(&m_head), head, 0));
+        loadLoadFence();
+        return head;
+    }
+#else
+    bool push(Node* node)
+    {
+        MutexLocker locker(m_headMutex);
+        node->next = m_head;
+        m_head = node;
+        return !node->next;
+    }
+
+    Node* takeAll()
+    {
+        MutexLocker locker(m_headMutex);
+        Node* head = m_head;
+        m_head = 0;
+        return head;
+    }
+
+    Mutex m_headMutex;
+#endif
+
+    static void deleteNodes(Node* node)
+    {
+        while (node) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    Node* volatile m_head;
+
+    Mutex m_waitMutex;
+    ThreadCondition m_waitCondition;
+    volatile unsigned m_waiterCount;
+    unsigned m_spinLimit;
+};
+
+} // namespace WTF
+
+using WTF::MPSCQueue;
+
+#endif // MPSCQueue_h
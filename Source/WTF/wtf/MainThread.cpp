@@ -32,6 +32,7 @@
 #include "CurrentTime.h"
 #include "Deque.h"
 #include "Functional.h"
+#include "MPSCQueue.h"
 #include "StdLibExtras.h"
 #include "Threading.h"
 #include <wtf/ThreadSpecific.h>
@@ -78,6 +79,14 @@ static Mutex& mainThreadFunctionQueueMutex()
     return staticMutex;
 }
 
+// Functions are posted to the incoming queue without taking a lock. They are moved to
+// functionQueue(), under mainThreadFunctionQueueMutex(), before being run or cancelled.
+static MPSCQueue<FunctionWithContext>& incomingFunctionQueue()
+{
+    DEFINE_STATIC_LOCAL(MPSCQueue<FunctionWithContext>, staticIncomingFunctionQueue, ());
+    return staticIncomingFunctionQueue;
+}
+
 static FunctionQueue& functionQueue()
 {
     DEFINE_STATIC_LOCAL(FunctionQueue, staticFunctionQueue, ());
@@ -97,6 +106,7 @@ void initializeMainThread()
     mainThreadIdentifier = currentThread();
 
     mainThreadFunctionQueueMutex();
+    incomingFunctionQueue();
     initializeMainThreadPlatform();
     initializeGCThreads();
 }
@@ -108,6 +118,7 @@ static pthread_once_t initializeMainThreadKeyOnce = PTHREAD_ONCE_INIT;
 static void initializeMainThreadOnce()
 {
     mainThreadFunctionQueueMutex();
+    incomingFunctionQueue();
     initializeMainThreadPlatform();
 }
 
@@ -120,6 +131,7 @@ void initializeMainThread()
 static void initializeMainThreadToProcessMainThreadOnce()
 {
     mainThreadFunctionQueueMutex();
+    incomingFunctionQueue();
     initializeMainThreadToProcessMainThreadPlatform();
 }
 
@@ -147,6 +159,7 @@ void dispatchFunctionsFromMainThread()
     while (true) {
         {
             MutexLocker locker(mainThreadFunctionQueueMutex());
+            incomingFunctionQueue().dequeueAll(functionQueue());
             if (!functionQueue().size())
                 break;
             invocation = functionQueue().takeFirst();
@@ -172,13 +185,9 @@ void dispatchFunctionsFromMainThread()
 void callOnMainThread(MainThreadFunction* function, void* context)
 {
     ASSERT(function);
-    bool needToSchedule = false;
-    {
-        MutexLocker locker(mainThreadFunctionQueueMutex());
-        needToSchedule = functionQueue().size() == 0;
-        functionQueue().append(FunctionWithContext(function, context));
-    }
-    if (needToSchedule)
+    // If the incoming queue was not empty, whoever made it non-empty scheduled a dispatch
+    // that has not drained it yet.
+    if (incomingFunctionQueue().enqueue(FunctionWithContext(function, context)))
         scheduleDispatchFunctionsOnMainThread();
 }
 
@@ -194,8 +203,7 @@ void callOnMainThreadAndWait(MainThreadFunction* function, void* context)
     ThreadCondition syncFlag;
     Mutex& functionQueueMutex = mainThreadFunctionQueueMutex();
     MutexLocker locker(functionQueueMutex);
-    functionQueue().append(FunctionWithContext(function, context, &syncFlag));
-    if (functionQueue().size() == 1)
+    if (incomingFunctionQueue().enqueue(FunctionWithContext(function, context, &syncFlag)))
         scheduleDispatchFunctionsOnMainThread();
     syncFlag.wait(functionQueueMutex);
 }
@@ -205,6 +213,7 @@ void cancelCallOnMainThread(MainThreadFunction* function, void* context)
     ASSERT(function);
 
     MutexLocker locker(mainThreadFunctionQueueMutex());
+    incomingFunctionQueue().dequeueAll(functionQueue());
 
     FunctionWithContextFinder pred(FunctionWithContext(function, context));
 
@@ -33,6 +33,7 @@
 #include <limits>
 #include <wtf/Assertions.h>
 #include <wtf/Deque.h>
+#include <wtf/MPSCQueue.h>
 #include <wtf/Noncopyable.h>
 #include <wtf/Threading.h>
 
@@ -47,6 +48,8 @@ namespace WTF {
     // The queue takes ownership of messages and transfer it to the new owner
     // when messages are fetched from the queue.
     // Essentially, MessageQueue acts as a queue of OwnPtr<DataType>.
+    // append() does not take a lock: messages go into a lock-free incoming queue
+    // that is moved over to m_queue, in batches, by whoever next reads from it.
     template<typename DataType>
     class MessageQueue {
         WTF_MAKE_NONCOPYABLE(MessageQueue);
@@ -79,8 +82,25 @@ namespace WTF {
     private:
         static bool alwaysTruePredicate(DataType*) { return true; }
 
+        // REQUIRES: m_mutex is held.
+        void takeIncomingMessages();
+
+        struct NonNullMessageAppender {
+            NonNullMessageAppender(Deque<DataType*>& queue) : queue(queue) { }
+            void append(DataType* message)
+            {
+                if (message)
+                    queue.append(message);
+            }
+            Deque<DataType*>& queue;
+        };
+
+        // Waiters only block on the incoming queue, so changes made to m_queue or
+        // m_killed under m_mutex are announced by enqueueing a null message.
+        void wakeUpWaiters() { m_incoming.enqueue(0); }
+
         mutable Mutex m_mutex;
-        ThreadCondition m_condition;
+        MPSCQueue<DataType*> m_incoming;
         Deque<DataType*> m_queue;
         bool m_killed;
     };
@@ -88,24 +108,29 @@ namespace WTF {
     template<typename DataType>
     MessageQueue<DataType>::~MessageQueue()
     {
+        takeIncomingMessages();
         deleteAllValues(m_queue);
     }
 
+    template<typename DataType>
+    inline void MessageQueue<DataType>::takeIncomingMessages()
+    {
+        NonNullMessageAppender appender(m_queue);
+        m_incoming.dequeueAll(appender);
+    }
+
     template<typename DataType>
     inline void MessageQueue<DataType>::append(PassOwnPtr<DataType> message)
     {
-        MutexLocker lock(m_mutex);
-        m_queue.append(message.leakPtr());
-        m_condition.signal();
+        m_incoming.enqueue(message.leakPtr());
     }
 
     template<typename DataType>
     inline void MessageQueue<DataType>::appendAndKill(PassOwnPtr<DataType> message)
     {
         MutexLocker lock(m_mutex);
-        m_queue.append(message.leakPtr());
         m_killed = true;
-        m_condition.broadcast();
+        m_incoming.enqueue(message.leakPtr());
     }
 
     // Returns true if the queue was empty before the item was added.
@@ -113,9 +138,10 @@ namespace WTF {
     inline bool MessageQueue<DataType>::appendAndCheckEmpty(PassOwnPtr<DataType> message)
     {
         MutexLocker lock(m_mutex);
+        takeIncomingMessages();
         bool wasEmpty = m_queue.isEmpty();
         m_queue.append(message.leakPtr());
-        m_condition.signal();
+        wakeUpWaiters();
         return wasEmpty;
     }
 
@@ -123,8 +149,9 @@ namespace WTF {
     inline void MessageQueue<DataType>::prepend(PassOwnPtr<DataType> message)
     {
         MutexLocker lock(m_mutex);
+        takeIncomingMessages();
         m_queue.prepend(message.leakPtr());
-        m_condition.signal();
+        wakeUpWaiters();
     }
 
     template<typename DataType>
@@ -144,8 +171,14 @@ namespace WTF {
         bool timedOut = false;
 
         DequeConstIterator<DataType*> found = m_queue.end();
-        while (!m_killed && !timedOut && (found = m_queue.findIf(predicate)) == m_queue.end())
-            timedOut = !m_condition.timedWait(m_mutex, absoluteTime);
+        while (true) {
+            takeIncomingMessages();
+            if (m_killed || timedOut || (found = m_queue.findIf(predicate)) != m_queue.end())
+                break;
+            m_mutex.unlock();
+            timedOut = !m_incoming.waitForItems(absoluteTime);
+            m_mutex.lock();
+        }
 
         ASSERT(!timedOut || absoluteTime != infiniteTime());
 
@@ -172,6 +205,7 @@ namespace WTF {
         MutexLocker lock(m_mutex);
         if (m_killed)
             return nullptr;
+        takeIncomingMessages();
         if (m_queue.isEmpty())
             return nullptr;
 
@@ -182,6 +216,7 @@ namespace WTF {
     inline PassOwnPtr<DataType> MessageQueue<DataType>::tryGetMessageIgnoringKilled()
     {
         MutexLocker lock(m_mutex);
+        takeIncomingMessages();
         if (m_queue.isEmpty())
             return nullptr;
 
@@ -193,6 +228,7 @@ namespace WTF {
     inline void MessageQueue<DataType>::removeIf(Predicate& predicate)
     {
         MutexLocker lock(m_mutex);
+        takeIncomingMessages();
         DequeConstIterator<DataType*> found = m_queue.end();
         while ((found = m_queue.findIf(predicate)) != m_queue.end()) {
             DataType* message = *found;
@@ -207,6 +243,7 @@ namespace WTF {
         MutexLocker lock(m_mutex);
         if (m_killed)
             return true;
+        takeIncomingMessages();
         return m_queue.isEmpty();
     }
 
@@ -215,7 +252,7 @@ namespace WTF {
     {
         MutexLocker lock(m_mutex);
         m_killed = true;
-        m_condition.broadcast();
+        wakeUpWaiters();
     }
 
     template<typename DataType>
@@ -120,6 +120,7 @@ MetaAllocator::MetaAllocator(size_t allocationGranule, size_t pageSize)
     , m_bytesAllocated(0)
     , m_bytesReserved(0)
     , m_bytesCommitted(0)
+    , m_numberOfFreeChunks(0)
     , m_tracker(0)
 #ifndef NDEBUG
     , m_mallocBalance(0)
@@ -199,6 +200,9 @@ MetaAllocator::Statistics MetaAllocator::currentStatistics()
     result.bytesAllocated = m_bytesAllocated;
     result.bytesReserved = m_bytesReserved;
     result.bytesCommitted = m_bytesCommitted;
+    result.numberOfFreeChunks = m_numberOfFreeChunks;
+    FreeSpaceNode* largestFreeChunk = m_freeSpaceSizeMap.last();
+    result.largestFreeChunkSize = largestFreeChunk ? largestFreeChunk->m_sizeInBytes : 0;
     return result;
 }
 
@@ -436,6 +440,7 @@ MetaAllocator::FreeSpaceNode* MetaAllocator::allocFreeSpaceNode()
 #ifndef NDEBUG
     m_mallocBalance++;
 #endif
+    m_numberOfFreeChunks++;
     return new (NotNull, fastMalloc(sizeof(FreeSpaceNode))) FreeSpaceNode(0, 0);
 }
 
@@ -444,6 +449,7 @@ void MetaAllocator::freeFreeSpaceNode(FreeSpaceNode* node)
 #ifndef NDEBUG
     m_mallocBalance--;
 #endif
+    m_numberOfFreeChunks--;
     fastFree(node);
 }
 
@@ -451,8 +457,8 @@ void MetaAllocator::freeFreeSpaceNode(FreeSpaceNode* node)
 void MetaAllocator::dumpProfile()
 {
     dataLogF(
-        "%d: MetaAllocator(%p): num allocations = %u, num frees = %u, allocated = %lu, reserved = %lu, committed = %lu\n",
-        getCurrentProcessID(), this, m_numAllocations, m_numFrees, m_bytesAllocated, m_bytesReserved, m_bytesCommitted);
+        "%d: MetaAllocator(%p): num allocations = %u, num frees = %u, allocated = %lu, reserved = %lu, committed = %lu, free chunks = %lu\n",
+        getCurrentProcessID(), this, m_numAllocations, m_numFrees, m_bytesAllocated, m_bytesReserved, m_bytesCommitted, m_numberOfFreeChunks);
 }
 #endif
 
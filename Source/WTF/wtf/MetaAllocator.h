@@ -80,11 +80,16 @@ public:
     size_t bytesReserved() { return m_bytesReserved; }
     size_t bytesCommitted() { return m_bytesCommitted; }
     
-    // Atomic method for getting allocator statistics.
+    // Atomic method for getting allocator statistics. Free space that is split
+    // into many small chunks cannot satisfy large allocations even when there is
+    // plenty of it in total, so the number of free chunks and the size of the
+    // largest one are reported alongside the byte counts.
     struct Statistics {
         size_t bytesAllocated;
         size_t bytesReserved;
         size_t bytesCommitted;
+        size_t numberOfFreeChunks;
+        size_t largestFreeChunkSize;
     };
     Statistics currentStatistics();
 
@@ -182,6 +187,7 @@ private:
     size_t m_bytesAllocated;
     size_t m_bytesReserved;
     size_t m_bytesCommitted;
+    size_t m_numberOfFreeChunks;
     
     SpinLock m_lock;
 
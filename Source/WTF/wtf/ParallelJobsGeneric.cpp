@@ -30,112 +30,38 @@
 #if ENABLE(THREADING_GENERIC)
 
 #include "ParallelJobs.h"
-#include <wtf/NumberOfCores.h>
+#include "TaskScheduler.h"
 
 namespace WTF {
 
-Vector< RefPtr<ParallelEnvironment::ThreadPrivate> >* ParallelEnvironment::s_threadPool = 0;
-
 ParallelEnvironment::ParallelEnvironment(ThreadFunction threadFunction, size_t sizeOfParameter, int requestedJobNumber) :
     m_threadFunction(threadFunction),
     m_sizeOfParameter(sizeOfParameter)
 {
     ASSERT_ARG(requestedJobNumber, requestedJobNumber >= 1);
 
-    int maxNumberOfCores = numberOfProcessorCores();
-
-    if (!requestedJobNumber || requestedJobNumber > maxNumberOfCores)
-        requestedJobNumber = static_cast<unsigned>(maxNumberOfCores);
-
-    if (!s_threadPool)
-        s_threadPool = new Vector< RefPtr<ThreadPrivate> >();
-
-    // The main thread should be also a worker.
-    int maxNumberOfNewThreads = requestedJobNumber - 1;
+    int concurrency = static_cast<int>(taskSchedulerConcurrency());
 
-    for (int i = 0; i < maxNumberOfCores && m_threads.size() < static_cast<unsigned>(maxNumberOfNewThreads); ++i) {
-        if (s_threadPool->size() < static_cast<unsigned>(i) + 1U)
-            s_threadPool->append(ThreadPrivate::create());
+    if (!requestedJobNumber || requestedJobNumber > concurrency)
+        requestedJobNumber = concurrency;
 
-        if ((*s_threadPool)[i]->tryLockFor(this))
-            m_threads.append((*s_threadPool)[i]);
-    }
-
-    m_numberOfJobs = m_threads.size() + 1;
+    m_numberOfJobs = requestedJobNumber;
 }
 
 void ParallelEnvironment::execute(void* parameters)
 {
     unsigned char* currentParameter = static_cast<unsigned char*>(parameters);
-    size_t i;
-    for (i = 0; i < m_threads.size(); ++i) {
-        m_threads[i]->execute(m_threadFunction, currentParameter);
+    TaskGroup group;
+    for (int i = 0; i < m_numberOfJobs - 1; ++i) {
+        group.run(m_threadFunction, currentParameter);
         currentParameter += m_sizeOfParameter;
     }
 
-    // The work for the main thread.
+    // The work for the calling thread.
     (*m_threadFunction)(currentParameter);
 
-    // Wait until all jobs are done.
-    for (i = 0; i < m_threads.size(); ++i)
-        m_threads[i]->waitForFinish();
-}
-
-bool ParallelEnvironment::ThreadPrivate::tryLockFor(ParallelEnvironment* parent)
-{
-    bool locked = m_mutex.tryLock();
-
-    if (!locked)
-        return false;
-
-    if (m_parent) {
-        m_mutex.unlock();
-        return false;
-    }
-
-    if (!m_threadID)
-        m_threadID = createThread(&ParallelEnvironment::ThreadPrivate::workerThread, this, "Parallel worker");
-
-    if (m_threadID)
-        m_parent = parent;
-
-    m_mutex.unlock();
-    return m_threadID;
-}
-
-void ParallelEnvironment::ThreadPrivate::execute(ThreadFunction threadFunction, void* parameters)
-{
-    MutexLocker lock(m_mutex);
-
-    m_threadFunction = threadFunction;
-    m_parameters = parameters;
-    m_running = true;
-    m_threadCondition.signal();
-}
-
-void ParallelEnvironment::ThreadPrivate::waitForFinish()
-{
-    MutexLocker lock(m_mutex);
-
-    while (m_running)
-        m_threadCondition.wait(m_mutex);
-}
-
-void ParallelEnvironment::ThreadPrivate::workerThread(void* threadData)
-{
-    ThreadPrivate* sharedThread = reinterpret_cast<ThreadPrivate*>(threadData);
-    MutexLocker lock(sharedThread->m_mutex);
-
-    while (sharedThread->m_threadID) {
-        if (sharedThread->m_running) {
-            (*sharedThread->m_threadFunction)(sharedThread->m_parameters);
-            sharedThread->m_running = false;
-            sharedThread->m_parent = 0;
-            sharedThread->m_threadCondition.signal();
-        }
-
-        sharedThread->m_threadCondition.wait(sharedThread->m_mutex);
-    }
+    // Wait until all jobs are done, running the ones nobody has picked up yet.
+    group.wait();
 }
 
 } // namespace WTF
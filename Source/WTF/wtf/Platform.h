@@ -942,6 +942,13 @@
 #endif
 #endif
 
+/* The sampling profiler interrupts the JS thread with a signal and reads the call frame register
+   out of the signal context, so it needs to know which register that is and where JIT code lives. */
+#if !defined(ENABLE_SAMPLING_PROFILER) && ENABLE(JIT) && ENABLE(LLINT) && !ENABLE(LLINT_C_LOOP) \
+    && ENABLE(EXECUTABLE_ALLOCATOR_FIXED) && CPU(X86_64) && OS(LINUX)
+#define ENABLE_SAMPLING_PROFILER 1
+#endif
+
 /* Use the QXmlStreamReader implementation for XMLDocumentParser */
 /* Use the QXmlQuery implementation for XSLTProcessor */
 #if PLATFORM(QT)
@@ -1025,6 +1032,12 @@
 #define WTF_USE_IMLANG_FONT_LINK2 1
 #endif
 
+/* The polynomial string hash gives the same values on every CPU, and hashes 16 characters
+   per step where SSE2 is available. Set to 0 to go back to SuperFastHash. */
+#if !defined(WTF_USE_POLYNOMIAL_STRING_HASH)
+#define WTF_USE_POLYNOMIAL_STRING_HASH 1
+#endif
+
 #if !defined(ENABLE_COMPARE_AND_SWAP) && (OS(WINDOWS) || (COMPILER(GCC) && (CPU(X86) || CPU(X86_64) || CPU(ARM_THUMB2))))
 #define ENABLE_COMPARE_AND_SWAP 1
 #endif
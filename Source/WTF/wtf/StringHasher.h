@@ -24,23 +24,105 @@
 
 #include <wtf/unicode/Unicode.h>
 
+#if USE(POLYNOMIAL_STRING_HASH)
+#include <wtf/text/StringSIMD.h>
+#endif
+
 namespace WTF {
 
+#if USE(POLYNOMIAL_STRING_HASH)
+// A polynomial hash, hash = hash * multiplier + character for each character, followed by
+// the MurmurHash3 finalizer. The products for a block of characters do not depend on each
+// other, so a block can be hashed with vector multiplies and one scalar multiply-add and
+// still give the same result as adding its characters one at a time.
+#else
 // Paul Hsieh's SuperFastHash
 // http://www.azillionmonkeys.com/qed/hash.html
+#endif
 
 // LChar data is interpreted as Latin-1-encoded (zero extended to 16 bits).
 
 // NOTE: The hash computation here must stay in sync with the create_hash_table script in
-// JavaScriptCore and the CodeGeneratorJS.pm script in WebCore.
+// JavaScriptCore and the Hasher.pm script in WebCore.
 
 // Golden ratio. Arbitrary start value to avoid mapping all zeros to a hash value of zero.
 static const unsigned stringHashingStartValue = 0x9E3779B9U;
 
+#if USE(POLYNOMIAL_STRING_HASH)
+// An odd multiplier close to the golden ratio, so each character reaches the high bits.
+static const unsigned stringHashingMultiplier = 0x9E3779B1U;
+#endif
+
 class StringHasher {
 public:
     static const unsigned flagCount = 8; // Save 8 bits for StringImpl to use as flags.
 
+#if USE(POLYNOMIAL_STRING_HASH)
+    StringHasher()
+        : m_hash(stringHashingStartValue)
+    {
+    }
+
+    void addCharacter(UChar character)
+    {
+        m_hash = m_hash * stringHashingMultiplier + character;
+    }
+
+    void addCharacters(UChar a, UChar b)
+    {
+        m_hash = m_hash * multiplierPower2 + a * stringHashingMultiplier + b;
+    }
+
+    template<typename T, UChar Converter(T)> void addCharacters(const T* data, unsigned length)
+    {
+        m_hash = hashCharacters<T, Converter>(m_hash, data, length);
+    }
+
+    template<typename T> void addCharacters(const T* data, unsigned length)
+    {
+        m_hash = hashCharacters(m_hash, data, length);
+    }
+
+    template<typename T, UChar Converter(T)> void addCharacters(const T* data)
+    {
+        unsigned hash = m_hash;
+        while (T character = *data++)
+            hash = hash * stringHashingMultiplier + Converter(character);
+        m_hash = hash;
+    }
+
+    template<typename T> void addCharacters(const T* data)
+    {
+        addCharacters<T, defaultConverter>(data);
+    }
+
+    // Characters can be added in any grouping, so the "assuming aligned" functions are the
+    // same as the others. They are kept so callers work with either hash.
+    void addCharactersAssumingAligned(UChar a, UChar b)
+    {
+        addCharacters(a, b);
+    }
+
+    template<typename T, UChar Converter(T)> void addCharactersAssumingAligned(const T* data, unsigned length)
+    {
+        addCharacters<T, Converter>(data, length);
+    }
+
+    template<typename T> void addCharactersAssumingAligned(const T* data, unsigned length)
+    {
+        addCharacters(data, length);
+    }
+
+    template<typename T, UChar Converter(T)> void addCharactersAssumingAligned(const T* data)
+    {
+        addCharacters<T, Converter>(data);
+    }
+
+    template<typename T> void addCharactersAssumingAligned(const T* data)
+    {
+        addCharacters<T, defaultConverter>(data);
+    }
+#else
     StringHasher()
         : m_hash(stringHashingStartValue)
         , m_hasPendingCharacter(false)
@@ -156,6 +238,7 @@ public:
     {
         addCharacters<T, defaultConverter>(data);
     }
+#endif
 
     unsigned hashWithTop8BitsMasked() const
     {
@@ -205,7 +288,9 @@ public:
 
     template<typename T> static unsigned computeHashAndMaskTop8Bits(const T* data, unsigned length)
     {
-        return computeHashAndMaskTop8Bits<T, defaultConverter>(data, length);
+        StringHasher hasher;
+        hasher.addCharactersAssumingAligned(data, length);
+        return hasher.hashWithTop8BitsMasked();
     }
 
     template<typename T> static unsigned computeHashAndMaskTop8Bits(const T* data)
@@ -229,7 +314,9 @@ public:
 
     template<typename T> static unsigned computeHash(const T* data, unsigned length)
     {
-        return computeHash<T, defaultConverter>(data, length);
+        StringHasher hasher;
+        hasher.addCharactersAssumingAligned(data, length);
+        return hasher.hash();
     }
 
     template<typename T> static unsigned computeHash(const T* data)
@@ -263,6 +350,137 @@ private:
         return character;
     }
 
+#if USE(POLYNOMIAL_STRING_HASH)
+    // Powers of stringHashingMultiplier, for adding several characters with one multiply-add.
+    static const unsigned multiplierPower2 = 0xFFE6CC61U;
+    static const unsigned multiplierPower3 = 0xCC042811U;
+    static const unsigned multiplierPower4 = 0x1F76BCC1U;
+    static const unsigned multiplierPower8 = 0x4B180981U;
+    static const unsigned multiplierPower16 = 0x5E8A5301U;
+
+    template<typename T, UChar Converter(T)> static unsigned hashCharacters(unsigned hash, const T* data, unsigned length)
+    {
+        for (; length >= 4; length -= 4, data += 4) {
+            hash = hash * multiplierPower4 + Converter(data[0]) * multiplierPower3 + Converter(data[1]) * multiplierPower2
+                + Converter(data[2]) * stringHashingMultiplier + Converter(data[3]);
+        }
+        while (length--)
+            hash = hash * stringHashingMultiplier + Converter(*data++);
+        return hash;
+    }
+
+#if STRING_SIMD_USE_SSE2
+    // The low and high 16 bits of multiplier^15 down to multiplier^0, the weights of the
+    // characters of a 16 character block in order. The last 8 weight an 8 character block.
+    static const uint16_t* multiplierPowersLow()
+    {
+        static const uint16_t powers[16] = {
+            0x7251, 0x0AA1, 0xEBF1, 0xE641, 0xC991, 0x65E1, 0x8B31, 0x0981,
+            0xB0D1, 0x5121, 0xBA71, 0xBCC1, 0x2811, 0xCC61, 0x79B1, 0x0001
+        };
+        return powers;
+    }
+
+    static const uint16_t* multiplierPowersHigh()
+    {
+        static const uint16_t powers[16] = {
+            0x6E8C, 0x4368, 0x0149, 0x448F, 0xB018, 0xA494, 0xF0D3, 0x4B18,
+            0x6364, 0x5ECD, 0x8BC6, 0x1F76, 0xCC04, 0xFFE6, 0x9E37, 0x0000
+        };
+        return powers;
+    }
+
+    static __m128i loadPowers(const uint16_t* powers)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(powers));
+    }
+
+    // Multiplies 8 characters by their 32-bit weights, keeping the low 32 bits of each
+    // product, and sums the products pairwise into four lanes. 16-bit multiplies give the
+    // low half of each product and the carry into the high half.
+    static __m128i weightedSums(__m128i characters, __m128i powersLow, __m128i powersHigh)
+    {
+        __m128i low = _mm_mullo_epi16(characters, powersLow);
+        __m128i high = _mm_add_epi16(_mm_mulhi_epu16(characters, powersLow), _mm_mullo_epi16(characters, powersHigh));
+        return _mm_add_epi32(_mm_unpacklo_epi16(low, high), _mm_unpackhi_epi16(low, high));
+    }
+
+    static unsigned horizontalSum(__m128i sums)
+    {
+        sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(1, 0, 3, 2)));
+        sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(sums);
+    }
+
+    static unsigned hashCharacters(unsigned hash, const LChar* data, unsigned length)
+    {
+        if (length >= 8) {
+            const __m128i zero = _mm_setzero_si128();
+            __m128i firstPowersLow = loadPowers(multiplierPowersLow());
+            __m128i firstPowersHigh = loadPowers(multiplierPowersHigh());
+            __m128i secondPowersLow = loadPowers(multiplierPowersLow() + 8);
+            __m128i secondPowersHigh = loadPowers(multiplierPowersHigh() + 8);
+            for (; length >= 16; length -= 16, data += 16) {
+                __m128i characters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+                __m128i sums = _mm_add_epi32(weightedSums(_mm_unpacklo_epi8(characters, zero), firstPowersLow, firstPowersHigh),
+                    weightedSums(_mm_unpackhi_epi8(characters, zero), secondPowersLow, secondPowersHigh));
+                hash = hash * multiplierPower16 + horizontalSum(sums);
+            }
+            if (length >= 8) {
+                __m128i characters = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(data)), zero);
+                hash = hash * multiplierPower8 + horizontalSum(weightedSums(characters, secondPowersLow, secondPowersHigh));
+                length -= 8;
+                data += 8;
+            }
+        }
+        return hashCharacters<LChar, defaultConverter>(hash, data, length);
+    }
+
+    static unsigned hashCharacters(unsigned hash, const UChar* data, unsigned length)
+    {
+        if (length >= 8) {
+            __m128i firstPowersLow = loadPowers(multiplierPowersLow());
+            __m128i firstPowersHigh = loadPowers(multiplierPowersHigh());
+            __m128i secondPowersLow = loadPowers(multiplierPowersLow() + 8);
+            __m128i secondPowersHigh = loadPowers(multiplierPowersHigh() + 8);
+            for (; length >= 16; length -= 16, data += 16) {
+                __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+                __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 8));
+                __m128i sums = _mm_add_epi32(weightedSums(first, firstPowersLow, firstPowersHigh),
+                    weightedSums(second, secondPowersLow, secondPowersHigh));
+                hash = hash * multiplierPower16 + horizontalSum(sums);
+            }
+            if (length >= 8) {
+                __m128i characters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+                hash = hash * multiplierPower8 + horizontalSum(weightedSums(characters, secondPowersLow, secondPowersHigh));
+                length -= 8;
+                data += 8;
+            }
+        }
+        return hashCharacters<UChar, defaultConverter>(hash, data, length);
+    }
+#else
+    template<typename T> static unsigned hashCharacters(unsigned hash, const T* data, unsigned length)
+    {
+        return hashCharacters<T, defaultConverter>(hash, data, length);
+    }
+#endif
+
+    unsigned avalancheBits() const
+    {
+        // MurmurHash3's finalizer, so that every bit of the result depends on every bit of the
+        // polynomial, whose low bits only depend on the low bits of the characters.
+        unsigned result = m_hash;
+        result ^= result >> 16;
+        result *= 0x85EBCA6BU;
+        result ^= result >> 13;
+        result *= 0xC2B2AE35U;
+        result ^= result >> 16;
+        return result;
+    }
+
+    unsigned m_hash;
+#else
     unsigned avalancheBits() const
     {
         unsigned result = m_hash;
@@ -287,6 +505,7 @@ private:
     unsigned m_hash;
     bool m_hasPendingCharacter;
     UChar m_pendingCharacter;
+#endif
 };
 
 } // namespace WTF
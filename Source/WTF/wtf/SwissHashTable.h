@@ -0,0 +1,778 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef WTF_SwissHashTable_h
+#define WTF_SwissHashTable_h
+
+#include <string.h>
+#include <wtf/HashTable.h>
+
+#if CPU(X86_64) || (CPU(X86) && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#define SWISS_HASH_TABLE_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define SWISS_HASH_TABLE_USE_SSE2 0
+#endif
+
+namespace WTF {
+
+    // SwissHashTable is an open addressing hash table that keeps one control byte per
+    // bucket next to the buckets themselves. A control byte is either empty, deleted, or
+    // holds 7 bits of the hash of the key in a full bucket. Lookups load a whole group of
+    // control bytes at once and only compare keys whose 7 bit hash matches, so a probe
+    // touches one cache line of metadata instead of one bucket per step, and the table
+    // can be filled up to 7/8 of its capacity before it has to grow.
+    //
+    // It has the same interface as HashTable. HashMap and HashSet use it when the key
+    // traits set useSwissTable, see SwissTableHashTraits.
+    //
+    // Unlike HashTable, it does not track live iterators in debug builds, and empty and
+    // deleted values are only used to initialize buckets, never to find out whether a
+    // bucket is in use.
+
+    class SwissHashTableGroup {
+    public:
+        static const int8_t emptyControl = -128; // 0b10000000
+        static const int8_t deletedControl = -2; // 0b11111110
+
+        static bool isFull(int8_t control) { return control >= 0; }
+
+#if SWISS_HASH_TABLE_USE_SSE2
+        static const unsigned width = 16;
+
+        explicit SwissHashTableGroup(const int8_t* controls)
+            : m_controls(_mm_loadu_si128(reinterpret_cast<const __m128i*>(controls)))
+        {
+        }
+
+        // Masks have bit i set when bucket i of the group matches.
+        unsigned match(int8_t hash) const { return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(hash), m_controls)); }
+        unsigned matchEmpty() const { return match(emptyControl); }
+        // Empty and deleted are the only control bytes with the sign bit set.
+        unsigned matchEmptyOrDeleted() const { return _mm_movemask_epi8(m_controls); }
+        unsigned matchFull() const { return ~matchEmptyOrDeleted() & 0xffff; }
+
+    private:
+        __m128i m_controls;
+#else
+        static const unsigned width = 8;
+
+        explicit SwissHashTableGroup(const int8_t* controls)
+        {
+            memcpy(m_controls, controls, width);
+        }
+
+        unsigned match(int8_t hash) const
+        {
+            unsigned mask = 0;
+            for (unsigned i = 0; i < width; ++i)
+                mask |= static_cast<unsigned>(m_controls[i] == hash) << i;
+            return mask;
+        }
+        unsigned matchEmpty() const { return match(emptyControl); }
+        unsigned matchEmptyOrDeleted() const
+        {
+            unsigned mask = 0;
+            for (unsigned i = 0; i < width; ++i)
+                mask |= static_cast<unsigned>(m_controls[i] < 0) << i;
+            return mask;
+        }
+        unsigned matchFull() const { return ~matchEmptyOrDeleted() & 0xff; }
+
+    private:
+        int8_t m_controls[width];
+#endif
+
+    public:
+        static unsigned lowestIndex(unsigned mask)
+        {
+            ASSERT(mask);
+#if COMPILER(GCC) || COMPILER(CLANG)
+            return __builtin_ctz(mask);
+#else
+            unsigned index = 0;
+            while (!(mask & 1)) {
+                mask >>= 1;
+                ++index;
+            }
+            return index;
+#endif
+        }
+        static unsigned clearLowest(unsigned mask) { return mask & (mask - 1); }
+    };
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    class SwissHashTable;
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    class SwissHashTableIterator;
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    class SwissHashTableConstIterator {
+    private:
+        typedef SwissHashTableIterator<Key, Value, Extractor, HashFunctions, Traits, KeyTraits> iterator;
+        typedef SwissHashTableConstIterator<Key, Value, Extractor, HashFunctions, Traits, KeyTraits> const_iterator;
+        typedef Value ValueType;
+        typedef const ValueType& ReferenceType;
+        typedef const ValueType* PointerType;
+
+        friend class SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>;
+        friend class SwissHashTableIterator<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>;
+
+        // Only looks at the control bytes, and skips a whole group at a time when it is
+        // entirely unused.
+        void skipEmptyBuckets()
+        {
+            while (m_position != m_endPosition) {
+                if (SwissHashTableGroup::isFull(*m_control))
+                    return;
+                size_t index = m_position - m_begin;
+                if (!(index % SwissHashTableGroup::width) && !SwissHashTableGroup(m_control).matchFull()) {
+                    m_position += SwissHashTableGroup::width;
+                    m_control += SwissHashTableGroup::width;
+                    continue;
+                }
+                ++m_position;
+                ++m_control;
+            }
+        }
+
+        SwissHashTableConstIterator(PointerType begin, PointerType position, PointerType endPosition, const int8_t* control)
+            : m_begin(begin)
+            , m_position(position)
+            , m_endPosition(endPosition)
+            , m_control(control)
+        {
+            skipEmptyBuckets();
+        }
+
+        SwissHashTableConstIterator(PointerType begin, PointerType position, PointerType endPosition, const int8_t* control, HashItemKnownGoodTag)
+            : m_begin(begin)
+            , m_position(position)
+            , m_endPosition(endPosition)
+            , m_control(control)
+        {
+        }
+
+    public:
+        SwissHashTableConstIterator()
+            : m_begin(0)
+            , m_position(0)
+            , m_endPosition(0)
+            , m_control(0)
+        {
+        }
+
+        PointerType get() const { return m_position; }
+        ReferenceType operator*() const { return *get(); }
+        PointerType operator->() const { return get(); }
+
+        const_iterator& operator++()
+        {
+            ASSERT(m_position != m_endPosition);
+            ++m_position;
+            ++m_control;
+            skipEmptyBuckets();
+            return *this;
+        }
+
+        // postfix ++ intentionally omitted
+
+        // Comparison.
+        bool operator==(const const_iterator& other) const { return m_position == other.m_position; }
+        bool operator!=(const const_iterator& other) const { return m_position != other.m_position; }
+        bool operator==(const iterator& other) const { return *this == static_cast<const_iterator>(other); }
+        bool operator!=(const iterator& other) const { return *this != static_cast<const_iterator>(other); }
+
+    private:
+        PointerType m_begin;
+        PointerType m_position;
+        PointerType m_endPosition;
+        const int8_t* m_control;
+    };
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    class SwissHashTableIterator {
+    private:
+        typedef SwissHashTableIterator<Key, Value, Extractor, HashFunctions, Traits, KeyTraits> iterator;
+        typedef SwissHashTableConstIterator<Key, Value, Extractor, HashFunctions, Traits, KeyTraits> const_iterator;
+        typedef Value ValueType;
+        typedef ValueType& ReferenceType;
+        typedef ValueType* PointerType;
+
+        friend class SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>;
+
+        SwissHashTableIterator(PointerType begin, PointerType pos, PointerType end, const int8_t* control) : m_iterator(begin, pos, end, control) { }
+        SwissHashTableIterator(PointerType begin, PointerType pos, PointerType end, const int8_t* control, HashItemKnownGoodTag tag) : m_iterator(begin, pos, end, control, tag) { }
+
+    public:
+        SwissHashTableIterator() { }
+
+        PointerType get() const { return const_cast<PointerType>(m_iterator.get()); }
+        ReferenceType operator*() const { return *get(); }
+        PointerType operator->() const { return get(); }
+
+        iterator& operator++() { ++m_iterator; return *this; }
+
+        // postfix ++ intentionally omitted
+
+        // Comparison.
+        bool operator==(const iterator& other) const { return m_iterator == other.m_iterator; }
+        bool operator!=(const iterator& other) const { return m_iterator != other.m_iterator; }
+        bool operator==(const const_iterator& other) const { return m_iterator == other; }
+        bool operator!=(const const_iterator& other) const { return m_iterator != other; }
+
+        operator const_iterator() const { return m_iterator; }
+
+    private:
+        const_iterator m_iterator;
+    };
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    class SwissHashTable {
+    public:
+        typedef SwissHashTableIterator<Key, Value, Extractor, HashFunctions, Traits, KeyTraits> iterator;
+        typedef SwissHashTableConstIterator<Key, Value, Extractor, HashFunctions, Traits, KeyTraits> const_iterator;
+        typedef Traits ValueTraits;
+        typedef Key KeyType;
+        typedef Value ValueType;
+        typedef IdentityHashTranslator<HashFunctions> IdentityTranslatorType;
+        typedef HashTableAddResult<iterator> AddResult;
+
+        SwissHashTable();
+        ~SwissHashTable()
+        {
+            if (m_table)
+                deallocateTable(m_table, m_tableSize);
+        }
+
+        SwissHashTable(const SwissHashTable&);
+        void swap(SwissHashTable&);
+        SwissHashTable& operator=(const SwissHashTable&);
+
+        iterator begin() { return isEmpty() ? end() : makeIterator(m_table); }
+        iterator end() { return makeKnownGoodIterator(m_table + m_tableSize); }
+        const_iterator begin() const { return isEmpty() ? end() : makeConstIterator(m_table); }
+        const_iterator end() const { return makeKnownGoodConstIterator(m_table + m_tableSize); }
+
+        int size() const { return m_keyCount; }
+        int capacity() const { return m_tableSize; }
+        bool isEmpty() const { return !m_keyCount; }
+
+        AddResult add(const ValueType& value) { return add<IdentityTranslatorType>(Extractor::extract(value), value); }
+
+        template<typename HashTranslator, typename T, typename Extra> AddResult add(const T& key, const Extra&);
+        template<typename HashTranslator, typename T, typename Extra> AddResult addPassingHashCode(const T& key, const Extra&);
+
+        iterator find(const KeyType& key) { return find<IdentityTranslatorType>(key); }
+        const_iterator find(const KeyType& key) const { return find<IdentityTranslatorType>(key); }
+        bool contains(const KeyType& key) const { return contains<IdentityTranslatorType>(key); }
+
+        template<typename HashTranslator, typename T> iterator find(const T&);
+        template<typename HashTranslator, typename T> const_iterator find(const T&) const;
+        template<typename HashTranslator, typename T> bool contains(const T&) const;
+
+        void remove(const KeyType&);
+        void remove(iterator);
+        void removeWithoutEntryConsistencyCheck(iterator);
+        void removeWithoutEntryConsistencyCheck(const_iterator);
+        void clear();
+
+        ValueType* lookup(const Key& key) { return lookup<IdentityTranslatorType>(key); }
+        template<typename HashTranslator, typename T> ValueType* lookup(const T&);
+
+#if !ASSERT_DISABLED
+        void checkTableConsistency() const;
+#else
+        static void checkTableConsistency() { }
+#endif
+#if CHECK_HASHTABLE_CONSISTENCY
+        void internalCheckTableConsistency() const { checkTableConsistency(); }
+#else
+        static void internalCheckTableConsistency() { }
+#endif
+
+    private:
+        typedef SwissHashTableGroup Group;
+
+        static const int minimumTableSize = KeyTraits::minimumTableSize > static_cast<int>(Group::width) ? KeyTraits::minimumTableSize : static_cast<int>(Group::width);
+
+        // The low 7 bits of the hash go into the control byte, the rest pick the group
+        // where probing starts.
+        static int8_t controlForHash(unsigned hash) { return static_cast<int8_t>(hash & 0x7f); }
+        static unsigned groupForHash(unsigned hash) { return hash >> 7; }
+
+        static ValueType* allocateTable(int size);
+        static void deallocateTable(ValueType* table, int size);
+        static int8_t* controlsForTable(ValueType* table, int size) { return reinterpret_cast<int8_t*>(table + size); }
+
+        template<typename HashTranslator, typename T> ValueType* lookupForWriting(const T&, unsigned hash, bool& found);
+        ValueType* findEmptyOrDeletedBucket(unsigned hash);
+        void setControl(ValueType* bucket, int8_t control) { m_control[bucket - m_table] = control; }
+
+        void remove(ValueType*);
+
+        // Deleted buckets still end probe sequences only at the next empty bucket, so
+        // they count towards the load.
+        bool shouldExpand() const { return (m_keyCount + m_deletedCount) * m_maxLoadDenominator >= m_tableSize * m_maxLoadNumerator; }
+        bool mustRehashInPlace() const { return m_keyCount * m_minLoad < m_tableSize * 2; }
+        bool shouldShrink() const { return m_keyCount * m_minLoad < m_tableSize && m_tableSize > minimumTableSize; }
+        void expand();
+        void shrink() { rehash(m_tableSize / 2); }
+
+        void rehash(int newTableSize);
+        void reinsert(ValueType&);
+
+        static void initializeBucket(ValueType& bucket) { HashTableBucketInitializer<Traits::emptyValueIsZero>::template initialize<Traits>(bucket); }
+
+        iterator makeIterator(ValueType* pos) { return iterator(m_table, pos, m_table + m_tableSize, m_control + (pos - m_table)); }
+        const_iterator makeConstIterator(ValueType* pos) const { return const_iterator(m_table, pos, m_table + m_tableSize, m_control + (pos - m_table)); }
+        iterator makeKnownGoodIterator(ValueType* pos) { return iterator(m_table, pos, m_table + m_tableSize, m_control + (pos - m_table), HashItemKnownGood); }
+        const_iterator makeKnownGoodConstIterator(ValueType* pos) const { return const_iterator(m_table, pos, m_table + m_tableSize, m_control + (pos - m_table), HashItemKnownGood); }
+
+        static const int m_maxLoadNumerator = 7;
+        static const int m_maxLoadDenominator = 8;
+        static const int m_minLoad = 6;
+
+        ValueType* m_table;
+        int8_t* m_control;
+        int m_tableSize;
+        int m_keyCount;
+        int m_deletedCount;
+    };
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    inline SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::SwissHashTable()
+        : m_table(0)
+        , m_control(0)
+        , m_tableSize(0)
+        , m_keyCount(0)
+        , m_deletedCount(0)
+    {
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    template<typename HashTranslator, typename T>
+    inline Value* SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::lookup(const T& key)
+    {
+        if (!m_table)
+            return 0;
+
+        unsigned h = HashTranslator::hash(key);
+        int8_t control = controlForHash(h);
+        unsigned groupMask = m_tableSize / Group::width - 1;
+        unsigned group = groupForHash(h) & groupMask;
+
+        // Triangular steps visit every group of a power of two sized table.
+        for (unsigned step = 1; ; ++step) {
+            unsigned base = group * Group::width;
+            Group controls(m_control + base);
+            for (unsigned mask = controls.match(control); mask; mask = Group::clearLowest(mask)) {
+                ValueType* entry = m_table + base + Group::lowestIndex(mask);
+                if (HashTranslator::equal(Extractor::extract(*entry), key))
+                    return entry;
+            }
+            if (controls.matchEmpty())
+                return 0;
+            group = (group + step) & groupMask;
+        }
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    template<typename HashTranslator, typename T>
+    inline Value* SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::lookupForWriting(const T& key, unsigned h, bool& found)
+    {
+        ASSERT(m_table);
+
+        int8_t control = controlForHash(h);
+        unsigned groupMask = m_tableSize / Group::width - 1;
+        unsigned group = groupForHash(h) & groupMask;
+        ValueType* insertionEntry = 0;
+
+        for (unsigned step = 1; ; ++step) {
+            unsigned base = group * Group::width;
+            Group controls(m_control + base);
+            for (unsigned mask = controls.match(control); mask; mask = Group::clearLowest(mask)) {
+                ValueType* entry = m_table + base + Group::lowestIndex(mask);
+                if (HashTranslator::equal(Extractor::extract(*entry), key)) {
+                    found = true;
+                    return entry;
+                }
+            }
+            if (!insertionEntry) {
+                if (unsigned mask = controls.matchEmptyOrDeleted())
+                    insertionEntry = m_table + base + Group::lowestIndex(mask);
+            }
+            if (controls.matchEmpty()) {
+                found = false;
+                return insertionEntry;
+            }
+            group = (group + step) & groupMask;
+        }
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    inline Value* SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::findEmptyOrDeletedBucket(unsigned h)
+    {
+        unsigned groupMask = m_tableSize / Group::width - 1;
+        unsigned group = groupForHash(h) & groupMask;
+        for (unsigned step = 1; ; ++step) {
+            unsigned base = group * Group::width;
+            if (unsigned mask = Group(m_control + base).matchEmptyOrDeleted())
+                return m_table + base + Group::lowestIndex(mask);
+            group = (group + step) & groupMask;
+        }
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    template<typename HashTranslator, typename T, typename Extra>
+    inline typename SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::AddResult SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::add(const T& key, const Extra& extra)
+    {
+        if (!m_table)
+            expand();
+
+        internalCheckTableConsistency();
+
+        unsigned h = HashTranslator::hash(key);
+        bool found;
+        ValueType* entry = lookupForWriting<HashTranslator>(key, h, found);
+        if (found)
+            return AddResult(makeKnownGoodIterator(entry), false);
+
+        if (m_control[entry - m_table] == Group::deletedControl)
+            --m_deletedCount;
+        setControl(entry, controlForHash(h));
+        HashTranslator::translate(*entry, key, extra);
+        ++m_keyCount;
+
+        if (shouldExpand()) {
+            KeyType enteredKey = Extractor::extract(*entry);
+            expand();
+            AddResult result(find(enteredKey), true);
+            ASSERT(result.iterator != end());
+            return result;
+        }
+
+        internalCheckTableConsistency();
+
+        return AddResult(makeKnownGoodIterator(entry), true);
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    template<typename HashTranslator, typename T, typename Extra>
+    inline typename SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::AddResult SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::addPassingHashCode(const T& key, const Extra& extra)
+    {
+        if (!m_table)
+            expand();
+
+        internalCheckTableConsistency();
+
+        unsigned h = HashTranslator::hash(key);
+        bool found;
+        ValueType* entry = lookupForWriting<HashTranslator>(key, h, found);
+        if (found)
+            return AddResult(makeKnownGoodIterator(entry), false);
+
+        if (m_control[entry - m_table] == Group::deletedControl)
+            --m_deletedCount;
+        setControl(entry, controlForHash(h));
+        HashTranslator::translate(*entry, key, extra, h);
+        ++m_keyCount;
+
+        if (shouldExpand()) {
+            KeyType enteredKey = Extractor::extract(*entry);
+            expand();
+            AddResult result(find(enteredKey), true);
+            ASSERT(result.iterator != end());
+            return result;
+        }
+
+        internalCheckTableConsistency();
+
+        return AddResult(makeKnownGoodIterator(entry), true);
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    inline void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::reinsert(ValueType& entry)
+    {
+        ASSERT(m_table);
+        unsigned h = HashFunctions::hash(Extractor::extract(entry));
+        ValueType* newEntry = findEmptyOrDeletedBucket(h);
+        setControl(newEntry, controlForHash(h));
+        Mover<ValueType, Traits::needsDestruction>::move(entry, *newEntry);
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    template<typename HashTranslator, typename T>
+    typename SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::iterator SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::find(const T& key)
+    {
+        ValueType* entry = lookup<HashTranslator>(key);
+        if (!entry)
+            return end();
+
+        return makeKnownGoodIterator(entry);
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    template<typename HashTranslator, typename T>
+    typename SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::const_iterator SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::find(const T& key) const
+    {
+        ValueType* entry = const_cast<SwissHashTable*>(this)->lookup<HashTranslator>(key);
+        if (!entry)
+            return end();
+
+        return makeKnownGoodConstIterator(entry);
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    template<typename HashTranslator, typename T>
+    bool SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::contains(const T& key) const
+    {
+        return const_cast<SwissHashTable*>(this)->lookup<HashTranslator>(key);
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::remove(ValueType* pos)
+    {
+        // Unused buckets always hold the empty value, so that translators can assign to
+        // them and the table can be destroyed without looking at the control bytes.
+        if (Traits::needsDestruction) {
+            pos->~ValueType();
+            initializeBucket(*pos);
+        }
+
+        // If the group still has an empty bucket, no probe sequence ever went past it, so
+        // the bucket can become empty again instead of leaving a tombstone behind.
+        unsigned index = pos - m_table;
+        if (Group(m_control + (index & ~(Group::width - 1))).matchEmpty())
+            m_control[index] = Group::emptyControl;
+        else {
+            m_control[index] = Group::deletedControl;
+            ++m_deletedCount;
+        }
+        --m_keyCount;
+
+        if (shouldShrink())
+            shrink();
+
+        internalCheckTableConsistency();
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    inline void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::remove(iterator it)
+    {
+        if (it == end())
+            return;
+
+        internalCheckTableConsistency();
+        remove(const_cast<ValueType*>(it.m_iterator.m_position));
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    inline void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::removeWithoutEntryConsistencyCheck(iterator it)
+    {
+        if (it == end())
+            return;
+
+        remove(const_cast<ValueType*>(it.m_iterator.m_position));
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    inline void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::removeWithoutEntryConsistencyCheck(const_iterator it)
+    {
+        if (it == end())
+            return;
+
+        remove(const_cast<ValueType*>(it.m_position));
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    inline void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::remove(const KeyType& key)
+    {
+        remove(find(key));
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    Value* SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::allocateTable(int size)
+    {
+        // The control bytes live right after the buckets, in the same allocation.
+        size_t bucketsSize = size * sizeof(ValueType);
+        ValueType* result;
+        if (Traits::emptyValueIsZero)
+            result = static_cast<ValueType*>(fastZeroedMalloc(bucketsSize + size));
+        else {
+            result = static_cast<ValueType*>(fastMalloc(bucketsSize + size));
+            for (int i = 0; i < size; i++)
+                initializeBucket(result[i]);
+        }
+        memset(controlsForTable(result, size), SwissHashTableGroup::emptyControl, size);
+        return result;
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::deallocateTable(ValueType* table, int size)
+    {
+        if (Traits::needsDestruction) {
+            for (int i = 0; i < size; ++i)
+                table[i].~ValueType();
+        }
+        fastFree(table);
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::expand()
+    {
+        int newSize;
+        if (m_tableSize == 0)
+            newSize = minimumTableSize;
+        else if (mustRehashInPlace())
+            newSize = m_tableSize;
+        else
+            newSize = m_tableSize * 2;
+
+        rehash(newSize);
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::rehash(int newTableSize)
+    {
+        int oldTableSize = m_tableSize;
+        ValueType* oldTable = m_table;
+        int8_t* oldControl = m_control;
+
+        m_tableSize = newTableSize;
+        m_table = allocateTable(newTableSize);
+        m_control = controlsForTable(m_table, newTableSize);
+
+        for (int i = 0; i != oldTableSize; ++i) {
+            if (Group::isFull(oldControl[i]))
+                reinsert(oldTable[i]);
+        }
+
+        m_deletedCount = 0;
+
+        if (oldTable)
+            deallocateTable(oldTable, oldTableSize);
+
+        internalCheckTableConsistency();
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::clear()
+    {
+        if (!m_table)
+            return;
+
+        deallocateTable(m_table, m_tableSize);
+        m_table = 0;
+        m_control = 0;
+        m_tableSize = 0;
+        m_keyCount = 0;
+        m_deletedCount = 0;
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::SwissHashTable(const SwissHashTable& other)
+        : m_table(0)
+        , m_control(0)
+        , m_tableSize(0)
+        , m_keyCount(0)
+        , m_deletedCount(0)
+    {
+        const_iterator end = other.end();
+        for (const_iterator it = other.begin(); it != end; ++it)
+            add(*it);
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::swap(SwissHashTable& other)
+    {
+        std::swap(m_table, other.m_table);
+        std::swap(m_control, other.m_control);
+        std::swap(m_tableSize, other.m_tableSize);
+        std::swap(m_keyCount, other.m_keyCount);
+        std::swap(m_deletedCount, other.m_deletedCount);
+    }
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>& SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::operator=(const SwissHashTable& other)
+    {
+        SwissHashTable tmp(other);
+        swap(tmp);
+        return *this;
+    }
+
+#if !ASSERT_DISABLED
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    void SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits>::checkTableConsistency() const
+    {
+        if (!m_table)
+            return;
+
+        int count = 0;
+        int deletedCount = 0;
+        for (int i = 0; i < m_tableSize; ++i) {
+            if (m_control[i] == Group::emptyControl)
+                continue;
+            if (m_control[i] == Group::deletedControl) {
+                ++deletedCount;
+                continue;
+            }
+
+            const ValueType* entry = m_table + i;
+            ASSERT(m_control[i] == controlForHash(HashFunctions::hash(Extractor::extract(*entry))));
+            const_iterator it = find(Extractor::extract(*entry));
+            ASSERT_UNUSED(it, entry == it.m_position);
+            ++count;
+        }
+
+        ASSERT(count == m_keyCount);
+        ASSERT(deletedCount == m_deletedCount);
+        ASSERT(m_tableSize >= minimumTableSize);
+        ASSERT(!(m_tableSize & (m_tableSize - 1)));
+        ASSERT(!shouldExpand());
+    }
+
+#endif // ASSERT_DISABLED
+
+    // Lets HashMap and HashSet pick their table implementation from the key traits.
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits, bool useSwissTable = KeyTraits::useSwissTable>
+    struct HashTableForTraits {
+        typedef HashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits> Type;
+    };
+
+    template<typename Key, typename Value, typename Extractor, typename HashFunctions, typename Traits, typename KeyTraits>
+    struct HashTableForTraits<Key, Value, Extractor, HashFunctions, Traits, KeyTraits, true> {
+        typedef SwissHashTable<Key, Value, Extractor, HashFunctions, Traits, KeyTraits> Type;
+    };
+
+    // Wraps existing traits to opt a HashMap or HashSet into SwissHashTable, for example
+    // HashMap<StringImpl*, int, PtrHash<StringImpl*>, SwissTableHashTraits<HashTraits<StringImpl*> > >.
+    template<typename Traits>
+    struct SwissTableHashTraits : Traits {
+        static const bool useSwissTable = true;
+    };
+
+} // namespace WTF
+
+using WTF::SwissHashTable;
+using WTF::SwissTableHashTraits;
+
+#endif // WTF_SwissHashTable_h
@@ -0,0 +1,397 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "TaskScheduler.h"
+
+#include "Deque.h"
+#include "NumberOfCores.h"
+#include "OwnPtr.h"
+#include "PassOwnPtr.h"
+#include "Vector.h"
+#include <algorithm>
+
+namespace WTF {
+
+namespace {
+
+struct Task {
+    Task()
+        : function(0)
+        , context(0)
+        , group(0)
+    {
+    }
+
+    Task(TaskFunction function, void* context, const Function<void ()>& closure, TaskGroup* group)
+        : function(function)
+        , context(context)
+        , closure(closure)
+        , group(group)
+    {
+    }
+
+    void run()
+    {
+        if (function)
+            function(context);
+        else
+            closure();
+    }
+
+    TaskFunction function;
+    void* context;
+    Function<void ()> closure;
+    TaskGroup* group;
+};
+
+class TaskGroupMatcher {
+public:
+    TaskGroupMatcher(TaskGroup* group) : m_group(group) { }
+    bool operator()(const Task& task) const { return task.group == m_group; }
+private:
+    TaskGroup* m_group;
+};
+
+// Each worker pops the newest task from its own queues, which keeps the data it just
+// touched in its cache, and steals the oldest task from everyone else's. Tasks queued
+// from threads outside the pool go to a shared injection queue.
+class TaskQueue {
+public:
+    void push(const Task& task, TaskPriority priority)
+    {
+        MutexLocker locker(m_mutex);
+        m_tasks[priority].append(task);
+    }
+
+    bool popNewest(Task& task, TaskPriority priority)
+    {
+        MutexLocker locker(m_mutex);
+        if (m_tasks[priority].isEmpty())
+            return false;
+        task = m_tasks[priority].takeLast();
+        return true;
+    }
+
+    bool popOldest(Task& task, TaskPriority priority)
+    {
+        MutexLocker locker(m_mutex);
+        if (m_tasks[priority].isEmpty())
+            return false;
+        task = m_tasks[priority].takeFirst();
+        return true;
+    }
+
+    bool popFromGroup(Task& task, TaskGroup* group)
+    {
+        MutexLocker locker(m_mutex);
+        Deque<Task>& tasks = m_tasks[group->priority()];
+        TaskGroupMatcher matcher(group);
+        Deque<Task>::iterator found = tasks.findIf(matcher);
+        if (found == tasks.end())
+            return false;
+        task = *found;
+        tasks.remove(found);
+        return true;
+    }
+
+private:
+    Mutex m_mutex;
+    Deque<Task> m_tasks[numberOfTaskPriorities];
+};
+
+} // namespace
+
+class TaskScheduler {
+    WTF_MAKE_NONCOPYABLE(TaskScheduler); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static TaskScheduler& shared();
+
+    unsigned concurrency() const { return m_workers.size() + 1; }
+
+    void enqueue(const Task&, TaskPriority);
+
+    // Runs one queued task of the group on the calling thread, if there is one.
+    bool runTaskFromGroup(TaskGroup*);
+
+private:
+    struct Worker {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        Worker(TaskScheduler* scheduler)
+            : scheduler(scheduler)
+            , thread(0)
+        {
+        }
+
+        TaskScheduler* scheduler;
+        ThreadIdentifier thread;
+        TaskQueue queue;
+    };
+
+    TaskScheduler();
+
+    static void workerThreadEntry(void*);
+    void workerLoop(Worker*);
+
+    Worker* currentWorker() const;
+    bool takeTask(Worker*, Task&);
+    void runTask(Task&);
+
+    Vector<OwnPtr<Worker> > m_workers;
+    TaskQueue m_injectionQueue;
+
+    // Number of tasks sitting in any queue. Idle workers sleep while it is zero.
+    int volatile m_queuedTasks;
+    int volatile m_idleWorkers;
+    Mutex m_idleMutex;
+    ThreadCondition m_idleCondition;
+};
+
+TaskScheduler& TaskScheduler::shared()
+{
+    AtomicallyInitializedStatic(TaskScheduler&, scheduler = *new TaskScheduler);
+    return scheduler;
+}
+
+TaskScheduler::TaskScheduler()
+    : m_queuedTasks(0)
+    , m_idleWorkers(0)
+{
+    // The thread that waits on a task group runs tasks too, so it counts as a worker.
+    int numberOfWorkers = numberOfProcessorCores() - 1;
+    for (int i = 0; i < numberOfWorkers; ++i)
+        m_workers.append(adoptPtr(new Worker(this)));
+
+    // Start the threads only once m_workers is complete, since they steal from each other.
+    for (size_t i = 0; i < m_workers.size(); ++i)
+        m_workers[i]->thread = createThread(workerThreadEntry, m_workers[i].get(), "WTF task scheduler worker");
+}
+
+TaskScheduler::Worker* TaskScheduler::currentWorker() const
+{
+    ThreadIdentifier thread = currentThread();
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        if (m_workers[i]->thread == thread)
+            return m_workers[i].get();
+    }
+    return 0;
+}
+
+void TaskScheduler::enqueue(const Task& task, TaskPriority priority)
+{
+    if (Worker* worker = currentWorker())
+        worker->queue.push(task, priority);
+    else
+        m_injectionQueue.push(task, priority);
+
+    // Both counters are updated with full barriers, so either we see the idle worker, or
+    // the worker sees the task before it goes to sleep.
+    atomicIncrement(&m_queuedTasks);
+    if (m_idleWorkers) {
+        MutexLocker locker(m_idleMutex);
+        m_idleCondition.signal();
+    }
+}
+
+bool TaskScheduler::takeTask(Worker* worker, Task& task)
+{
+    for (unsigned priority = 0; priority < numberOfTaskPriorities; ++priority) {
+        TaskPriority taskPriority = static_cast<TaskPriority>(priority);
+        if (worker && worker->queue.popNewest(task, taskPriority))
+            return true;
+        if (m_injectionQueue.popOldest(task, taskPriority))
+            return true;
+        for (size_t i = 0; i < m_workers.size(); ++i) {
+            if (m_workers[i] != worker && m_workers[i]->queue.popOldest(task, taskPriority))
+                return true;
+        }
+    }
+    return false;
+}
+
+bool TaskScheduler::runTaskFromGroup(TaskGroup* group)
+{
+    Task task;
+    Worker* worker = currentWorker();
+    bool found = (worker && worker->queue.popFromGroup(task, group)) || m_injectionQueue.popFromGroup(task, group);
+    for (size_t i = 0; !found && i < m_workers.size(); ++i)
+        found = m_workers[i]->queue.popFromGroup(task, group);
+    if (!found)
+        return false;
+
+    atomicDecrement(&m_queuedTasks);
+    runTask(task);
+    return true;
+}
+
+void TaskScheduler::runTask(Task& task)
+{
+    TaskGroup* group = task.group;
+    task.run();
+    // Drop the closure before the group can be destroyed by a returning wait().
+    task = Task();
+    group->taskFinished();
+}
+
+void TaskScheduler::workerThreadEntry(void* context)
+{
+    Worker* worker = static_cast<Worker*>(context);
+    worker->scheduler->workerLoop(worker);
+}
+
+void TaskScheduler::workerLoop(Worker* worker)
+{
+    while (true) {
+        Task task;
+        if (m_queuedTasks && takeTask(worker, task)) {
+            atomicDecrement(&m_queuedTasks);
+            runTask(task);
+            continue;
+        }
+
+        MutexLocker locker(m_idleMutex);
+        atomicIncrement(&m_idleWorkers);
+        while (!m_queuedTasks)
+            m_idleCondition.wait(m_idleMutex);
+        atomicDecrement(&m_idleWorkers);
+    }
+}
+
+TaskGroup::TaskGroup(TaskPriority priority)
+    : m_priority(priority)
+    , m_pendingTasks(0)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    wait();
+}
+
+void TaskGroup::run(TaskFunction function, void* context)
+{
+    ASSERT(function);
+    {
+        MutexLocker locker(m_mutex);
+        ++m_pendingTasks;
+    }
+    TaskScheduler::shared().enqueue(Task(function, context, Function<void ()>(), this), m_priority);
+}
+
+void TaskGroup::run(const Function<void ()>& function)
+{
+    ASSERT(!function.isNull());
+    {
+        MutexLocker locker(m_mutex);
+        ++m_pendingTasks;
+    }
+    TaskScheduler::shared().enqueue(Task(0, 0, function, this), m_priority);
+}
+
+void TaskGroup::wait()
+{
+    TaskScheduler& scheduler = TaskScheduler::shared();
+    while (true) {
+        {
+            MutexLocker locker(m_mutex);
+            if (!m_pendingTasks)
+                return;
+        }
+
+        if (scheduler.runTaskFromGroup(this))
+            continue;
+
+        // Everything left is running on other threads. Tasks they add to this group go
+        // to their own queues, and they will get to them before finishing.
+        MutexLocker locker(m_mutex);
+        while (m_pendingTasks)
+            m_condition.wait(m_mutex);
+        return;
+    }
+}
+
+void TaskGroup::taskFinished()
+{
+    MutexLocker locker(m_mutex);
+    ASSERT(m_pendingTasks);
+    if (!--m_pendingTasks)
+        m_condition.broadcast();
+}
+
+unsigned taskSchedulerConcurrency()
+{
+    return TaskScheduler::shared().concurrency();
+}
+
+namespace {
+
+struct ParallelForRange {
+    ParallelForFunction function;
+    void* context;
+    size_t begin;
+    size_t end;
+};
+
+void runParallelForRange(void* range)
+{
+    ParallelForRange* parallelForRange = static_cast<ParallelForRange*>(range);
+    parallelForRange->function(parallelForRange->context, parallelForRange->begin, parallelForRange->end);
+}
+
+} // namespace
+
+void parallelFor(size_t begin, size_t end, size_t grainSize, ParallelForFunction function, void* context, TaskPriority priority)
+{
+    if (begin >= end)
+        return;
+    if (!grainSize)
+        grainSize = 1;
+
+    // A few ranges per thread lets the threads that finish early steal from the others.
+    static const size_t rangesPerThread = 4;
+    size_t count = end - begin;
+    size_t numberOfRanges = std::min((count + grainSize - 1) / grainSize, rangesPerThread * taskSchedulerConcurrency());
+    if (numberOfRanges <= 1) {
+        function(context, begin, end);
+        return;
+    }
+
+    Vector<ParallelForRange, 32> ranges(numberOfRanges);
+    for (size_t i = 0; i < numberOfRanges; ++i) {
+        ranges[i].function = function;
+        ranges[i].context = context;
+        ranges[i].begin = begin + count * i / numberOfRanges;
+        ranges[i].end = begin + count * (i + 1) / numberOfRanges;
+    }
+
+    TaskGroup group(priority);
+    for (size_t i = 1; i < numberOfRanges; ++i)
+        group.run(runParallelForRange, &ranges[i]);
+    runParallelForRange(&ranges[0]);
+    group.wait();
+}
+
+} // namespace WTF
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TaskScheduler_h
+#define TaskScheduler_h
+
+#include <wtf/FastAllocBase.h>
+#include <wtf/Functional.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Threading.h>
+
+// Usage:
+//
+//     // Fork/join
+//     TaskGroup group;
+//     group.run(bind(&decodeRows, decoder, 0, half));
+//     group.run(&decodeRowsWorker, &secondHalfParameters);
+//     group.wait();
+//
+//     // Parallel loop, where BlurRows has void operator()(size_t beginRow, size_t endRow)
+//     BlurRows blurRows(source, destination);
+//     parallelFor(0, height, 64, blurRows);
+//
+// Tasks run on a process-wide pool with one thread per processor core, minus one for
+// the thread that waits on the results, which runs tasks of its own group while it
+// waits. Every worker keeps its own queue and steals from the others once it runs dry,
+// so independent callers share the cores instead of each spawning threads of their own.
+
+namespace WTF {
+
+// Idle workers take high priority tasks first, wherever they were queued.
+enum TaskPriority {
+    HighTaskPriority,
+    NormalTaskPriority,
+    LowTaskPriority
+};
+
+static const unsigned numberOfTaskPriorities = LowTaskPriority + 1;
+
+typedef void (*TaskFunction)(void*);
+
+class TaskGroup {
+    WTF_MAKE_NONCOPYABLE(TaskGroup); WTF_MAKE_FAST_ALLOCATED;
+public:
+    WTF_EXPORT_PRIVATE explicit TaskGroup(TaskPriority = NormalTaskPriority);
+    // Waits for tasks that are still running.
+    WTF_EXPORT_PRIVATE ~TaskGroup();
+
+    WTF_EXPORT_PRIVATE void run(TaskFunction, void* context);
+    WTF_EXPORT_PRIVATE void run(const Function<void ()>&);
+
+    // Returns once every task run in this group, including tasks that those tasks
+    // added, has finished. Queued tasks of the group are run on the calling thread.
+    WTF_EXPORT_PRIVATE void wait();
+
+    TaskPriority priority() const { return m_priority; }
+
+private:
+    friend class TaskScheduler;
+
+    void taskFinished();
+
+    TaskPriority m_priority;
+    unsigned m_pendingTasks;
+    Mutex m_mutex;
+    ThreadCondition m_condition;
+};
+
+// The number of tasks that can run at the same time, counting the waiting thread.
+WTF_EXPORT_PRIVATE unsigned taskSchedulerConcurrency();
+
+typedef void (*ParallelForFunction)(void* context, size_t begin, size_t end);
+
+// Splits [begin, end) into ranges of at least grainSize indices, calls the function on
+// each of them in parallel and returns once all of them are done.
+WTF_EXPORT_PRIVATE void parallelFor(size_t begin, size_t end, size_t grainSize, ParallelForFunction, void* context, TaskPriority = NormalTaskPriority);
+
+template<typename Functor>
+void parallelForFunctorThunk(void* functor, size_t begin, size_t end)
+{
+    (*static_cast<Functor*>(functor))(begin, end);
+}
+
+// The functor is called as functor(begin, end), possibly from several threads at once.
+template<typename Functor>
+void parallelFor(size_t begin, size_t end, size_t grainSize, Functor& functor, TaskPriority priority = NormalTaskPriority)
+{
+    parallelFor(begin, end, grainSize, parallelForFunctorThunk<Functor>, &functor, priority);
+}
+
+} // namespace WTF
+
+using WTF::HighTaskPriority;
+using WTF::LowTaskPriority;
+using WTF::NormalTaskPriority;
+using WTF::TaskFunction;
+using WTF::TaskGroup;
+using WTF::TaskPriority;
+using WTF::parallelFor;
+using WTF::taskSchedulerConcurrency;
+
+#endif // TaskScheduler_h
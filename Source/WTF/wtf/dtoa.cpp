@@ -3,7 +3,7 @@
  * The author of this software is David M. Gay.
  *
  * Copyright (c) 1991, 2000, 2001 by Lucent Technologies.
- * Copyright (C) 2002, 2005, 2006, 2007, 2008, 2010, 2012 Apple Inc. All rights reserved.
+ * Copyright (C) 2002, 2005, 2006, 2007, 2008, 2010, 2012, 2013 Apple Inc. All rights reserved.
  *
  * Permission to use, copy, modify, and distribute this software for any
  * purpose without fee is hereby granted, provided that this entire notice
@@ -1228,6 +1228,27 @@ void dtoaRoundDP(DtoaBuffer result, double dd, int ndigits, bool& sign, int& exp
 
 const char* numberToString(double d, NumberToStringBuffer buffer)
 {
+    // Integral values that a double holds exactly print as plain integers, so there is no
+    // shortest representation to search for. These are common, since most arithmetic that
+    // overflows int32 or goes through Math functions still produces integers.
+    if (std::abs(d) < 9007199254740992.0) {
+        int64_t integer = static_cast<int64_t>(d);
+        if (integer == d) {
+            uint64_t magnitude = integer < 0 ? -static_cast<uint64_t>(integer) : integer;
+            char* end = buffer + NumberToStringBufferLength;
+            char* p = end;
+            *--p = '\0';
+            do {
+                *--p = '0' + magnitude % 10;
+                magnitude /= 10;
+            } while (magnitude);
+            if (integer < 0)
+                *--p = '-';
+            memmove(buffer, p, end - p);
+            return buffer;
+        }
+    }
+
     double_conversion::StringBuilder builder(buffer, NumberToStringBufferLength);
     const double_conversion::DoubleToStringConverter& converter = double_conversion::DoubleToStringConverter::EcmaScriptConverter();
     converter.ToShortest(d, &builder);
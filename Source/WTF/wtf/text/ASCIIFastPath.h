@@ -22,12 +22,10 @@
 #ifndef ASCIIFastPath_h
 #define ASCIIFastPath_h
 
-#if OS(DARWIN) && (CPU(X86) || CPU(X86_64))
-#include <emmintrin.h>
-#endif
 #include <stdint.h>
 #include <wtf/Alignment.h>
 #include <wtf/StdLibExtras.h>
+#include <wtf/text/StringSIMD.h>
 #include <wtf/unicode/Unicode.h>
 
 namespace WTF {
@@ -76,6 +74,18 @@ inline bool charactersAreAllASCII(const CharacterType* characters, size_t length
     MachineWord allCharBits = 0;
     const CharacterType* end = characters + length;
 
+#if STRING_SIMD_USE_SSE2
+    const size_t charactersPerVector = SIMDCharacterTraits<CharacterType>::charactersPerVector;
+    if (length >= charactersPerVector) {
+        __m128i allVectorBits = _mm_setzero_si128();
+        const CharacterType* vectorEnd = end - charactersPerVector;
+        for (; characters <= vectorEnd; characters += charactersPerVector)
+            allVectorBits = _mm_or_si128(allVectorBits, loadCharacters(characters));
+        if (!SIMDCharacterTraits<CharacterType>::isAllASCII(allVectorBits))
+            return false;
+    }
+#endif
+
     // Prologue: align the input.
     while (!isAlignedToMachineWord(characters) && characters != end) {
         allCharBits |= *characters;
@@ -102,7 +112,7 @@ inline bool charactersAreAllASCII(const CharacterType* characters, size_t length
 
 inline void copyLCharsFromUCharSource(LChar* destination, const UChar* source, size_t length)
 {
-#if OS(DARWIN) && (CPU(X86) || CPU(X86_64))
+#if STRING_SIMD_USE_SSE2
     const uintptr_t memoryAccessSize = 16; // Memory accesses on 16 byte (128 bit) alignment
     const uintptr_t memoryAccessMask = memoryAccessSize - 1;
 
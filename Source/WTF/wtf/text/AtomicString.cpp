@@ -70,12 +70,74 @@ static ALWAYS_INLINE HashSet<StringImpl*>& stringTable()
     return wtfThreadData().atomicStringTable()->table();
 }
 
+#if ENABLE(COMPARE_AND_SWAP)
+void AtomicString::enableThreadSharedTable()
+{
+    AtomicStringTable::enableThreadSharedTable(wtfThreadData());
+}
+#endif
+
+template<typename HashTranslator, typename T>
+static inline void translateForThreadSharedTable(StringImpl*& location, const T& value, unsigned hash)
+{
+    HashTranslator::translate(location, value, hash);
+}
+
+// Wraps a translator for the thread-shared table, whose stripe is picked from the hash
+// before the lookup, so that the lookup does not compute it again.
+template<typename T, typename HashTranslator>
+struct ThreadSharedTranslator {
+    struct Key {
+        const T& value;
+        unsigned hash;
+    };
+
+    static unsigned hash(const Key& key)
+    {
+        return key.hash;
+    }
+
+    static bool equal(StringImpl* const& string, const Key& key)
+    {
+        return HashTranslator::equal(string, key.value);
+    }
+
+    static void translate(StringImpl*& location, const Key& key, unsigned hash)
+    {
+        translateForThreadSharedTable<HashTranslator>(location, key.value, hash);
+        location->setIsThreadShared();
+    }
+};
+
+template<typename T, typename HashTranslator>
+static PassRefPtr<StringImpl> addToThreadSharedTable(ThreadSharedAtomicStringTable& table, const T& value)
+{
+    typedef ThreadSharedTranslator<T, HashTranslator> Translator;
+    typename Translator::Key key = { value, HashTranslator::hash(value) };
+
+    ThreadSharedAtomicStringTable::Stripe& stripe = table.stripeForHash(key.hash);
+    MutexLocker locker(stripe.lock);
+    HashSet<StringImpl*>::AddResult addResult = stripe.table.add<Translator>(key);
+    if (!addResult.isNewEntry && !(*addResult.iterator)->tryRefThreadShared()) {
+        // Another thread dropped the last reference and is waiting for the lock to remove
+        // the string. It leaves the table alone once a new string has taken its place.
+        Translator::translate(*addResult.iterator, key, key.hash);
+    }
+
+    // A new string comes with the reference it was created with, an old one was referenced above.
+    return adoptRef(*addResult.iterator);
+}
+
 template<typename T, typename HashTranslator>
 static inline PassRefPtr<StringImpl> addToStringTable(const T& value)
 {
+    AtomicStringTable* table = wtfThreadData().atomicStringTable();
+    if (ThreadSharedAtomicStringTable* threadSharedTable = table->threadSharedTable())
+        return addToThreadSharedTable<T, HashTranslator>(*threadSharedTable, value);
+
     AtomicStringTableLocker locker;
 
-    HashSet<StringImpl*>::AddResult addResult = stringTable().add<HashTranslator>(value);
+    HashSet<StringImpl*>::AddResult addResult = table->table().add<HashTranslator>(value);
 
     // If the string is newly-translated, then we need to adopt it.
     // The boolean in the pair tells us if that is so.
@@ -190,27 +252,13 @@ struct HashAndUTF8CharactersTranslator {
             return equalUTF16WithUTF8(stringCharacters, stringCharacters + string->length(), buffer.characters, buffer.characters + buffer.length);
         }
 
-        if (string->is8Bit()) {
-            const LChar* stringCharacters = string->characters8();
-
-            for (unsigned i = 0; i < buffer.length; ++i) {
-                ASSERT(isASCII(buffer.characters[i]));
-                if (stringCharacters[i] != buffer.characters[i])
-                    return false;
-            }
-
-            return true;
-        }
-
-        const UChar* stringCharacters = string->characters16();
+        const LChar* bufferCharacters = reinterpret_cast<const LChar*>(buffer.characters);
+        ASSERT(charactersAreAllASCII(bufferCharacters, buffer.length));
 
-        for (unsigned i = 0; i < buffer.length; ++i) {
-            ASSERT(isASCII(buffer.characters[i]));
-            if (stringCharacters[i] != buffer.characters[i])
-                return false;
-        }
+        if (string->is8Bit())
+            return WTF::equal(string->characters8(), bufferCharacters, buffer.length);
 
-        return true;
+        return WTF::equal(string->characters16(), bufferCharacters, buffer.length);
     }
 
     static void translate(StringImpl*& location, const HashAndUTF8Characters& buffer, unsigned hash)
@@ -295,8 +343,26 @@ struct SubstringTranslator {
         location->setHash(hash);
         location->setIsAtomic(true);
     }
+
+    static void translateToCopy(StringImpl*& location, const SubstringLocation& buffer, unsigned hash)
+    {
+        if (buffer.baseString->is8Bit())
+            location = StringImpl::create(buffer.baseString->characters8() + buffer.start, buffer.length).leakRef();
+        else
+            location = StringImpl::create(buffer.baseString->characters16() + buffer.start, buffer.length).leakRef();
+        location->setHash(hash);
+        location->setIsAtomic(true);
+    }
 };
 
+// A substring keeps its base string alive, and the base string can belong to another
+// thread, so the thread-shared table gets a copy of the characters.
+template<>
+inline void translateForThreadSharedTable<SubstringTranslator, SubstringLocation>(StringImpl*& location, const SubstringLocation& buffer, unsigned hash)
+{
+    SubstringTranslator::translateToCopy(location, buffer, hash);
+}
+
 PassRefPtr<StringImpl> AtomicString::add(StringImpl* baseString, unsigned start, unsigned length)
 {
     if (!baseString)
@@ -377,6 +443,33 @@ PassRefPtr<StringImpl> AtomicString::addFromLiteralData(const char* characters,
     return addToStringTable<CharBuffer, CharBufferFromLiteralDataTranslator>(buffer);
 }
 
+static PassRefPtr<StringImpl> addSlowCaseToThreadSharedTable(ThreadSharedAtomicStringTable& table, StringImpl* string)
+{
+    if (string->isSubString()) {
+        if (string->is8Bit()) {
+            LCharBuffer buffer = { string->characters8(), string->length() };
+            return addToThreadSharedTable<LCharBuffer, LCharBufferTranslator>(table, buffer);
+        }
+        UCharBuffer buffer = { string->characters16(), string->length() };
+        return addToThreadSharedTable<UCharBuffer, UCharBufferTranslator>(table, buffer);
+    }
+
+    ThreadSharedAtomicStringTable::Stripe& stripe = table.stripeForHash(string->hash());
+    MutexLocker locker(stripe.lock);
+    HashSet<StringImpl*>::AddResult addResult = stripe.table.add(string);
+    if (!addResult.isNewEntry) {
+        if ((*addResult.iterator)->tryRefThreadShared())
+            return adoptRef(*addResult.iterator);
+        // See addToThreadSharedTable().
+        *addResult.iterator = string;
+    }
+
+    // Nothing else can see the string yet, so the flags can be set without synchronization.
+    string->setIsAtomic(true);
+    string->setIsThreadShared();
+    return string;
+}
+
 PassRefPtr<StringImpl> AtomicString::addSlowCase(StringImpl* string)
 {
     if (!string->length())
@@ -384,8 +477,12 @@ PassRefPtr<StringImpl> AtomicString::addSlowCase(StringImpl* string)
 
     ASSERT_WITH_MESSAGE(!string->isAtomic(), "AtomicString should not hit the slow case if the string is already atomic.");
 
+    AtomicStringTable* table = wtfThreadData().atomicStringTable();
+    if (ThreadSharedAtomicStringTable* threadSharedTable = table->threadSharedTable())
+        return addSlowCaseToThreadSharedTable(*threadSharedTable, string);
+
     AtomicStringTableLocker locker;
-    HashSet<StringImpl*>::AddResult addResult = stringTable().add(string);
+    HashSet<StringImpl*>::AddResult addResult = table->table().add(string);
 
     if (addResult.isNewEntry) {
         ASSERT(*addResult.iterator == string);
@@ -396,10 +493,32 @@ PassRefPtr<StringImpl> AtomicString::addSlowCase(StringImpl* string)
 }
 
 template<typename CharacterType>
-static inline HashSet<StringImpl*>::iterator findString(const StringImpl* stringImpl)
+static inline HashSet<StringImpl*>::iterator findString(HashSet<StringImpl*>& table, const StringImpl* stringImpl)
 {
     HashAndCharacters<CharacterType> buffer = { stringImpl->existingHash(), stringImpl->getCharacters<CharacterType>(), stringImpl->length() };
-    return stringTable().find<HashAndCharactersTranslator<CharacterType> >(buffer);
+    return table.find<HashAndCharactersTranslator<CharacterType> >(buffer);
+}
+
+static AtomicStringImpl* findInThreadSharedTable(ThreadSharedAtomicStringTable& table, const StringImpl* stringImpl)
+{
+    ThreadSharedAtomicStringTable::Stripe& stripe = table.stripeForHash(stringImpl->existingHash());
+    StringImpl* result;
+    {
+        MutexLocker locker(stripe.lock);
+        HashSet<StringImpl*>::iterator iterator;
+        if (stringImpl->is8Bit())
+            iterator = findString<LChar>(stripe.table, stringImpl);
+        else
+            iterator = findString<UChar>(stripe.table, stringImpl);
+        // Skip a string whose last reference is gone, since it is about to be removed.
+        if (iterator == stripe.table.end() || !(*iterator)->tryRefThreadShared())
+            return 0;
+        result = *iterator;
+    }
+
+    // Destroying the string takes the stripe lock, so the reference is dropped outside of it.
+    result->deref();
+    return static_cast<AtomicStringImpl*>(result);
 }
 
 AtomicStringImpl* AtomicString::find(const StringImpl* stringImpl)
@@ -410,20 +529,43 @@ AtomicStringImpl* AtomicString::find(const StringImpl* stringImpl)
     if (!stringImpl->length())
         return static_cast<AtomicStringImpl*>(StringImpl::empty());
 
+    AtomicStringTable* table = wtfThreadData().atomicStringTable();
+    if (ThreadSharedAtomicStringTable* threadSharedTable = table->threadSharedTable())
+        return findInThreadSharedTable(*threadSharedTable, stringImpl);
+
     AtomicStringTableLocker locker;
     HashSet<StringImpl*>::iterator iterator;
     if (stringImpl->is8Bit())
-        iterator = findString<LChar>(stringImpl);
+        iterator = findString<LChar>(table->table(), stringImpl);
     else
-        iterator = findString<UChar>(stringImpl);
-    if (iterator == stringTable().end())
+        iterator = findString<UChar>(table->table(), stringImpl);
+    if (iterator == table->table().end())
         return 0;
     return static_cast<AtomicStringImpl*>(*iterator);
 }
 
+static HashSet<StringImpl*>::iterator findInThreadSharedStripe(ThreadSharedAtomicStringTable::Stripe& stripe, StringImpl* string)
+{
+    // Look for this very string: once its last reference was dropped, another thread may
+    // have replaced it with an equal one.
+    HashSet<StringImpl*>::iterator iterator = stripe.table.find(string);
+    if (iterator != stripe.table.end() && *iterator != string)
+        return stripe.table.end();
+    return iterator;
+}
+
 void AtomicString::remove(StringImpl* string)
 {
     ASSERT(string->isAtomic());
+    if (string->isThreadShared()) {
+        ThreadSharedAtomicStringTable::Stripe& stripe = ThreadSharedAtomicStringTable::shared()->stripeForHash(string->existingHash());
+        MutexLocker locker(stripe.lock);
+        HashSet<StringImpl*>::iterator iterator = findInThreadSharedStripe(stripe, string);
+        if (iterator != stripe.table.end())
+            stripe.table.remove(iterator);
+        return;
+    }
+
     AtomicStringTableLocker locker;
     HashSet<StringImpl*>& atomicStringTable = stringTable();
     HashSet<StringImpl*>::iterator iterator = atomicStringTable.find(string);
@@ -464,6 +606,12 @@ AtomicString AtomicString::fromUTF8Internal(const char* charactersStart, const c
 #if !ASSERT_DISABLED
 bool AtomicString::isInAtomicStringTable(StringImpl* string)
 {
+    if (string->isThreadShared()) {
+        ThreadSharedAtomicStringTable::Stripe& stripe = ThreadSharedAtomicStringTable::shared()->stripeForHash(string->existingHash());
+        MutexLocker locker(stripe.lock);
+        return findInThreadSharedStripe(stripe, string) != stripe.table.end();
+    }
+
     AtomicStringTableLocker locker;
     return stringTable().contains(string);
 }
@@ -41,6 +41,15 @@ class AtomicString {
 public:
     WTF_EXPORT_PRIVATE static void init();
 
+#if ENABLE(COMPARE_AND_SWAP)
+    // Makes the calling thread, and every thread that starts using AtomicString afterwards,
+    // atomize strings in one table shared by all threads. Strings from that table can be
+    // handed to any thread, and their ref counts are updated atomically. Call it before
+    // AtomicString::init() and before starting other threads; a thread that has already
+    // atomized strings keeps its own table.
+    WTF_EXPORT_PRIVATE static void enableThreadSharedTable();
+#endif
+
     AtomicString() { }
     AtomicString(const LChar* s) : m_string(add(s)) { }
     AtomicString(const char* s) : m_string(add(s)) { }
@@ -87,6 +96,8 @@ public:
     AtomicString(WTF::HashTableDeletedValueType) : m_string(WTF::HashTableDeletedValue) { }
     bool isHashTableDeletedValue() const { return m_string.isHashTableDeletedValue(); }
 
+    // Returns an unreferenced pointer, which another thread can release at any time if the
+    // string comes from the thread-shared table.
     WTF_EXPORT_STRING_API static AtomicStringImpl* find(const StringImpl*);
 
     operator const String&() const { return m_string; }
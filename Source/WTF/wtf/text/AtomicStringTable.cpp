@@ -49,6 +49,22 @@ void AtomicStringTable::create(WTFThreadData& data)
     data.m_atomicStringTable = new AtomicStringTable;
     data.m_atomicStringTableDestructor = AtomicStringTable::destroy;
 #endif // USE(WEB_THREAD)
+
+    data.m_atomicStringTable->m_threadSharedTable = ThreadSharedAtomicStringTable::s_shared;
+}
+
+ThreadSharedAtomicStringTable* ThreadSharedAtomicStringTable::s_shared;
+
+void AtomicStringTable::enableThreadSharedTable(WTFThreadData& data)
+{
+    if (!ThreadSharedAtomicStringTable::s_shared)
+        ThreadSharedAtomicStringTable::s_shared = new ThreadSharedAtomicStringTable;
+
+    // Strings the thread already atomized stay in its own table, and so does every string
+    // it atomizes later, since they have to be found there.
+    AtomicStringTable* table = data.atomicStringTable();
+    if (table->m_table.isEmpty())
+        table->m_threadSharedTable = ThreadSharedAtomicStringTable::s_shared;
 }
 
 void AtomicStringTable::destroy(AtomicStringTable* table)
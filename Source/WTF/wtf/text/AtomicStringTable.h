@@ -24,11 +24,13 @@
 #define WTF_AtomicStringTable_h
 
 #include <wtf/HashSet.h>
+#include <wtf/Threading.h>
 #include <wtf/WTFThreadData.h>
 
 namespace WTF {
 
 class StringImpl;
+class ThreadSharedAtomicStringTable;
 
 class AtomicStringTable {
     WTF_MAKE_FAST_ALLOCATED;
@@ -37,10 +39,49 @@ public:
     static void create(WTFThreadData&);
     HashSet<StringImpl*>& table() { return m_table; }
 
+    // Null unless the thread atomizes its strings in the table shared by all threads.
+    ThreadSharedAtomicStringTable* threadSharedTable() const { return m_threadSharedTable; }
+
+    // See AtomicString::enableThreadSharedTable().
+    static void enableThreadSharedTable(WTFThreadData&);
+
 private:
+    AtomicStringTable()
+        : m_threadSharedTable(0)
+    {
+    }
+
     static void destroy(AtomicStringTable*);
 
     HashSet<StringImpl*> m_table;
+    ThreadSharedAtomicStringTable* m_threadSharedTable;
+};
+
+// The process-wide table is split in stripes, each with its own lock, so that threads
+// only contend when they atomize strings whose hashes end in the same bits.
+class ThreadSharedAtomicStringTable {
+    WTF_MAKE_NONCOPYABLE(ThreadSharedAtomicStringTable); WTF_MAKE_FAST_ALLOCATED;
+public:
+    struct Stripe {
+        Mutex lock;
+        HashSet<StringImpl*> table;
+    };
+
+    // Null until AtomicString::enableThreadSharedTable() is called.
+    static ThreadSharedAtomicStringTable* shared() { return s_shared; }
+
+    Stripe& stripeForHash(unsigned hash) { return m_stripes[hash & (numberOfStripes - 1)]; }
+
+private:
+    friend class AtomicStringTable;
+
+    ThreadSharedAtomicStringTable() { }
+
+    static const unsigned numberOfStripes = 64;
+
+    static ThreadSharedAtomicStringTable* s_shared;
+
+    Stripe m_stripes[numberOfStripes];
 };
 
 }
@@ -29,9 +29,18 @@
 
 #include "IntegerToStringConversion.h"
 #include "WTFString.h"
+#include <limits>
 
 namespace WTF {
 
+// A chunked builder grows its first buffer like any other builder until the string is this
+// long, so short strings still end up in one buffer that toString() can return as it is.
+static const unsigned minimumChunkCapacity = 4096;
+
+// Later buffers are about as long as the string so far, up to this many characters, which
+// bounds both the number of chunks and the capacity left unused in the last one.
+static const unsigned maximumChunkCapacity = 1024 * 1024;
+
 static size_t expandedCapacity(size_t capacity, size_t newLength)
 {
     static const size_t minimumCapacity = 16;
@@ -40,6 +49,13 @@ static size_t expandedCapacity(size_t capacity, size_t newLength)
 
 void StringBuilder::reifyString() const
 {
+    // A chunked builder that has started a second chunk concatenates them all once, and
+    // from then on holds the result like a builder that was given a single string.
+    if (hasChunks()) {
+        const_cast<StringBuilder*>(this)->flattenChunks();
+        return;
+    }
+
     // Check if the string already exists.
     if (!m_string.isNull()) {
         ASSERT(m_string.length() == m_length);
@@ -66,6 +82,35 @@ void StringBuilder::reifyString() const
 
 void StringBuilder::resize(unsigned newSize)
 {
+    if (hasChunks()) {
+        ASSERT(newSize <= length());
+        if (newSize >= m_chunksLength) {
+            m_length = m_chunkStart + (newSize - m_chunksLength);
+            return;
+        }
+
+        // Drop the characters in the current buffer, and the chunks past the new end. The rest
+        // of the buffer is still free for what gets appended next.
+        m_chunkStart = m_length;
+        while (!m_chunks.isEmpty() && m_chunksLength - m_chunks.last().length() >= newSize) {
+            m_chunksLength -= m_chunks.last().length();
+            m_chunks.removeLast();
+        }
+        if (m_chunks.isEmpty()) {
+            clear();
+            return;
+        }
+        if (newSize < m_chunksLength) {
+            String& lastChunk = m_chunks.last();
+            lastChunk = lastChunk.substringSharingImpl(0, lastChunk.length() - (m_chunksLength - newSize));
+            m_chunksLength = newSize;
+        }
+        m_chunksAre8Bit = true;
+        for (size_t i = 0; i < m_chunks.size(); ++i)
+            m_chunksAre8Bit &= m_chunks[i].is8Bit();
+        return;
+    }
+
     // Check newSize < m_length, hence m_length > 0.
     ASSERT(newSize <= m_length);
     if (newSize == m_length)
@@ -171,6 +216,19 @@ void StringBuilder::reallocateBuffer<UChar>(unsigned requiredLength)
 
 void StringBuilder::reserveCapacity(unsigned newCapacity)
 {
+    if (hasChunks()) {
+        // Chunks are never reallocated, so make room in a new buffer if the current one is short.
+        unsigned currentLength = length();
+        if (newCapacity <= currentLength)
+            return;
+        unsigned additionalLength = newCapacity - currentLength;
+        if (m_buffer && m_buffer->length() - m_length >= additionalLength)
+            return;
+        finishChunk();
+        allocateChunk(additionalLength);
+        return;
+    }
+
     if (m_buffer) {
         // If there is already a buffer, then grow if necessary.
         if (newCapacity > m_buffer->length()) {
@@ -224,6 +282,9 @@ CharType* StringBuilder::appendUninitializedSlow(unsigned requiredLength)
 {
     ASSERT(requiredLength);
 
+    if (m_isChunked && (hasChunks() || requiredLength > minimumChunkCapacity))
+        return appendUninitializedToNewChunk<CharType>(requiredLength - m_length);
+
     if (m_buffer) {
         // If the buffer is valid it must be at least as long as the current builder contents!
         ASSERT(m_buffer->length() >= m_length);
@@ -258,7 +319,19 @@ void StringBuilder::append(const UChar* characters, unsigned length)
         unsigned requiredLength = length + m_length;
         if (requiredLength < length)
             CRASH();
-        
+
+        // Rather than upconverting everything appended so far, a chunked builder that is past its
+        // first buffer keeps the 8-bit characters as a chunk, and continues in a 16-bit buffer.
+        if (m_isChunked && (hasChunks() || requiredLength > minimumChunkCapacity)) {
+            finishChunk();
+            m_buffer = 0;
+            m_length = 0;
+            m_chunkStart = 0;
+            m_is8Bit = false;
+            memcpy(appendUninitializedToNewChunk<UChar>(length), characters, static_cast<size_t>(length) * sizeof(UChar));
+            return;
+        }
+
         if (m_buffer) {
             // If the buffer is valid it must be at least as long as the current builder contents!
             ASSERT(m_buffer->length() >= m_length);
@@ -330,6 +403,10 @@ void StringBuilder::appendNumber(unsigned long long number)
 
 bool StringBuilder::canShrink() const
 {
+    // Chunks are concatenated into a string of the exact length anyway.
+    if (hasChunks())
+        return false;
+
     // Only shrink the buffer if it's less than 80% full. Need to tune this heuristic!
     return m_buffer && m_buffer->length() > (m_length + (m_length >> 2));
 }
@@ -346,4 +423,156 @@ void StringBuilder::shrinkToFit()
     }
 }
 
+// Ends the current chunk at the last character appended. The rest of the current buffer, if
+// there is one, becomes the start of the next chunk.
+void StringBuilder::finishChunk()
+{
+    ASSERT(m_isChunked);
+    unsigned chunkLength = m_length - m_chunkStart;
+    if (!chunkLength)
+        return;
+
+    if (m_buffer) {
+        if (!m_chunkStart && m_length == m_buffer->length())
+            m_chunks.append(m_buffer.get());
+        else
+            m_chunks.append(StringImpl::create(m_buffer, m_chunkStart, chunkLength));
+        m_chunkStart = m_length;
+    } else {
+        // The only string appended so far, which was kept rather than copied.
+        ASSERT(!hasChunks() && !m_chunkStart && m_string.length() == m_length);
+        m_chunks.append(m_string);
+        m_length = 0;
+    }
+
+    m_string = String();
+    m_chunksLength += chunkLength;
+    if (!m_is8Bit)
+        m_chunksAre8Bit = false;
+    if (!m_buffer)
+        m_is8Bit = true;
+}
+
+// The total length has to fit in an unsigned however much of the current buffer gets used.
+static inline void checkChunkedLength(unsigned chunksLength, unsigned availableLength)
+{
+    if (static_cast<uint64_t>(chunksLength) + availableLength > std::numeric_limits<unsigned>::max())
+        CRASH();
+}
+
+void StringBuilder::allocateChunk(unsigned capacity)
+{
+    ASSERT(m_isChunked && m_length == m_chunkStart);
+    checkChunkedLength(m_chunksLength, capacity);
+    if (m_is8Bit)
+        m_buffer = StringImpl::createUninitialized(capacity, m_bufferCharacters8);
+    else
+        m_buffer = StringImpl::createUninitialized(capacity, m_bufferCharacters16);
+    m_length = 0;
+    m_chunkStart = 0;
+    m_valid16BitShadowLength = 0;
+    m_string = String();
+}
+
+template <typename CharType>
+CharType* StringBuilder::appendUninitializedToNewChunk(unsigned length)
+{
+    finishChunk();
+    unsigned capacity = std::max(length, std::min(std::max(m_chunksLength, minimumChunkCapacity), maximumChunkCapacity));
+    allocateChunk(capacity);
+    m_length = length;
+    return getBufferCharacters<CharType>();
+}
+
+void StringBuilder::appendChunk(const String& string)
+{
+    ASSERT(m_isChunked && !string.isEmpty());
+    finishChunk();
+    checkChunkedLength(m_chunksLength, string.length());
+    m_chunks.append(string);
+    m_chunksLength += string.length();
+    if (!string.is8Bit())
+        m_chunksAre8Bit = false;
+    checkChunkedLength(m_chunksLength, m_buffer ? m_buffer->length() - m_chunkStart : 0);
+}
+
+void StringBuilder::appendChunksOf(const StringBuilder& other)
+{
+    unsigned numberOfChunks = other.numberOfChunks();
+    for (unsigned i = 0; i < numberOfChunks; ++i)
+        append(other.chunk(i));
+}
+
+void StringBuilder::flattenChunks()
+{
+    ASSERT(hasChunks());
+    finishChunk();
+
+    if (m_chunks.size() == 1)
+        m_string = m_chunks[0];
+    else if (m_chunksAre8Bit) {
+        LChar* destination;
+        m_string = StringImpl::createUninitialized(m_chunksLength, destination);
+        for (size_t i = 0; i < m_chunks.size(); ++i) {
+            StringImpl::copyChars(destination, m_chunks[i].characters8(), m_chunks[i].length());
+            destination += m_chunks[i].length();
+        }
+    } else {
+        UChar* destination;
+        m_string = StringImpl::createUninitialized(m_chunksLength, destination);
+        for (size_t i = 0; i < m_chunks.size(); ++i) {
+            const String& chunk = m_chunks[i];
+            if (chunk.is8Bit())
+                StringImpl::copyChars(destination, chunk.characters8(), chunk.length());
+            else
+                StringImpl::copyChars(destination, chunk.characters16(), chunk.length());
+            destination += chunk.length();
+        }
+    }
+
+    m_length = m_chunksLength;
+    m_buffer = 0;
+    m_bufferCharacters8 = 0;
+    m_is8Bit = m_string.is8Bit();
+    m_valid16BitShadowLength = 0;
+    m_chunksAre8Bit = true;
+    m_chunkStart = 0;
+    m_chunksLength = 0;
+    m_chunks.clear();
+}
+
+String StringBuilder::chunk(unsigned index) const
+{
+    ASSERT(index < numberOfChunks());
+    if (index < m_chunks.size())
+        return m_chunks[index];
+    if (!hasChunks())
+        return toStringPreserveCapacity();
+
+    // Make the characters in the current buffer a chunk of their own, so that neither resize()
+    // nor later appends can write to characters the caller holds on to.
+    const_cast<StringBuilder*>(this)->finishChunk();
+    return m_chunks[index];
+}
+
+UChar StringBuilder::chunkedCharacterAt(unsigned index) const
+{
+    ASSERT(hasChunks());
+    if (index >= m_chunksLength) {
+        index += m_chunkStart - m_chunksLength;
+        return m_is8Bit ? m_bufferCharacters8[index] : m_bufferCharacters16[index];
+    }
+
+    // Callers mostly look at the last few characters, so search from the end.
+    unsigned chunkEnd = m_chunksLength;
+    for (size_t i = m_chunks.size(); i--; ) {
+        unsigned chunkStart = chunkEnd - m_chunks[i].length();
+        if (index >= chunkStart)
+            return m_chunks[i][index - chunkStart];
+        chunkEnd = chunkStart;
+    }
+    ASSERT_NOT_REACHED();
+    return 0;
+}
+
 } // namespace WTF
@@ -27,6 +27,7 @@
 #ifndef StringBuilder_h
 #define StringBuilder_h
 
+#include <wtf/Vector.h>
 #include <wtf/text/AtomicString.h>
 #include <wtf/text/WTFString.h>
 
@@ -42,6 +43,28 @@ public:
         , m_is8Bit(true)
         , m_valid16BitShadowLength(0)
         , m_bufferCharacters8(0)
+        , m_isChunked(false)
+        , m_chunksAre8Bit(true)
+        , m_chunkStart(0)
+        , m_chunksLength(0)
+    {
+    }
+
+    // A chunked builder never reallocates a buffer once the string outgrows a small one.
+    // Instead it starts a new buffer and keeps the full one as a chunk, and it keeps long
+    // appended strings as chunks of their own. Characters already appended are not copied
+    // again until the string is flattened, and a string consumer that can hold a list of
+    // strings, like a JSC rope, can take the chunks as they are.
+    enum ChunkedTag { Chunked };
+    explicit StringBuilder(ChunkedTag)
+        : m_length(0)
+        , m_is8Bit(true)
+        , m_valid16BitShadowLength(0)
+        , m_bufferCharacters8(0)
+        , m_isChunked(true)
+        , m_chunksAre8Bit(true)
+        , m_chunkStart(0)
+        , m_chunksLength(0)
     {
     }
 
@@ -57,13 +80,18 @@ public:
 
         // If we're appending to an empty string, and there is not a buffer (reserveCapacity has not been called)
         // then just retain the string.
-        if (!m_length && !m_buffer) {
+        if (!m_length && !m_buffer && !hasChunks()) {
             m_string = string;
             m_length = string.length();
             m_is8Bit = m_string.is8Bit();
             return;
         }
 
+        if (m_isChunked && string.length() >= s_minimumAdoptedChunkLength) {
+            appendChunk(string);
+            return;
+        }
+
         if (string.is8Bit())
             append(string.characters8(), string.length());
         else
@@ -72,14 +100,20 @@ public:
 
     void append(const StringBuilder& other)
     {
-        if (!other.m_length)
+        if (!other.length())
             return;
 
+        if (other.hasChunks()) {
+            appendChunksOf(other);
+            return;
+        }
+
         // If we're appending to an empty string, and there is not a buffer (reserveCapacity has not been called)
         // then just retain the string.
-        if (!m_length && !m_buffer && !other.m_string.isNull()) {
+        if (!m_length && !m_buffer && !hasChunks() && !other.m_string.isNull()) {
             m_string = other.m_string;
             m_length = other.m_length;
+            m_is8Bit = other.m_is8Bit;
             return;
         }
 
@@ -178,6 +212,8 @@ public:
 
     AtomicString toAtomicString() const
     {
+        if (hasChunks())
+            reifyString();
         if (!m_length)
             return emptyAtom;
 
@@ -197,16 +233,18 @@ public:
 
     unsigned length() const
     {
-        return m_length;
+        return m_chunksLength + m_length - m_chunkStart;
     }
 
-    bool isEmpty() const { return !m_length; }
+    bool isEmpty() const { return !length(); }
 
+    // In a chunked builder, only the last buffer grows, so this is a hint for the characters
+    // still to come: when it is exact, they all land in one buffer that is filled exactly.
     WTF_EXPORT_PRIVATE void reserveCapacity(unsigned newCapacity);
 
     unsigned capacity() const
     {
-        return m_buffer ? m_buffer->length() : m_length;
+        return m_chunksLength - m_chunkStart + (m_buffer ? m_buffer->length() : m_length);
     }
 
     WTF_EXPORT_PRIVATE void resize(unsigned newSize);
@@ -217,7 +255,9 @@ public:
 
     UChar operator[](unsigned i) const
     {
-        ASSERT_WITH_SECURITY_IMPLICATION(i < m_length);
+        ASSERT_WITH_SECURITY_IMPLICATION(i < length());
+        if (UNLIKELY(hasChunks()))
+            return chunkedCharacterAt(i);
         if (m_is8Bit)
             return characters8()[i];
         return characters16()[i];
@@ -225,7 +265,9 @@ public:
 
     const LChar* characters8() const
     {
-        ASSERT(m_is8Bit);
+        ASSERT(is8Bit());
+        if (hasChunks())
+            reifyString();
         if (!m_length)
             return 0;
         if (!m_string.isNull())
@@ -236,7 +278,9 @@ public:
 
     const UChar* characters16() const
     {
-        ASSERT(!m_is8Bit);
+        ASSERT(!is8Bit());
+        if (hasChunks())
+            reifyString();
         if (!m_length)
             return 0;
         if (!m_string.isNull())
@@ -247,6 +291,8 @@ public:
     
     const UChar* characters() const
     {
+        if (hasChunks())
+            reifyString();
         if (!m_length)
             return 0;
         if (!m_string.isNull())
@@ -260,7 +306,12 @@ public:
         return m_buffer->characters();
     }
     
-    bool is8Bit() const { return m_is8Bit; }
+    bool is8Bit() const { return m_is8Bit && m_chunksAre8Bit; }
+
+    // The contents are the concatenation of the chunks, in order. A builder that is not
+    // chunked, or has not outgrown its first buffer, has at most one.
+    unsigned numberOfChunks() const { return m_chunks.size() + (m_length > m_chunkStart ? 1 : 0); }
+    WTF_EXPORT_PRIVATE String chunk(unsigned index) const;
 
     void clear()
     {
@@ -270,6 +321,10 @@ public:
         m_bufferCharacters8 = 0;
         m_is8Bit = true;
         m_valid16BitShadowLength = 0;
+        m_chunksAre8Bit = true;
+        m_chunkStart = 0;
+        m_chunksLength = 0;
+        m_chunks.clear();
     }
 
     void swap(StringBuilder& stringBuilder)
@@ -280,6 +335,11 @@ public:
         std::swap(m_is8Bit, stringBuilder.m_is8Bit);
         std::swap(m_valid16BitShadowLength, stringBuilder.m_valid16BitShadowLength);
         std::swap(m_bufferCharacters8, stringBuilder.m_bufferCharacters8);
+        std::swap(m_isChunked, stringBuilder.m_isChunked);
+        std::swap(m_chunksAre8Bit, stringBuilder.m_chunksAre8Bit);
+        std::swap(m_chunkStart, stringBuilder.m_chunkStart);
+        std::swap(m_chunksLength, stringBuilder.m_chunksLength);
+        m_chunks.swap(stringBuilder.m_chunks);
     }
 
 private:
@@ -296,6 +356,21 @@ private:
     ALWAYS_INLINE CharType * getBufferCharacters();
     WTF_EXPORT_PRIVATE void reifyString() const;
 
+    // Strings at least this long are kept as chunks rather than copied into a chunked builder.
+    static const unsigned s_minimumAdoptedChunkLength = 1024;
+
+    bool hasChunks() const { return !m_chunks.isEmpty(); }
+    void finishChunk();
+    void allocateChunk(unsigned capacity);
+    template <typename CharType>
+    CharType* appendUninitializedToNewChunk(unsigned length);
+    void flattenChunks();
+    WTF_EXPORT_PRIVATE void appendChunk(const String&);
+    WTF_EXPORT_PRIVATE void appendChunksOf(const StringBuilder&);
+    WTF_EXPORT_PRIVATE UChar chunkedCharacterAt(unsigned) const;
+
+    // In a chunked builder, m_length is the end of the characters in m_buffer, and the ones
+    // before m_chunkStart already belong to the last chunk.
     unsigned m_length;
     mutable String m_string;
     RefPtr<StringImpl> m_buffer;
@@ -305,6 +380,11 @@ private:
         LChar* m_bufferCharacters8;
         UChar* m_bufferCharacters16;
     };
+    bool m_isChunked;
+    bool m_chunksAre8Bit;
+    unsigned m_chunkStart;
+    unsigned m_chunksLength;
+    Vector<String> m_chunks;
 };
 
 template <>
@@ -30,6 +30,7 @@
 #include "StringHash.h"
 #include <wtf/ProcessID.h>
 #include <wtf/StdLibExtras.h>
+#include <wtf/TCSpinLock.h>
 #include <wtf/WTFThreadData.h>
 #include <wtf/unicode/CharacterNames.h>
 
@@ -154,6 +155,51 @@ void StringImpl::destroy(StringImpl* stringImpl)
     fastFree(stringImpl);
 }
 
+void StringImpl::refThreadShared()
+{
+    unsigned refCount;
+    do {
+        refCount = m_refCount;
+        ASSERT(refCount > s_refCountFlagIsThreadShared);
+    } while (!weakCompareAndSwap(&m_refCount, refCount, refCount + s_refCountIncrement));
+}
+
+void StringImpl::derefThreadShared()
+{
+    unsigned refCount;
+    do {
+        refCount = m_refCount;
+        ASSERT(refCount > s_refCountFlagIsThreadShared);
+    } while (!weakCompareAndSwap(&m_refCount, refCount, refCount - s_refCountIncrement));
+
+    // Once the count drops to zero tryRefThreadShared() fails, so only this thread can
+    // get here. The destructor takes the string out of the table under its lock.
+    if (refCount - s_refCountIncrement == s_refCountFlagIsThreadShared)
+        StringImpl::destroy(this);
+}
+
+bool StringImpl::tryRefThreadShared()
+{
+    ASSERT(isThreadShared());
+    while (true) {
+        unsigned refCount = m_refCount;
+        if (refCount == s_refCountFlagIsThreadShared)
+            return false;
+        if (weakCompareAndSwap(&m_refCount, refCount, refCount + s_refCountIncrement))
+            return true;
+    }
+}
+
+void StringImpl::setFlagThreadShared(unsigned flag) const
+{
+    unsigned hashAndFlags;
+    do {
+        hashAndFlags = m_hashAndFlags;
+        if (hashAndFlags & flag)
+            return;
+    } while (!weakCompareAndSwap(&m_hashAndFlags, hashAndFlags, hashAndFlags | flag));
+}
+
 PassRefPtr<StringImpl> StringImpl::createFromLiteral(const char* characters, unsigned length)
 {
     ASSERT_WITH_MESSAGE(length, "Use StringImpl::empty() to create an empty string");
@@ -300,10 +346,15 @@ PassRefPtr<StringImpl> StringImpl::create(const LChar* string)
     return create(string, length);
 }
 
+static SpinLock threadSharedUpconversionLock = SPINLOCK_INITIALIZER;
+
 const UChar* StringImpl::getData16SlowCase() const
 {
-    if (has16BitShadow())
+    if (has16BitShadow()) {
+        // Pairs with the store fence below, for thread-shared strings.
+        loadLoadFence();
         return m_copyData16;
+    }
 
     if (bufferOwnership() == BufferSubstring) {
         // If this is a substring, return a pointer into the parent string.
@@ -314,17 +365,33 @@ const UChar* StringImpl::getData16SlowCase() const
 
     STRING_STATS_ADD_UPCONVERTED_STRING(m_length);
     
+    // Several threads can ask for the characters of a thread-shared string at once, and
+    // they read m_copyData16 as soon as they see the flag, so it has to be set last.
+    bool isThreadShared = this->isThreadShared();
+    if (isThreadShared) {
+        threadSharedUpconversionLock.Lock();
+        if (has16BitShadow()) {
+            threadSharedUpconversionLock.Unlock();
+            return m_copyData16;
+        }
+    }
+
     unsigned len = length();
     if (hasTerminatingNullCharacter())
         ++len;
 
-    m_copyData16 = static_cast<UChar*>(fastMalloc(len * sizeof(UChar)));
-
-    m_hashAndFlags |= s_hashFlagHas16BitShadow;
+    UChar* copyData16 = static_cast<UChar*>(fastMalloc(len * sizeof(UChar)));
+    copyLCharsToUChars(copyData16, m_data8, len);
+    m_copyData16 = copyData16;
 
-    upconvertCharacters(0, len);
+    if (isThreadShared) {
+        storeStoreFence();
+        setFlag(s_hashFlagHas16BitShadow);
+        threadSharedUpconversionLock.Unlock();
+    } else
+        m_hashAndFlags |= s_hashFlagHas16BitShadow;
 
-    return m_copyData16;
+    return copyData16;
 }
 
 void StringImpl::upconvertCharacters(unsigned start, unsigned end) const
@@ -332,8 +399,7 @@ void StringImpl::upconvertCharacters(unsigned start, unsigned end) const
     ASSERT(is8Bit());
     ASSERT(has16BitShadow());
 
-    for (size_t i = start; i < end; ++i)
-        m_copyData16[i] = m_data8[i];
+    copyLCharsToUChars(m_copyData16 + start, m_data8 + start, end - start);
 }
     
 
@@ -393,55 +459,38 @@ PassRefPtr<StringImpl> StringImpl::lower()
     // no-op code path up through the first 'return' statement.
 
     // First scan the string for uppercase and non-ASCII characters:
-    bool noUpper = true;
     if (is8Bit()) {
-        unsigned failingIndex;
-        for (unsigned i = 0; i < m_length; ++i) {
-            LChar character = m_data8[i];
-            if (UNLIKELY((character & ~0x7F) || isASCIIUpper(character))) {
-                failingIndex = i;
-                goto SlowPath8bitLower;
-            }
-        }
-        return this;
+        unsigned failingIndex = findFirstASCIIUpperOrNonASCII(m_data8, m_length);
+        if (failingIndex == m_length)
+            return this;
 
-SlowPath8bitLower:
         LChar* data8;
         RefPtr<StringImpl> newImpl = createUninitialized(m_length, data8);
 
-        for (unsigned i = 0; i < failingIndex; ++i)
-            data8[i] = m_data8[i];
+        copyChars(data8, m_data8, failingIndex);
+        if (convertASCIICase(data8 + failingIndex, m_data8 + failingIndex, m_length - failingIndex, false))
+            return newImpl.release();
 
         for (unsigned i = failingIndex; i < m_length; ++i) {
             LChar character = m_data8[i];
-            if (!(character & ~0x7F))
-                data8[i] = toASCIILower(character);
-            else
+            if (character & ~0x7F)
                 data8[i] = static_cast<LChar>(Unicode::toLower(character));
         }
 
         return newImpl.release();
     }
-    unsigned ored = 0;
 
-    for (unsigned i = 0; i < m_length; ++i) {
-        UChar character = m_data16[i];
-        if (UNLIKELY(isASCIIUpper(character)))
-            noUpper = false;
-        ored |= character;
-    }
     // Nothing to do if the string is all ASCII with no uppercase.
-    if (noUpper && !(ored & ~0x7F))
+    unsigned failingIndex = findFirstASCIIUpperOrNonASCII(m_data16, m_length);
+    if (failingIndex == m_length)
         return this;
 
-    if (!(ored & ~0x7F)) {
+    if (charactersAreAllASCII(m_data16 + failingIndex, m_length - failingIndex)) {
         UChar* data16;
         RefPtr<StringImpl> newImpl = createUninitialized(m_length, data16);
-        
-        for (unsigned i = 0; i < m_length; ++i) {
-            UChar c = m_data16[i];
-            data16[i] = toASCIILower(c);
-        }
+
+        copyChars(data16, m_data16, failingIndex);
+        convertASCIICase(data16 + failingIndex, m_data16 + failingIndex, m_length - failingIndex, false);
         return newImpl.release();
     }
 
@@ -480,20 +529,7 @@ PassRefPtr<StringImpl> StringImpl::upper()
         RefPtr<StringImpl> newImpl = createUninitialized(m_length, data8);
         
         // Do a faster loop for the case where all the characters are ASCII.
-        unsigned ored = 0;
-        for (int i = 0; i < length; ++i) {
-            LChar c = m_data8[i];
-            ored |= c;
-#if CPU(X86) && defined(_MSC_VER) && _MSC_VER >=1700
-            // Workaround for an MSVC 2012 x86 optimizer bug. Remove once the bug is fixed.
-            // See https://connect.microsoft.com/VisualStudio/feedback/details/780362/optimization-bug-of-range-comparison
-            // for more details.
-            data8[i] = c >= 'a' && c <= 'z' ? c & ~0x20 : c;
-#else
-            data8[i] = toASCIIUpper(c);
-#endif
-        }
-        if (!(ored & ~0x7F))
+        if (convertASCIICase(data8, m_data8, m_length, true))
             return newImpl.release();
 
         // Do a slower implementation for cases that include non-ASCII Latin-1 characters.
@@ -541,13 +577,7 @@ upconvert:
     RefPtr<StringImpl> newImpl = createUninitialized(m_length, data16);
     
     // Do a faster loop for the case where all the characters are ASCII.
-    unsigned ored = 0;
-    for (int i = 0; i < length; ++i) {
-        UChar c = source16[i];
-        ored |= c;
-        data16[i] = toASCIIUpper(c);
-    }
-    if (!(ored & ~0x7F))
+    if (convertASCIICase(data16, source16, m_length, true))
         return newImpl.release();
 
     // Do a slower implementation for cases that include non-ASCII characters.
@@ -868,24 +898,43 @@ float StringImpl::toFloat(bool* ok)
     return charactersToFloat(characters16(), m_length, ok);
 }
 
-bool equalIgnoringCase(const LChar* a, const LChar* b, unsigned length)
-{
-    while (length--) {
-        LChar bc = *b++;
-        if (foldCase(*a++) != foldCase(bc))
-            return false;
+template<typename CharacterType>
+static inline bool equalIgnoringCaseWithSIMD(const CharacterType* a, const LChar* b, unsigned length)
+{
+    // Compare vectors of ASCII characters at once, and fall back to one character at
+    // a time for the vectors that are not all ASCII and for the tail.
+    const unsigned charactersPerStep = 16;
+    while (length) {
+        unsigned equalLength = equalIgnoringASCIICasePrefixLengthSIMD(a, b, length);
+        a += equalLength;
+        b += equalLength;
+        length -= equalLength;
+
+        unsigned stepLength = min(length, charactersPerStep);
+        for (unsigned i = 0; i < stepLength; ++i) {
+            CharacterType aCharacter = a[i];
+            LChar bCharacter = b[i];
+            if (!((aCharacter | bCharacter) & ~0x7F)) {
+                if (toASCIILower(aCharacter) != toASCIILower(bCharacter))
+                    return false;
+            } else if (foldCase(aCharacter) != foldCase(bCharacter))
+                return false;
+        }
+        a += stepLength;
+        b += stepLength;
+        length -= stepLength;
     }
     return true;
 }
 
+bool equalIgnoringCase(const LChar* a, const LChar* b, unsigned length)
+{
+    return equalIgnoringCaseWithSIMD(a, b, length);
+}
+
 bool equalIgnoringCase(const UChar* a, const LChar* b, unsigned length)
 {
-    while (length--) {
-        LChar bc = *b++;
-        if (foldCase(*a++) != foldCase(bc))
-            return false;
-    }
-    return true;
+    return equalIgnoringCaseWithSIMD(a, b, length);
 }
 
 size_t StringImpl::find(CharacterMatchFunctionPtr matchFunction, unsigned start)
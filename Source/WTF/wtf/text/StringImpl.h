@@ -29,6 +29,7 @@
 #include <wtf/StdLibExtras.h>
 #include <wtf/StringHasher.h>
 #include <wtf/Vector.h>
+#include <wtf/text/StringSIMD.h>
 #include <wtf/unicode/Unicode.h>
 
 #if PLATFORM(QT)
@@ -515,7 +516,7 @@ public:
         if (m_hashAndFlags & s_hashFlagDidReportCost)
             return 0;
 
-        m_hashAndFlags |= s_hashFlagDidReportCost;
+        setFlag(s_hashFlagDidReportCost);
         return m_length;
     }
 
@@ -550,9 +551,21 @@ public:
             m_hashAndFlags &= ~s_hashFlagIsAtomic;
     }
 
-#ifdef STRING_STATS
-    bool isSubString() const { return  bufferOwnership() == BufferSubstring; }
-#endif
+    // Strings in the thread-shared AtomicString table can be referenced from any thread.
+    // Their ref count is updated atomically, and they never report hasOneRef().
+    bool isThreadShared() const { return m_refCount & s_refCountFlagIsThreadShared; }
+    void setIsThreadShared()
+    {
+        ASSERT(!isStatic());
+        ASSERT(isAtomic());
+        ASSERT(!isSubString());
+        m_refCount |= s_refCountFlagIsThreadShared;
+    }
+    // Refs the string unless its last reference is already gone, in which case it is
+    // about to be removed from the table by the thread destroying it.
+    WTF_EXPORT_STRING_API bool tryRefThreadShared();
+
+    bool isSubString() const { return bufferOwnership() == BufferSubstring; }
 
 #if PLATFORM(QT)
     QStringData* qStringData() { return bufferOwnership() == BufferAdoptedQString ? m_qStringData : 0; }
@@ -607,11 +620,19 @@ public:
 
     inline void ref()
     {
+        if (UNLIKELY(isThreadShared())) {
+            refThreadShared();
+            return;
+        }
         m_refCount += s_refCountIncrement;
     }
 
     inline void deref()
     {
+        if (UNLIKELY(isThreadShared())) {
+            derefThreadShared();
+            return;
+        }
         unsigned tempRefCount = m_refCount - s_refCountIncrement;
         if (!tempRefCount) {
             StringImpl::destroy(this);
@@ -652,8 +673,7 @@ public:
 
     ALWAYS_INLINE static void copyChars(UChar* destination, const LChar* source, unsigned numCharacters)
     {
-        for (unsigned i = 0; i < numCharacters; ++i)
-            destination[i] = source[i];
+        copyLCharsToUChars(destination, source, numCharacters);
     }
 
     // Some string features, like refcounting and the atomicity flag, are not
@@ -784,10 +804,23 @@ private:
     template <typename CharType> static PassRefPtr<StringImpl> createInternal(const CharType*, unsigned);
     WTF_EXPORT_STRING_API NEVER_INLINE const UChar* getData16SlowCase() const;
     WTF_EXPORT_PRIVATE NEVER_INLINE unsigned hashSlowCase() const;
+    WTF_EXPORT_STRING_API NEVER_INLINE void refThreadShared();
+    WTF_EXPORT_STRING_API NEVER_INLINE void derefThreadShared();
+    void setFlag(unsigned flag) const
+    {
+        if (UNLIKELY(isThreadShared())) {
+            setFlagThreadShared(flag);
+            return;
+        }
+        m_hashAndFlags |= flag;
+    }
+    WTF_EXPORT_STRING_API NEVER_INLINE void setFlagThreadShared(unsigned) const;
 
-    // The bottom bit in the ref count indicates a static (immortal) string.
+    // The bottom bit in the ref count indicates a static (immortal) string, the next one
+    // a string in the thread-shared AtomicString table.
     static const unsigned s_refCountFlagIsStaticString = 0x1;
-    static const unsigned s_refCountIncrement = 0x2; // This allows us to ref / deref without disturbing the static string flag.
+    static const unsigned s_refCountFlagIsThreadShared = 0x2;
+    static const unsigned s_refCountIncrement = 0x4; // This allows us to ref / deref without disturbing the flags.
 
     // The bottom 8 bits in the hash are flags.
     static const unsigned s_flagCount = 8;
@@ -883,10 +916,14 @@ inline bool equal(const LChar* a, StringImpl* b) { return equal(b, a); }
 inline bool equal(const char* a, StringImpl* b) { return equal(b, reinterpret_cast<const LChar*>(a)); }
 WTF_EXPORT_STRING_API bool equalNonNull(const StringImpl* a, const StringImpl* b);
 
-// Do comparisons 8 or 4 bytes-at-a-time on architectures where it's safe.
+// Do comparisons 8 or 4 bytes-at-a-time on architectures where it's safe, after
+// comparing whole vectors first where SSE2 is available.
 #if CPU(X86_64)
 ALWAYS_INLINE bool equal(const LChar* a, const LChar* b, unsigned length)
 {
+    if (!equalVectorsSIMD(a, b, length))
+        return false;
+
     unsigned dwordLength = length >> 3;
 
     if (dwordLength) {
@@ -926,6 +963,9 @@ ALWAYS_INLINE bool equal(const LChar* a, const LChar* b, unsigned length)
 
 ALWAYS_INLINE bool equal(const UChar* a, const UChar* b, unsigned length)
 {
+    if (!equalVectorsSIMD(a, b, length))
+        return false;
+
     unsigned dwordLength = length >> 2;
     
     if (dwordLength) {
@@ -957,6 +997,9 @@ ALWAYS_INLINE bool equal(const UChar* a, const UChar* b, unsigned length)
 #elif CPU(X86)
 ALWAYS_INLINE bool equal(const LChar* a, const LChar* b, unsigned length)
 {
+    if (!equalVectorsSIMD(a, b, length))
+        return false;
+
     const uint32_t* aCharacters = reinterpret_cast<const uint32_t*>(a);
     const uint32_t* bCharacters = reinterpret_cast<const uint32_t*>(b);
 
@@ -983,6 +1026,9 @@ ALWAYS_INLINE bool equal(const LChar* a, const LChar* b, unsigned length)
 
 ALWAYS_INLINE bool equal(const UChar* a, const UChar* b, unsigned length)
 {
+    if (!equalVectorsSIMD(a, b, length))
+        return false;
+
     const uint32_t* aCharacters = reinterpret_cast<const uint32_t*>(a);
     const uint32_t* bCharacters = reinterpret_cast<const uint32_t*>(b);
     
@@ -1092,11 +1138,7 @@ ALWAYS_INLINE bool equal(const UChar* a, const UChar* b, unsigned length) { retu
 
 ALWAYS_INLINE bool equal(const LChar* a, const UChar* b, unsigned length)
 {
-    for (unsigned i = 0; i < length; ++i) {
-        if (a[i] != b[i])
-            return false;
-    }
-    return true;
+    return equalSIMD(a, b, length);
 }
 
 ALWAYS_INLINE bool equal(const UChar* a, const LChar* b, unsigned length) { return equal(b, a, length); }
@@ -1122,12 +1164,7 @@ WTF_EXPORT_STRING_API bool equalIgnoringNullity(StringImpl*, StringImpl*);
 template<typename CharacterType>
 inline size_t find(const CharacterType* characters, unsigned length, CharacterType matchCharacter, unsigned index = 0)
 {
-    while (index < length) {
-        if (characters[index] == matchCharacter)
-            return index;
-        ++index;
-    }
-    return notFound;
+    return findCharacterSIMD(characters, length, matchCharacter, index);
 }
 
 ALWAYS_INLINE size_t find(const UChar* characters, unsigned length, LChar matchCharacter, unsigned index = 0)
@@ -1340,6 +1377,10 @@ inline unsigned lengthOfNullTerminatedString(const CharacterType* string)
 
 inline PassRefPtr<StringImpl> StringImpl::isolatedCopy() const
 {
+    // Every thread can use strings from the thread-shared AtomicString table as they are.
+    if (isThreadShared())
+        return const_cast<StringImpl*>(this);
+
     if (!requiresCopy()) {
         if (is8Bit())
             return StringImpl::createWithoutCopying(m_data8, m_length, hasTerminatingNullCharacter() ? DoesHaveTerminatingNullCharacter : DoesNotHaveTerminatingNullCharacter);
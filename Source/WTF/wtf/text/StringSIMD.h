@@ -0,0 +1,373 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef StringSIMD_h
+#define StringSIMD_h
+
+#include <wtf/ASCIICType.h>
+#include <wtf/NotFound.h>
+#include <wtf/unicode/Unicode.h>
+
+#if CPU(X86_64) || (CPU(X86) && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#define STRING_SIMD_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define STRING_SIMD_USE_SSE2 0
+#endif
+
+// Kernels for the hot loops over string characters: searching, comparing, ASCII case
+// conversion and widening. With SSE2 they handle 16 bytes per step using unaligned
+// loads that never read past the end of the buffer; the last partial vector is done
+// one character at a time. Every function also has a plain loop for other CPUs, so
+// callers need no #if of their own.
+
+namespace WTF {
+
+#if STRING_SIMD_USE_SSE2
+
+template<typename CharacterType> struct SIMDCharacterTraits;
+
+template<> struct SIMDCharacterTraits<LChar> {
+    static const unsigned charactersPerVector = 16;
+
+    static __m128i splat(LChar character) { return _mm_set1_epi8(static_cast<char>(character)); }
+    static __m128i equalMask(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+
+    // All ones in the characters that lie in [first, first + 25]. Shifting the range
+    // down to the bottom of the signed range lets one signed compare do the test.
+    static __m128i letterMask(__m128i characters, LChar first)
+    {
+        __m128i shifted = _mm_add_epi8(characters, _mm_set1_epi8(static_cast<char>(0x80 - first)));
+        return _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + 26)));
+    }
+
+    static bool isAllASCII(__m128i characters) { return !_mm_movemask_epi8(characters); }
+    static __m128i caseBit() { return _mm_set1_epi8(0x20); }
+};
+
+template<> struct SIMDCharacterTraits<UChar> {
+    static const unsigned charactersPerVector = 8;
+
+    static __m128i splat(UChar character) { return _mm_set1_epi16(static_cast<short>(character)); }
+    static __m128i equalMask(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+
+    static __m128i letterMask(__m128i characters, UChar first)
+    {
+        __m128i shifted = _mm_add_epi16(characters, _mm_set1_epi16(static_cast<short>(0x8000 - first)));
+        return _mm_cmplt_epi16(shifted, _mm_set1_epi16(-32768 + 26));
+    }
+
+    static bool isAllASCII(__m128i characters)
+    {
+        __m128i nonASCIIBits = _mm_and_si128(characters, _mm_set1_epi16(static_cast<short>(0xFF80)));
+        return _mm_movemask_epi8(_mm_cmpeq_epi16(nonASCIIBits, _mm_setzero_si128())) == 0xFFFF;
+    }
+    static __m128i caseBit() { return _mm_set1_epi16(0x20); }
+};
+
+inline __m128i loadCharacters(const void* characters) { return _mm_loadu_si128(static_cast<const __m128i*>(characters)); }
+inline void storeCharacters(void* destination, __m128i characters) { _mm_storeu_si128(static_cast<__m128i*>(destination), characters); }
+
+// Strings shorter than a vector are common, so the kernels also take one step of half a
+// vector before falling back to single characters. The upper half is zero.
+inline __m128i loadHalfCharacters(const void* characters) { return _mm_loadl_epi64(static_cast<const __m128i*>(characters)); }
+inline void storeHalfCharacters(void* destination, __m128i characters) { _mm_storel_epi64(static_cast<__m128i*>(destination), characters); }
+
+inline unsigned indexOfLowestSetBit(unsigned mask)
+{
+    ASSERT(mask);
+#if COMPILER(GCC) || COMPILER(CLANG)
+    return __builtin_ctz(mask);
+#else
+    unsigned index = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+#endif // STRING_SIMD_USE_SSE2
+
+template<typename CharacterType>
+inline size_t findCharacterSIMD(const CharacterType* characters, unsigned length, CharacterType matchCharacter, unsigned index)
+{
+#if STRING_SIMD_USE_SSE2
+    typedef SIMDCharacterTraits<CharacterType> Traits;
+    if (index < length) {
+        __m128i match = Traits::splat(matchCharacter);
+        for (; length - index >= Traits::charactersPerVector; index += Traits::charactersPerVector) {
+            unsigned mask = _mm_movemask_epi8(Traits::equalMask(loadCharacters(characters + index), match));
+            if (mask)
+                return index + indexOfLowestSetBit(mask) / sizeof(CharacterType);
+        }
+        if (length - index >= Traits::charactersPerVector / 2) {
+            // Only the lower half holds characters.
+            unsigned mask = _mm_movemask_epi8(Traits::equalMask(loadHalfCharacters(characters + index), match)) & 0xFF;
+            if (mask)
+                return index + indexOfLowestSetBit(mask) / sizeof(CharacterType);
+            index += Traits::charactersPerVector / 2;
+        }
+    }
+#endif
+    for (; index < length; ++index) {
+        if (characters[index] == matchCharacter)
+            return index;
+    }
+    return notFound;
+}
+
+// Compares whole vectors and advances a, b and length past them. Returns false at the
+// first vector that differs; the caller compares what is left.
+template<typename CharacterType>
+ALWAYS_INLINE bool equalVectorsSIMD(const CharacterType*& a, const CharacterType*& b, unsigned& length)
+{
+#if STRING_SIMD_USE_SSE2
+    typedef SIMDCharacterTraits<CharacterType> Traits;
+    for (; length >= Traits::charactersPerVector; length -= Traits::charactersPerVector) {
+        if (_mm_movemask_epi8(Traits::equalMask(loadCharacters(a), loadCharacters(b))) != 0xFFFF)
+            return false;
+        a += Traits::charactersPerVector;
+        b += Traits::charactersPerVector;
+    }
+#else
+    UNUSED_PARAM(a);
+    UNUSED_PARAM(b);
+    UNUSED_PARAM(length);
+#endif
+    return true;
+}
+
+inline bool equalSIMD(const LChar* a, const UChar* b, unsigned length)
+{
+#if STRING_SIMD_USE_SSE2
+    __m128i zero = _mm_setzero_si128();
+    for (; length >= 16; length -= 16, a += 16, b += 16) {
+        __m128i latin1 = loadCharacters(a);
+        __m128i low = _mm_cmpeq_epi16(_mm_unpacklo_epi8(latin1, zero), loadCharacters(b));
+        __m128i high = _mm_cmpeq_epi16(_mm_unpackhi_epi8(latin1, zero), loadCharacters(b + 8));
+        if (_mm_movemask_epi8(_mm_and_si128(low, high)) != 0xFFFF)
+            return false;
+    }
+    if (length >= 8) {
+        __m128i widened = _mm_unpacklo_epi8(loadHalfCharacters(a), zero);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(widened, loadCharacters(b))) != 0xFFFF)
+            return false;
+        length -= 8;
+        a += 8;
+        b += 8;
+    }
+#endif
+    for (unsigned i = 0; i < length; ++i) {
+        if (a[i] != b[i])
+            return false;
+    }
+    return true;
+}
+
+inline void copyLCharsToUChars(UChar* destination, const LChar* source, unsigned length)
+{
+    unsigned i = 0;
+#if STRING_SIMD_USE_SSE2
+    __m128i zero = _mm_setzero_si128();
+    for (; length - i >= 16; i += 16) {
+        __m128i latin1 = loadCharacters(source + i);
+        storeCharacters(destination + i, _mm_unpacklo_epi8(latin1, zero));
+        storeCharacters(destination + i + 8, _mm_unpackhi_epi8(latin1, zero));
+    }
+    if (length - i >= 8) {
+        storeCharacters(destination + i, _mm_unpacklo_epi8(loadHalfCharacters(source + i), zero));
+        i += 8;
+    }
+#endif
+    for (; i < length; ++i)
+        destination[i] = source[i];
+}
+
+// Copies the ASCII bytes at the start of a UTF-8 or Latin-1 source, widening them if the
+// destination is 16-bit, and returns how many it copied. It only reads whole vectors, so
+// fewer than 16 bytes at the end are left to the caller, and it may write characters past
+// the ones it counts: the destination must have room for length characters. Other CPUs
+// copy nothing and leave it all to the caller's own loop.
+template<typename CharacterType>
+inline size_t copyASCIIPrefixSIMD(CharacterType* destination, const LChar* source, size_t length)
+{
+    size_t i = 0;
+#if STRING_SIMD_USE_SSE2
+    __m128i zero = _mm_setzero_si128();
+    for (; length - i >= 16; i += 16) {
+        __m128i vector = loadCharacters(source + i);
+        if (sizeof(CharacterType) == 1)
+            storeCharacters(destination + i, vector);
+        else {
+            storeCharacters(destination + i, _mm_unpacklo_epi8(vector, zero));
+            storeCharacters(destination + i + 8, _mm_unpackhi_epi8(vector, zero));
+        }
+        if (unsigned nonASCIIMask = _mm_movemask_epi8(vector))
+            return i + indexOfLowestSetBit(nonASCIIMask);
+    }
+#else
+    UNUSED_PARAM(destination);
+    UNUSED_PARAM(source);
+    UNUSED_PARAM(length);
+#endif
+    return i;
+}
+
+// Returns the index of the first character that is an ASCII uppercase letter or is not
+// ASCII, or length if there is none.
+template<typename CharacterType>
+inline unsigned findFirstASCIIUpperOrNonASCII(const CharacterType* characters, unsigned length)
+{
+    unsigned i = 0;
+#if STRING_SIMD_USE_SSE2
+    typedef SIMDCharacterTraits<CharacterType> Traits;
+    for (; length - i >= Traits::charactersPerVector; i += Traits::charactersPerVector) {
+        __m128i vector = loadCharacters(characters + i);
+        if (!Traits::isAllASCII(vector) || _mm_movemask_epi8(Traits::letterMask(vector, 'A')))
+            break;
+    }
+    if (length - i >= Traits::charactersPerVector / 2) {
+        __m128i vector = loadHalfCharacters(characters + i);
+        if (Traits::isAllASCII(vector) && !_mm_movemask_epi8(Traits::letterMask(vector, 'A')))
+            i += Traits::charactersPerVector / 2;
+    }
+#endif
+    for (; i < length; ++i) {
+        CharacterType character = characters[i];
+        if ((character & ~0x7F) || isASCIIUpper(character))
+            return i;
+    }
+    return length;
+}
+
+// Copies source to destination converting ASCII letters to the given case and leaving
+// everything else alone. Returns true if every character was ASCII.
+template<typename CharacterType>
+inline bool convertASCIICase(CharacterType* destination, const CharacterType* source, unsigned length, bool toUpper)
+{
+    unsigned i = 0;
+    unsigned ored = 0;
+#if STRING_SIMD_USE_SSE2
+    typedef SIMDCharacterTraits<CharacterType> Traits;
+    bool allASCII = true;
+    CharacterType firstLetter = toUpper ? 'a' : 'A';
+    for (; length - i >= Traits::charactersPerVector; i += Traits::charactersPerVector) {
+        __m128i vector = loadCharacters(source + i);
+        allASCII &= Traits::isAllASCII(vector);
+        // Flipping the case bit of a letter of the opposite case converts it.
+        __m128i flip = _mm_and_si128(Traits::letterMask(vector, firstLetter), Traits::caseBit());
+        storeCharacters(destination + i, _mm_xor_si128(vector, flip));
+    }
+    if (length - i >= Traits::charactersPerVector / 2) {
+        __m128i vector = loadHalfCharacters(source + i);
+        allASCII &= Traits::isAllASCII(vector);
+        __m128i flip = _mm_and_si128(Traits::letterMask(vector, firstLetter), Traits::caseBit());
+        storeHalfCharacters(destination + i, _mm_xor_si128(vector, flip));
+        i += Traits::charactersPerVector / 2;
+    }
+    if (!allASCII)
+        ored = 0x80;
+#endif
+    for (; i < length; ++i) {
+        CharacterType character = source[i];
+        ored |= character;
+#if CPU(X86) && defined(_MSC_VER) && _MSC_VER >=1700
+        // Workaround for an MSVC 2012 x86 optimizer bug. Remove once the bug is fixed.
+        // See https://connect.microsoft.com/VisualStudio/feedback/details/780362/optimization-bug-of-range-comparison
+        // for more details.
+        if (toUpper)
+            destination[i] = character >= 'a' && character <= 'z' ? character & ~0x20 : character;
+        else
+#else
+        if (toUpper)
+            destination[i] = toASCIIUpper(character);
+        else
+#endif
+            destination[i] = toASCIILower(character);
+    }
+    return !(ored & ~0x7F);
+}
+
+#if STRING_SIMD_USE_SSE2
+inline __m128i toASCIILowerSIMD(__m128i characters)
+{
+    typedef SIMDCharacterTraits<LChar> Traits;
+    return _mm_or_si128(characters, _mm_and_si128(Traits::letterMask(characters, 'A'), Traits::caseBit()));
+}
+
+inline bool equalIgnoringASCIICaseSIMD(__m128i a, __m128i b)
+{
+    typedef SIMDCharacterTraits<LChar> Traits;
+    if (!Traits::isAllASCII(_mm_or_si128(a, b)))
+        return false;
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(toASCIILowerSIMD(a), toASCIILowerSIMD(b))) == 0xFFFF;
+}
+#endif
+
+// Return how many leading characters are known to be equal ignoring ASCII case. They
+// stop early at a vector that differs or that contains a non-ASCII character, so the
+// caller has to look at the characters after the returned prefix itself.
+inline unsigned equalIgnoringASCIICasePrefixLengthSIMD(const LChar* a, const LChar* b, unsigned length)
+{
+    unsigned i = 0;
+#if STRING_SIMD_USE_SSE2
+    for (; length - i >= 16; i += 16) {
+        if (!equalIgnoringASCIICaseSIMD(loadCharacters(a + i), loadCharacters(b + i)))
+            break;
+    }
+#else
+    UNUSED_PARAM(a);
+    UNUSED_PARAM(b);
+    UNUSED_PARAM(length);
+#endif
+    return i;
+}
+
+inline unsigned equalIgnoringASCIICasePrefixLengthSIMD(const UChar* a, const LChar* b, unsigned length)
+{
+    unsigned i = 0;
+#if STRING_SIMD_USE_SSE2
+    for (; length - i >= 16; i += 16) {
+        __m128i low = loadCharacters(a + i);
+        __m128i high = loadCharacters(a + i + 8);
+        // Packing saturates as signed, so check for non-ASCII characters before it.
+        if (!SIMDCharacterTraits<UChar>::isAllASCII(_mm_or_si128(low, high)))
+            break;
+        if (!equalIgnoringASCIICaseSIMD(_mm_packus_epi16(low, high), loadCharacters(b + i)))
+            break;
+    }
+#else
+    UNUSED_PARAM(a);
+    UNUSED_PARAM(b);
+    UNUSED_PARAM(length);
+#endif
+    return i;
+}
+
+} // namespace WTF
+
+#endif // StringSIMD_h
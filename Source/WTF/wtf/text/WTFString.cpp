@@ -30,6 +30,7 @@
 #include <wtf/MathExtras.h>
 #include <wtf/NeverDestroyed.h>
 #include <wtf/text/CString.h>
+#include <wtf/text/StringBuffer.h>
 #include <wtf/StringExtras.h>
 #include <wtf/Vector.h>
 #include <wtf/dtoa.h>
@@ -698,9 +699,10 @@ bool String::isSafeToSendToAnotherThread() const
     if (!impl())
         return true;
     // AtomicStrings are not safe to send between threads as ~StringImpl()
-    // will try to remove them from the wrong AtomicStringTable.
+    // will try to remove them from the wrong AtomicStringTable, unless they
+    // come from the thread-shared one.
     if (impl()->isAtomic())
-        return false;
+        return impl()->isThreadShared();
     if (impl()->hasOneRef())
         return true;
     if (isEmpty())
@@ -930,12 +932,27 @@ String String::fromUTF8(const LChar* stringStart, size_t length)
     if (charactersAreAllASCII(stringStart, length))
         return StringImpl::create(stringStart, length);
 
+    // Most text that is not ASCII still fits in 8 bits, so decode into an 8-bit buffer and only
+    // switch to 16 bits at the first character that does not fit.
+    const char* stringCurrent = reinterpret_cast<const char*>(stringStart);
+    const char* stringEnd = reinterpret_cast<const char*>(stringStart + length);
+    StringBuffer<LChar> latin1Buffer(length);
+    LChar* latin1Current = latin1Buffer.characters();
+    ConversionResult latin1Result = convertUTF8ToLatin1(&stringCurrent, stringEnd, &latin1Current, latin1Current + length);
+    unsigned latin1Length = latin1Current - latin1Buffer.characters();
+    if (latin1Result == conversionOK) {
+        latin1Buffer.shrink(latin1Length);
+        return adopt(latin1Buffer);
+    }
+    if (latin1Result != sourceNotLatin1)
+        return String();
+
     Vector<UChar, 1024> buffer(length);
     UChar* bufferStart = buffer.data();
- 
-    UChar* bufferCurrent = bufferStart;
-    const char* stringCurrent = reinterpret_cast<const char*>(stringStart);
-    if (convertUTF8ToUTF16(&stringCurrent, reinterpret_cast<const char *>(stringStart + length), &bufferCurrent, bufferCurrent + buffer.size()) != conversionOK)
+    StringImpl::copyChars(bufferStart, latin1Buffer.characters(), latin1Length);
+
+    UChar* bufferCurrent = bufferStart + latin1Length;
+    if (convertUTF8ToUTF16(&stringCurrent, stringEnd, &bufferCurrent, bufferStart + buffer.size()) != conversionOK)
         return String();
 
     unsigned utf16Length = bufferCurrent - bufferStart;
@@ -28,7 +28,9 @@
 #include "UTF8.h"
 
 #include "ASCIICType.h"
+#include <algorithm>
 #include <wtf/StringHasher.h>
+#include <wtf/text/StringSIMD.h>
 #include <wtf/unicode/CharacterNames.h>
 
 namespace WTF {
@@ -303,6 +305,16 @@ ConversionResult convertUTF8ToUTF16(
     UChar* target = *targetStart;
     UChar orAllData = 0;
     while (source < sourceEnd) {
+        if (isASCII(*source) && target < targetEnd) {
+            // Fast path for runs of ASCII. Most UTF-8 text is mostly ASCII.
+            size_t asciiLength = copyASCIIPrefixSIMD(target, reinterpret_cast<const LChar*>(source), std::min<size_t>(sourceEnd - source, targetEnd - target));
+            if (asciiLength) {
+                source += asciiLength;
+                target += asciiLength;
+                continue;
+            }
+        }
+
         int utf8SequenceLength = inlineUTF8SequenceLength(*source);
         if (sourceEnd - source < utf8SequenceLength)  {
             result = sourceExhausted;
@@ -367,6 +379,51 @@ ConversionResult convertUTF8ToUTF16(
     return result;
 }
 
+ConversionResult convertUTF8ToLatin1(
+    const char** sourceStart, const char* sourceEnd, 
+    LChar** targetStart, LChar* targetEnd)
+{
+    ConversionResult result = conversionOK;
+    const char* source = *sourceStart;
+    LChar* target = *targetStart;
+    while (source < sourceEnd) {
+        if (target >= targetEnd) {
+            result = targetExhausted;
+            break;
+        }
+
+        if (isASCII(*source)) {
+            size_t asciiLength = copyASCIIPrefixSIMD(target, reinterpret_cast<const LChar*>(source), std::min<size_t>(sourceEnd - source, targetEnd - target));
+            if (asciiLength) {
+                source += asciiLength;
+                target += asciiLength;
+            } else
+                *target++ = *source++;
+            continue;
+        }
+
+        int utf8SequenceLength = inlineUTF8SequenceLengthNonASCII(*source);
+        if (sourceEnd - source < utf8SequenceLength)  {
+            result = sourceExhausted;
+            break;
+        }
+        if (!isLegalUTF8(reinterpret_cast<const unsigned char*>(source), utf8SequenceLength)) {
+            result = sourceIllegal;
+            break;
+        }
+
+        // Only two byte sequences starting with C2 or C3 encode characters up to U+00FF.
+        if (utf8SequenceLength != 2 || static_cast<unsigned char>(*source) > 0xC3) {
+            result = sourceNotLatin1;
+            break;
+        }
+        *target++ = static_cast<LChar>(readUTF8Sequence(source, utf8SequenceLength));
+    }
+    *sourceStart = source;
+    *targetStart = target;
+    return result;
+}
+
 unsigned calculateStringHashAndLengthFromUTF8MaskingTop8Bits(const char* data, const char* dataEnd, unsigned& dataLength, unsigned& utf16Length)
 {
     if (!data)
@@ -45,7 +45,8 @@ namespace Unicode {
             conversionOK,       // conversion successful
             sourceExhausted,    // partial character in source, but hit end
             targetExhausted,    // insuff. room in target for conversion
-            sourceIllegal       // source sequence is illegal/malformed
+            sourceIllegal,      // source sequence is illegal/malformed
+            sourceNotLatin1     // character above U+00FF, for a Latin-1 target
     } ConversionResult;
 
     // These conversion functions take a "strict" argument. When this
@@ -66,6 +67,14 @@ namespace Unicode {
                     const char** sourceStart, const char* sourceEnd, 
                     UChar** targetStart, UChar* targetEnd, bool* isSourceAllASCII = 0, bool strict = true);
 
+    // Decodes UTF-8 straight into 8-bit characters, for text that is likely to be Latin-1.
+    // Stops with sourceNotLatin1 at the first character above U+00FF, leaving the source at its
+    // first byte, so the caller can widen what it has and finish with convertUTF8ToUTF16.
+    // Illegal sequences stop the conversion just like they do in strict convertUTF8ToUTF16.
+    WTF_EXPORT_PRIVATE ConversionResult convertUTF8ToLatin1(
+                    const char** sourceStart, const char* sourceEnd, 
+                    LChar** targetStart, LChar* targetEnd);
+
     WTF_EXPORT_PRIVATE ConversionResult convertLatin1ToUTF8(
                     const LChar** sourceStart, const LChar* sourceEnd, 
                     char** targetStart, char* targetEnd);
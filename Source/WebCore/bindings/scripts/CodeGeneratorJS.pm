@@ -3687,36 +3687,35 @@ sub GenerateHashTable
 
     # Generate size data for compact' size hash table
 
-    my @table = ();
-    my @links = ();
-
-    my $compactSize = ceilingToPowerOf2($size * 2);
-
-    my $maxDepth = 0;
-    my $collisions = 0;
-    my $numEntries = $compactSize;
-
-    my $i = 0;
-    foreach (@{$keys}) {
-        my $depth = 0;
-        my $h = Hasher::GenerateHashValue($_) % $numEntries;
-
-        while (defined($table[$h])) {
-            if (defined($links[$h])) {
-                $h = $links[$h];
-                $depth++;
-            } else {
-                $collisions++;
-                $links[$h] = $compactSize;
-                $h = $compactSize;
-                $compactSize++;
+    my $numEntries = ceilingToPowerOf2($size * 2);
+
+    # The table is laid out at run time with the hash function StringHasher was built
+    # with, so leave room for the collisions of either one.
+    my $compactSize = $numEntries;
+    foreach my $hashFunction (\&Hasher::GenerateHashValue, \&Hasher::GeneratePolynomialHashValue) {
+        my @table = ();
+        my @links = ();
+        my $tableSize = $numEntries;
+
+        my $i = 0;
+        foreach (@{$keys}) {
+            my $h = $hashFunction->($_) % $numEntries;
+
+            while (defined($table[$h])) {
+                if (defined($links[$h])) {
+                    $h = $links[$h];
+                } else {
+                    $links[$h] = $tableSize;
+                    $h = $tableSize;
+                    $tableSize++;
+                }
             }
-        }
 
-        $table[$h] = $i;
+            $table[$h] = $i;
+            $i++;
+        }
 
-        $i++;
-        $maxDepth = $depth if ($depth > $maxDepth);
+        $compactSize = $tableSize if $tableSize > $compactSize;
     }
 
     # Start outputing the hashtables
@@ -3742,7 +3741,7 @@ sub GenerateHashTable
 
     # Dump the hash table
     push(@implContent, "\nstatic const HashTableValue $nameEntries\[\] =\n\{\n");
-    $i = 0;
+    my $i = 0;
     foreach my $key (@{$keys}) {
         my $conditional;
         my $targetType;
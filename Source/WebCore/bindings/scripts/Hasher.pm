@@ -90,4 +90,43 @@ sub GenerateHashValue
     return $hash;
 }
 
+# The low 32 bits of $a * $b, for 32-bit $a and $b. Multiplying by 16 bits of $b at a time
+# keeps every intermediate value exact.
+sub multiply32($$) {
+    my ($a, $b) = @_;
+    my $EXP2_32 = 4294967296;
+    my $low = ($a * ($b & 0xFFFF)) % $EXP2_32;
+    my $high = (($a * ($b >> 16)) % 65536) * 65536;
+    return ($low + $high) % $EXP2_32;
+}
+
+# The polynomial hash StringHasher uses when USE(POLYNOMIAL_STRING_HASH) is set.
+sub GeneratePolynomialHashValue
+{
+    my @chars = split(/ */, $_[0]);
+
+    my $hash = 0x9e3779b9;
+    foreach my $char (@chars) {
+        $hash = (multiply32($hash, 0x9e3779b1) + ord($char)) % 4294967296;
+    }
+
+    # MurmurHash3's finalizer
+    $hash ^= $hash >> 16;
+    $hash = multiply32($hash, 0x85ebca6b);
+    $hash ^= $hash >> 13;
+    $hash = multiply32($hash, 0xc2b2ae35);
+    $hash ^= $hash >> 16;
+
+    # Save 8 bits for StringImpl to use as flags.
+    $hash &= 0xffffff;
+
+    # This avoids ever returning a hash code of 0, since that is used to
+    # signal "hash not computed yet". Setting the high bit maintains
+    # reasonable fidelity to a hash code of 0 because it is likely to yield
+    # exactly 0 when hash lookup masks out the high bits.
+    $hash = (0x80000000 >> 8) if ($hash == 0);
+
+    return $hash;
+}
+
 1;
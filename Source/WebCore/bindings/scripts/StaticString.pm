@@ -42,13 +42,18 @@ sub GenerateStrings($)
     while ( my ($name, $value) = each %strings ) {
         my $length = length($value);
         my $hash = Hasher::GenerateHashValue($value);
+        my $polynomialHash = Hasher::GeneratePolynomialHashValue($value);
         push(@result, <<END);
 static StringImpl::StaticASCIILiteral ${name}Data = {
     StringImpl::StaticASCIILiteral::s_initialRefCount,
     $length,
     ${name}String8,
     0,
+#if USE(POLYNOMIAL_STRING_HASH)
+    StringImpl::StaticASCIILiteral::s_initialFlags | (${polynomialHash} << StringImpl::StaticASCIILiteral::s_hashShift)
+#else
     StringImpl::StaticASCIILiteral::s_initialFlags | (${hash} << StringImpl::StaticASCIILiteral::s_hashShift)
+#endif
 };
 END
     }
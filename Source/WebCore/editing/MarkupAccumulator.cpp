@@ -103,6 +103,7 @@ void MarkupAccumulator::appendCharactersReplacingEntities(StringBuilder& result,
 MarkupAccumulator::MarkupAccumulator(Vector<Node*>* nodes, EAbsoluteURLs resolveUrlsMethod, const Range* range, EFragmentSerialization fragmentSerialization)
     : m_nodes(nodes)
     , m_range(range)
+    , m_markup(StringBuilder::Chunked)
     , m_resolveURLsMethod(resolveUrlsMethod)
     , m_fragmentSerialization(fragmentSerialization)
 {
@@ -43,6 +43,23 @@ MemoryPressureHandler::MemoryPressureHandler()
 {
 }
 
+void MemoryPressureHandler::fastMallocSizeClassStatistics(Vector<WTF::FastMallocSizeClassStatistics>& statistics)
+{
+    statistics.resize(WTF::fastMallocSizeClassStatistics(0, 0));
+    statistics.shrink(WTF::fastMallocSizeClassStatistics(statistics.data(), statistics.size()));
+}
+
+void MemoryPressureHandler::fastMallocThreadCacheStatistics(Vector<WTF::FastMallocThreadCacheStatistics>& statistics)
+{
+    // Threads can come and go between the calls, so retry until the buffer was large enough.
+    size_t count = WTF::fastMallocThreadCacheStatistics(0, 0);
+    do {
+        statistics.resize(count);
+        count = WTF::fastMallocThreadCacheStatistics(statistics.data(), statistics.size());
+    } while (count > statistics.size());
+    statistics.shrink(count);
+}
+
 #if !PLATFORM(MAC) || PLATFORM(IOS) || __MAC_OS_X_VERSION_MIN_REQUIRED == 1060
 
 void MemoryPressureHandler::install() { }
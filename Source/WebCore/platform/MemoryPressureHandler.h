@@ -28,6 +28,8 @@
 
 #include <time.h>
 #include <wtf/FastAllocBase.h>
+#include <wtf/FastMalloc.h>
+#include <wtf/Vector.h>
 
 namespace WebCore {
 
@@ -46,6 +48,10 @@ public:
         m_lowMemoryHandler = handler;
     }
 
+    // Where FastMalloc's free memory sits, for deciding how much releaseMemory() can give back.
+    static void fastMallocSizeClassStatistics(Vector<WTF::FastMallocSizeClassStatistics>&);
+    static void fastMallocThreadCacheStatistics(Vector<WTF::FastMallocThreadCacheStatistics>&);
+
 private:
     void uninstall();
 
@@ -29,6 +29,7 @@
 #include "TextCodecASCIIFastPath.h"
 #include <wtf/text/CString.h>
 #include <wtf/text/StringBuffer.h>
+#include <wtf/text/StringSIMD.h>
 #include <wtf/unicode/CharacterNames.h>
 
 using namespace WTF;
@@ -292,7 +293,13 @@ String TextCodecUTF8::decode(const char* bytes, size_t length, bool flush, bool
 
         while (source < end) {
             if (isASCII(*source)) {
-                // Fast path for ASCII. Most UTF-8 text will be ASCII.
+                // Fast path for ASCII. Most UTF-8 text will be ASCII. Each byte turns into at
+                // most one character, so the buffer has room for all the bytes that are left.
+                if (size_t asciiLength = copyASCIIPrefixSIMD(destination, source, end - source)) {
+                    source += asciiLength;
+                    destination += asciiLength;
+                    continue;
+                }
                 if (isAlignedToMachineWord(source)) {
                     while (source < alignedEnd) {
                         MachineWord chunk = *reinterpret_cast_ptr<const MachineWord*>(source);
@@ -369,7 +376,13 @@ upConvertTo16Bit:
         
         while (source < end) {
             if (isASCII(*source)) {
-                // Fast path for ASCII. Most UTF-8 text will be ASCII.
+                // Fast path for ASCII. Most UTF-8 text will be ASCII. Each byte turns into at
+                // most one character, so the buffer has room for all the bytes that are left.
+                if (size_t asciiLength = copyASCIIPrefixSIMD(destination16, source, end - source)) {
+                    source += asciiLength;
+                    destination16 += asciiLength;
+                    continue;
+                }
                 if (isAlignedToMachineWord(source)) {
                     while (source < alignedEnd) {
                         MachineWord chunk = *reinterpret_cast_ptr<const MachineWord*>(source);
@@ -25,7 +25,10 @@
 
 #include "config.h"
 
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
 #include <wtf/text/AtomicString.h>
+#include <wtf/text/StringBuilder.h>
 
 namespace TestWebKitAPI {
 
@@ -56,4 +59,96 @@ TEST(WTF, AtomicStringCreationFromLiteralUniqueness)
     ASSERT_EQ(string1.impl(), string3.impl());
 }
 
+#if ENABLE(COMPARE_AND_SWAP)
+
+static const unsigned numberOfThreads = 4;
+static const unsigned numberOfNames = 500;
+
+static String nameForIndex(unsigned index)
+{
+    StringBuilder builder;
+    builder.appendLiteral("name");
+    builder.appendNumber(index);
+    if (index % 3)
+        builder.append(static_cast<UChar>(0x2603));
+    return builder.toString();
+}
+
+struct AtomizeNames {
+    Vector<String> names;
+    Vector<AtomicString> atoms;
+};
+
+static void atomizeNames(void* context)
+{
+    AtomizeNames* atomizeNames = static_cast<AtomizeNames*>(context);
+    for (unsigned round = 0; round < 20; ++round) {
+        // Threads keep dropping the last reference to strings that other threads look up.
+        for (unsigned i = 0; i < numberOfNames; ++i) {
+            AtomicString temporary(atomizeNames->names[i]);
+            AtomicString fromCharacters(atomizeNames->names[i].characters(), atomizeNames->names[i].length());
+            EXPECT_EQ(temporary.impl(), fromCharacters.impl());
+        }
+    }
+    for (unsigned i = 0; i < numberOfNames; ++i)
+        atomizeNames->atoms.append(AtomicString(atomizeNames->names[i]));
+}
+
+TEST(WTF, AtomicStringThreadSharedTable)
+{
+    WTF::initializeThreading();
+    // The test thread keeps its own table if it already has atomic strings, threads
+    // started from now on use the shared one.
+    AtomicString::enableThreadSharedTable();
+
+    AtomizeNames threads[numberOfThreads];
+    ThreadIdentifier threadIdentifiers[numberOfThreads];
+    for (unsigned i = 0; i < numberOfThreads; ++i) {
+        for (unsigned j = 0; j < numberOfNames; ++j)
+            threads[i].names.append(nameForIndex(j));
+        threadIdentifiers[i] = createThread(atomizeNames, &threads[i], "AtomicString test");
+    }
+    for (unsigned i = 0; i < numberOfThreads; ++i)
+        waitForThreadCompletion(threadIdentifiers[i]);
+
+    for (unsigned i = 0; i < numberOfNames; ++i) {
+        AtomicStringImpl* impl = threads[0].atoms[i].impl();
+        ASSERT_TRUE(impl->isThreadShared());
+        ASSERT_TRUE(threads[0].atoms[i] == threads[0].names[i]);
+        for (unsigned j = 1; j < numberOfThreads; ++j)
+            ASSERT_EQ(impl, threads[j].atoms[i].impl());
+
+        // The strings can be used on this thread as they are.
+        ASSERT_EQ(impl, AtomicString(threads[0].atoms[i].string()).impl());
+        ASSERT_TRUE(threads[0].atoms[i].string().isSafeToSendToAnotherThread());
+        ASSERT_EQ(impl, threads[0].atoms[i].string().isolatedCopy().impl());
+    }
+}
+
+static void atomizeSubstring(void* context)
+{
+    AtomicString* result = static_cast<AtomicString*>(context);
+    String base("prefix-attribute-name-that-is-long-suffix");
+    *result = AtomicString(base.impl(), 7, 27);
+
+    // Substrings that become atomic in the shared table must not refer to their base.
+    String substring = StringImpl::create(base.impl(), 7, 27);
+    EXPECT_TRUE(substring.impl()->isSubString());
+    EXPECT_EQ(result->impl(), AtomicString(substring).impl());
+}
+
+TEST(WTF, AtomicStringThreadSharedTableSubstring)
+{
+    WTF::initializeThreading();
+    AtomicString::enableThreadSharedTable();
+
+    AtomicString substring;
+    waitForThreadCompletion(createThread(atomizeSubstring, &substring, "AtomicString test"));
+    ASSERT_TRUE(substring == "attribute-name-that-is-long");
+    ASSERT_TRUE(substring.impl()->isThreadShared());
+    ASSERT_FALSE(substring.impl()->isSubString());
+}
+
+#endif // ENABLE(COMPARE_AND_SWAP)
+
 } // namespace TestWebKitAPI
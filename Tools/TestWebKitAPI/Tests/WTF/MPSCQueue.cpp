@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include <wtf/CurrentTime.h>
+#include <wtf/MPSCQueue.h>
+#include <wtf/MessageQueue.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+namespace TestWebKitAPI {
+
+static const unsigned producerCount = 4;
+static const unsigned itemsPerProducer = 20000;
+
+TEST(WTF_MPSCQueue, FIFOOrder)
+{
+    MPSCQueue<unsigned> queue;
+    EXPECT_TRUE(queue.isEmpty());
+
+    EXPECT_TRUE(queue.enqueue(0));
+    for (unsigned i = 1; i < 100; ++i)
+        EXPECT_FALSE(queue.enqueue(i));
+    EXPECT_FALSE(queue.isEmpty());
+
+    Vector<unsigned> items;
+    EXPECT_EQ(100u, queue.dequeueAll(items));
+    EXPECT_TRUE(queue.isEmpty());
+    ASSERT_EQ(100u, items.size());
+    for (unsigned i = 0; i < 100; ++i)
+        EXPECT_EQ(i, items[i]);
+
+    EXPECT_EQ(0u, queue.dequeueAll(items));
+    EXPECT_TRUE(queue.enqueue(100));
+}
+
+TEST(WTF_MPSCQueue, WaitTimesOut)
+{
+    MPSCQueue<unsigned> queue;
+    EXPECT_FALSE(queue.waitForItems(currentTime() + 0.01));
+
+    queue.enqueue(1);
+    EXPECT_TRUE(queue.waitForItems(currentTime() + 0.01));
+}
+
+struct ProducerData {
+    MPSCQueue<unsigned>* queue;
+    unsigned producer;
+};
+
+static void produce(void* context)
+{
+    ProducerData* data = static_cast<ProducerData*>(context);
+    for (unsigned i = 0; i < itemsPerProducer; ++i)
+        data->queue->enqueue(data->producer * itemsPerProducer + i);
+}
+
+TEST(WTF_MPSCQueue, MultipleProducers)
+{
+    WTF::initializeThreading();
+
+    MPSCQueue<unsigned> queue;
+    ProducerData data[producerCount];
+    ThreadIdentifier threads[producerCount];
+    for (unsigned i = 0; i < producerCount; ++i) {
+        data[i].queue = &queue;
+        data[i].producer = i;
+        threads[i] = createThread(produce, &data[i], "MPSCQueue producer");
+    }
+
+    Vector<unsigned> items;
+    while (items.size() < producerCount * itemsPerProducer) {
+        if (queue.waitForItems(currentTime() + 10))
+            queue.dequeueAll(items);
+        else
+            break;
+    }
+
+    for (unsigned i = 0; i < producerCount; ++i)
+        waitForThreadCompletion(threads[i]);
+
+    ASSERT_EQ(producerCount * itemsPerProducer, items.size());
+    // Items from one producer must come out in the order they went in.
+    unsigned next[producerCount] = { 0 };
+    for (size_t i = 0; i < items.size(); ++i) {
+        unsigned producer = items[i] / itemsPerProducer;
+        ASSERT_LT(producer, producerCount);
+        EXPECT_EQ(next[producer], items[i] % itemsPerProducer);
+        next[producer] = items[i] % itemsPerProducer + 1;
+    }
+}
+
+struct IsTwo {
+    bool operator()(unsigned* value) { return *value == 2; }
+};
+
+TEST(WTF_MessageQueue, AppendPrependAndRemove)
+{
+    MessageQueue<unsigned> queue;
+    queue.append(adoptPtr(new unsigned(1)));
+    queue.append(adoptPtr(new unsigned(2)));
+    queue.prepend(adoptPtr(new unsigned(0)));
+    queue.append(adoptPtr(new unsigned(3)));
+
+    IsTwo isTwo;
+    queue.removeIf(isTwo);
+
+    EXPECT_EQ(0u, *queue.tryGetMessage());
+    EXPECT_EQ(1u, *queue.tryGetMessage());
+    EXPECT_EQ(3u, *queue.tryGetMessage());
+    EXPECT_FALSE(queue.tryGetMessage());
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+static void killQueue(void* context)
+{
+    static_cast<MessageQueue<unsigned>*>(context)->kill();
+}
+
+TEST(WTF_MessageQueue, KillWakesWaiter)
+{
+    WTF::initializeThreading();
+
+    MessageQueue<unsigned> queue;
+    ThreadIdentifier thread = createThread(killQueue, &queue, "MessageQueue killer");
+    EXPECT_FALSE(queue.waitForMessage());
+    EXPECT_TRUE(queue.killed());
+    waitForThreadCompletion(thread);
+}
+
+static void appendMessages(void* context)
+{
+    MessageQueue<unsigned>* queue = static_cast<MessageQueue<unsigned>*>(context);
+    for (unsigned i = 0; i < itemsPerProducer; ++i)
+        queue->append(adoptPtr(new unsigned(i)));
+}
+
+TEST(WTF_MessageQueue, WaitForMessagesFromAnotherThread)
+{
+    WTF::initializeThreading();
+
+    MessageQueue<unsigned> queue;
+    ThreadIdentifier thread = createThread(appendMessages, &queue, "MessageQueue producer");
+    for (unsigned i = 0; i < itemsPerProducer; ++i) {
+        OwnPtr<unsigned> message = queue.waitForMessage();
+        ASSERT_TRUE(message);
+        EXPECT_EQ(i, *message);
+    }
+    waitForThreadCompletion(thread);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+} // namespace TestWebKitAPI
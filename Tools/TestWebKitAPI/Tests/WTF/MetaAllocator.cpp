@@ -950,4 +950,35 @@ TEST_F(MetaAllocatorTest, DemandAllocDontCoalescePageThenDoubleHeap)
     testDemandAllocDontCoalesce(pageSize(), defaultPagesInHeap, defaultPagesInHeap * pageSize());
 }
 
+TEST_F(MetaAllocatorTest, FragmentationStatistics)
+{
+    // Tests that freeing a block between two live ones leaves a hole that is
+    // counted as its own free chunk, and that the chunks coalesce again once
+    // the neighbors are freed.
+    
+    MetaAllocator::Statistics statistics = allocator->currentStatistics();
+    EXPECT_EQ(statistics.numberOfFreeChunks, 1u);
+    EXPECT_EQ(statistics.largestFreeChunkSize, defaultPagesInHeap * pageSize());
+    
+    MetaAllocatorHandle* first = allocate(32);
+    MetaAllocatorHandle* second = allocate(32);
+    MetaAllocatorHandle* third = allocate(32);
+    EXPECT_EQ(second->start(), first->end());
+    EXPECT_EQ(third->start(), second->end());
+    
+    free(second);
+    statistics = allocator->currentStatistics();
+    EXPECT_EQ(statistics.numberOfFreeChunks, 2u);
+    EXPECT_EQ(statistics.largestFreeChunkSize, defaultPagesInHeap * pageSize() - 96);
+    
+    free(first);
+    statistics = allocator->currentStatistics();
+    EXPECT_EQ(statistics.numberOfFreeChunks, 2u);
+    
+    free(third);
+    statistics = allocator->currentStatistics();
+    EXPECT_EQ(statistics.numberOfFreeChunks, 1u);
+    EXPECT_EQ(statistics.largestFreeChunkSize, defaultPagesInHeap * pageSize());
+}
+
 } // namespace TestWebKitAPI
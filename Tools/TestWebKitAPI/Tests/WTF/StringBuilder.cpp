@@ -332,4 +332,136 @@ TEST(StringBuilderTest, ToAtomicStringOnEmpty)
     }
 }
 
+static String repeatedString(const char* pattern, unsigned length)
+{
+    StringBuilder builder;
+    while (builder.length() < length)
+        builder.append(pattern);
+    builder.resize(length);
+    return builder.toString();
+}
+
+TEST(StringBuilderTest, ChunkedAppend)
+{
+    StringBuilder builder(StringBuilder::Chunked);
+    StringBuilder expected;
+    for (unsigned i = 0; i < 3000; ++i) {
+        builder.appendLiteral("0123456789");
+        builder.appendNumber(i);
+        expected.appendLiteral("0123456789");
+        expected.appendNumber(i);
+    }
+    EXPECT_EQ(expected.length(), builder.length());
+    EXPECT_GT(builder.numberOfChunks(), 1U);
+    EXPECT_TRUE(builder.is8Bit());
+    EXPECT_EQ(expected[10000], builder[10000]);
+    EXPECT_EQ(expected[builder.length() - 1], builder[builder.length() - 1]);
+
+    StringBuilder concatenated;
+    for (unsigned i = 0; i < builder.numberOfChunks(); ++i)
+        concatenated.append(builder.chunk(i));
+    EXPECT_EQ(expected.toString(), concatenated.toString());
+
+    EXPECT_EQ(expected.toString(), builder.toString());
+    EXPECT_EQ(1U, builder.numberOfChunks());
+
+    // Short strings stay in one buffer.
+    StringBuilder shortBuilder(StringBuilder::Chunked);
+    String abc = repeatedString("abc", 3000);
+    shortBuilder.append("0123456789");
+    shortBuilder.append(abc.characters8(), abc.length());
+    EXPECT_EQ(1U, shortBuilder.numberOfChunks());
+    EXPECT_EQ(10 + abc.length(), shortBuilder.length());
+    EXPECT_EQ(abc, shortBuilder.toString().substring(10));
+}
+
+TEST(StringBuilderTest, ChunkedAdoptsLongStrings)
+{
+    String longString = repeatedString("abcdefgh", 5000);
+    StringBuilder builder(StringBuilder::Chunked);
+    builder.appendLiteral("<");
+    builder.append(longString);
+    builder.appendLiteral(">");
+    EXPECT_EQ(3U, builder.numberOfChunks());
+    EXPECT_EQ(longString.impl(), builder.chunk(1).impl());
+    EXPECT_EQ(5002U, builder.length());
+    EXPECT_EQ('a', builder[1]);
+    EXPECT_EQ('>', builder[5001]);
+
+    StringBuilder other;
+    other.append(builder);
+    EXPECT_EQ(builder.toString(), other.toString());
+    EXPECT_EQ(longString, builder.toString().substring(1, 5000));
+    EXPECT_EQ('<', builder[0]);
+}
+
+TEST(StringBuilderTest, ChunkedUpconvert)
+{
+    String latin1 = repeatedString("abcdefgh", 6000);
+    UChar snowman = 0x2603;
+    StringBuilder builder(StringBuilder::Chunked);
+    builder.append(latin1.characters8(), latin1.length());
+    builder.append(&snowman, 1);
+    builder.append(latin1.characters8(), 10);
+    EXPECT_FALSE(builder.is8Bit());
+    EXPECT_GT(builder.numberOfChunks(), 1U);
+    EXPECT_TRUE(builder.chunk(0).is8Bit());
+    EXPECT_EQ(snowman, builder[6000]);
+    EXPECT_EQ('b', builder[6002]);
+
+    String result = builder.toString();
+    EXPECT_FALSE(result.is8Bit());
+    EXPECT_EQ(latin1, result.substring(0, 6000));
+    EXPECT_EQ(snowman, result[6000]);
+    EXPECT_EQ(latin1.substring(0, 10), result.substring(6001));
+}
+
+TEST(StringBuilderTest, ChunkedResize)
+{
+    String expected = repeatedString("0123456789", 20000);
+    StringBuilder builder(StringBuilder::Chunked);
+    for (unsigned i = 0; i < 2000; ++i)
+        builder.appendLiteral("0123456789");
+    ASSERT_GT(builder.numberOfChunks(), 2U);
+
+    // Within the last chunk, then back into an earlier one.
+    builder.resize(19995);
+    EXPECT_EQ(19995U, builder.length());
+    EXPECT_EQ('4', builder[19994]);
+    builder.resize(5003);
+    EXPECT_EQ(5003U, builder.length());
+    EXPECT_EQ('2', builder[5002]);
+    builder.appendLiteral("x");
+    EXPECT_EQ(expected.substring(0, 5003), builder.toString().substring(0, 5003));
+    EXPECT_EQ(String("x"), builder.toString().substring(5003));
+
+    builder.resize(0);
+    expectEmpty(builder);
+    builder.appendLiteral("abc");
+    expectBuilderContent("abc", builder);
+}
+
+TEST(StringBuilderTest, ChunkedReserveCapacity)
+{
+    String part = repeatedString("abcdefgh", 1000);
+    StringBuilder builder(StringBuilder::Chunked);
+    builder.reserveCapacity(part.length() * 8);
+    for (unsigned i = 0; i < 8; ++i)
+        builder.append(part.characters8(), part.length());
+    EXPECT_EQ(1U, builder.numberOfChunks());
+    EXPECT_EQ(part.length() * 8, builder.capacity());
+
+    // Once past the first buffer, a reservation still keeps what follows in one chunk.
+    builder.append(part.characters8(), 10);
+    unsigned numberOfChunks = builder.numberOfChunks();
+    builder.reserveCapacity(builder.length() + part.length() * 10);
+    for (unsigned i = 0; i < 10; ++i)
+        builder.append(part.characters8(), part.length());
+    EXPECT_EQ(numberOfChunks + 1, builder.numberOfChunks());
+
+    AtomicString atomicString = builder.toAtomicString();
+    EXPECT_EQ(part.length() * 18 + 10, atomicString.length());
+    EXPECT_EQ(1U, builder.numberOfChunks());
+}
+
 } // namespace
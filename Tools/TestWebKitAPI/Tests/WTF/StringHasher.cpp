@@ -32,13 +32,34 @@ namespace TestWebKitAPI {
 static const LChar nullLChars[2] = { 0, 0 };
 static const UChar nullUChars[2] = { 0, 0 };
 
-static const unsigned emptyStringHash = 0x4EC889EU;
-static const unsigned singleNullCharacterHash = 0x3D3ABF44U;
-
 static const LChar testALChars[6] = { 0x41, 0x95, 0xFF, 0x50, 0x01, 0 };
 static const UChar testAUChars[6] = { 0x41, 0x95, 0xFF, 0x50, 0x01, 0 };
 static const UChar testBUChars[6] = { 0x41, 0x95, 0xFFFF, 0x1080, 0x01, 0 };
 
+// Long enough to go through the 16 and 8 character blocks of the vectorized hash.
+static const char longIdentifier[] = "HTMLDocumentParser::pumpTokenizerIfPossible";
+
+#if USE(POLYNOMIAL_STRING_HASH)
+static const unsigned emptyStringHash = 0x92CA2F0EU;
+static const unsigned singleNullCharacterHash = 0x8B862025U;
+
+static const unsigned testAHash1 = 0x6423F261;
+static const unsigned testAHash2 = 0xBE90EAF0;
+static const unsigned testAHash3 = 0xA92B94E9;
+static const unsigned testAHash4 = 0xF7DDA02F;
+static const unsigned testAHash5 = 0xF30A4AFC;
+
+static const unsigned testBHash1 = 0x6423F261;
+static const unsigned testBHash2 = 0xBE90EAF0;
+static const unsigned testBHash3 = 0x064C81CB;
+static const unsigned testBHash4 = 0xB402C101;
+static const unsigned testBHash5 = 0x55BEC2A8;
+
+static const unsigned longIdentifierHash = 0xFA5201E0;
+#else
+static const unsigned emptyStringHash = 0x4EC889EU;
+static const unsigned singleNullCharacterHash = 0x3D3ABF44U;
+
 static const unsigned testAHash1 = 0xEA32B004;
 static const unsigned testAHash2 = 0x93F0F71E;
 static const unsigned testAHash3 = 0xCB609EB1;
@@ -51,6 +72,9 @@ static const unsigned testBHash3 = 0x59EB1B2C;
 static const unsigned testBHash4 = 0xA7BCCC0A;
 static const unsigned testBHash5 = 0x79201649;
 
+static const unsigned longIdentifierHash = 0x7186F3B7;
+#endif
+
 TEST(WTF, StringHasher)
 {
     StringHasher hasher;
@@ -441,4 +465,52 @@ TEST(WTF, StringHasher_hashMemory)
     ASSERT_EQ(testBHash5 & 0xFFFFFF, StringHasher::hashMemory<10>(testBUChars));
 }
 
+TEST(WTF, StringHasher_longStrings)
+{
+    unsigned length = sizeof(longIdentifier) - 1;
+    LChar lchars[sizeof(longIdentifier)];
+    UChar uchars[sizeof(longIdentifier)];
+    for (unsigned i = 0; i <= length; ++i) {
+        lchars[i] = longIdentifier[i];
+        uchars[i] = longIdentifier[i];
+    }
+
+    ASSERT_EQ(longIdentifierHash, StringHasher::computeHash(lchars, length));
+    ASSERT_EQ(longIdentifierHash, StringHasher::computeHash(uchars, length));
+    ASSERT_EQ(longIdentifierHash, StringHasher::computeHash(lchars));
+    ASSERT_EQ(longIdentifierHash, StringHasher::computeHash(uchars));
+    ASSERT_EQ(longIdentifierHash & 0xFFFFFF, StringHasher::computeHashAndMaskTop8Bits(lchars, length));
+    ASSERT_EQ(longIdentifierHash & 0xFFFFFF, StringHasher::computeHashAndMaskTop8Bits(uchars, length));
+}
+
+TEST(WTF, StringHasher_blocksMatchSingleCharacters)
+{
+    // Every length up to a few blocks, with characters that use all 16 bits, hashed in one
+    // call and one character at a time. The 8-bit string has the same low bytes.
+    static const unsigned maxLength = 80;
+    LChar lchars[maxLength];
+    UChar uchars[maxLength];
+    for (unsigned i = 0; i < maxLength; ++i) {
+        uchars[i] = static_cast<UChar>(0xFFFF - i * 0x0F0F);
+        lchars[i] = static_cast<LChar>(uchars[i]);
+    }
+
+    for (unsigned length = 0; length <= maxLength; ++length) {
+        StringHasher uCharHasher;
+        StringHasher lCharHasher;
+        for (unsigned i = 0; i < length; ++i) {
+            uCharHasher.addCharacter(uchars[i]);
+            lCharHasher.addCharacter(lchars[i]);
+        }
+        ASSERT_EQ(uCharHasher.hash(), StringHasher::computeHash(uchars, length));
+        ASSERT_EQ(lCharHasher.hash(), StringHasher::computeHash(lchars, length));
+
+        // Splitting the characters between calls at any point gives the same hash.
+        StringHasher splitHasher;
+        splitHasher.addCharacters(uchars, length / 3);
+        splitHasher.addCharacters(uchars + length / 3, length - length / 3);
+        ASSERT_EQ(uCharHasher.hash(), splitHasher.hash());
+    }
+}
+
 } // namespace TestWebKitAPI
@@ -93,7 +93,8 @@ TEST(WTF, StringImplReplaceWithLiteral)
     ASSERT_TRUE(equal(testStringImpl.get(), "15555554"));
 
     // Cases for 16Bit source.
-    String testString = String::fromUTF8("résumé");
+    static const UChar resume[] = { 'r', 0x00E9, 's', 'u', 'm', 0x00E9 };
+    String testString(resume, WTF_ARRAY_LENGTH(resume));
     ASSERT_FALSE(testString.impl()->is8Bit());
 
     testStringImpl = testString.impl()->replace('2', "NotFound", 8);
@@ -102,15 +103,151 @@ TEST(WTF, StringImplReplaceWithLiteral)
     testStringImpl = testString.impl()->replace(UChar(0x00E9 /*U+00E9 is 'é'*/), "e", 1);
     ASSERT_TRUE(equal(testStringImpl.get(), "resume"));
 
-    testString = String::fromUTF8("résumé");
+    testString = String(resume, WTF_ARRAY_LENGTH(resume));
     ASSERT_FALSE(testString.impl()->is8Bit());
     testStringImpl = testString.impl()->replace(UChar(0x00E9 /*U+00E9 is 'é'*/), "", 0);
     ASSERT_TRUE(equal(testStringImpl.get(), "rsum"));
 
-    testString = String::fromUTF8("résumé");
+    testString = String(resume, WTF_ARRAY_LENGTH(resume));
     ASSERT_FALSE(testString.impl()->is8Bit());
     testStringImpl = testString.impl()->replace(UChar(0x00E9 /*U+00E9 is 'é'*/), "555", 3);
     ASSERT_TRUE(equal(testStringImpl.get(), "r555sum555"));
 }
 
+// The SIMD kernels work on 16 bytes at a time, so check every length and position
+// around a few vectors' worth of characters.
+static const unsigned maximumTestLength = 70;
+
+static String makeTestString(unsigned length, bool make16Bit)
+{
+    Vector<UChar> characters;
+    for (unsigned i = 0; i < length; ++i)
+        characters.append('a' + i % 26);
+    if (make16Bit)
+        return String::adopt(characters);
+    return String::make8BitFrom16BitSource(characters.data(), characters.size());
+}
+
+static String replaceCharacter(const String& string, unsigned index, UChar character)
+{
+    Vector<UChar> characters;
+    characters.append(string.characters(), string.length());
+    characters[index] = character;
+    if (string.is8Bit() && character <= 0xFF)
+        return String::make8BitFrom16BitSource(characters.data(), characters.size());
+    return String::adopt(characters);
+}
+
+TEST(WTF, StringImplFindCharacter)
+{
+    for (unsigned length = 1; length <= maximumTestLength; ++length) {
+        for (unsigned make16Bit = 0; make16Bit < 2; ++make16Bit) {
+            String string = makeTestString(length, make16Bit);
+            ASSERT_EQ(notFound, string.find('#'));
+            for (unsigned position = 0; position < length; ++position) {
+                String withMatch = replaceCharacter(string, position, '#');
+                ASSERT_EQ(position, withMatch.find('#'));
+                ASSERT_EQ(position, withMatch.find('#', position));
+                ASSERT_EQ(notFound, withMatch.find('#', position + 1));
+            }
+        }
+    }
+    ASSERT_EQ(notFound, String("abc").find('a', 10));
+}
+
+TEST(WTF, StringImplEqual)
+{
+    for (unsigned length = 1; length <= maximumTestLength; ++length) {
+        String string8 = makeTestString(length, false);
+        String string16 = makeTestString(length, true);
+        ASSERT_TRUE(string8.is8Bit());
+        ASSERT_FALSE(string16.is8Bit());
+        ASSERT_TRUE(equal(string8.impl(), makeTestString(length, false).impl()));
+        ASSERT_TRUE(equal(string8.impl(), string16.impl()));
+        ASSERT_TRUE(equal(string16.impl(), makeTestString(length, true).impl()));
+
+        for (unsigned position = 0; position < length; ++position) {
+            String different8 = replaceCharacter(string8, position, '#');
+            String different16 = replaceCharacter(string16, position, 0x2603);
+            ASSERT_FALSE(equal(string8.impl(), different8.impl()));
+            ASSERT_FALSE(equal(string16.impl(), different8.impl()));
+            ASSERT_FALSE(equal(string8.impl(), different16.impl()));
+            ASSERT_FALSE(equal(string16.impl(), different16.impl()));
+        }
+    }
+}
+
+TEST(WTF, StringImplEqualIgnoringCase)
+{
+    for (unsigned length = 1; length <= maximumTestLength; ++length) {
+        String lower8 = makeTestString(length, false);
+        String upper8 = lower8.upper();
+        String upper16 = makeTestString(length, true).upper();
+        ASSERT_TRUE(equalIgnoringCase(lower8.impl(), upper8.impl()));
+        ASSERT_TRUE(equalIgnoringCase(upper16.impl(), lower8.impl()));
+
+        for (unsigned position = 0; position < length; ++position) {
+            // Latin-1 letters fold as well.
+            ASSERT_TRUE(equalIgnoringCase(replaceCharacter(lower8, position, 0xE9).impl(), replaceCharacter(upper8, position, 0xC9).impl()));
+            ASSERT_TRUE(equalIgnoringCase(replaceCharacter(upper16, position, 0xC9).impl(), replaceCharacter(lower8, position, 0xE9).impl()));
+
+            ASSERT_FALSE(equalIgnoringCase(replaceCharacter(lower8, position, '#').impl(), upper8.impl()));
+            ASSERT_FALSE(equalIgnoringCase(replaceCharacter(upper16, position, '#').impl(), lower8.impl()));
+            // Characters above 0xFF must not be mistaken for ASCII, like U+FF41 FULLWIDTH LATIN SMALL LETTER A.
+            ASSERT_FALSE(equalIgnoringCase(replaceCharacter(upper16, position, 0xFF41).impl(), replaceCharacter(lower8, position, 'a').impl()));
+        }
+    }
+}
+
+TEST(WTF, StringImplLowerAndUpper)
+{
+    for (unsigned length = 1; length <= maximumTestLength; ++length) {
+        for (unsigned make16Bit = 0; make16Bit < 2; ++make16Bit) {
+            String lower = makeTestString(length, make16Bit);
+            String upper = lower.upper();
+            ASSERT_EQ(lower.is8Bit(), upper.is8Bit());
+            ASSERT_EQ(length, upper.length());
+            for (unsigned i = 0; i < length; ++i)
+                ASSERT_EQ(toASCIIUpper(lower[i]), upper[i]);
+            ASSERT_TRUE(lower == upper.lower());
+            // Lowering a string that is already lowercase returns it unchanged.
+            ASSERT_EQ(lower.impl(), lower.impl()->lower().get());
+
+            for (unsigned position = 0; position < length; ++position) {
+                ASSERT_TRUE(replaceCharacter(lower, position, 0xE9) == replaceCharacter(upper, position, 0xC9).lower());
+                ASSERT_TRUE(replaceCharacter(upper, position, 0xC9) == replaceCharacter(lower, position, 0xE9).upper());
+                ASSERT_TRUE(replaceCharacter(lower, position, '[') == replaceCharacter(upper, position, '[').lower());
+                ASSERT_TRUE(replaceCharacter(upper, position, '{') == replaceCharacter(lower, position, '{').upper());
+            }
+        }
+    }
+}
+
+TEST(WTF, StringImplCharacterWidthConversion)
+{
+    for (unsigned length = 1; length <= maximumTestLength; ++length) {
+        String string8 = makeTestString(length, false);
+        String string16 = makeTestString(length, true);
+        ASSERT_TRUE(charactersAreAllASCII(string16.characters16(), length));
+        ASSERT_TRUE(charactersAreAllASCII(string8.characters8(), length));
+
+        // Widening.
+        const UChar* characters = string8.characters();
+        for (unsigned i = 0; i < length; ++i)
+            ASSERT_EQ(string16[i], characters[i]);
+
+        // Narrowing.
+        Vector<LChar> narrowed(length);
+        WTF::copyLCharsFromUCharSource(narrowed.data(), string16.characters16(), length);
+        for (unsigned i = 0; i < length; ++i)
+            ASSERT_EQ(string16[i], narrowed[i]);
+
+        for (unsigned position = 0; position < length; ++position) {
+            ASSERT_FALSE(charactersAreAllASCII(replaceCharacter(string16, position, 0x8000).characters16(), length));
+            ASSERT_FALSE(charactersAreAllASCII(replaceCharacter(string16, position, 0x80).characters16(), length));
+            ASSERT_FALSE(charactersAreAllASCII(replaceCharacter(string8, position, 0xE9).characters8(), length));
+        }
+    }
+}
+
 } // namespace TestWebKitAPI
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+#include <wtf/RefCounted.h>
+#include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace TestWebKitAPI {
+
+typedef SwissTableHashTraits<HashTraits<int> > SwissIntTraits;
+typedef HashMap<int, int, DefaultHash<int>::Hash, SwissIntTraits> SwissIntHashMap;
+typedef HashSet<int, DefaultHash<int>::Hash, SwissIntTraits> SwissIntHashSet;
+
+static unsigned nextRandom(unsigned& seed)
+{
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+TEST(WTF_SwissHashTable, AddFindRemove)
+{
+    SwissIntHashMap map;
+    HashMap<int, int> reference;
+    unsigned seed = 1;
+
+    for (int i = 0; i < 20000; ++i) {
+        int key = nextRandom(seed) % 5000 + 1;
+        if (nextRandom(seed) % 3) {
+            int value = nextRandom(seed);
+            ASSERT_EQ(reference.add(key, value).isNewEntry, map.add(key, value).isNewEntry);
+        } else {
+            reference.remove(key);
+            map.remove(key);
+        }
+        ASSERT_EQ(reference.size(), map.size());
+    }
+
+    for (int key = 1; key <= 5000; ++key) {
+        ASSERT_EQ(reference.contains(key), map.contains(key));
+        ASSERT_EQ(reference.get(key), map.get(key));
+    }
+
+    int iterated = 0;
+    SwissIntHashMap::const_iterator end = map.end();
+    for (SwissIntHashMap::const_iterator it = map.begin(); it != end; ++it) {
+        ASSERT_EQ(reference.get(it->key), it->value);
+        ++iterated;
+    }
+    ASSERT_EQ(reference.size(), iterated);
+
+    map.checkConsistency();
+}
+
+TEST(WTF_SwissHashTable, LoadFactor)
+{
+    SwissIntHashSet set;
+    HashSet<int> reference;
+    for (int i = 1; i <= 1500; ++i) {
+        set.add(i);
+        reference.add(i);
+    }
+
+    // The table may be 7/8 full, so 1500 keys fit in 2048 buckets where HashTable
+    // needs 4096.
+    ASSERT_EQ(1500, set.size());
+    ASSERT_EQ(2048, set.capacity());
+    ASSERT_EQ(4096, reference.capacity());
+
+    for (int i = 1; i <= 1500; ++i)
+        ASSERT_TRUE(set.contains(i));
+    ASSERT_FALSE(set.contains(1501));
+
+    for (int i = 1; i <= 1490; ++i)
+        set.remove(i);
+    ASSERT_EQ(10, set.size());
+    ASSERT_TRUE(set.capacity() < 2048);
+    for (int i = 1491; i <= 1500; ++i)
+        ASSERT_TRUE(set.contains(i));
+}
+
+TEST(WTF_SwissHashTable, IteratorComparison)
+{
+    SwissIntHashMap map;
+    ASSERT_TRUE(map.begin() == map.end());
+
+    map.add(1, 2);
+    ASSERT_TRUE(map.begin() != map.end());
+    ASSERT_FALSE(map.begin() == map.end());
+
+    SwissIntHashMap::const_iterator begin = map.begin();
+    ASSERT_TRUE(begin == map.begin());
+    ASSERT_TRUE(begin != map.end());
+    ASSERT_EQ(1, begin->key);
+    ASSERT_EQ(2, begin->value);
+}
+
+TEST(WTF_SwissHashTable, StringKeys)
+{
+    typedef HashMap<String, unsigned, StringHash, SwissTableHashTraits<HashTraits<String> > > SwissStringHashMap;
+    SwissStringHashMap map;
+    for (unsigned i = 0; i < 500; ++i)
+        map.add(String::format("key%u", i), i);
+
+    for (unsigned i = 0; i < 500; i += 2)
+        map.remove(String::format("key%u", i));
+
+    ASSERT_EQ(250, map.size());
+    for (unsigned i = 0; i < 500; ++i)
+        ASSERT_EQ(i % 2 ? i : 0, map.get(String::format("key%u", i)));
+
+    SwissStringHashMap copy(map);
+    map.clear();
+    ASSERT_TRUE(map.isEmpty());
+    ASSERT_EQ(250, copy.size());
+    ASSERT_EQ(7u, copy.get("key7"));
+}
+
+class DestructionCounter : public RefCounted<DestructionCounter> {
+public:
+    static PassRefPtr<DestructionCounter> create(int* counter) { return adoptRef(new DestructionCounter(counter)); }
+    ~DestructionCounter() { ++*m_counter; }
+
+private:
+    explicit DestructionCounter(int* counter) : m_counter(counter) { }
+    int* m_counter;
+};
+
+TEST(WTF_SwissHashTable, ValuesAreDestroyed)
+{
+    int destroyed = 0;
+    {
+        HashMap<int, RefPtr<DestructionCounter>, DefaultHash<int>::Hash, SwissIntTraits> map;
+        for (int i = 1; i <= 100; ++i)
+            map.add(i, DestructionCounter::create(&destroyed));
+
+        map.remove(1);
+        ASSERT_EQ(1, destroyed);
+
+        RefPtr<DestructionCounter> taken = map.take(2);
+        ASSERT_EQ(1, destroyed);
+        taken = 0;
+        ASSERT_EQ(2, destroyed);
+
+        map.set(3, DestructionCounter::create(&destroyed));
+        ASSERT_EQ(3, destroyed);
+    }
+    ASSERT_EQ(101, destroyed);
+}
+
+TEST(WTF_SwissHashTable, Swap)
+{
+    SwissIntHashSet a;
+    SwissIntHashSet b;
+    for (int i = 1; i <= 100; ++i)
+        a.add(i);
+    b.add(1000);
+
+    a.swap(b);
+    ASSERT_EQ(1, a.size());
+    ASSERT_EQ(100, b.size());
+    ASSERT_TRUE(a.contains(1000));
+    ASSERT_TRUE(b.contains(50));
+}
+
+// Microbenchmarks comparing HashTable and SwissHashTable. They are disabled by default;
+// run them with --gtest_also_run_disabled_tests --gtest_filter=*SwissHashTableBenchmark*.
+
+static const unsigned benchmarkIterations = 20;
+
+template<typename Set, typename Key>
+static double timeLookups(const Vector<Key>& keys, const Vector<Key>& misses)
+{
+    Set set;
+    for (size_t i = 0; i < keys.size(); ++i)
+        set.add(keys[i]);
+
+    double start = monotonicallyIncreasingTime();
+    size_t found = 0;
+    for (unsigned iteration = 0; iteration < benchmarkIterations; ++iteration) {
+        for (size_t i = 0; i < keys.size(); ++i)
+            found += set.contains(keys[i]);
+        for (size_t i = 0; i < misses.size(); ++i)
+            found += set.contains(misses[i]);
+    }
+    double time = monotonicallyIncreasingTime() - start;
+    EXPECT_EQ(keys.size() * benchmarkIterations, found);
+    return time;
+}
+
+template<typename Set, typename Key>
+static double timeChurn(const Vector<Key>& keys)
+{
+    double start = monotonicallyIncreasingTime();
+    for (unsigned iteration = 0; iteration < benchmarkIterations; ++iteration) {
+        Set set;
+        for (size_t i = 0; i < keys.size(); ++i)
+            set.add(keys[i]);
+        for (size_t i = 0; i < keys.size(); i += 2)
+            set.remove(keys[i]);
+        for (size_t i = 0; i < keys.size(); i += 2)
+            set.add(keys[i]);
+    }
+    return monotonicallyIncreasingTime() - start;
+}
+
+template<typename Set, typename Key>
+static double timeIteration(const Vector<Key>& keys)
+{
+    Set set;
+    for (size_t i = 0; i < keys.size(); ++i)
+        set.add(keys[i]);
+
+    double start = monotonicallyIncreasingTime();
+    size_t count = 0;
+    for (unsigned iteration = 0; iteration < benchmarkIterations; ++iteration) {
+        typename Set::const_iterator end = set.end();
+        for (typename Set::const_iterator it = set.begin(); it != end; ++it)
+            ++count;
+    }
+    double time = monotonicallyIncreasingTime() - start;
+    EXPECT_EQ(set.size() * benchmarkIterations, count);
+    return time;
+}
+
+template<typename Key, typename Hash>
+static void compareTables(const char* name, const Vector<Key>& keys, const Vector<Key>& misses)
+{
+    typedef HashSet<Key, Hash> OldSet;
+    typedef HashSet<Key, Hash, SwissTableHashTraits<HashTraits<Key> > > SwissSet;
+
+    printf("%-24s %7u keys  lookup %8.2fms -> %8.2fms  churn %8.2fms -> %8.2fms  iterate %8.2fms -> %8.2fms\n", name, static_cast<unsigned>(keys.size()),
+        timeLookups<OldSet>(keys, misses) * 1000, timeLookups<SwissSet>(keys, misses) * 1000,
+        timeChurn<OldSet>(keys) * 1000, timeChurn<SwissSet>(keys) * 1000,
+        timeIteration<OldSet>(keys) * 1000, timeIteration<SwissSet>(keys) * 1000);
+}
+
+TEST(WTF_SwissHashTableBenchmark, DISABLED_IntegerKeys)
+{
+    // Dense small integers, as in the JSC symbol and constant tables.
+    for (unsigned size = 100; size <= 1000000; size *= 10) {
+        Vector<int> keys;
+        Vector<int> misses;
+        for (unsigned i = 1; i <= size; ++i) {
+            keys.append(i);
+            misses.append(size + i);
+        }
+        compareTables<int, IntHash<unsigned> >("sequential int", keys, misses);
+    }
+}
+
+TEST(WTF_SwissHashTableBenchmark, DISABLED_PointerKeys)
+{
+    // Heap addresses, as in DocumentOrderedMap and the many pointer keyed maps in WebCore.
+    for (unsigned size = 100; size <= 1000000; size *= 10) {
+        Vector<char*> allocations;
+        Vector<void*> keys;
+        Vector<void*> misses;
+        for (unsigned i = 0; i < size * 2; ++i) {
+            allocations.append(static_cast<char*>(fastMalloc(32)));
+            (i % 2 ? misses : keys).append(allocations.last());
+        }
+        compareTables<void*, PtrHash<void*> >("heap pointer", keys, misses);
+        for (size_t i = 0; i < allocations.size(); ++i)
+            fastFree(allocations[i]);
+    }
+}
+
+TEST(WTF_SwissHashTableBenchmark, DISABLED_StringKeys)
+{
+    // Identifier-like strings, as in the AtomicString table.
+    static const char* const prefixes[] = { "on", "get", "set", "data-", "webkit", "_", "is", "has" };
+    unsigned seed = 1;
+    for (unsigned size = 100; size <= 100000; size *= 10) {
+        Vector<String> keys;
+        Vector<String> misses;
+        for (unsigned i = 0; i < size; ++i) {
+            keys.append(String::format("%s%uValue", prefixes[nextRandom(seed) % 8], i));
+            misses.append(String::format("%s%uMissing", prefixes[nextRandom(seed) % 8], i));
+        }
+        compareTables<String, StringHash>("identifier string", keys, misses);
+    }
+}
+
+} // namespace TestWebKitAPI
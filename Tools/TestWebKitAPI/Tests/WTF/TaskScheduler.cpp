@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include <wtf/Atomics.h>
+#include <wtf/Functional.h>
+#include <wtf/ParallelJobs.h>
+#include <wtf/TaskScheduler.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+namespace TestWebKitAPI {
+
+static const size_t arraySize = 100000;
+
+struct FillSquares {
+    FillSquares(Vector<size_t>& values)
+        : values(values)
+        , calls(0)
+    {
+    }
+
+    void operator()(size_t begin, size_t end)
+    {
+        atomicIncrement(&calls);
+        for (size_t i = begin; i < end; ++i)
+            values[i] = i * i;
+    }
+
+    Vector<size_t>& values;
+    int volatile calls;
+};
+
+TEST(WTF_TaskScheduler, ParallelFor)
+{
+    WTF::initializeThreading();
+    EXPECT_LE(1u, taskSchedulerConcurrency());
+
+    Vector<size_t> values(arraySize);
+    values.fill(0);
+    FillSquares fillSquares(values);
+    parallelFor(0, arraySize, 1000, fillSquares);
+
+    EXPECT_LE(1, fillSquares.calls);
+    EXPECT_GE(100, fillSquares.calls);
+    for (size_t i = 0; i < arraySize; ++i)
+        ASSERT_EQ(i * i, values[i]);
+}
+
+TEST(WTF_TaskScheduler, ParallelForEmptyAndSmallRanges)
+{
+    WTF::initializeThreading();
+
+    Vector<size_t> values(10);
+    values.fill(0);
+    FillSquares fillSquares(values);
+
+    parallelFor(5, 5, 1, fillSquares);
+    EXPECT_EQ(0, fillSquares.calls);
+
+    // A range smaller than the grain size runs in one call.
+    parallelFor(0, 10, 100, fillSquares);
+    EXPECT_EQ(1, fillSquares.calls);
+    for (size_t i = 0; i < 10; ++i)
+        EXPECT_EQ(i * i, values[i]);
+}
+
+static int volatile s_counter;
+
+static void incrementCounter(void*)
+{
+    atomicIncrement(&s_counter);
+}
+
+static void incrementCounterMember(int* counter)
+{
+    atomicIncrement(counter);
+}
+
+TEST(WTF_TaskScheduler, GroupRunsFunctionsAndClosures)
+{
+    WTF::initializeThreading();
+
+    s_counter = 0;
+    int closureCounter = 0;
+    {
+        TaskGroup group(HighTaskPriority);
+        for (unsigned i = 0; i < 100; ++i) {
+            group.run(incrementCounter, 0);
+            group.run(bind(incrementCounterMember, &closureCounter));
+        }
+        group.wait();
+        EXPECT_EQ(100, s_counter);
+        EXPECT_EQ(100, closureCounter);
+
+        // A group can be reused once it has been waited on.
+        group.run(incrementCounter, 0);
+    }
+    // The destructor waits as well.
+    EXPECT_EQ(101, s_counter);
+}
+
+static const unsigned fanOut = 8;
+
+static void recursiveSum(void* context)
+{
+    int* depth = static_cast<int*>(context);
+    atomicIncrement(&s_counter);
+    if (!*depth)
+        return;
+
+    int childDepths[fanOut];
+    TaskGroup group(LowTaskPriority);
+    for (unsigned i = 0; i < fanOut; ++i) {
+        childDepths[i] = *depth - 1;
+        group.run(recursiveSum, &childDepths[i]);
+    }
+    group.wait();
+}
+
+TEST(WTF_TaskScheduler, NestedGroups)
+{
+    WTF::initializeThreading();
+
+    s_counter = 0;
+    int depth = 3;
+    recursiveSum(&depth);
+    // 1 + 8 + 64 + 512 tasks.
+    EXPECT_EQ(585, s_counter);
+}
+
+struct JobParameter {
+    size_t begin;
+    size_t end;
+    size_t sum;
+};
+
+static void sumRange(JobParameter* parameter)
+{
+    parameter->sum = 0;
+    for (size_t i = parameter->begin; i < parameter->end; ++i)
+        parameter->sum += i;
+}
+
+TEST(WTF_TaskScheduler, ParallelJobs)
+{
+    WTF::initializeThreading();
+
+    ParallelJobs<JobParameter> parallelJobs(sumRange, 4);
+    size_t numberOfJobs = parallelJobs.numberOfJobs();
+    ASSERT_LE(1u, numberOfJobs);
+    for (size_t i = 0; i < numberOfJobs; ++i) {
+        parallelJobs.parameter(i).begin = arraySize * i / numberOfJobs;
+        parallelJobs.parameter(i).end = arraySize * (i + 1) / numberOfJobs;
+    }
+    parallelJobs.execute();
+
+    size_t sum = 0;
+    for (size_t i = 0; i < numberOfJobs; ++i)
+        sum += parallelJobs.parameter(i).sum;
+    EXPECT_EQ(arraySize * (arraySize - 1) / 2, sum);
+}
+
+} // namespace TestWebKitAPI
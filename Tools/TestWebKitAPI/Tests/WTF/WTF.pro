@@ -11,6 +11,7 @@ SOURCES += \
     IntegerToStringConversion.cpp \
     ListHashSet.cpp \
     MD5.cpp \
+    MPSCQueue.cpp \
     MathExtras.cpp \
     MediaTime.cpp \
     RedBlackTree.cpp \
@@ -20,6 +21,8 @@ SOURCES += \
     StringHasher.cpp \
     StringImpl.cpp \
     StringOperators.cpp \
+    SwissHashTable.cpp \
+    TaskScheduler.cpp \
     TemporaryChange.cpp \
     Vector.cpp \
     VectorBasic.cpp \
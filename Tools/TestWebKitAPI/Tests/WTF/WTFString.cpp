@@ -139,21 +139,85 @@ TEST(WTF, StringReplaceWithLiteral)
     ASSERT_STREQ("1224", testString.utf8().data());
 
     // Cases for 16Bit source.
-    testString = String::fromUTF8("résumé");
+    // String::fromUTF8() makes an 8-bit string when it can, so spell out the characters.
+    static const UChar resume[] = { 'r', 0x00E9, 's', 'u', 'm', 0x00E9 };
+    testString = String(resume, WTF_ARRAY_LENGTH(resume));
     ASSERT_FALSE(testString.is8Bit());
     testString.replaceWithLiteral(UChar(0x00E9 /*U+00E9 is 'é'*/), "e");
     ASSERT_STREQ("resume", testString.utf8().data());
 
-    testString = String::fromUTF8("résumé");
+    testString = String(resume, WTF_ARRAY_LENGTH(resume));
     ASSERT_FALSE(testString.is8Bit());
     testString.replaceWithLiteral(UChar(0x00E9 /*U+00E9 is 'é'*/), "");
     ASSERT_STREQ("rsum", testString.utf8().data());
 
-    testString = String::fromUTF8("résumé");
+    testString = String(resume, WTF_ARRAY_LENGTH(resume));
     ASSERT_FALSE(testString.is8Bit());
     testString.replaceWithLiteral('3', "NotFound");
     ASSERT_STREQ("résumé", testString.utf8().data());
 }
 
 
+TEST(WTF, StringFromUTF8)
+{
+    // Latin-1 text decodes to an 8-bit string.
+    String latin1 = String::fromUTF8("résumé");
+    EXPECT_TRUE(latin1.is8Bit());
+    EXPECT_EQ(6U, latin1.length());
+    EXPECT_EQ(0x00E9, latin1[1]);
+    EXPECT_EQ(0x00E9, latin1[5]);
+
+    // Other text decodes to a 16-bit string.
+    String snowman = String::fromUTF8("ab\xE2\x98\x83");
+    EXPECT_FALSE(snowman.is8Bit());
+    EXPECT_EQ(3U, snowman.length());
+    EXPECT_EQ(0x2603, snowman[2]);
+
+    String supplementary = String::fromUTF8("\xF0\x9F\x98\x80z");
+    EXPECT_FALSE(supplementary.is8Bit());
+    EXPECT_EQ(3U, supplementary.length());
+    EXPECT_EQ(0xD83D, supplementary[0]);
+    EXPECT_EQ(0xDE00, supplementary[1]);
+
+    // Malformed and truncated sequences fail.
+    EXPECT_TRUE(String::fromUTF8("a\xC0\x80").isNull());
+    EXPECT_TRUE(String::fromUTF8("a\xFF").isNull());
+    EXPECT_TRUE(String::fromUTF8("abc\xC3").isNull());
+    EXPECT_TRUE(String::fromUTF8("\xE2\x98").isNull());
+    EXPECT_TRUE(String::fromUTF8("\xED\xA0\x80").isNull());
+}
+
+TEST(WTF, StringFromUTF8AroundVectors)
+{
+    // The ASCII fast path copies 16 bytes at a time, so put a non-ASCII character at every
+    // position around a few vectors, with and without a later character above U+00FF.
+    for (unsigned length = 1; length < 70; ++length) {
+        for (unsigned position = 0; position < length; ++position) {
+            for (unsigned wide = 0; wide < 2; ++wide) {
+                Vector<char> utf8;
+                Vector<UChar> expected;
+                for (unsigned i = 0; i < length; ++i) {
+                    if (i == position) {
+                        utf8.append('\xC3');
+                        utf8.append('\xA9');
+                        expected.append(0x00E9);
+                    } else if (wide && i == length - 1) {
+                        utf8.append('\xE2');
+                        utf8.append('\x98');
+                        utf8.append('\x83');
+                        expected.append(0x2603);
+                    } else {
+                        utf8.append('a' + i % 26);
+                        expected.append('a' + i % 26);
+                    }
+                }
+                String string = String::fromUTF8(utf8.data(), utf8.size());
+                EXPECT_TRUE(String(expected.data(), expected.size()) == string);
+                EXPECT_EQ(!wide || position == length - 1, string.is8Bit());
+            }
+        }
+    }
+}
+
+
 } // namespace TestWebKitAPI